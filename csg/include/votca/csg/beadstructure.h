@@ -24,6 +24,7 @@
 
 // VOTCA includes
 #include <votca/tools/graph.h>
+#include <votca/tools/labeledgraph.h>
 
 namespace votca {
 namespace csg {
@@ -113,7 +114,9 @@ class BeadStructure {
    * \brief Compare the topology of two bead structures
    *
    * This function looks at how the beads are arranged within the bead structure
-   * and determines if the topology is the same.
+   * and determines if the topology is the same. Structures with different
+   * structure hashes are rejected immediately, only for equal hashes the
+   * beads are matched explicitly.
    *
    * @param[in] beadstructure - beadstructure to compare with
    * @return - if the same returns true else false
@@ -121,6 +124,14 @@ class BeadStructure {
    **/
   bool isStructureEquivalent(BeadStructure &beadstructure);
 
+  /**
+   * \brief Hash of the topology of the bead structure
+   *
+   * Equivalent bead structures have the same hash, so it can be used to sort
+   * structures into groups before comparing them with isStructureEquivalent.
+   **/
+  std::uint64_t getStructureHash();
+
   /// Determine if a bead exists in the structure
   bool BeadExist(Index bead_id) const { return beads_.count(bead_id); }
 
@@ -148,7 +159,7 @@ class BeadStructure {
   bool graphUpToDate = false;
   bool single_structureUpToDate_ = false;
   bool single_structure_ = false;
-  std::string structure_id_ = "";
+  tools::LabeledGraph labeled_graph_;
   tools::Graph graph_;
   std::set<tools::Edge> connections_;
   std::unordered_map<Index, BeadInfo> beads_;
@@ -27,6 +27,20 @@ namespace csg {
 
 std::vector<BeadStructure> breakIntoStructures(BeadStructure& beadstructure);
 
+/**
+ * \brief Sort bead structures into groups of equivalent structures
+ *
+ * Structures are bucketed by their structure hash, so each structure is only
+ * compared explicitly against the groups sharing its hash and the grouping
+ * scales linearly with the number of structures.
+ *
+ * @param[in] structures - bead structures to group
+ * @return - indices of the structures in each group, the groups are ordered
+ * by the first structure that belongs to them
+ */
+std::vector<std::vector<Index>> groupEquivalentStructures(
+    std::vector<BeadStructure>& structures);
+
 }  // namespace csg
 }  // namespace votca
 
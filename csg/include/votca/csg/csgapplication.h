@@ -117,6 +117,8 @@ class CsgApplication : public tools::Application {
     CsgApplication *app_ = nullptr;
     Topology top_, top_cg_;
     std::unique_ptr<TopologyMap> map_;
+    /// raw data of the current frame, if the reader decodes frames separately
+    std::string frame_data_;
     Index id_ = -1;
 
     void Run(void) override;
@@ -151,10 +153,20 @@ class CsgApplication : public tools::Application {
   virtual void MergeWorker(Worker *worker);
 
  protected:
+  /**
+   * \brief skips frames of the trajectory, seeks if the reader supports it
+   * @return False if the trajectory ended
+   */
+  bool SkipFrames(Index nskip, Worker *worker);
+
   std::list<CGObserver *> observers_;
   bool do_mapping_;
   std::vector<std::unique_ptr<Worker>> myWorkers_;
   Index nframes_;
+  /// only every stride_-th frame is processed
+  Index stride_ = 1;
+  /// index of the next frame the trajectory reader will return
+  Index next_frame_ = 0;
   bool is_first_frame_;
   Index nthreads_;
   tools::Mutex nframesMutex_;
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <vector>
 
 // Local VOTCA includes
 #include "bead.h"
@@ -53,6 +54,7 @@ class ExclusionList {
     std::list<Bead *> exclude_;
   };
 
+  /// builds the exclusions from the bonded interactions of top
   void CreateExclusions(Topology *top);
   exclusion_t *GetExclusions(Bead *bead);
   const exclusion_t *GetExclusions(Bead *bead) const;
@@ -62,6 +64,7 @@ class ExclusionList {
   iterator begin() { return exclusions_.begin(); }
   iterator end() { return exclusions_.end(); }
 
+  /// binary search in the sorted exclusions of the bead with the smaller id
   bool IsExcluded(Bead *bead1, Bead *bead2) const;
 
   template <typename iterable>
@@ -72,8 +75,14 @@ class ExclusionList {
   void RemoveExclusion(Bead *bead1, Bead *bead2);
 
  private:
+  // adds bead2 to the exclusions of bead1, requires bead1 id < bead2 id
+  void AddExclusion(Bead *bead1, Bead *bead2);
+
   std::list<exclusion_t *> exclusions_;
   std::map<Bead *, exclusion_t *> excl_by_bead_;
+  // excluded_ids_[i] holds the sorted ids j>i of the beads excluded with bead
+  // i, this is what IsExcluded searches
+  std::vector<std::vector<Index>> excluded_ids_;
 
   friend std::ostream &operator<<(std::ostream &out, ExclusionList &exl);
 };
@@ -103,26 +112,7 @@ inline void ExclusionList::ExcludeList(iterable &l) {
 template <typename iterable>
 inline void ExclusionList::InsertExclusion(Bead *beadA, iterable &l) {
   for (Bead *beadB : l) {
-    Bead *bead1 = beadA;
-    Bead *bead2 = beadB;
-    if (bead2->getId() < bead1->getId()) {
-      std::swap(bead1, bead2);
-    }
-    if (bead1 == bead2) {
-      continue;
-    }
-    if (IsExcluded(bead1, bead2)) {
-      continue;
-    }
-
-    exclusion_t *e;
-    if ((e = GetExclusions(bead1)) == nullptr) {
-      e = new exclusion_t;
-      e->atom_ = bead1;
-      exclusions_.push_back(e);
-      excl_by_bead_[bead1] = e;
-    }
-    e->exclude_.push_back(bead2);
+    InsertExclusion(beadA, beadB);
   }
 }
 
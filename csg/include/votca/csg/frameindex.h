@@ -0,0 +1,100 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_FRAMEINDEX_H
+#define VOTCA_CSG_FRAMEINDEX_H
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
+namespace votca {
+namespace csg {
+
+/**
+    \brief byte offsets of the frames in a text trajectory file
+
+    Text trajectory readers record the start of every frame while reading.
+    Once the end of the file was reached, the index is complete and can be
+    stored next to the trajectory (file.vidx), so that the next Open of the
+    same, unmodified trajectory knows all frame boundaries without scanning
+    the file again. With a complete index a frame can be read with a single
+    block read and frames can be located directly.
+ */
+class FrameIndex {
+ public:
+  /// readers do not write sidecar files for trajectories smaller than this,
+  /// rescanning them is cheap
+  static constexpr std::int64_t MinSizeForSidecar = 64 * 1024 * 1024;
+
+  FrameIndex() = default;
+
+  /// name of the sidecar index file of a trajectory
+  static std::string SidecarName(const std::string &trjfile) {
+    return trjfile + ".vidx";
+  }
+
+  /// \brief tries to load the sidecar index, returns false if there is none
+  /// or if it does not match the trajectory anymore
+  bool Load(const std::string &trjfile);
+
+  /// \brief writes the sidecar index if it is complete, returns false if
+  /// nothing was written
+  bool Save(const std::string &trjfile) const;
+
+  void Clear();
+
+  /// \brief records the start of a frame, offsets have to be added in order,
+  /// already known frames are ignored
+  void AddFrame(Index frame, std::int64_t offset);
+
+  /// \brief marks the index as complete, end is the size of the trajectory
+  void setComplete(std::int64_t end);
+
+  bool isComplete() const { return end_ >= 0; }
+
+  /// number of frames whose start is known
+  Index KnownFrames() const { return Index(offsets_.size()); }
+
+  /// byte offset of the start of frame
+  std::int64_t FrameStart(Index frame) const { return offsets_[frame]; }
+
+  /// \brief returns true if the start and the end of frame are known
+  bool KnowsFrameSize(Index frame) const {
+    return frame + 1 < KnownFrames() || (isComplete() && frame < KnownFrames());
+  }
+
+  /// size of frame in bytes, only valid if KnowsFrameSize(frame)
+  std::int64_t FrameSize(Index frame) const {
+    std::int64_t next =
+        (frame + 1 < KnownFrames()) ? offsets_[frame + 1] : end_;
+    return next - offsets_[frame];
+  }
+
+ private:
+  std::vector<std::int64_t> offsets_;
+  std::int64_t end_ = -1;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_FRAMEINDEX_H
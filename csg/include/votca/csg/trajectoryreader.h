@@ -19,6 +19,7 @@
 #define VOTCA_CSG_TRAJECTORYREADER_H
 
 // Standard includes
+#include <stdexcept>
 #include <string>
 
 // Local VOTCA includes
@@ -46,6 +47,44 @@ class TrajectoryReader {
   /// read in the next frame
   virtual bool NextFrame(Topology &top) = 0;
 
+  /// \brief true if the reader can jump to a frame, see SeekFrame
+  virtual bool CanSeekFrame() const { return false; }
+
+  /**
+   * \brief positions the reader such that the next NextFrame call reads the
+   * given frame, frames are counted from 0
+   *
+   * Only valid after FirstFrame was called. Returns false if the trajectory
+   * has less frames.
+   */
+  virtual bool SeekFrame(Index) {
+    throw std::runtime_error("SeekFrame is not supported by this reader");
+  }
+
+  /// \brief total number of frames in the trajectory, -1 if the reader does
+  /// not know it, only valid after FirstFrame was called
+  virtual Index FrameCount() { return -1; }
+
+  /**
+   * \brief true if the reader splits reading a frame into fetching the raw
+   * frame data (ReadFrameData) and converting it (DecodeFrameData)
+   *
+   * Only ReadFrameData has to be called in order, so several threads can
+   * decode frames at the same time while the file is read sequentially.
+   */
+  virtual bool CanDecodeFrameData() const { return false; }
+
+  /// \brief reads the raw data of the next frame into buffer, returns false
+  /// if there are no frames left
+  virtual bool ReadFrameData(std::string &) {
+    throw std::runtime_error("ReadFrameData is not supported by this reader");
+  }
+
+  /// \brief fills top with the frame stored in buffer, has to be thread-safe
+  virtual void DecodeFrameData(const std::string &, Topology &) const {
+    throw std::runtime_error("DecodeFrameData is not supported by this reader");
+  }
+
   static void RegisterPlugins(void);
 };
 
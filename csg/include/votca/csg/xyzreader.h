@@ -19,6 +19,7 @@
 #define __VOTCA_CSG_XYZREADER_H
 
 // Standard includes
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -30,6 +31,7 @@
 #include <votca/tools/unitconverter.h>
 
 // Local VOTCA includes
+#include "frameindex.h"
 #include "topologyreader.h"
 #include "trajectoryreader.h"
 
@@ -40,7 +42,8 @@ namespace csg {
     \brief class for reading xyz files
 
     This class provides the TrajectoryReader + Topology reader interface
-    for xyz files
+    for xyz files. The frame offsets are kept in a FrameIndex, so frames can
+    be located directly, e.g. for --first-frame and --stride.
 
 */
 class XYZReader : public TrajectoryReader, public TopologyReader {
@@ -60,6 +63,10 @@ class XYZReader : public TrajectoryReader, public TopologyReader {
   /// read in the next frame
   bool NextFrame(Topology &top) override;
 
+  bool CanSeekFrame() const override { return true; }
+  bool SeekFrame(Index frame) override;
+  Index FrameCount() override;
+
   template <class T>
   void ReadFile(T &container) {
     if (!ReadFrame<true, T>(container)) {
@@ -105,9 +112,20 @@ class XYZReader : public TrajectoryReader, public TopologyReader {
   template <bool topology, class T>
   bool ReadFrame(T &container);
 
+  /// reads over the next frame and records its offset
+  bool SkipFrame();
+  void CompleteIndex();
+  void EndOfTrajectory();
+  /// positions the stream at the start of frame
+  void PositionAt(Index frame);
+
   std::ifstream fl_;
   std::string file_;
   Index line_;
+  FrameIndex index_;
+  bool index_from_sidecar_ = false;
+  // next frame to be read
+  Index frame_ = 0;
 };
 
 template <bool topology, class T>
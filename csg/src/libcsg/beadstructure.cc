@@ -21,7 +21,6 @@
 // VOTCA includes
 #include <votca/tools/graph_bf_visitor.h>
 #include <votca/tools/graphalgorithm.h>
-#include <votca/tools/graphdistvisitor.h>
 
 // Local VOTCA includes
 #include "votca/csg/beadstructure.h"
@@ -55,7 +54,7 @@ void BeadStructure::CalculateStructure_() {
 
   InitializeGraph_();
   if (!structureIdUpToDate) {
-    structure_id_ = tools::findStructureId<tools::GraphDistVisitor>(graph_);
+    labeled_graph_ = tools::LabeledGraph(graph_);
     structureIdUpToDate = true;
   }
 }
@@ -173,7 +172,12 @@ bool BeadStructure::isStructureEquivalent(BeadStructure &beadstructure) {
   if (!beadstructure.structureIdUpToDate) {
     beadstructure.CalculateStructure_();
   }
-  return structure_id_.compare(beadstructure.structure_id_) == 0;
+  return labeled_graph_.isIsomorphic(beadstructure.labeled_graph_);
+}
+
+std::uint64_t BeadStructure::getStructureHash() {
+  CalculateStructure_();
+  return labeled_graph_.getHash();
 }
 
 std::vector<Index> BeadStructure::getNeighBeadIds(const Index &index) {
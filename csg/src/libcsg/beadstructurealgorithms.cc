@@ -15,6 +15,9 @@
  *
  */
 
+// Standard includes
+#include <unordered_map>
+
 // VOTCA includes
 #include <votca/tools/graphalgorithm.h>
 
@@ -45,5 +48,28 @@ vector<BeadStructure> breakIntoStructures(BeadStructure &beadstructure) {
   return structures;
 }
 
+vector<vector<Index>> groupEquivalentStructures(
+    vector<BeadStructure> &structures) {
+  vector<vector<Index>> groups;
+  unordered_map<std::uint64_t, vector<Index>> groups_by_hash;
+  for (Index i = 0; i < Index(structures.size()); ++i) {
+    vector<Index> &candidate_groups =
+        groups_by_hash[structures[i].getStructureHash()];
+    bool found = false;
+    for (Index group : candidate_groups) {
+      if (structures[i].isStructureEquivalent(structures[groups[group][0]])) {
+        groups[group].push_back(i);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      candidate_groups.push_back(Index(groups.size()));
+      groups.push_back({i});
+    }
+  }
+  return groups;
+}
+
 }  // namespace csg
 }  // namespace votca
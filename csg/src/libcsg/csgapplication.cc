@@ -15,9 +15,15 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <memory>
+
 // Third party includes
 #include <boost/algorithm/string/trim.hpp>
-#include <memory>
+
+// VOTCA includes
+#include <votca/tools/profiler.h>
 
 // Local VOTCA includes
 #include "votca/csg/cgengine.h"
@@ -69,9 +75,18 @@ void CsgApplication::Initialize() {
         "begin", boost::program_options::value<double>()->default_value(0.0),
         "  skip frames before this time (only works for Gromacs files)")(
         "first-frame", boost::program_options::value<Index>()->default_value(0),
-        "  start with this frame")("nframes",
-                                   boost::program_options::value<Index>(),
-                                   "  process the given number of frames");
+        "  start with this frame, lammps dump, h5md, xyz and gro files jump\n"
+        "  there directly, other formats read over the frames before")(
+        "nframes", boost::program_options::value<Index>(),
+        "  process the given number of frames")(
+        "stride", boost::program_options::value<Index>()->default_value(1),
+        "  only process every n-th frame, skipped frames are read over\n"
+        "  unless the format can jump to a frame, see first-frame")(
+        "nparts", boost::program_options::value<Index>()->default_value(1),
+        "  split the selected frames into this number of consecutive parts,\n"
+        "  e.g. to analyse them in independent runs")(
+        "part", boost::program_options::value<Index>()->default_value(0),
+        "  process only this part (counted from 0) of the frames, see nparts");
   }
 
   if (DoThreaded()) {
@@ -110,6 +125,18 @@ bool CsgApplication::EvaluateOptions() {
     }
   }
 
+  if (DoTrajectory()) {
+    stride_ = OptionsMap()["stride"].as<Index>();
+    if (stride_ < 1) {
+      throw std::runtime_error("stride has to be larger than 0");
+    }
+    Index nparts = OptionsMap()["nparts"].as<Index>();
+    Index part = OptionsMap()["part"].as<Index>();
+    if (nparts < 1 || part < 0 || part >= nparts) {
+      throw std::runtime_error("part has to be in the range [0, nparts)");
+    }
+  }
+
   /* check threading options */
   if (DoThreaded()) {
     nthreads_ = OptionsMap()["nt"].as<Index>();
@@ -139,7 +166,10 @@ void CsgApplication::Worker::Run() {
     if (app_->SynchronizeThreads()) {
       Index id = getId();
       app_->threadsMutexesOut_[id]->Lock();
-      app_->MergeWorker(this);
+      {
+        tools::ScopedTimer timer("CsgApplication::MergeWorker");
+        app_->MergeWorker(this);
+      }
       app_->threadsMutexesOut_[(id + 1) % app_->nthreads_]->Unlock();
     }
   }
@@ -154,6 +184,7 @@ bool CsgApplication::ProcessData(Worker *worker) {
     // wait til its your turn
     threadsMutexesIn_[id]->Lock();
   }
+  tools::ScopedTimer read_timer("CsgApplication::ReadFrame");
   traj_readerMutex_.Lock();
   if (nframes_ == 0) {
     traj_readerMutex_.Unlock();
@@ -166,9 +197,22 @@ bool CsgApplication::ProcessData(Worker *worker) {
     return false;
   }
   nframes_--;
+  // readers which can decode frames separately only fetch the raw frame
+  // here, the conversion is done below without holding the reader lock
+  bool decode_frame = false;
   if (!is_first_frame_ || worker->getId() != 0) {
     // get frame
-    bool tmpRes = traj_reader_->NextFrame(worker->top_);
+    bool tmpRes = SkipFrames(stride_ - 1, worker);
+    if (tmpRes) {
+      if (traj_reader_->CanDecodeFrameData()) {
+        tmpRes = traj_reader_->ReadFrameData(worker->frame_data_);
+        read_timer.AddBytes(Index(worker->frame_data_.size()));
+        decode_frame = true;
+      } else {
+        tmpRes = traj_reader_->NextFrame(worker->top_);
+      }
+      next_frame_++;
+    }
     if (!tmpRes) {
       traj_readerMutex_.Unlock();
       if (SynchronizeThreads()) {
@@ -182,21 +226,52 @@ bool CsgApplication::ProcessData(Worker *worker) {
   }
 
   traj_readerMutex_.Unlock();
+  read_timer.Stop();
   if (SynchronizeThreads()) {
     // unlock next frame for input
     threadsMutexesIn_[(id + 1) % nthreads_]->Unlock();
   }
+  if (decode_frame) {
+    tools::ScopedTimer timer("CsgApplication::DecodeFrame",
+                             Index(worker->frame_data_.size()));
+    traj_reader_->DecodeFrameData(worker->frame_data_, worker->top_);
+  }
   // evaluate
   if (do_mapping_) {
-    worker->map_->Apply();
+    {
+      tools::ScopedTimer timer("CsgApplication::Map");
+      worker->map_->Apply();
+    }
+    tools::ScopedTimer timer("CsgApplication::EvalConfiguration");
     worker->EvalConfiguration(&worker->top_cg_, &worker->top_);
   } else {
+    tools::ScopedTimer timer("CsgApplication::EvalConfiguration");
     worker->EvalConfiguration(&worker->top_);
   }
 
   return true;
 }
 
+bool CsgApplication::SkipFrames(Index nskip, Worker *worker) {
+  if (nskip == 0) {
+    return true;
+  }
+  if (traj_reader_->CanSeekFrame()) {
+    next_frame_ += nskip;
+    return traj_reader_->SeekFrame(next_frame_);
+  }
+  for (Index i = 0; i < nskip; i++) {
+    bool ok = traj_reader_->CanDecodeFrameData()
+                  ? traj_reader_->ReadFrameData(worker->frame_data_)
+                  : traj_reader_->NextFrame(worker->top_);
+    if (!ok) {
+      return false;
+    }
+    next_frame_++;
+  }
+  return true;
+}
+
 void CsgApplication::Run(void) {
   // create reader for atomistic topology
   std::unique_ptr<TopologyReader> reader =
@@ -335,11 +410,56 @@ void CsgApplication::Run(void) {
              "is intended.\n"
           << std::endl;
     }
+    // frames are counted from 0 here, first-frame 0 and 1 both refer to the
+    // first frame of the trajectory
+    Index skip = std::max(first_frame - 1, Index(0));
+    Index nparts = OptionsMap()["nparts"].as<Index>();
+    if (nparts > 1) {
+      if (has_begin && begin > 0) {
+        throw std::runtime_error("begin cannot be combined with nparts");
+      }
+      Index count = traj_reader_->FrameCount();
+      if (count < 0) {
+        throw std::runtime_error(
+            "nparts needs a trajectory format which knows its number of "
+            "frames");
+      }
+      // split the selected frames, not the whole trajectory, so that the
+      // parts together process exactly the frames of a single run
+      Index selected =
+          (count > skip) ? (count - skip + stride_ - 1) / stride_ : 0;
+      if (nframes_ >= 0) {
+        selected = std::min(selected, nframes_);
+      }
+      Index part = OptionsMap()["part"].as<Index>();
+      Index part_begin = part * selected / nparts;
+      Index part_end = (part + 1) * selected / nparts;
+      if (part_end == part_begin) {
+        throw std::runtime_error("part " + std::to_string(part) +
+                                 " does not contain any frames");
+      }
+      skip += part_begin * stride_;
+      nframes_ = part_end - part_begin;
+      std::cout << "Processing part " << part << " of " << nparts << ": "
+                << nframes_ << " frames starting at frame " << skip
+                << std::endl;
+    }
+
     // seek first frame, let thread0 do that
-    bool bok;
-    for (bok = true; bok == true; bok = traj_reader_->NextFrame(master->top_)) {
-      if ((has_begin && (master->top_.getTime() < begin)) || first_frame > 1) {
-        first_frame--;
+    next_frame_ = 1;
+    bool bok = true;
+    if (skip > 0 && traj_reader_->CanSeekFrame()) {
+      bok = traj_reader_->SeekFrame(skip) &&
+            traj_reader_->NextFrame(master->top_);
+      next_frame_ = skip + 1;
+      skip = 0;
+    }
+    for (; bok == true; bok = traj_reader_->NextFrame(master->top_)) {
+      if ((has_begin && (master->top_.getTime() < begin)) || skip > 0) {
+        if (skip > 0) {
+          skip--;
+        }
+        next_frame_++;
         continue;
       }
       break;
@@ -391,7 +511,9 @@ void CsgApplication::Run(void) {
         myWorker->WaitDone();
         if (!SynchronizeThreads()) {
           mergeMutex.Lock();
+          tools::ScopedTimer timer("CsgApplication::MergeWorker");
           MergeWorker(myWorker.get());
+          timer.Stop();
           mergeMutex.Unlock();
         }
       }
@@ -33,20 +33,37 @@ void ExclusionList::Clear(void) {
     delete exclusion_;
   }
   exclusions_.clear();
+  excl_by_bead_.clear();
+  excluded_ids_.clear();
 }
 
+// All pairs are collected and sorted first, so every exclusion is appended to
+// the end of its bead's list, O(n log n) in the number of pairs.
 void ExclusionList::CreateExclusions(Topology *top) {
   InteractionContainer &ic = top->BondedInteractions();
 
+  std::vector<std::pair<Index, Index>> pairs;
   for (auto &ia : ic) {
     Index beads_in_int = ia->BeadCount();
-    std::vector<Bead *> l;
+    for (Index i = 0; i < beads_in_int; i++) {
+      for (Index j = i + 1; j < beads_in_int; j++) {
+        Index id1 = ia->getBeadId(i);
+        Index id2 = ia->getBeadId(j);
+        if (id1 != id2) {
+          pairs.push_back(std::minmax(id1, id2));
+        }
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
+  pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
 
-    for (Index ibead = 0; ibead < beads_in_int; ibead++) {
-      Index ii = ia->getBeadId(ibead);
-      l.push_back(top->getBead(ii));
+  for (const auto &pair : pairs) {
+    Bead *bead1 = top->getBead(pair.first);
+    Bead *bead2 = top->getBead(pair.second);
+    if (!IsExcluded(bead1, bead2)) {
+      AddExclusion(bead1, bead2);
     }
-    ExcludeList(l);
   }
 }
 
@@ -74,18 +91,35 @@ bool ExclusionList::IsExcluded(Bead *bead1, Bead *bead2) const {
   if (bead1->getMoleculeId() != bead2->getMoleculeId()) {
     return false;
   }
-  if (bead2->getId() < bead1->getId()) {
-    swap(bead1, bead2);
+  Index id1 = bead1->getId();
+  Index id2 = bead2->getId();
+  if (id2 < id1) {
+    swap(id1, id2);
   }
+  if (id1 < 0 || id1 >= Index(excluded_ids_.size())) {
+    return false;
+  }
+  const std::vector<Index> &ids = excluded_ids_[id1];
+  return std::binary_search(ids.begin(), ids.end(), id2);
+}
 
-  const exclusion_t *excl = GetExclusions(bead1);
-  if (excl != nullptr) {
-    if (find(excl->exclude_.begin(), excl->exclude_.end(), bead2) !=
-        excl->exclude_.end()) {
-      return true;
-    }
+void ExclusionList::AddExclusion(Bead *bead1, Bead *bead2) {
+  exclusion_t *e;
+  if ((e = GetExclusions(bead1)) == nullptr) {
+    e = new exclusion_t;
+    e->atom_ = bead1;
+    exclusions_.push_back(e);
+    excl_by_bead_[bead1] = e;
+  }
+  e->exclude_.push_back(bead2);
+
+  Index id1 = bead1->getId();
+  if (id1 >= Index(excluded_ids_.size())) {
+    excluded_ids_.resize(id1 + 1);
   }
-  return false;
+  std::vector<Index> &ids = excluded_ids_[id1];
+  ids.insert(std::upper_bound(ids.begin(), ids.end(), bead2->getId()),
+             bead2->getId());
 }
 
 void ExclusionList::InsertExclusion(Bead *bead1, Bead *bead2) {
@@ -100,15 +134,7 @@ void ExclusionList::InsertExclusion(Bead *bead1, Bead *bead2) {
   if (IsExcluded(bead1, bead2)) {
     return;
   }
-
-  exclusion_t *e;
-  if ((e = GetExclusions(bead1)) == nullptr) {
-    e = new exclusion_t;
-    e->atom_ = bead1;
-    exclusions_.push_back(e);
-    excl_by_bead_[bead1] = e;
-  }
-  e->exclude_.push_back(bead2);
+  AddExclusion(bead1, bead2);
 }
 
 void ExclusionList::RemoveExclusion(Bead *bead1, Bead *bead2) {
@@ -124,20 +150,16 @@ void ExclusionList::RemoveExclusion(Bead *bead1, Bead *bead2) {
     return;
   }
 
-  std::list<exclusion_t *>::iterator ex =
-      std::find_if(exclusions_.begin(), exclusions_.end(),
-                   [&bead1](exclusion_t *e) { return e->atom_ == bead1; });
-
-  if (ex == exclusions_.end()) {
-    return;
-  }
+  std::vector<Index> &ids = excluded_ids_[bead1->getId()];
+  ids.erase(std::lower_bound(ids.begin(), ids.end(), bead2->getId()));
 
-  (*ex)->exclude_.remove(bead2);
-  if ((*ex)->exclude_.empty()) {
-    (*ex) = nullptr;
-    exclusions_.erase(ex);
+  exclusion_t *e = GetExclusions(bead1);
+  e->exclude_.remove(bead2);
+  if (e->exclude_.empty()) {
+    exclusions_.remove(e);
+    excl_by_bead_.erase(bead1);
+    delete e;
   }
-  exclusions_.remove(nullptr);
 }
 
 bool compareAtomIdiExclusionList(const ExclusionList::exclusion_t *a,
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+// Local VOTCA includes
+#include "votca/csg/frameindex.h"
+
+namespace votca {
+namespace csg {
+
+namespace {
+
+constexpr std::array<char, 8> magic = {'V', 'O', 'T', 'C', 'A', 'I', 'D', 'X'};
+constexpr std::int64_t version = 1;
+
+// size and modification time identify the version of the trajectory an index
+// was created for
+bool FileStamp(const std::string &file, std::int64_t &size,
+               std::int64_t &mtime) {
+  std::error_code ec;
+  size = std::int64_t(std::filesystem::file_size(file, ec));
+  if (ec) {
+    return false;
+  }
+  auto time = std::filesystem::last_write_time(file, ec);
+  if (ec) {
+    return false;
+  }
+  mtime = std::int64_t(time.time_since_epoch().count());
+  return true;
+}
+
+}  // namespace
+
+void FrameIndex::Clear() {
+  offsets_.clear();
+  end_ = -1;
+}
+
+void FrameIndex::AddFrame(Index frame, std::int64_t offset) {
+  if (frame < KnownFrames()) {
+    return;
+  }
+  if (frame != KnownFrames()) {
+    throw std::runtime_error("FrameIndex: frames have to be added in order");
+  }
+  offsets_.push_back(offset);
+}
+
+void FrameIndex::setComplete(std::int64_t end) { end_ = end; }
+
+bool FrameIndex::Load(const std::string &trjfile) {
+  Clear();
+  std::int64_t size, mtime;
+  if (!FileStamp(trjfile, size, mtime)) {
+    return false;
+  }
+  std::ifstream in(SidecarName(trjfile), std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  std::array<char, 8> header;
+  std::int64_t file_version, file_size, file_mtime, nframes;
+  in.read(header.data(), header.size());
+  in.read(reinterpret_cast<char *>(&file_version), sizeof(file_version));
+  in.read(reinterpret_cast<char *>(&file_size), sizeof(file_size));
+  in.read(reinterpret_cast<char *>(&file_mtime), sizeof(file_mtime));
+  in.read(reinterpret_cast<char *>(&nframes), sizeof(nframes));
+  if (!in || header != magic || file_version != version || file_size != size ||
+      file_mtime != mtime || nframes < 0) {
+    return false;
+  }
+  std::vector<std::int64_t> offsets(nframes);
+  in.read(reinterpret_cast<char *>(offsets.data()),
+          std::streamsize(nframes * std::int64_t(sizeof(std::int64_t))));
+  if (!in) {
+    return false;
+  }
+  offsets_ = std::move(offsets);
+  end_ = size;
+  return true;
+}
+
+bool FrameIndex::Save(const std::string &trjfile) const {
+  std::int64_t size, mtime;
+  if (!isComplete() || !FileStamp(trjfile, size, mtime) || size != end_) {
+    return false;
+  }
+  std::ofstream out(SidecarName(trjfile), std::ios::binary);
+  if (!out.is_open()) {
+    // e.g. read-only directory, we just rescan next time
+    return false;
+  }
+  std::int64_t nframes = KnownFrames();
+  out.write(magic.data(), magic.size());
+  out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  out.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  out.write(reinterpret_cast<const char *>(&mtime), sizeof(mtime));
+  out.write(reinterpret_cast<const char *>(&nframes), sizeof(nframes));
+  out.write(reinterpret_cast<const char *>(offsets_.data()),
+            std::streamsize(nframes * std::int64_t(sizeof(std::int64_t))));
+  return bool(out);
+}
+
+}  // namespace csg
+}  // namespace votca
@@ -36,7 +36,9 @@ namespace csg {
     \brief class for reading dlpoly trajectory and configuration files
 
     This class encapsulates the dlpoly trajectory and configuration reading
-   function and provides an interface to fill a topology class
+   function and provides an interface to fill a topology class. Frames
+   cannot be located directly, --first-frame and --stride read over the
+   frames they skip.
 
 */
 
@@ -43,7 +43,7 @@ bool GROReader::ReadTopology(string file, Topology &top) {
     throw std::ios_base::failure("Error on open topology file: " + file);
   }
 
-  NextFrame(top);
+  ReadFrame(top);
 
   fl_.close();
 
@@ -55,6 +55,9 @@ bool GROReader::Open(const string &file) {
   if (!fl_.is_open()) {
     throw std::ios_base::failure("Error on open trajectory file: " + file);
   }
+  fname_ = file;
+  frame_ = 0;
+  index_from_sidecar_ = index_.Load(file);
   return true;
 }
 
@@ -67,6 +70,97 @@ bool GROReader::FirstFrame(Topology &top) {
 }
 
 bool GROReader::NextFrame(Topology &top) {
+  std::int64_t start = std::int64_t(fl_.tellg());
+  bool success = ReadFrame(top);
+  if (success) {
+    index_.AddFrame(frame_, start);
+    ++frame_;
+  } else {
+    EndOfTrajectory();
+  }
+  return success;
+}
+
+bool GROReader::SkipFrame() {
+  std::int64_t start = std::int64_t(fl_.tellg());
+  string line;
+  tools::getline(fl_, line);  // title
+  if (fl_.eof()) {
+    EndOfTrajectory();
+    return false;
+  }
+  tools::getline(fl_, line);  // number atoms
+  Index natoms = std::stol(line);
+  // the atoms and the box line
+  for (Index i = 0; i <= natoms; ++i) {
+    tools::getline(fl_, line);
+    if (fl_.eof()) {
+      throw std::runtime_error("unexpected end of file in gro file");
+    }
+  }
+  index_.AddFrame(frame_, start);
+  ++frame_;
+  return true;
+}
+
+void GROReader::EndOfTrajectory() {
+  if (index_.isComplete()) {
+    return;
+  }
+  fl_.clear();
+  fl_.seekg(0, std::ios::end);
+  std::int64_t end = std::int64_t(fl_.tellg());
+  index_.setComplete(end);
+  if (!index_from_sidecar_ && end >= FrameIndex::MinSizeForSidecar) {
+    index_.Save(fname_);
+  }
+}
+
+void GROReader::PositionAt(Index frame) {
+  fl_.clear();
+  if (frame < index_.KnownFrames()) {
+    fl_.seekg(index_.FrameStart(frame));
+  } else {
+    fl_.seekg(0, std::ios::end);
+  }
+  frame_ = frame;
+}
+
+void GROReader::CompleteIndex() {
+  if (index_.isComplete()) {
+    return;
+  }
+  // scan the rest of the file, starting at the last known frame
+  Index current = frame_;
+  if (index_.KnownFrames() > 0) {
+    PositionAt(index_.KnownFrames() - 1);
+  } else {
+    fl_.clear();
+    fl_.seekg(0);
+    frame_ = 0;
+  }
+  while (SkipFrame()) {
+  }
+  PositionAt(current);
+}
+
+bool GROReader::SeekFrame(Index frame) {
+  if (frame >= index_.KnownFrames()) {
+    CompleteIndex();
+  }
+  if (frame < 0 || frame >= index_.KnownFrames()) {
+    return false;
+  }
+  PositionAt(frame);
+  return true;
+}
+
+Index GROReader::FrameCount() {
+  CompleteIndex();
+  return index_.KnownFrames();
+}
+
+bool GROReader::ReadFrame(Topology &top) {
   string tmp;
   tools::getline(fl_, tmp);  // title
   if (fl_.eof()) {
@@ -19,6 +19,7 @@
 #define VOTCA_CSG_GROREADER_PRIVATE_H
 
 // Standard includes
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -27,6 +28,7 @@
 #include <votca/tools/unitconverter.h>
 
 // Local includes
+#include "votca/csg/frameindex.h"
 #include "votca/csg/topologyreader.h"
 #include "votca/csg/trajectoryreader.h"
 
@@ -37,7 +39,8 @@ namespace csg {
     \brief reader for gro files
 
     This class provides the TrajectoryReader + Topology reader interface
-    for gro files
+    for gro files. The frame offsets are kept in a FrameIndex, so frames can
+    be located directly, e.g. for --first-frame and --stride.
 
 */
 class GROReader : public TrajectoryReader, public TopologyReader {
@@ -66,11 +69,28 @@ class GROReader : public TrajectoryReader, public TopologyReader {
   /// read in the next frame
   bool NextFrame(Topology &top) override;
 
+  bool CanSeekFrame() const override { return true; }
+  bool SeekFrame(Index frame) override;
+  Index FrameCount() override;
+
   void Close() override;
 
  private:
+  bool ReadFrame(Topology &top);
+  /// reads over the next frame and records its offset
+  bool SkipFrame();
+  void CompleteIndex();
+  void EndOfTrajectory();
+  /// positions the stream at the start of frame
+  void PositionAt(Index frame);
+
   std::ifstream fl_;
+  std::string fname_;
   bool topology_;
+  FrameIndex index_;
+  bool index_from_sidecar_ = false;
+  // next frame to be read
+  Index frame_ = 0;
 };
 
 }  // namespace csg
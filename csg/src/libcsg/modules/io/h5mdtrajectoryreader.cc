@@ -16,6 +16,7 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -124,6 +125,7 @@ void H5MDTrajectoryReader::Initialize(Topology &top) {
   CheckError(atom_position_group_,
              "Unable to open " + position_group_name + " group");
   idx_frame_ = -1;
+  buffer_frames_ = 0;
   ds_atom_position_ = H5Dopen(atom_position_group_, "value", H5P_DEFAULT);
   CheckError(ds_atom_position_,
              "Unable to open " + position_group_name + "/value dataset");
@@ -217,6 +219,9 @@ void H5MDTrajectoryReader::Initialize(Topology &top) {
   rank_ = H5Sget_simple_extent_dims(fs_atom_position_, dims, nullptr);
   N_particles_ = dims[1];
   vec_components_ = (int)dims[2];
+  if (rank_ != 3 || vec_components_ != 3) {
+    throw ios_base::failure("H5MD: positions have to be stored as 3d vectors");
+  }
   max_idx_frame_ = dims[0] - 1;
 
   // TODO: reads mass, charge and particle type.
@@ -241,6 +246,58 @@ bool H5MDTrajectoryReader::FirstFrame(Topology &top) {  // NOLINT const
   return true;
 }
 
+Index H5MDTrajectoryReader::FramesPerBlock() const {
+  // keep the buffers of one block below this size
+  const Index max_block_bytes = 64 * 1024 * 1024;
+  Index frame_bytes = Index(sizeof(double)) * N_particles_ * vec_components_;
+  if (has_velocity_ != H5MDTrajectoryReader::NONE) {
+    frame_bytes *= 2;
+  }
+  if (has_force_ != H5MDTrajectoryReader::NONE) {
+    frame_bytes += Index(sizeof(double)) * N_particles_ * vec_components_;
+  }
+  Index frames = 1;
+  hid_t plist = H5Dget_create_plist(ds_atom_position_);
+  if (plist >= 0) {
+    if (H5Pget_layout(plist) == H5D_CHUNKED) {
+      hsize_t chunk[3] = {1, 1, 1};
+      if (H5Pget_chunk(plist, 3, chunk) > 0) {
+        frames = Index(chunk[0]);
+      }
+    }
+    H5Pclose(plist);
+  }
+  frames = std::min(frames, std::max(max_block_bytes / frame_bytes, Index(1)));
+  return std::max(frames, Index(1));
+}
+
+void H5MDTrajectoryReader::FillBuffer(Index frame) {
+  // start blocks at multiples of the block size, so reads match the chunks
+  Index block = FramesPerBlock();
+  buffer_first_ = (frame / block) * block;
+  buffer_frames_ = std::min(block, max_idx_frame_ + 1 - buffer_first_);
+  Index values = N_particles_ * vec_components_;
+
+  ReadRows(ds_atom_position_, H5T_NATIVE_DOUBLE, buffer_first_, buffer_frames_,
+           values, positions_);
+  if (has_velocity_ != H5MDTrajectoryReader::NONE) {
+    ReadRows(ds_atom_velocity_, H5T_NATIVE_DOUBLE, buffer_first_,
+             buffer_frames_, values, velocities_);
+  }
+  if (has_force_ != H5MDTrajectoryReader::NONE) {
+    ReadRows(ds_atom_force_, H5T_NATIVE_DOUBLE, buffer_first_, buffer_frames_,
+             values, forces_);
+  }
+  if (has_id_group_ != H5MDTrajectoryReader::NONE) {
+    ReadRows(ds_atom_id_, H5T_NATIVE_INT, buffer_first_, buffer_frames_,
+             N_particles_, ids_);
+  }
+  if (has_box_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
+    ReadRows(ds_edges_group_, H5T_NATIVE_DOUBLE, buffer_first_, buffer_frames_,
+             3, boxes_);
+  }
+}
+
 /// Reading the data.
 bool H5MDTrajectoryReader::NextFrame(Topology &top) {  // NOLINT const reference
   // Reads the position row.
@@ -251,56 +308,48 @@ bool H5MDTrajectoryReader::NextFrame(Topology &top) {  // NOLINT const reference
 
   cout << '\r' << "Reading frame: " << idx_frame_ << "\n";
   cout.flush();
+
+  if (idx_frame_ < buffer_first_ ||
+      idx_frame_ >= buffer_first_ + buffer_frames_) {
+    try {
+      FillBuffer(idx_frame_);
+    } catch (const std::runtime_error &e) {
+      return false;
+    }
+  }
+  Index row = idx_frame_ - buffer_first_;
+
   // Set volume of box because top on workers somehow does not have this
   // information.
   if (has_box_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-    std::unique_ptr<double[]> box = std::unique_ptr<double[]>{new double[3]};
-    ReadBox(ds_edges_group_, H5T_NATIVE_DOUBLE, idx_frame_, box);
+    const double *box = boxes_.data() + 3 * row;
     m = Eigen::Matrix3d::Zero();
-    m(0, 0) = box.get()[0] * length_scaling_;
-    m(1, 1) = box.get()[1] * length_scaling_;
-    m(2, 2) = box.get()[2] * length_scaling_;
+    m(0, 0) = box[0] * length_scaling_;
+    m(1, 1) = box[1] * length_scaling_;
+    m(2, 2) = box[2] * length_scaling_;
     cout << "Time dependent box:" << endl;
     cout << m << endl;
   }
   top.setBox(m);
 
-  double *positions;
-  double *forces = nullptr;
-  double *velocities = nullptr;
-  int *ids = nullptr;
-
-  try {
-    positions = ReadVectorData<double>(ds_atom_position_, H5T_NATIVE_DOUBLE,
-                                       idx_frame_);
-  } catch (const std::runtime_error &e) {
-    return false;
-  }
-
-  if (has_velocity_ != H5MDTrajectoryReader::NONE) {
-    velocities = ReadVectorData<double>(ds_atom_velocity_, H5T_NATIVE_DOUBLE,
-                                        idx_frame_);
-  }
-
-  if (has_force_ != H5MDTrajectoryReader::NONE) {
-    forces =
-        ReadVectorData<double>(ds_atom_force_, H5T_NATIVE_DOUBLE, idx_frame_);
-  }
-
-  if (has_id_group_ != H5MDTrajectoryReader::NONE) {
-    ids = ReadScalarData<int>(ds_atom_id_, H5T_NATIVE_INT, idx_frame_);
-  }
+  Index values = N_particles_ * vec_components_;
+  const double *positions = positions_.data() + row * values;
+  const double *velocities = (has_velocity_ != H5MDTrajectoryReader::NONE)
+                                 ? velocities_.data() + row * values
+                                 : nullptr;
+  const double *forces = (has_force_ != H5MDTrajectoryReader::NONE)
+                             ? forces_.data() + row * values
+                             : nullptr;
+  const int *ids = (has_id_group_ != H5MDTrajectoryReader::NONE)
+                       ? ids_.data() + row * N_particles_
+                       : nullptr;
 
   // Process atoms.
   for (Index at_idx = 0; at_idx < N_particles_; at_idx++) {
-    double x, y, z;
     Index array_index = at_idx * vec_components_;
-    x = positions[array_index] * length_scaling_;
-    y = positions[array_index + 1] * length_scaling_;
-    z = positions[array_index + 2] * length_scaling_;
     // Set atom id, or it is an index of a row in dataset or from id dataset.
     Index atom_id = at_idx;
-    if (has_id_group_ != H5MDTrajectoryReader::NONE) {
+    if (ids != nullptr) {
       if (ids[at_idx] == -1) {  // ignore values where id == -1
         continue;
       }
@@ -315,56 +364,38 @@ bool H5MDTrajectoryReader::NextFrame(Topology &top) {  // NOLINT const reference
                                boost::lexical_cast<std::string>(atom_id));
     }
 
-    b->setPos(Eigen::Vector3d(x, y, z));
-    if (has_velocity_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-      double vx, vy, vz;
-      vx = velocities[array_index] * velocity_scaling_;
-      vy = velocities[array_index + 1] * velocity_scaling_;
-      vz = velocities[array_index + 2] * velocity_scaling_;
-      b->setVel(Eigen::Vector3d(vx, vy, vz));
+    b->setPos(length_scaling_ *
+              Eigen::Map<const Eigen::Vector3d>(positions + array_index));
+    if (velocities != nullptr) {
+      b->setVel(velocity_scaling_ *
+                Eigen::Map<const Eigen::Vector3d>(velocities + array_index));
     }
-
-    if (has_force_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-      double fx, fy, fz;
-      fx = forces[array_index] * force_scaling_;
-      fy = forces[array_index + 1] * force_scaling_;
-      fz = forces[array_index + 2] * force_scaling_;
-      b->setF(Eigen::Vector3d(fx, fy, fz));
+    if (forces != nullptr) {
+      b->setF(force_scaling_ *
+              Eigen::Map<const Eigen::Vector3d>(forces + array_index));
     }
   }
 
-  // Clean up pointers.
-  delete[] positions;
-  if (has_force_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-    delete[] forces;
-  }
-  if (has_velocity_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-    delete[] velocities;
+  return true;
+}
+
+bool H5MDTrajectoryReader::SeekFrame(Index frame) {
+  if (first_frame_) {
+    throw std::runtime_error("H5MD: SeekFrame called before FirstFrame");
   }
-  if (has_id_group_ == H5MDTrajectoryReader::TIMEDEPENDENT) {
-    delete[] ids;
+  if (frame < 0 || frame > max_idx_frame_) {
+    return false;
   }
-
+  // NextFrame advances to the next row before reading
+  idx_frame_ = frame - 1;
   return true;
 }
 
-void H5MDTrajectoryReader::ReadBox(hid_t ds, hid_t ds_data_type, Index row,
-                                   std::unique_ptr<double[]> &data_out) {
-  hsize_t offset[2];
-  offset[0] = row;
-  offset[1] = 0;
-  hsize_t ch_rows[2];
-  ch_rows[0] = 1;
-  ch_rows[1] = 3;
-  hid_t dsp = H5Dget_space(ds);
-  H5Sselect_hyperslab(dsp, H5S_SELECT_SET, offset, nullptr, ch_rows, nullptr);
-  hid_t mspace1 = H5Screate_simple(2, ch_rows, nullptr);
-  herr_t status =
-      H5Dread(ds, ds_data_type, mspace1, dsp, H5P_DEFAULT, data_out.get());
-  if (status < 0) {
-    throw std::runtime_error("Error ReadScalarData: " +
-                             boost::lexical_cast<std::string>(status));
+Index H5MDTrajectoryReader::FrameCount() {
+  if (first_frame_) {
+    return -1;
   }
+  return max_idx_frame_ + 1;
 }
 
 double H5MDTrajectoryReader::ReadScaleFactor(const hid_t &ds,
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Third party includes
 #include <hdf5.h>
@@ -39,7 +40,9 @@ namespace csg {
 /**
     \brief class for reading H5MD trajectory.
 
-    This class implements the H5MD trajectory reading function. The format of
+    This class implements the H5MD trajectory reading function. Frames are
+   read in blocks with one hyperslab selection per dataset, the block size
+   follows the chunking of the position dataset. The format of
    the H5MD file is defined in Pierre de Buyl, Peter H. Colberg, Felix Höfling,
    H5MD: A structured, efficient, and portable file format for molecular data,
    http://dx.doi.org/10.1016/j.cpc.2014.01.018 The current reference is
@@ -65,58 +68,47 @@ class H5MDTrajectoryReader : public TrajectoryReader {
   /// Closes original trajectory file.
   void Close() override;
 
+  /// Frames are rows of the datasets, so any frame can be read directly.
+  bool CanSeekFrame() const override { return true; }
+  bool SeekFrame(Index frame) override;
+  Index FrameCount() override;
+
  private:
   enum DatasetState { NONE, STATIC, TIMEDEPENDENT };
 
-  /// Reads dataset that contains vectors.
+  /// \brief Reads the rows [first, first+nrows) of a time dependent dataset
+  /// with one hyperslab selection, values_per_row values are read per row.
   template <typename T1>
-  T1 *ReadVectorData(hid_t ds, hid_t ds_data_type, Index row) {
-    hsize_t offset[3];
-    offset[0] = hsize_t(row);
-    offset[1] = 0;
-    offset[2] = 0;
-    hsize_t chunk_rows[3];
-    chunk_rows[0] = 1;
-    chunk_rows[1] = N_particles_;
-    chunk_rows[2] = vec_components_;
+  void ReadRows(hid_t ds, hid_t ds_data_type, Index first, Index nrows,
+                Index values_per_row, std::vector<T1> &data_out) {
     hid_t dsp = H5Dget_space(ds);
-    H5Sselect_hyperslab(dsp, H5S_SELECT_SET, offset, nullptr, chunk_rows,
-                        nullptr);
-    hid_t mspace1 = H5Screate_simple(vec_components_, chunk_rows, nullptr);
-    T1 *data_out = new T1[N_particles_ * vec_components_];
-    herr_t status =
-        H5Dread(ds, ds_data_type, mspace1, dsp, H5P_DEFAULT, data_out);
-    if (status < 0) {
-      throw std::runtime_error("Error ReadVectorData: " +
-                               boost::lexical_cast<std::string>(status));
-    } else {
-      return data_out;
+    CheckError(dsp, "Unable to get the dataspace of a dataset.");
+    int rank = H5Sget_simple_extent_ndims(dsp);
+    hsize_t offset[3] = {hsize_t(first), 0, 0};
+    hsize_t count[3] = {hsize_t(nrows), hsize_t(N_particles_),
+                        hsize_t(vec_components_)};
+    if (rank == 2) {
+      count[1] = hsize_t(values_per_row);
     }
-  }
-
-  /// Reads dataset with scalar values.
-  template <typename T1>
-  T1 *ReadScalarData(hid_t ds, hid_t ds_data_type, Index row) {
-    hsize_t offset[2];
-    offset[0] = row;
-    offset[1] = 0;
-    hsize_t ch_rows[2];
-    ch_rows[0] = 1;
-    ch_rows[1] = N_particles_;
-    hid_t dsp = H5Dget_space(ds);
-    H5Sselect_hyperslab(dsp, H5S_SELECT_SET, offset, nullptr, ch_rows, nullptr);
-    hid_t mspace1 = H5Screate_simple(2, ch_rows, nullptr);
-    T1 *data_out = new T1[N_particles_];
+    H5Sselect_hyperslab(dsp, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    hid_t mspace = H5Screate_simple(rank, count, nullptr);
+    data_out.resize(nrows * values_per_row);
     herr_t status =
-        H5Dread(ds, ds_data_type, mspace1, dsp, H5P_DEFAULT, data_out);
+        H5Dread(ds, ds_data_type, mspace, dsp, H5P_DEFAULT, data_out.data());
+    H5Sclose(mspace);
+    H5Sclose(dsp);
     if (status < 0) {
-      throw std::runtime_error("Error ReadScalarData: " +
+      throw std::runtime_error("Error ReadRows: " +
                                boost::lexical_cast<std::string>(status));
-    } else {
-      return data_out;
     }
   }
 
+  /// Reads the block of frames which contains frame into the buffers.
+  void FillBuffer(Index frame);
+
+  /// Number of frames read at once, aligned with the dataset chunks.
+  Index FramesPerBlock() const;
+
   template <typename T1>
   void ReadStaticData(hid_t ds, hid_t ds_data_type,
                       std::unique_ptr<T1> &outbuf) {
@@ -127,9 +119,6 @@ class H5MDTrajectoryReader : public TrajectoryReader {
     }
   }
 
-  void ReadBox(hid_t ds, hid_t ds_data_type, Index row,
-               std::unique_ptr<double[]> &data_out);
-
   double ReadScaleFactor(const hid_t &ds, const std::string &unit_type);
 
   void CheckError(hid_t hid, std::string error_message) {
@@ -202,6 +191,15 @@ class H5MDTrajectoryReader : public TrajectoryReader {
 
   // Box matrix.
   Eigen::Matrix3d m;
+
+  // Frames [buffer_first_, buffer_first_ + buffer_frames_) are buffered.
+  Index buffer_first_ = 0;
+  Index buffer_frames_ = 0;
+  std::vector<double> positions_;
+  std::vector<double> velocities_;
+  std::vector<double> forces_;
+  std::vector<double> boxes_;
+  std::vector<int> ids_;
 };
 
 }  // namespace csg
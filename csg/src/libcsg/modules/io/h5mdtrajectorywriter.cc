@@ -0,0 +1,340 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+// VOTCA includes
+#include <votca/tools/version.h>
+
+// Local private VOTCA includes
+#include "h5mdtrajectorywriter.h"
+
+namespace votca {
+namespace csg {
+
+H5MDTrajectoryWriter::~H5MDTrajectoryWriter() {
+  if (file_id_ >= 0) {
+    try {
+      Close();
+    } catch (std::exception &) {
+      // destructors must not throw
+    }
+  }
+}
+
+void H5MDTrajectoryWriter::Open(std::string file, bool bAppend) {
+  if (bAppend) {
+    throw std::runtime_error(
+        "H5MD writer: appending to an existing file is not supported");
+  }
+  file_id_ = H5Fcreate(file.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(file_id_, "Unable to create file " + file);
+
+  hid_t g_h5md =
+      H5Gcreate(file_id_, "h5md", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(g_h5md, "Unable to create /h5md group.");
+  int version[2] = {1, 1};
+  hsize_t version_dims[1] = {2};
+  hid_t version_space = H5Screate_simple(1, version_dims, nullptr);
+  hid_t at_version = H5Acreate(g_h5md, "version", H5T_NATIVE_INT,
+                               version_space, H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(at_version, "Unable to create version attribute.");
+  H5Awrite(at_version, H5T_NATIVE_INT, version);
+  H5Aclose(at_version);
+  H5Sclose(version_space);
+
+  hid_t g_author =
+      H5Gcreate(g_h5md, "author", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  const char *user = std::getenv("USER");
+  WriteStringAttribute(g_author, "name", {user ? user : "unknown"});
+  H5Gclose(g_author);
+  hid_t g_creator =
+      H5Gcreate(g_h5md, "creator", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  WriteStringAttribute(g_creator, "name", {"VOTCA"});
+  WriteStringAttribute(g_creator, "version", {tools::ToolsVersionStr()});
+  H5Gclose(g_creator);
+  H5Gclose(g_h5md);
+
+  initialized_ = false;
+  written_frames_ = 0;
+  buffered_frames_ = 0;
+}
+
+void H5MDTrajectoryWriter::Close() {
+  if (file_id_ < 0) {
+    return;
+  }
+  Flush();
+  CloseElement(position_);
+  CloseElement(velocity_);
+  CloseElement(force_);
+  CloseElement(edges_);
+  if (box_group_ >= 0) {
+    H5Gclose(box_group_);
+    box_group_ = -1;
+  }
+  if (particle_group_ >= 0) {
+    H5Gclose(particle_group_);
+    particle_group_ = -1;
+  }
+  H5Fclose(file_id_);
+  file_id_ = -1;
+}
+
+void H5MDTrajectoryWriter::CloseElement(Element &element) {
+  for (hid_t *ds : {&element.value, &element.step, &element.time}) {
+    if (*ds >= 0) {
+      H5Dclose(*ds);
+      *ds = -1;
+    }
+  }
+  if (element.group >= 0) {
+    H5Gclose(element.group);
+    element.group = -1;
+  }
+}
+
+void H5MDTrajectoryWriter::WriteStringAttribute(
+    hid_t loc, const std::string &name,
+    const std::vector<std::string> &values) {
+  std::size_t length = 1;
+  for (const auto &v : values) {
+    length = std::max(length, v.size());
+  }
+  // fixed length strings, stored without separators
+  std::string data(length * values.size(), '\0');
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    data.replace(i * length, values[i].size(), values[i]);
+  }
+  hid_t type = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type, length);
+  H5Tset_strpad(type, H5T_STR_NULLPAD);
+  hid_t space;
+  if (values.size() == 1) {
+    space = H5Screate(H5S_SCALAR);
+  } else {
+    hsize_t dims[1] = {values.size()};
+    space = H5Screate_simple(1, dims, nullptr);
+  }
+  hid_t attr = H5Acreate(loc, name.c_str(), type, space, H5P_DEFAULT,
+                         H5P_DEFAULT);
+  CheckError(attr, "Unable to create attribute " + name);
+  H5Awrite(attr, type, data.data());
+  H5Aclose(attr);
+  H5Sclose(space);
+  H5Tclose(type);
+}
+
+hid_t H5MDTrajectoryWriter::CreateDataset(
+    hid_t parent, const std::string &name, hid_t type,
+    const std::vector<hsize_t> &frame_dims) {
+  std::vector<hsize_t> dims = {0};
+  std::vector<hsize_t> maxdims = {H5S_UNLIMITED};
+  std::vector<hsize_t> chunk = {hsize_t(chunk_frames_)};
+  for (hsize_t d : frame_dims) {
+    dims.push_back(d);
+    maxdims.push_back(d);
+    chunk.push_back(d);
+  }
+  int rank = int(dims.size());
+  hid_t space = H5Screate_simple(rank, dims.data(), maxdims.data());
+  hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(dcpl, rank, chunk.data());
+  if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+    H5Pset_shuffle(dcpl);
+    H5Pset_deflate(dcpl, 4);
+  }
+  hid_t ds = H5Dcreate(parent, name.c_str(), type, space, H5P_DEFAULT, dcpl,
+                       H5P_DEFAULT);
+  CheckError(ds, "Unable to create dataset " + name);
+  H5Pclose(dcpl);
+  H5Sclose(space);
+  return ds;
+}
+
+H5MDTrajectoryWriter::Element H5MDTrajectoryWriter::CreateElement(
+    hid_t parent, const std::string &name,
+    const std::vector<hsize_t> &frame_dims, const Element *shared_time) {
+  Element element;
+  element.group =
+      H5Gcreate(parent, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(element.group, "Unable to create group " + name);
+  element.value = CreateDataset(element.group, "value", H5T_NATIVE_DOUBLE,
+                                frame_dims);
+  if (shared_time == nullptr) {
+    element.step = CreateDataset(element.group, "step", H5T_NATIVE_INT64, {});
+    element.time = CreateDataset(element.group, "time", H5T_NATIVE_DOUBLE, {});
+  } else {
+    // all elements are sampled at the same frames, H5MD allows to share
+    // step and time via hard links
+    H5Lcreate_hard(shared_time->group, "step", element.group, "step",
+                   H5P_DEFAULT, H5P_DEFAULT);
+    H5Lcreate_hard(shared_time->group, "time", element.group, "time",
+                   H5P_DEFAULT, H5P_DEFAULT);
+  }
+  return element;
+}
+
+void H5MDTrajectoryWriter::Initialize(Topology &conf) {
+  n_particles_ = conf.BeadCount();
+  has_velocity_ = conf.HasVel();
+  has_force_ = conf.HasForce();
+  // aim for chunks of about 1 MB
+  const Index chunk_bytes = 1024 * 1024;
+  Index frame_bytes =
+      std::max(Index(sizeof(double)) * 3 * n_particles_, Index(1));
+  chunk_frames_ = std::clamp(chunk_bytes / frame_bytes, Index(1), Index(128));
+
+  std::string group_name = conf.getParticleGroup();
+  if (group_name == "unassigned") {
+    group_name = "atoms";
+  }
+  hid_t particles =
+      H5Gcreate(file_id_, "particles", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(particles, "Unable to create /particles group.");
+  particle_group_ = H5Gcreate(particles, group_name.c_str(), H5P_DEFAULT,
+                              H5P_DEFAULT, H5P_DEFAULT);
+  CheckError(particle_group_, "Unable to create particle group " + group_name);
+  H5Gclose(particles);
+
+  hsize_t n = hsize_t(n_particles_);
+  position_ = CreateElement(particle_group_, "position", {n, 3}, nullptr);
+  if (has_velocity_) {
+    velocity_ = CreateElement(particle_group_, "velocity", {n, 3}, &position_);
+  }
+  if (has_force_) {
+    force_ = CreateElement(particle_group_, "force", {n, 3}, &position_);
+  }
+
+  box_group_ = H5Gcreate(particle_group_, "box", H5P_DEFAULT, H5P_DEFAULT,
+                         H5P_DEFAULT);
+  CheckError(box_group_, "Unable to create box group.");
+  int dimension = 3;
+  hid_t scalar = H5Screate(H5S_SCALAR);
+  hid_t at_dimension = H5Acreate(box_group_, "dimension", H5T_NATIVE_INT,
+                                 scalar, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(at_dimension, H5T_NATIVE_INT, &dimension);
+  H5Aclose(at_dimension);
+  H5Sclose(scalar);
+  std::string boundary =
+      (conf.getBoxType() == BoundaryCondition::typeOpen) ? "none" : "periodic";
+  WriteStringAttribute(box_group_, "boundary", {boundary, boundary, boundary});
+  edges_ = CreateElement(box_group_, "edges", {3}, &position_);
+
+  initialized_ = true;
+}
+
+void H5MDTrajectoryWriter::AppendRows(hid_t ds, hid_t type,
+                                      const std::vector<hsize_t> &frame_dims,
+                                      const void *data) {
+  std::vector<hsize_t> offset = {hsize_t(written_frames_)};
+  std::vector<hsize_t> count = {hsize_t(buffered_frames_)};
+  for (hsize_t d : frame_dims) {
+    offset.push_back(0);
+    count.push_back(d);
+  }
+  std::vector<hsize_t> extent = count;
+  extent[0] = hsize_t(written_frames_ + buffered_frames_);
+  if (H5Dset_extent(ds, extent.data()) < 0) {
+    throw std::runtime_error("H5MD writer: Unable to extend dataset");
+  }
+  int rank = int(count.size());
+  hid_t fspace = H5Dget_space(ds);
+  H5Sselect_hyperslab(fspace, H5S_SELECT_SET, offset.data(), nullptr,
+                      count.data(), nullptr);
+  hid_t mspace = H5Screate_simple(rank, count.data(), nullptr);
+  herr_t status = H5Dwrite(ds, type, mspace, fspace, H5P_DEFAULT, data);
+  H5Sclose(mspace);
+  H5Sclose(fspace);
+  if (status < 0) {
+    throw std::runtime_error("H5MD writer: Unable to write frames");
+  }
+}
+
+void H5MDTrajectoryWriter::Flush() {
+  if (buffered_frames_ == 0) {
+    return;
+  }
+  hsize_t n = hsize_t(n_particles_);
+  AppendRows(position_.value, H5T_NATIVE_DOUBLE, {n, 3}, positions_.data());
+  AppendRows(position_.step, H5T_NATIVE_INT64, {}, steps_.data());
+  AppendRows(position_.time, H5T_NATIVE_DOUBLE, {}, times_.data());
+  if (has_velocity_) {
+    AppendRows(velocity_.value, H5T_NATIVE_DOUBLE, {n, 3},
+               velocities_.data());
+  }
+  if (has_force_) {
+    AppendRows(force_.value, H5T_NATIVE_DOUBLE, {n, 3}, forces_.data());
+  }
+  AppendRows(edges_.value, H5T_NATIVE_DOUBLE, {3}, edges_buffer_.data());
+
+  written_frames_ += buffered_frames_;
+  buffered_frames_ = 0;
+  positions_.clear();
+  velocities_.clear();
+  forces_.clear();
+  edges_buffer_.clear();
+  steps_.clear();
+  times_.clear();
+}
+
+void H5MDTrajectoryWriter::Write(Topology *conf) {
+  if (file_id_ < 0) {
+    throw std::runtime_error("H5MD writer: no file opened");
+  }
+  if (!initialized_) {
+    Initialize(*conf);
+  }
+  if (conf->BeadCount() != n_particles_) {
+    throw std::runtime_error(
+        "H5MD writer: number of beads changed between frames");
+  }
+  Eigen::Matrix3d box = conf->getBox();
+  if (!box.isDiagonal()) {
+    throw std::runtime_error(
+        "H5MD writer: only rectangular boxes are supported");
+  }
+
+  for (const Bead &bead : conf->Beads()) {
+    const Eigen::Vector3d &pos = bead.getPos();
+    positions_.insert(positions_.end(), pos.data(), pos.data() + 3);
+    if (has_velocity_) {
+      const Eigen::Vector3d &vel = bead.getVel();
+      velocities_.insert(velocities_.end(), vel.data(), vel.data() + 3);
+    }
+    if (has_force_) {
+      const Eigen::Vector3d &f = bead.getF();
+      forces_.insert(forces_.end(), f.data(), f.data() + 3);
+    }
+  }
+  for (Index i = 0; i < 3; ++i) {
+    edges_buffer_.push_back(box(i, i));
+  }
+  steps_.push_back(std::int64_t(conf->getStep()));
+  times_.push_back(conf->getTime());
+  buffered_frames_++;
+
+  if (buffered_frames_ == chunk_frames_) {
+    Flush();
+  }
+}
+
+}  // namespace csg
+}  // namespace votca
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_H5MDTRAJECTORYWRITER_PRIVATE_H
+#define VOTCA_CSG_H5MDTRAJECTORYWRITER_PRIVATE_H
+
+// Standard includes
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third party includes
+#include <hdf5.h>
+
+// Local VOTCA includes
+#include "votca/csg/topology.h"
+#include "votca/csg/trajectorywriter.h"
+
+namespace votca {
+namespace csg {
+
+/**
+    \brief class for writing H5MD trajectories
+
+    Writes positions, and velocities and forces if the topology has them,
+   together with a time dependent box into /particles/<group>, where group is
+   the particle group of the topology ("atoms" if unassigned). The datasets
+   are chunked along the frames and deflate compressed if the filter is
+   available. Frames are collected in memory and written one chunk at a time,
+   which is also the block size the H5MDTrajectoryReader uses for reading.
+   Only rectangular boxes are supported, as in the reader.
+*/
+class H5MDTrajectoryWriter : public TrajectoryWriter {
+ public:
+  H5MDTrajectoryWriter() = default;
+  ~H5MDTrajectoryWriter() override;
+
+  void Open(std::string file, bool bAppend = false) override;
+  void Close() override;
+
+  void Write(Topology *conf) override;
+
+ private:
+  /// a time dependent H5MD element with value, step and time datasets
+  struct Element {
+    hid_t group = -1;
+    hid_t value = -1;
+    hid_t step = -1;
+    hid_t time = -1;
+  };
+
+  void Initialize(Topology &conf);
+  Element CreateElement(hid_t parent, const std::string &name,
+                        const std::vector<hsize_t> &frame_dims,
+                        const Element *shared_time);
+  hid_t CreateDataset(hid_t parent, const std::string &name, hid_t type,
+                      const std::vector<hsize_t> &frame_dims);
+  void AppendRows(hid_t ds, hid_t type, const std::vector<hsize_t> &frame_dims,
+                  const void *data);
+  void WriteStringAttribute(hid_t loc, const std::string &name,
+                            const std::vector<std::string> &values);
+  void CloseElement(Element &element);
+  /// writes all buffered frames to the file
+  void Flush();
+
+  void CheckError(hid_t hid, const std::string &error_message) const {
+    if (hid < 0) {
+      throw std::runtime_error("H5MD writer: " + error_message);
+    }
+  }
+
+  hid_t file_id_ = -1;
+  hid_t particle_group_ = -1;
+  hid_t box_group_ = -1;
+  Element position_;
+  Element velocity_;
+  Element force_;
+  Element edges_;
+
+  bool initialized_ = false;
+  bool has_velocity_ = false;
+  bool has_force_ = false;
+  Index n_particles_ = 0;
+  Index chunk_frames_ = 1;
+  Index written_frames_ = 0;
+  Index buffered_frames_ = 0;
+
+  std::vector<double> positions_;
+  std::vector<double> velocities_;
+  std::vector<double> forces_;
+  std::vector<double> edges_buffer_;
+  std::vector<std::int64_t> steps_;
+  std::vector<double> times_;
+};
+
+}  // namespace csg
+}  // namespace votca
+
+#endif  // VOTCA_CSG_H5MDTRAJECTORYWRITER_PRIVATE_H
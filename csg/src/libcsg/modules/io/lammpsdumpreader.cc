@@ -16,27 +16,61 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 // Third party includes
 #include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 
 // VOTCA includes
 #include <votca/tools/constants.h>
 #include <votca/tools/getline.h>
+#include <votca/tools/numberparser.h>
 
 // Local private VOTCA includes
 #include "lammpsdumpreader.h"
 
 namespace votca {
 namespace csg {
-using namespace boost;
 using namespace std;
 
+namespace {
+
+std::string_view Trim(std::string_view s) {
+  size_t start = s.find_first_not_of(" \t\r");
+  if (start == std::string_view::npos) {
+    return std::string_view();
+  }
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(start, end - start + 1);
+}
+
+bool StartsWith(std::string_view s, std::string_view prefix) {
+  return s.substr(0, prefix.size()) == prefix;
+}
+
+// columns of the atoms section we know about
+enum class Column {
+  other,
+  type,
+  x,
+  y,
+  z,
+  xs,
+  ys,
+  zs,
+  vx,
+  vy,
+  vz,
+  fx,
+  fy,
+  fz
+};
+
+}  // namespace
+
 bool LAMMPSDumpReader::ReadTopology(string file, Topology &top) {
-  topology_ = true;
   top.Cleanup();
 
   fl_.open(file);
@@ -44,8 +78,14 @@ bool LAMMPSDumpReader::ReadTopology(string file, Topology &top) {
     throw std::ios_base::failure("Error on open topology file: " + file);
   }
   fname_ = file;
+  index_.Clear();
+  frame_ = 0;
 
-  NextFrame(top);
+  if (ReadFrameLines(buffer_)) {
+    ParseFrame(buffer_, top, true);
+  }
+  cout << "WARNING: topology created from .dump file, masses, charges, "
+          "types, residue names are wrong!\n";
 
   fl_.close();
 
@@ -58,93 +98,209 @@ bool LAMMPSDumpReader::Open(const string &file) {
     throw std::ios_base::failure("Error on open trajectory file: " + file);
   }
   fname_ = file;
+  frame_ = 0;
+  index_from_sidecar_ = index_.Load(file);
   return true;
 }
 
 void LAMMPSDumpReader::Close() { fl_.close(); }
 
 bool LAMMPSDumpReader::FirstFrame(Topology &top) {
-  topology_ = false;
   NextFrame(top);
   return true;
 }
 
 bool LAMMPSDumpReader::NextFrame(Topology &top) {
+  if (!ReadFrameData(buffer_)) {
+    return false;
+  }
+  DecodeFrameData(buffer_, top);
+  return true;
+}
+
+bool LAMMPSDumpReader::ReadFrameData(string &buffer) {
+  if (index_.KnowsFrameSize(frame_)) {
+    // frame boundaries are known, read the whole frame at once
+    fl_.clear();
+    fl_.seekg(index_.FrameStart(frame_));
+    buffer.resize(size_t(index_.FrameSize(frame_)));
+    if (!fl_.read(buffer.data(), std::streamsize(buffer.size()))) {
+      throw std::ios_base::failure("Error reading frame " +
+                                   std::to_string(frame_) +
+                                   " from lammps file '" + fname_ + "'");
+    }
+  } else if (!ReadFrameLines(buffer)) {
+    EndOfTrajectory();
+    return false;
+  }
+  ++frame_;
+  return true;
+}
+
+void LAMMPSDumpReader::EndOfTrajectory() {
+  if (index_.isComplete()) {
+    return;
+  }
+  fl_.clear();
+  fl_.seekg(0, std::ios::end);
+  std::int64_t end = std::int64_t(fl_.tellg());
+  index_.setComplete(end);
+  if (!index_from_sidecar_ && end >= FrameIndex::MinSizeForSidecar) {
+    index_.Save(fname_);
+  }
+}
+
+void LAMMPSDumpReader::CompleteIndex() {
+  if (index_.isComplete()) {
+    return;
+  }
+  // scan the rest of the file, starting at the last known frame
+  Index current = frame_;
+  frame_ = std::max(index_.KnownFrames() - 1, Index(0));
+  fl_.clear();
+  fl_.seekg(index_.KnownFrames() > 0 ? index_.FrameStart(frame_) : 0);
+  string scratch;
+  while (ReadFrameLines(scratch)) {
+    ++frame_;
+  }
+  EndOfTrajectory();
+  frame_ = current;
+}
+
+bool LAMMPSDumpReader::SeekFrame(Index frame) {
+  if (frame >= index_.KnownFrames()) {
+    CompleteIndex();
+  }
+  if (frame < 0 || frame >= index_.KnownFrames()) {
+    return false;
+  }
+  // ReadFrameData jumps to the start of the frame
+  frame_ = frame;
+  return true;
+}
+
+Index LAMMPSDumpReader::FrameCount() {
+  CompleteIndex();
+  return index_.KnownFrames();
+}
+
+bool LAMMPSDumpReader::ReadFrameLines(string &buffer) {
+  buffer.clear();
   string line;
-  tools::getline(fl_, line);
-  boost::algorithm::trim(line);
-  while (!fl_.eof()) {
-    if (line.substr(0, 5) != "ITEM:") {
-      throw std::ios_base::failure("unexpected line in lammps file:\n" + line);
+  std::int64_t start;
+  // skip empty lines between frames
+  do {
+    start = std::int64_t(fl_.tellg());
+    if (!tools::getline(fl_, line)) {
+      return false;
     }
-    if (line.substr(6, 8) == "TIMESTEP") {
-      ReadTimestep(top);
-    } else if (line.substr(6, 15) == "NUMBER OF ATOMS") {
-      ReadNumAtoms(top);
-    } else if (line.substr(6, 10) == "BOX BOUNDS") {
-      ReadBox(top);
-    } else if (line.substr(6, 5) == "ATOMS") {
-      ReadAtoms(top, line);
+    boost::algorithm::trim(line);
+  } while (line.empty());
+  index_.AddFrame(frame_, start);
+
+  Index natoms = -1;
+  while (true) {
+    buffer.append(line).push_back('\n');
+    if (StartsWith(line, "ITEM: ATOMS")) {
       break;
     }
-
-    else {
-      throw std::ios_base::failure("unknown item lammps file : " +
-                                   line.substr(6));
+    bool natoms_next = StartsWith(line, "ITEM: NUMBER OF ATOMS");
+    if (!tools::getline(fl_, line)) {
+      throw std::runtime_error("Error: unexpected end of lammps file '" +
+                               fname_ + "' in header of frame " +
+                               std::to_string(frame_));
     }
-    tools::getline(fl_, line);
     boost::algorithm::trim(line);
+    if (natoms_next) {
+      natoms = tools::ParseNumber<Index>(line);
+    }
+  }
+  if (natoms < 0) {
+    throw std::runtime_error("Error: number of atoms missing in lammps file '" +
+                             fname_ + "'");
   }
-  if (topology_) {
-    cout << "WARNING: topology created from .dump file, masses, charges, "
-            "types, residue names are wrong!\n";
+  for (Index i = 0; i < natoms; ++i) {
+    if (!tools::getline(fl_, line)) {
+      throw std::runtime_error("Error: unexpected end of lammps file '" +
+                               fname_ + "' only " + std::to_string(i) +
+                               " atoms of " + std::to_string(natoms) +
+                               " read.");
+    }
+    buffer.append(line).push_back('\n');
   }
-  return !fl_.eof();
-  ;
+  return true;
 }
 
-void LAMMPSDumpReader::ReadTimestep(Topology &top) {
-  string s;
-  tools::getline(fl_, s);
-  boost::algorithm::trim(s);
-  top.setStep(boost::lexical_cast<Index>(s));
-  cout << "Reading frame, timestep " << top.getStep() << endl;
+void LAMMPSDumpReader::DecodeFrameData(const string &buffer,
+                                       Topology &top) const {
+  ParseFrame(buffer, top, false);
 }
 
-void LAMMPSDumpReader::ReadBox(Topology &top) {
-  string s;
+void LAMMPSDumpReader::ParseFrame(std::string_view data, Topology &top,
+                                  bool topology) const {
+  Index natoms = -1;
+  while (!data.empty()) {
+    std::string_view line = Trim(tools::NextLine(data));
+    if (line.empty()) {
+      continue;
+    }
+    if (!StartsWith(line, "ITEM:")) {
+      throw std::ios_base::failure("unexpected line in lammps file:\n" +
+                                   string(line));
+    }
+    std::string_view item = line.substr(6);
+    if (StartsWith(item, "TIMESTEP")) {
+      top.setStep(tools::ParseNumber<Index>(Trim(tools::NextLine(data))));
+      cout << "Reading frame, timestep " + std::to_string(top.getStep()) +
+                  "\n";
+    } else if (StartsWith(item, "NUMBER OF ATOMS")) {
+      natoms = tools::ParseNumber<Index>(Trim(tools::NextLine(data)));
+      if (!topology && natoms != top.BeadCount()) {
+        throw std::runtime_error(
+            "number of beads in topology and trajectory differ");
+      }
+    } else if (StartsWith(item, "BOX BOUNDS")) {
+      ReadBox(data, top);
+    } else if (StartsWith(item, "ATOMS")) {
+      ReadAtoms(data, top, line, natoms, topology);
+      return;
+    } else {
+      throw std::ios_base::failure("unknown item lammps file : " +
+                                   string(item));
+    }
+  }
+  throw std::runtime_error("Error: no atoms section found in lammps file '" +
+                           fname_ + "'");
+}
 
+void LAMMPSDumpReader::ReadBox(std::string_view &data, Topology &top) const {
   Eigen::Matrix3d m = Eigen::Matrix3d::Zero();
 
   for (Index i = 0; i < 3; ++i) {
-    tools::getline(fl_, s);
-    boost::algorithm::trim(s);
-    vector<double> v = tools::Tokenizer(s, " ").ToVector<double>();
-    if (v.size() != 2) {
+    std::string_view line = tools::NextLine(data);
+    double lo = tools::ParseNextNumber<double>(line);
+    double hi = tools::ParseNextNumber<double>(line);
+    if (!tools::NextWord(line).empty()) {
       throw std::ios_base::failure("invalid box format");
     }
-    m(i, i) = v[1] - v[0];
+    m(i, i) = hi - lo;
   }
   top.setBox(m * tools::conv::ang2nm);
 }
 
-void LAMMPSDumpReader::ReadNumAtoms(Topology &top) {
-  string s;
-  tools::getline(fl_, s);
-  boost::algorithm::trim(s);
-  natoms_ = boost::lexical_cast<Index>(s);
-  if (!topology_ && natoms_ != top.BeadCount()) {
-    std::runtime_error("number of beads in topology and trajectory differ");
+void LAMMPSDumpReader::ReadAtoms(std::string_view &data, Topology &top,
+                                 std::string_view itemline, Index natoms,
+                                 bool topology) const {
+  if (natoms < 0) {
+    throw std::runtime_error("Error: number of atoms missing in lammps file '" +
+                             fname_ + "'");
   }
-}
-
-void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
-  if (topology_) {
+  if (topology) {
     top.CreateResidue("dum");
     if (!top.BeadTypeExist("no")) {
       top.RegisterBeadType("no");
     }
-    for (Index i = 0; i < natoms_; ++i) {
+    for (Index i = 0; i < natoms; ++i) {
       (void)top.CreateBead(Bead::spherical, "no", "no", 0, 0, 0);
     }
   }
@@ -154,26 +310,50 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
   bool vel = false;
   Index id = -1;
 
-  vector<string> fields;
-
+  // translate the column names once instead of comparing strings per atom
+  vector<Column> columns;
   {
-    tools::Tokenizer tok(itemline.substr(12), " ");
-    fields = tok.ToVector();
-    Index j = 0;
-    for (tools::Tokenizer::iterator i = tok.begin(); i != tok.end(); ++i, ++j) {
-      if (*i == "x" || *i == "y" || *i == "z") {
-        pos = true;
-      } else if (*i == "xu" || *i == "yu" || *i == "zu") {
-        pos = true;
-      } else if (*i == "xs" || *i == "ys" || *i == "zs") {
+    std::string_view header = itemline.substr(12);
+    for (std::string_view name = tools::NextWord(header); !name.empty();
+         name = tools::NextWord(header)) {
+      Column c = Column::other;
+      if (name == "x" || name == "xu") {
+        c = Column::x;
+      } else if (name == "y" || name == "yu") {
+        c = Column::y;
+      } else if (name == "z" || name == "zu") {
+        c = Column::z;
+      } else if (name == "xs") {
+        c = Column::xs;
+      } else if (name == "ys") {
+        c = Column::ys;
+      } else if (name == "zs") {
+        c = Column::zs;
+      } else if (name == "vx") {
+        c = Column::vx;
+      } else if (name == "vy") {
+        c = Column::vy;
+      } else if (name == "vz") {
+        c = Column::vz;
+      } else if (name == "fx") {
+        c = Column::fx;
+      } else if (name == "fy") {
+        c = Column::fy;
+      } else if (name == "fz") {
+        c = Column::fz;
+      } else if (name == "type") {
+        c = Column::type;
+      } else if (name == "id") {
+        id = Index(columns.size());
+      }
+      if (c >= Column::x && c <= Column::zs) {
         pos = true;
-      } else if (*i == "vx" || *i == "vy" || *i == "vz") {
+      } else if (c >= Column::vx && c <= Column::vz) {
         vel = true;
-      } else if (*i == "fx" || *i == "fy" || *i == "fz") {
+      } else if (c >= Column::fx && c <= Column::fz) {
         force = true;
-      } else if (*i == "id") {
-        id = j;
       }
+      columns.push_back(c);
     }
   }
   if (id < 0) {
@@ -181,73 +361,95 @@ void LAMMPSDumpReader::ReadAtoms(Topology &top, string itemline) {
         "error, id not found in any column of the atoms section");
   }
 
-  for (Index i = 0; i < natoms_; ++i) {
-    string s;
-    tools::getline(fl_, s);
-    boost::algorithm::trim(s);
-    if (fl_.eof()) {
+  const Eigen::Matrix3d m = top.getBox();
+  const double force_conv = tools::conv::kcal2kj / tools::conv::ang2nm;
+  vector<std::string_view> words(columns.size());
+
+  for (Index i = 0; i < natoms; ++i) {
+    if (data.empty()) {
       throw std::runtime_error("Error: unexpected end of lammps file '" +
-                               fname_ + "' only " +
-                               boost::lexical_cast<string>(i) + " atoms of " +
-                               boost::lexical_cast<string>(natoms_) + " read.");
+                               fname_ + "' only " + std::to_string(i) +
+                               " atoms of " + std::to_string(natoms) +
+                               " read.");
     }
-
-    tools::Tokenizer tok(s, " ");
-    tools::Tokenizer::iterator itok = tok.begin();
-    vector<string> fields2 = tok.ToVector();
-    // internal numbering begins with 0
-    Index atom_id = boost::lexical_cast<Index>(fields2[id]);
-    if (atom_id > natoms_) {
+    std::string_view line = tools::NextLine(data);
+    for (auto &word : words) {
+      word = tools::NextWord(line);
+    }
+    if (!tools::NextWord(line).empty()) {
       throw std::runtime_error(
-          "Error: found atom with id " + boost::lexical_cast<string>(atom_id) +
-          " but only " + boost::lexical_cast<string>(natoms_) +
-          " atoms defined in header of file '" + fname_ + "'");
+          "error, wrong number of columns in atoms section");
+    }
+    // internal numbering begins with 0
+    Index atom_id = tools::ParseNumber<Index>(words[id]);
+    if (atom_id > natoms || atom_id < 1) {
+      throw std::runtime_error("Error: found atom with id " +
+                               std::to_string(atom_id) + " but only " +
+                               std::to_string(natoms) +
+                               " atoms defined in header of file '" + fname_ +
+                               "'");
     }
     Bead *b = top.getBead(atom_id - 1);
     b->HasPos(pos);
     b->HasF(force);
     b->HasVel(vel);
-    Eigen::Matrix3d m = top.getBox();
 
-    for (size_t j = 0; itok != tok.end(); ++itok, ++j) {
-      if (j == fields.size()) {
-        throw std::runtime_error(
-            "error, wrong number of columns in atoms section");
-      } else if (fields[j] == "x") {
-        b->Pos().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "y") {
-        b->Pos().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "z") {
-        b->Pos().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "xu") {
-        b->Pos().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "yu") {
-        b->Pos().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "zu") {
-        b->Pos().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "xs") {
-        b->Pos().x() = stod(*itok) * m(0, 0);  // box is already in nm
-      } else if (fields[j] == "ys") {
-        b->Pos().y() = stod(*itok) * m(1, 1);  // box is already in nm
-      } else if (fields[j] == "zs") {
-        b->Pos().z() = stod(*itok) * m(2, 2);  // box is already in nm
-      } else if (fields[j] == "vx") {
-        b->Vel().x() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "vy") {
-        b->Vel().y() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "vz") {
-        b->Vel().z() = stod(*itok) * tools::conv::ang2nm;
-      } else if (fields[j] == "fx") {
-        b->F().x() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if (fields[j] == "fy") {
-        b->F().y() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if (fields[j] == "fz") {
-        b->F().z() = stod(*itok) * tools::conv::kcal2kj / tools::conv::ang2nm;
-      } else if ((fields[j] == "type") && topology_) {
-        if (!top.BeadTypeExist(*itok)) {
-          top.RegisterBeadType(*itok);
-        }
-        b->setType(*itok);
+    for (size_t j = 0; j < columns.size(); ++j) {
+      switch (columns[j]) {
+        case Column::other:
+          break;
+        case Column::x:
+          b->Pos().x() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        case Column::y:
+          b->Pos().y() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        case Column::z:
+          b->Pos().z() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        // box is already in nm
+        case Column::xs:
+          b->Pos().x() = tools::ParseNumber<double>(words[j]) * m(0, 0);
+          break;
+        case Column::ys:
+          b->Pos().y() = tools::ParseNumber<double>(words[j]) * m(1, 1);
+          break;
+        case Column::zs:
+          b->Pos().z() = tools::ParseNumber<double>(words[j]) * m(2, 2);
+          break;
+        case Column::vx:
+          b->Vel().x() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        case Column::vy:
+          b->Vel().y() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        case Column::vz:
+          b->Vel().z() =
+              tools::ParseNumber<double>(words[j]) * tools::conv::ang2nm;
+          break;
+        case Column::fx:
+          b->F().x() = tools::ParseNumber<double>(words[j]) * force_conv;
+          break;
+        case Column::fy:
+          b->F().y() = tools::ParseNumber<double>(words[j]) * force_conv;
+          break;
+        case Column::fz:
+          b->F().z() = tools::ParseNumber<double>(words[j]) * force_conv;
+          break;
+        case Column::type:
+          if (topology) {
+            string type(words[j]);
+            if (!top.BeadTypeExist(type)) {
+              top.RegisterBeadType(type);
+            }
+            b->setType(type);
+          }
+          break;
       }
     }
   }
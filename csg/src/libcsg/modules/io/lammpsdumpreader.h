@@ -18,11 +18,13 @@
 #ifndef VOTCA_CSG_LAMMPSDUMPREADER_H
 #define VOTCA_CSG_LAMMPSDUMPREADER_H
 
+#include "../../../../include/votca/csg/frameindex.h"
 #include "../../../../include/votca/csg/topologyreader.h"
 #include "../../../../include/votca/csg/trajectoryreader.h"
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <votca/tools/unitconverter.h>
 
 namespace votca {
@@ -32,7 +34,10 @@ namespace csg {
     \brief class for reading lammps dump files
 
     This class provides the TrajectoryReader + Topology reader interface
-    for lammps dump files
+    for lammps dump files. Reading the text of a frame and parsing it are
+    separate steps, so frames can be parsed by several threads. The frame
+    offsets are kept in a FrameIndex, which is stored next to large dump
+    files once they were read completely.
 
 */
 class LAMMPSDumpReader : public TrajectoryReader, public TopologyReader {
@@ -62,18 +67,33 @@ class LAMMPSDumpReader : public TrajectoryReader, public TopologyReader {
   /// read in the next frame
   bool NextFrame(Topology &top) override;
 
+  bool CanSeekFrame() const override { return true; }
+  bool SeekFrame(Index frame) override;
+  Index FrameCount() override;
+
+  bool CanDecodeFrameData() const override { return true; }
+  bool ReadFrameData(std::string &buffer) override;
+  void DecodeFrameData(const std::string &buffer,
+                       Topology &top) const override;
+
   void Close() override;
 
  private:
-  void ReadTimestep(Topology &top);
-  void ReadBox(Topology &top);
-  void ReadNumAtoms(Topology &top);
-  void ReadAtoms(Topology &top, std::string itemline);
+  bool ReadFrameLines(std::string &buffer);
+  void CompleteIndex();
+  void EndOfTrajectory();
+  void ParseFrame(std::string_view data, Topology &top, bool topology) const;
+  void ReadBox(std::string_view &data, Topology &top) const;
+  void ReadAtoms(std::string_view &data, Topology &top,
+                 std::string_view itemline, Index natoms, bool topology) const;
 
   std::ifstream fl_;
   std::string fname_;
-  bool topology_;
-  Index natoms_;
+  std::string buffer_;
+  FrameIndex index_;
+  bool index_from_sidecar_ = false;
+  // next frame to be read
+  Index frame_ = 0;
 };
 
 }  // namespace csg
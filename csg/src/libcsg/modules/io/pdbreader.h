@@ -38,7 +38,8 @@ namespace csg {
     brief class for reading pdb files
 
     This class provides the Trajectory and Topology reader interface
-    for pdb files
+    for pdb files. Frames cannot be located directly, --first-frame and
+    --stride read over the frames they skip.
 
 */
 class PDBReader : public TopologyReader, public TrajectoryReader {
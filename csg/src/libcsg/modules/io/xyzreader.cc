@@ -56,6 +56,8 @@ bool XYZReader::Open(const string &file) {
     throw std::ios_base::failure("Error on open trajectory file: " + file);
   }
   line_ = 0;
+  frame_ = 0;
+  index_from_sidecar_ = index_.Load(file);
   return true;
 }
 
@@ -64,9 +66,92 @@ void XYZReader::Close() { fl_.close(); }
 bool XYZReader::FirstFrame(Topology &top) { return NextFrame(top); }
 
 bool XYZReader::NextFrame(Topology &top) {
+  std::int64_t start = std::int64_t(fl_.tellg());
   bool success = ReadFrame<false, Topology>(top);
+  if (success) {
+    index_.AddFrame(frame_, start);
+    ++frame_;
+  } else {
+    EndOfTrajectory();
+  }
   return success;
 }
 
+bool XYZReader::SkipFrame() {
+  std::int64_t start = std::int64_t(fl_.tellg());
+  string line;
+  if (!tools::getline(fl_, line) || fl_.eof()) {
+    EndOfTrajectory();
+    return false;
+  }
+  Index natoms = std::stol(line);
+  // the title line and the atoms
+  for (Index i = 0; i <= natoms; ++i) {
+    if (!tools::getline(fl_, line) || fl_.eof()) {
+      throw std::runtime_error("unexpected end of file in xyz file");
+    }
+  }
+  index_.AddFrame(frame_, start);
+  ++frame_;
+  return true;
+}
+
+void XYZReader::EndOfTrajectory() {
+  if (index_.isComplete()) {
+    return;
+  }
+  fl_.clear();
+  fl_.seekg(0, std::ios::end);
+  std::int64_t end = std::int64_t(fl_.tellg());
+  index_.setComplete(end);
+  if (!index_from_sidecar_ && end >= FrameIndex::MinSizeForSidecar) {
+    index_.Save(file_);
+  }
+}
+
+void XYZReader::PositionAt(Index frame) {
+  fl_.clear();
+  if (frame < index_.KnownFrames()) {
+    fl_.seekg(index_.FrameStart(frame));
+  } else {
+    fl_.seekg(0, std::ios::end);
+  }
+  frame_ = frame;
+}
+
+void XYZReader::CompleteIndex() {
+  if (index_.isComplete()) {
+    return;
+  }
+  // scan the rest of the file, starting at the last known frame
+  Index current = frame_;
+  if (index_.KnownFrames() > 0) {
+    PositionAt(index_.KnownFrames() - 1);
+  } else {
+    fl_.clear();
+    fl_.seekg(0);
+    frame_ = 0;
+  }
+  while (SkipFrame()) {
+  }
+  PositionAt(current);
+}
+
+bool XYZReader::SeekFrame(Index frame) {
+  if (frame >= index_.KnownFrames()) {
+    CompleteIndex();
+  }
+  if (frame < 0 || frame >= index_.KnownFrames()) {
+    return false;
+  }
+  PositionAt(frame);
+  return true;
+}
+
+Index XYZReader::FrameCount() {
+  CompleteIndex();
+  return index_.KnownFrames();
+}
+
 }  // namespace csg
 }  // namespace votca
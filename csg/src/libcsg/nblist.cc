@@ -18,6 +18,9 @@
 // Standard library includes
 #include <iostream>
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/csg/nblist.h"
 #include "votca/csg/topology.h"
@@ -35,6 +38,7 @@ NBList::~NBList() {
 }
 
 void NBList::Generate(BeadList &list1, BeadList &list2, bool do_exclusions) {
+  tools::ScopedTimer timer("NBList::Generate");
   BeadList::iterator iter1;
   BeadList::iterator iter2;
   do_exclusions_ = do_exclusions;
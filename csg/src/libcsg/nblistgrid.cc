@@ -15,6 +15,9 @@
  *
  */
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/csg/nblistgrid.h"
 #include "votca/csg/topology.h"
@@ -27,6 +30,7 @@ using namespace std;
 
 void NBListGrid::Generate(BeadList &list1, BeadList &list2,
                           bool do_exclusions) {
+  tools::ScopedTimer timer("NBListGrid::Generate");
 
   do_exclusions_ = do_exclusions;
   if (list1.empty()) {
@@ -53,6 +57,7 @@ void NBListGrid::Generate(BeadList &list1, BeadList &list2,
 }
 
 void NBListGrid::Generate(BeadList &list, bool do_exclusions) {
+  tools::ScopedTimer timer("NBListGrid::Generate");
   do_exclusions_ = do_exclusions;
   if (list.empty()) {
     return;
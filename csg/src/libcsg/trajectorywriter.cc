@@ -15,6 +15,8 @@
  *
  */
 
+#include <votca_csg_config.h>
+
 // Local VOTCA includes
 #include "votca/csg/trajectorywriter.h"
 #include "votca/csg/pdbwriter.h"
@@ -26,6 +28,9 @@
 #include "modules/io/gmxtrajectorywriter.h"
 #endif
 #include "modules/io/growriter.h"
+#ifdef H5MD
+#include "modules/io/h5mdtrajectorywriter.h"
+#endif
 #include "modules/io/lammpsdumpwriter.h"
 
 namespace votca {
@@ -44,6 +49,9 @@ void TrajectoryWriter::RegisterPlugins() {
   TrjWriterFactory().Register<GMXTrajectoryWriter>("xtc");
 #endif
   TrjWriterFactory().Register<GROWriter>("gro");
+#ifdef H5MD
+  TrjWriterFactory().Register<H5MDTrajectoryWriter>("h5");
+#endif
 }
 }  // namespace csg
 }  // namespace votca
@@ -218,4 +218,46 @@ BOOST_AUTO_TEST_CASE(test_beadstructure_breakIntoStructures) {
   BOOST_CHECK_EQUAL(structure2_count, 2);
 }
 
+BOOST_AUTO_TEST_CASE(test_beadstructure_groupEquivalentStructures) {
+
+  // Three waters H - O - H with different ids and one H - H - O which has the
+  // same beads but a different topology
+  vector<BeadStructure> structures;
+  votca::Index id = 0;
+  for (votca::Index i = 0; i < 4; ++i) {
+    TestBead hydrogen1;
+    hydrogen1.setName("Hydrogen");
+    hydrogen1.setId(++id);
+    TestBead oxygen;
+    oxygen.setName("Oxygen");
+    oxygen.setId(++id);
+    TestBead hydrogen2;
+    hydrogen2.setName("Hydrogen");
+    hydrogen2.setId(++id);
+
+    BeadStructure water;
+    water.AddBead(hydrogen1);
+    water.AddBead(oxygen);
+    water.AddBead(hydrogen2);
+    if (i == 2) {
+      water.ConnectBeads(hydrogen1.getId(), hydrogen2.getId());
+      water.ConnectBeads(hydrogen2.getId(), oxygen.getId());
+    } else {
+      water.ConnectBeads(hydrogen1.getId(), oxygen.getId());
+      water.ConnectBeads(hydrogen2.getId(), oxygen.getId());
+    }
+    structures.push_back(water);
+  }
+
+  BOOST_CHECK_EQUAL(structures[0].getStructureHash(),
+                    structures[3].getStructureHash());
+  BOOST_CHECK(structures[0].getStructureHash() !=
+              structures[2].getStructureHash());
+
+  vector<vector<votca::Index>> groups = groupEquivalentStructures(structures);
+  BOOST_REQUIRE_EQUAL(groups.size(), 2);
+  BOOST_CHECK(groups[0] == vector<votca::Index>({0, 1, 3}));
+  BOOST_CHECK(groups[1] == vector<votca::Index>({2}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
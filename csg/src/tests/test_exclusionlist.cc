@@ -0,0 +1,85 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE exclusionlist_test
+
+// Standard includes
+#include <sstream>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/topology.h"
+
+using namespace std;
+using namespace votca::csg;
+
+BOOST_AUTO_TEST_SUITE(exclusionlist_test)
+
+/**
+ * A chain of five beads with bonds and angles in one molecule and a single
+ * bead in a second molecule. Bonds and angles exclude neighbours up to the
+ * second next one.
+ **/
+BOOST_AUTO_TEST_CASE(chain_test) {
+  Topology top;
+  string bead_type_name = "type1";
+  top.RegisterBeadType(bead_type_name);
+  Molecule *chain = top.CreateMolecule("chain");
+  Molecule *single = top.CreateMolecule("single");
+  for (votca::Index i = 0; i < 6; i++) {
+    Bead *bead = top.CreateBead(Bead::spherical, "bead" + to_string(i),
+                                bead_type_name, 1, 1.0, 0.0);
+    bead->setId(i);
+    if (i < 5) {
+      chain->AddBead(bead, bead->getName());
+    } else {
+      single->AddBead(bead, bead->getName());
+    }
+  }
+  for (votca::Index i = 0; i < 4; i++) {
+    top.AddBondedInteraction(new IBond(i, i + 1));
+  }
+  for (votca::Index i = 0; i < 3; i++) {
+    top.AddBondedInteraction(new IAngle(i, i + 1, i + 2));
+  }
+  top.RebuildExclusions();
+
+  ExclusionList &excl = top.getExclusions();
+  for (votca::Index i = 0; i < 6; i++) {
+    for (votca::Index j = 0; j < 6; j++) {
+      bool excluded = i != j && i < 5 && j < 5 && std::abs(i - j) <= 2;
+      BOOST_CHECK_EQUAL(excl.IsExcluded(top.getBead(i), top.getBead(j)),
+                        excluded);
+    }
+  }
+
+  excl.RemoveExclusion(top.getBead(2), top.getBead(0));
+  BOOST_CHECK(!excl.IsExcluded(top.getBead(0), top.getBead(2)));
+  excl.RemoveExclusion(top.getBead(1), top.getBead(0));
+  BOOST_CHECK(excl.GetExclusions(top.getBead(0)) == nullptr);
+  excl.InsertExclusion(top.getBead(4), top.getBead(0));
+  BOOST_CHECK(excl.IsExcluded(top.getBead(0), top.getBead(4)));
+
+  stringstream out;
+  out << excl;
+  BOOST_CHECK_EQUAL(out.str(), "1 5\n2 3 4\n3 4 5\n4 5\n");
+  top.Cleanup();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
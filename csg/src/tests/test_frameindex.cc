@@ -0,0 +1,91 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE frameindex_test
+
+// Standard includes
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/frameindex.h"
+
+using namespace votca::csg;
+
+BOOST_AUTO_TEST_SUITE(frameindex_test)
+
+BOOST_AUTO_TEST_CASE(offsets_test) {
+  FrameIndex index;
+  BOOST_CHECK_EQUAL(index.KnownFrames(), 0);
+  index.AddFrame(0, 0);
+  index.AddFrame(1, 100);
+  // already known frames are ignored
+  index.AddFrame(1, 100);
+  BOOST_CHECK_THROW(index.AddFrame(3, 300), std::runtime_error);
+  BOOST_CHECK_EQUAL(index.KnownFrames(), 2);
+  BOOST_CHECK(index.KnowsFrameSize(0));
+  BOOST_CHECK(!index.KnowsFrameSize(1));
+  BOOST_CHECK_EQUAL(index.FrameSize(0), 100);
+
+  index.setComplete(250);
+  BOOST_CHECK(index.isComplete());
+  BOOST_CHECK(index.KnowsFrameSize(1));
+  BOOST_CHECK(!index.KnowsFrameSize(2));
+  BOOST_CHECK_EQUAL(index.FrameSize(1), 150);
+}
+
+BOOST_AUTO_TEST_CASE(sidecar_test) {
+  std::string trjfile = "test_frameindex.trj";
+  {
+    std::ofstream out(trjfile);
+    out << std::string(30, 'a');
+  }
+  std::remove(FrameIndex::SidecarName(trjfile).c_str());
+
+  FrameIndex index;
+  BOOST_CHECK(!index.Load(trjfile));
+  index.AddFrame(0, 0);
+  index.AddFrame(1, 10);
+  index.AddFrame(2, 20);
+  // incomplete indices are not stored
+  BOOST_CHECK(!index.Save(trjfile));
+  index.setComplete(30);
+  BOOST_CHECK(index.Save(trjfile));
+
+  FrameIndex loaded;
+  BOOST_CHECK(loaded.Load(trjfile));
+  BOOST_CHECK(loaded.isComplete());
+  BOOST_CHECK_EQUAL(loaded.KnownFrames(), 3);
+  BOOST_CHECK_EQUAL(loaded.FrameStart(2), 20);
+  BOOST_CHECK_EQUAL(loaded.FrameSize(2), 10);
+
+  // a modified trajectory invalidates the index
+  {
+    std::ofstream out(trjfile, std::ios::app);
+    out << "more";
+  }
+  BOOST_CHECK(!loaded.Load(trjfile));
+  BOOST_CHECK_EQUAL(loaded.KnownFrames(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
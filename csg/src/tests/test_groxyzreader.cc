@@ -0,0 +1,138 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE groxyzreader_test
+
+// Standard includes
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/csg/bead.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/topologyreader.h"
+#include "votca/csg/trajectoryreader.h"
+
+using namespace std;
+using namespace votca::csg;
+
+BOOST_AUTO_TEST_SUITE(groxyzreader_test)
+
+namespace {
+
+// two beads, the x coordinate of the first bead is the frame number in nm
+void WriteGro(const string &filename, votca::Index nframes) {
+  ofstream out(filename);
+  for (votca::Index frame = 0; frame < nframes; frame++) {
+    out << "frame " << frame << "\n    2\n";
+    out << "    1SOL     OW    1" << setw(8) << fixed << setprecision(3)
+        << double(frame) << "   0.000   0.000\n";
+    out << "    1SOL    HW1    2   0.100   0.000   0.000\n";
+    out << "   5.00000   5.00000   5.00000\n";
+  }
+}
+
+// two atoms, the x coordinate of the first atom is the frame number in
+// Angstrom
+void WriteXYZ(const string &filename, votca::Index nframes) {
+  ofstream out(filename);
+  for (votca::Index frame = 0; frame < nframes; frame++) {
+    out << "2\nframe " << frame << "\n";
+    out << "O " << double(frame) << " 0.0 0.0\n";
+    out << "H 1.0 0.0 0.0\n";
+  }
+}
+
+void CheckSeekFrame(const string &filename, double nm_per_frame) {
+  TopologyReader::RegisterPlugins();
+  TrajectoryReader::RegisterPlugins();
+  Topology top;
+  std::unique_ptr<TopologyReader> topreader =
+      TopReaderFactory().Create(filename);
+  topreader->ReadTopology(filename, top);
+  BOOST_REQUIRE_EQUAL(top.BeadCount(), 2);
+
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader->CanSeekFrame());
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK_SMALL(top.getBead(0)->getPos().x(), 1e-10);
+  BOOST_CHECK_EQUAL(reader->FrameCount(), 5);
+
+  // counting the frames does not change the position of the reader
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_CLOSE(top.getBead(0)->getPos().x(), nm_per_frame, 1e-8);
+
+  BOOST_CHECK(reader->SeekFrame(4));
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_CLOSE(top.getBead(0)->getPos().x(), 4 * nm_per_frame, 1e-8);
+  BOOST_CHECK(!reader->NextFrame(top));
+
+  BOOST_CHECK(reader->SeekFrame(2));
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_CLOSE(top.getBead(0)->getPos().x(), 2 * nm_per_frame, 1e-8);
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_CLOSE(top.getBead(0)->getPos().x(), 3 * nm_per_frame, 1e-8);
+
+  BOOST_CHECK(!reader->SeekFrame(5));
+  reader->Close();
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(test_gro_seekframe) {
+  string filename = "test_seekframe.gro";
+  WriteGro(filename, 5);
+  CheckSeekFrame(filename, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_xyz_seekframe) {
+  string filename = "test_seekframe.xyz";
+  WriteXYZ(filename, 5);
+  CheckSeekFrame(filename, 0.1);
+}
+
+/**
+ * \brief Seeking before all frames were read scans the rest of the file
+ */
+BOOST_AUTO_TEST_CASE(test_xyz_seek_ahead) {
+  string filename = "test_seekahead.xyz";
+  WriteXYZ(filename, 5);
+  TopologyReader::RegisterPlugins();
+  TrajectoryReader::RegisterPlugins();
+  Topology top;
+  TopReaderFactory().Create(filename)->ReadTopology(filename, top);
+
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK(reader->SeekFrame(3));
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_CLOSE(top.getBead(0)->getPos().x(), 0.3, 1e-8);
+  reader->Close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
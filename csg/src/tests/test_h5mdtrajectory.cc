@@ -0,0 +1,126 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE h5mdtrajectory_test
+
+// Standard includes
+#include <memory>
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// VOTCA includes
+#include <votca/tools/types.h>
+
+// Local VOTCA includes
+#include "votca/csg/bead.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/trajectoryreader.h"
+#include "votca/csg/trajectorywriter.h"
+
+using namespace std;
+using namespace votca::csg;
+
+namespace {
+
+void MakeTopology(Topology &top, votca::Index nbeads) {
+  top.setBox(3.0 * Eigen::Matrix3d::Identity());
+  top.setParticleGroup("atoms");
+  top.RegisterBeadType("A");
+  for (votca::Index i = 0; i < nbeads; ++i) {
+    top.CreateBead(Bead::spherical, "A", "A", 1, 1.0, 0.0);
+  }
+}
+
+Eigen::Vector3d Position(votca::Index step, votca::Index bead) {
+  return Eigen::Vector3d(0.1 * double(step), 0.01 * double(bead), 0.5);
+}
+
+Eigen::Vector3d Force(votca::Index step, votca::Index bead) {
+  return Eigen::Vector3d(double(bead), -double(step), 1.0);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(h5mdtrajectory_test)
+
+/**
+ * \brief Test writing a trajectory and reading it back frame by frame
+ *
+ * More frames than fit into a single chunk are written, so that the writer
+ * has to extend its datasets and the reader has to fetch several blocks.
+ */
+BOOST_AUTO_TEST_CASE(test_roundtrip) {
+  TrajectoryWriter::RegisterPlugins();
+  TrajectoryReader::RegisterPlugins();
+  if (!TrjWriterFactory().IsRegistered("h5")) {
+    BOOST_TEST_MESSAGE("votca was built without H5MD support");
+    return;
+  }
+
+  const votca::Index nbeads = 5;
+  const votca::Index nframes = 300;
+  string filename = "test_roundtrip.h5";
+  {
+    Topology top;
+    MakeTopology(top, nbeads);
+    top.SetHasForce(true);
+    std::unique_ptr<TrajectoryWriter> writer =
+        TrjWriterFactory().Create(filename);
+    writer->Open(filename);
+    for (votca::Index step = 0; step < nframes; ++step) {
+      top.setStep(step);
+      top.setTime(0.5 * double(step));
+      top.setBox((3.0 + 0.01 * double(step)) * Eigen::Matrix3d::Identity());
+      for (votca::Index i = 0; i < nbeads; ++i) {
+        top.getBead(i)->setPos(Position(step, i));
+        top.getBead(i)->setF(Force(step, i));
+      }
+      writer->Write(&top);
+    }
+    writer->Close();
+  }
+
+  Topology top;
+  MakeTopology(top, nbeads);
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  reader->Open(filename);
+  BOOST_REQUIRE(reader->FirstFrame(top));
+  BOOST_CHECK_EQUAL(reader->FrameCount(), nframes);
+  votca::Index step = 0;
+  do {
+    BOOST_CHECK_CLOSE(top.getBox()(0, 0), 3.0 + 0.01 * double(step), 1e-8);
+    for (votca::Index i = 0; i < nbeads; ++i) {
+      BOOST_CHECK(top.getBead(i)->getPos().isApprox(Position(step, i)));
+      BOOST_CHECK(top.getBead(i)->getF().isApprox(Force(step, i)));
+    }
+    step++;
+  } while (reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(step, nframes);
+
+  // jumping back into an already read block
+  BOOST_REQUIRE(reader->SeekFrame(7));
+  BOOST_REQUIRE(reader->NextFrame(top));
+  BOOST_CHECK(top.getBead(2)->getPos().isApprox(Position(7, 2)));
+  reader->Close();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -328,4 +328,112 @@ BOOST_AUTO_TEST_CASE(test_trajectorywriter) {
   }
 }
 
+namespace {
+
+void MakeSmallTopology(Topology &top) {
+  top.setBox(2.0 * Eigen::Matrix3d::Identity());
+  top.RegisterBeadType("A");
+  for (votca::Index i = 0; i < 3; ++i) {
+    top.CreateBead(Bead::spherical, "A", "A", 1, 1.0, 0.0);
+  }
+}
+
+// writes nframes frames of a small system, the x coordinate of all beads is
+// 0.1 * step
+void WriteSmallTrajectory(const string &filename, votca::Index nframes) {
+  Topology top;
+  MakeSmallTopology(top);
+  TrajectoryWriter::RegisterPlugins();
+  std::unique_ptr<TrajectoryWriter> writer =
+      TrjWriterFactory().Create(filename);
+  writer->Open(filename);
+  for (votca::Index step = 0; step < nframes; ++step) {
+    top.setStep(step);
+    for (votca::Index i = 0; i < 3; ++i) {
+      top.getBead(i)->setPos(
+          Eigen::Vector3d(0.1 * double(step), 0.01 * double(i), 0.5));
+    }
+    writer->Write(&top);
+  }
+  writer->Close();
+}
+
+}  // namespace
+
+/**
+ * \brief Test reading raw frame data and decoding it separately
+ *
+ * Several frames are written, their raw data is fetched in order and then
+ * decoded in reverse order into separate topologies, like worker threads
+ * of a CsgApplication would do.
+ */
+BOOST_AUTO_TEST_CASE(test_framedata) {
+  string filename = "test_framedata.dump";
+  WriteSmallTrajectory(filename, 4);
+
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader->CanDecodeFrameData());
+  reader->Open(filename);
+  std::vector<std::string> frames;
+  std::string data;
+  while (reader->ReadFrameData(data)) {
+    frames.push_back(data);
+  }
+  reader->Close();
+  BOOST_REQUIRE_EQUAL(frames.size(), 4);
+
+  for (votca::Index step = 3; step >= 0; --step) {
+    Topology frame;
+    MakeSmallTopology(frame);
+    reader->DecodeFrameData(frames[step], frame);
+    BOOST_CHECK_EQUAL(frame.getStep(), step);
+    for (votca::Index i = 0; i < 3; ++i) {
+      BOOST_CHECK_CLOSE(frame.getBead(i)->Pos().x() + 1.0,
+                        0.1 * double(step) + 1.0, 1e-4);
+      BOOST_CHECK_CLOSE(frame.getBead(i)->Pos().y() + 1.0,
+                        0.01 * double(i) + 1.0, 1e-4);
+    }
+  }
+}
+
+/**
+ * \brief Test counting frames and jumping between them
+ */
+BOOST_AUTO_TEST_CASE(test_seekframe) {
+  string filename = "test_seekframe.dump";
+  WriteSmallTrajectory(filename, 5);
+
+  TrajectoryReader::RegisterPlugins();
+  std::unique_ptr<TrajectoryReader> reader =
+      TrjReaderFactory().Create(filename);
+  BOOST_REQUIRE(reader->CanSeekFrame());
+  Topology top;
+  MakeSmallTopology(top);
+  reader->Open(filename);
+  reader->FirstFrame(top);
+  BOOST_CHECK_EQUAL(top.getStep(), 0);
+  BOOST_CHECK_EQUAL(reader->FrameCount(), 5);
+
+  // counting the frames does not change the position of the reader
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(top.getStep(), 1);
+
+  BOOST_CHECK(reader->SeekFrame(4));
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(top.getStep(), 4);
+  BOOST_CHECK_CLOSE(top.getBead(0)->Pos().x(), 0.4, 1e-4);
+  BOOST_CHECK(!reader->NextFrame(top));
+
+  BOOST_CHECK(reader->SeekFrame(2));
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(top.getStep(), 2);
+  BOOST_CHECK(reader->NextFrame(top));
+  BOOST_CHECK_EQUAL(top.getStep(), 3);
+
+  BOOST_CHECK(!reader->SeekFrame(5));
+  reader->Close();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
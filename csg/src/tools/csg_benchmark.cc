@@ -0,0 +1,731 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+// VOTCA includes
+#include <votca/tools/histogramnew.h>
+#include <votca/tools/tokenizer.h>
+
+// Local VOTCA includes
+#include "votca/csg/beadlist.h"
+#include "votca/csg/exclusionlist.h"
+#include "votca/csg/nblist.h"
+#include "votca/csg/nblistgrid.h"
+#include "votca/csg/nblistgrid_3body.h"
+
+// Local private VOTCA includes
+#include "csg_benchmark.h"
+#include "csg_fmatch.h"
+#include "csg_stat_imc.h"
+
+using votca::Index;
+using Replica = CsgBenchmark::Replica;
+using Frame = CsgBenchmark::Frame;
+
+int main(int argc, char **argv) {
+  CsgBenchmark app;
+  return app.Exec(argc, argv);
+}
+
+namespace {
+
+const std::vector<std::string> all_kernels = {
+    "nblist",        "nblistgrid", "nblistgrid_3body", "topologymap",
+    "exclusionlist", "histogram",  "imc",              "fmatch"};
+
+/// bond length of the polymer and spread of the atoms around their bead
+const double bond_length = 0.35;
+const double atom_spread = 0.03;
+
+/// Work done for a single frame, Evaluate is called from the thread that
+/// owns the replica and returns the number of processed items
+class BenchmarkKernel {
+ public:
+  virtual ~BenchmarkKernel() = default;
+  virtual std::string Name() const = 0;
+  /// unit of the throughput besides frames, e.g. pairs
+  virtual std::string Items() const = 0;
+  /// kernels which are not thread safe only run on one thread
+  virtual bool Threaded() const { return true; }
+  /// kernels that start from the atomistic frame do the mapping themselves
+  virtual bool Atomistic() const { return false; }
+  virtual void Begin(Index, Replica &) {}
+  virtual Index Evaluate(Index thread, const Frame &frame,
+                         Replica &replica) = 0;
+};
+
+template <class NBListType>
+class NBListKernel : public BenchmarkKernel {
+ public:
+  NBListKernel(std::string name, std::string items, double cutoff)
+      : name_(std::move(name)), items_(std::move(items)), cutoff_(cutoff) {}
+  std::string Name() const override { return name_; }
+  std::string Items() const override { return items_; }
+  Index Evaluate(Index, const Frame &, Replica &replica) override {
+    BeadList beads;
+    beads.Generate(replica.cg, "*");
+    NBListType nb;
+    nb.setCutoff(cutoff_);
+    nb.Generate(beads, true);
+    return Index(nb.size());
+  }
+
+ private:
+  std::string name_;
+  std::string items_;
+  double cutoff_;
+};
+
+class TopologyMapKernel : public BenchmarkKernel {
+ public:
+  std::string Name() const override { return "topologymap"; }
+  std::string Items() const override { return "beads"; }
+  bool Atomistic() const override { return true; }
+  Index Evaluate(Index, const Frame &, Replica &replica) override {
+    replica.map->Apply();
+    return replica.cg.BeadCount();
+  }
+};
+
+/// builds the exclusions of the frame and checks all pairs within the cutoff
+class ExclusionListKernel : public BenchmarkKernel {
+ public:
+  std::string Name() const override { return "exclusionlist"; }
+  std::string Items() const override { return "pairs"; }
+  Index Evaluate(Index, const Frame &frame, Replica &replica) override {
+    ExclusionList exclusions;
+    exclusions.CreateExclusions(&replica.cg);
+    Index excluded = 0;
+    for (const auto &pair : frame.pairs) {
+      if (exclusions.IsExcluded(replica.cg.getBead(pair.first),
+                                replica.cg.getBead(pair.second))) {
+        excluded++;
+      }
+    }
+    excluded_ += excluded;
+    return Index(frame.pairs.size());
+  }
+
+ private:
+  std::atomic<Index> excluded_{0};
+};
+
+class HistogramKernel : public BenchmarkKernel {
+ public:
+  explicit HistogramKernel(double cutoff) : cutoff_(cutoff) {}
+  std::string Name() const override { return "histogram"; }
+  std::string Items() const override { return "pairs"; }
+  Index Evaluate(Index, const Frame &frame, Replica &) override {
+    votca::tools::HistogramNew hist;
+    hist.Initialize(0.0, cutoff_, Index(cutoff_ / 0.01) + 1);
+    hist.ProcessRange(frame.dist.begin(), frame.dist.end());
+    return Index(frame.dist.size());
+  }
+
+ private:
+  double cutoff_;
+};
+
+/// Imc with the options set in code instead of read from a file
+class BenchmarkImc : public votca::csg::Imc {
+ public:
+  explicit BenchmarkImc(const votca::tools::Property &options) {
+    options_ = options;
+    bonded_ = options_.Select("cg.bonded");
+    nonbonded_ = options_.Select("cg.non-bonded");
+  }
+};
+
+/// frame evaluation of csg_stat --do-imc, each thread has its own worker and
+/// the workers are merged after every frame as in CsgApplication
+class ImcKernel : public BenchmarkKernel {
+ public:
+  explicit ImcKernel(const votca::tools::Property &options)
+      : options_(options) {}
+  std::string Name() const override { return "imc"; }
+  std::string Items() const override { return "pairs"; }
+  bool Atomistic() const override { return true; }
+  void Begin(Index nthreads, Replica &replica) override {
+    workers_.clear();
+    imc_ = std::make_unique<BenchmarkImc>(options_);
+    imc_->DoImc(true);
+    imc_->Initialize();
+    imc_->BeginEvaluate(&replica.cg, &replica.atomistic);
+    for (Index i = 0; i < nthreads; i++) {
+      workers_.push_back(imc_->ForkWorker());
+    }
+  }
+  Index Evaluate(Index thread, const Frame &frame, Replica &replica) override {
+    replica.map->Apply();
+    workers_[thread]->EvalConfiguration(&replica.cg, &replica.atomistic);
+    std::lock_guard<std::mutex> lock(merge_mutex_);
+    imc_->MergeWorker(workers_[thread].get());
+    return Index(frame.pairs.size());
+  }
+
+ private:
+  votca::tools::Property options_;
+  std::unique_ptr<BenchmarkImc> imc_;
+  std::vector<std::unique_ptr<CsgApplication::Worker>> workers_;
+  std::mutex merge_mutex_;
+};
+
+/// CGForceMatching with the options set in code and no reference forces,
+/// the fitted splines are not written
+class BenchmarkForceMatching : public CGForceMatching {
+ public:
+  explicit BenchmarkForceMatching(const votca::tools::Property &options) {
+    options_ = options;
+    bonded_ = options_.Select("cg.bonded");
+    nonbonded_ = options_.Select("cg.non-bonded");
+    has_existing_forces_ = false;
+  }
+
+ protected:
+  void WriteOutFiles() override {}
+};
+
+/// frame evaluation of csg_fmatch, one frame per block so every frame also
+/// solves the least squares problem
+class ForceMatchingKernel : public BenchmarkKernel {
+ public:
+  explicit ForceMatchingKernel(const votca::tools::Property &options)
+      : options_(options) {}
+  std::string Name() const override { return "fmatch"; }
+  std::string Items() const override { return "pairs"; }
+  bool Threaded() const override { return false; }
+  bool Atomistic() const override { return true; }
+  void Begin(Index, Replica &replica) override {
+    fmatch_ = std::make_unique<BenchmarkForceMatching>(options_);
+    fmatch_->BeginEvaluate(&replica.cg, &replica.atomistic);
+  }
+  Index Evaluate(Index, const Frame &frame, Replica &replica) override {
+    replica.map->Apply();
+    fmatch_->EvalConfiguration(&replica.cg, &replica.atomistic);
+    return Index(frame.pairs.size());
+  }
+
+ private:
+  votca::tools::Property options_;
+  std::unique_ptr<BenchmarkForceMatching> fmatch_;
+};
+
+/// Range of a force matching grid with spacing step in which every interval
+/// holds at least min_samples of the values, the longest such run of
+/// intervals is taken. Spline coefficients of an interval without samples
+/// are not determined by the frames and leave the least squares problem
+/// singular.
+std::pair<double, double> SampledRange(const std::vector<double> &values,
+                                       double step, Index min_samples) {
+  std::vector<Index> counts;
+  for (double value : values) {
+    auto bin = std::size_t(value / step);
+    if (bin >= counts.size()) {
+      counts.resize(bin + 1, 0);
+    }
+    counts[bin]++;
+  }
+  Index nbins = Index(counts.size());
+  Index best_start = 0;
+  Index best_length = 0;
+  Index start = 0;
+  for (Index i = 0; i <= nbins; i++) {
+    if (i == nbins || counts[std::size_t(i)] < min_samples) {
+      if (i - start > best_length) {
+        best_start = start;
+        best_length = i - start;
+      }
+      start = i + 1;
+    }
+  }
+  if (best_length < 2) {
+    throw std::runtime_error(
+        "the frames sample too few distances for force matching, increase "
+        "--frames or --beads");
+  }
+  return {double(best_start) * step, double(best_start + best_length) * step};
+}
+
+void LoadFrame(const Frame &frame, Index step, Topology &top) {
+  top.setStep(step);
+  for (Index i = 0; i < top.BeadCount(); i++) {
+    top.getBead(i)->setPos(frame.pos[i]);
+    top.getBead(i)->setF(frame.force[i]);
+  }
+}
+
+/// runs the kernel over all frames for every thread count, frame i is
+/// evaluated by thread i % nthreads
+votca::tools::Property RunKernel(
+    BenchmarkKernel &kernel, const std::vector<Index> &threads,
+    const std::vector<Frame> &atomistic_frames,
+    const std::vector<Frame> &cg_frames,
+    std::vector<std::unique_ptr<Replica>> &replicas) {
+  votca::tools::Property output("kernel", "", "");
+  output.setAttribute("name", kernel.Name());
+  output.setAttribute("items", kernel.Items());
+  std::cout << kernel.Name() << std::endl;
+
+  std::vector<Index> thread_counts = threads;
+  if (!kernel.Threaded()) {
+    thread_counts = {1};
+  }
+  const std::vector<Frame> &frames =
+      kernel.Atomistic() ? atomistic_frames : cg_frames;
+  Index nframes = Index(frames.size());
+  double reference_time = 0.0;
+  Index reference_threads = 0;
+  for (Index nthreads : thread_counts) {
+    kernel.Begin(nthreads, *replicas[0]);
+    std::vector<Index> items(nthreads, 0);
+    std::vector<std::exception_ptr> errors(nthreads, nullptr);
+    std::vector<std::thread> workers;
+    std::chrono::time_point<std::chrono::steady_clock> start =
+        std::chrono::steady_clock::now();
+    for (Index t = 0; t < nthreads; t++) {
+      workers.emplace_back([&, t]() {
+        try {
+          for (Index f = t; f < nframes; f += nthreads) {
+            Replica &replica = *replicas[t];
+            LoadFrame(frames[f], f,
+                      kernel.Atomistic() ? replica.atomistic : replica.cg);
+            items[t] += kernel.Evaluate(t, cg_frames[f], replica);
+          }
+        } catch (...) {
+          errors[t] = std::current_exception();
+        }
+      });
+    }
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    std::chrono::time_point<std::chrono::steady_clock> end =
+        std::chrono::steady_clock::now();
+    for (const std::exception_ptr &error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    double time =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end - start)
+            .count();
+    Index total = std::accumulate(items.begin(), items.end(), Index(0));
+    if (reference_threads == 0) {
+      reference_time = time;
+      reference_threads = nthreads;
+    }
+    double speedup = reference_time / time;
+    double efficiency = speedup * double(reference_threads) / double(nthreads);
+
+    std::cout << " threads:" << nthreads << " time:" << time
+              << " frames/s:" << double(nframes) / time << " "
+              << kernel.Items() << "/s:" << double(total) / time
+              << " speedup:" << speedup << std::endl;
+    votca::tools::Property &run = output.add("threads", "");
+    run.setAttribute("n", nthreads);
+    run.add("time", std::to_string(time));
+    run.add("frames_per_s", std::to_string(double(nframes) / time));
+    run.add(kernel.Items(), std::to_string(total));
+    run.add(kernel.Items() + "_per_s", std::to_string(double(total) / time));
+    run.add("speedup", std::to_string(speedup));
+    run.add("efficiency", std::to_string(efficiency));
+  }
+  return output;
+}
+
+}  // namespace
+
+void CsgBenchmark::Initialize() {
+  namespace propt = boost::program_options;
+
+  AddProgramOptions()("system",
+                      propt::value<std::string>()->default_value("lj"),
+                      "  lj (single bead molecules) or polymer");
+  AddProgramOptions()("beads", propt::value<Index>()->default_value(4000),
+                      "  number of coarse-grained beads");
+  AddProgramOptions()("chain-length", propt::value<Index>()->default_value(20),
+                      "  beads per polymer chain");
+  AddProgramOptions()("atoms-per-bead",
+                      propt::value<Index>()->default_value(3),
+                      "  atoms mapped onto one bead");
+  AddProgramOptions()("density", propt::value<double>()->default_value(10.0),
+                      "  bead density in nm^-3");
+  AddProgramOptions()(
+      "box", propt::value<std::string>()->default_value("orthorhombic"),
+      "  open, orthorhombic or triclinic");
+  AddProgramOptions()("cutoff", propt::value<double>()->default_value(1.2),
+                      "  cutoff of the pair kernels in nm");
+  AddProgramOptions()("cutoff-3body",
+                      propt::value<double>()->default_value(0.5),
+                      "  cutoff of the 3body neighbour list in nm");
+  AddProgramOptions()("frames", propt::value<Index>()->default_value(8),
+                      "  number of frames per run");
+  AddProgramOptions()("threads",
+                      propt::value<std::string>()->default_value("1"),
+                      "  comma separated list of thread counts");
+  AddProgramOptions()(
+      "kernels", propt::value<std::string>()->default_value("all"),
+      "  comma separated list of nblist, nblistgrid, nblistgrid_3body, "
+      "topologymap, exclusionlist, histogram, imc, fmatch");
+  AddProgramOptions()("seed", propt::value<Index>()->default_value(42),
+                      "  seed of the generated frames");
+  AddProgramOptions()(
+      "out", propt::value<std::string>()->default_value("csg_benchmark.xml"),
+      "  xml file with the timings");
+}
+
+bool CsgBenchmark::EvaluateOptions() {
+  system_ = OptionsMap()["system"].as<std::string>();
+  if (system_ != "lj" && system_ != "polymer") {
+    throw std::runtime_error("--system has to be lj or polymer");
+  }
+  boxtype_ = OptionsMap()["box"].as<std::string>();
+  if (boxtype_ != "open" && boxtype_ != "orthorhombic" &&
+      boxtype_ != "triclinic") {
+    throw std::runtime_error("--box has to be open, orthorhombic or triclinic");
+  }
+  chain_length_ =
+      (system_ == "lj") ? 1 : OptionsMap()["chain-length"].as<Index>();
+  atoms_per_bead_ = OptionsMap()["atoms-per-bead"].as<Index>();
+  nmolecules_ = OptionsMap()["beads"].as<Index>() / chain_length_;
+  nframes_ = OptionsMap()["frames"].as<Index>();
+  seed_ = OptionsMap()["seed"].as<Index>();
+  density_ = OptionsMap()["density"].as<double>();
+  cutoff_ = OptionsMap()["cutoff"].as<double>();
+  cutoff_3body_ = OptionsMap()["cutoff-3body"].as<double>();
+  if (chain_length_ < 1 || atoms_per_bead_ < 1 || nmolecules_ < 1 ||
+      nframes_ < 1 || density_ <= 0.0) {
+    throw std::runtime_error(
+        "--beads, --chain-length, --atoms-per-bead, --frames and --density "
+        "have to be positive");
+  }
+
+  threads_ = votca::tools::Tokenizer(OptionsMap()["threads"].as<std::string>(),
+                                     ",")
+                 .ToVector<Index>();
+  if (threads_.empty() ||
+      *std::min_element(threads_.begin(), threads_.end()) < 1) {
+    throw std::runtime_error("--threads has to list positive thread counts");
+  }
+
+  std::string kernels = OptionsMap()["kernels"].as<std::string>();
+  std::vector<std::string> requested =
+      (kernels == "all") ? all_kernels
+                         : votca::tools::Tokenizer(kernels, ",").ToVector();
+  kernels_.clear();
+  for (const std::string &kernel : requested) {
+    if (std::find(all_kernels.begin(), all_kernels.end(), kernel) ==
+        all_kernels.end()) {
+      throw std::runtime_error("unknown kernel " + kernel);
+    }
+    // the grid search, which csg_stat always uses, needs a periodic box
+    if (!Periodic() &&
+        (kernel == "nblistgrid" || kernel == "nblistgrid_3body" ||
+         kernel == "imc")) {
+      std::cout << "skipping " << kernel << ", it needs a periodic box"
+                << std::endl;
+      continue;
+    }
+    kernels_.push_back(kernel);
+  }
+  return true;
+}
+
+std::string CsgBenchmark::MappingXML() {
+  votca::tools::Property mapping("cg_molecule", "", "");
+  mapping.add("name", "MOL");
+  mapping.add("ident", "MOL");
+  votca::tools::Property &topology = mapping.add("topology", "");
+  votca::tools::Property &beads = topology.add("cg_beads", "");
+  std::string bonds;
+  for (Index i = 0; i < chain_length_; i++) {
+    votca::tools::Property &bead = beads.add("cg_bead", "");
+    bead.add("name", "B" + std::to_string(i + 1));
+    bead.add("type", "A");
+    bead.add("mapping", "M");
+    std::string atoms;
+    for (Index k = 0; k < atoms_per_bead_; k++) {
+      atoms += std::to_string(i + 1) + ":MON:A" + std::to_string(k + 1) + " ";
+    }
+    bead.add("beads", atoms);
+    if (i > 0) {
+      bonds += "B" + std::to_string(i) + " B" + std::to_string(i + 1) + " ";
+    }
+  }
+  if (chain_length_ > 1) {
+    votca::tools::Property &bond =
+        topology.add("cg_bonded", "").add("bond", "");
+    bond.add("name", "bond");
+    bond.add("beads", bonds);
+  }
+  std::string weights;
+  for (Index k = 0; k < atoms_per_bead_; k++) {
+    weights += "1 ";
+  }
+  votca::tools::Property &map = mapping.add("maps", "").add("map", "");
+  map.add("name", "M");
+  map.add("weights", weights);
+
+  std::string filename =
+      OptionsMap()["out"].as<std::string>() + ".mapping.xml";
+  std::ofstream ofs(filename);
+  ofs << mapping << std::endl;
+  return filename;
+}
+
+votca::tools::Property CsgBenchmark::InteractionOptions() const {
+  votca::tools::Property options;
+  votca::tools::Property &cg = options.add("cg", "");
+  cg.add("nbsearch", Periodic() ? "grid" : "simple");
+  votca::tools::Property &fmatch = cg.add("fmatch", "");
+  // the smoothing rows of the simple least squares keep grid points without
+  // samples from making the system singular
+  fmatch.add("constrainedLS", "false");
+  fmatch.add("frames_per_block", "1");
+
+  votca::tools::Property &nonbonded = cg.add("non-bonded", "");
+  nonbonded.add("name", "A-A");
+  nonbonded.add("type1", "A");
+  nonbonded.add("type2", "A");
+  nonbonded.add("min", "0");
+  nonbonded.add("max", std::to_string(cutoff_));
+  nonbonded.add("step", "0.01");
+  // the force matching grids only cover distances the frames sample
+  std::vector<double> dist;
+  std::vector<double> bonds;
+  for (const Frame &frame : cg_frames_) {
+    dist.insert(dist.end(), frame.dist.begin(), frame.dist.end());
+    bonds.insert(bonds.end(), frame.bonds.begin(), frame.bonds.end());
+  }
+  const Index min_samples = 10;
+  const double nb_step = 0.02;
+  std::pair<double, double> nb_range =
+      SampledRange(dist, nb_step, min_samples);
+  votca::tools::Property &nb_fmatch = nonbonded.add("fmatch", "");
+  nb_fmatch.add("min", std::to_string(nb_range.first));
+  nb_fmatch.add("max", std::to_string(std::min(nb_range.second, cutoff_)));
+  nb_fmatch.add("step", std::to_string(nb_step));
+  nb_fmatch.add("out_step", std::to_string(nb_step));
+  nonbonded.add("inverse", "").add("imc", "").add("group", "A-A");
+
+  if (chain_length_ > 1) {
+    votca::tools::Property &bonded = cg.add("bonded", "");
+    bonded.add("name", "bond");
+    bonded.add("min", "0");
+    bonded.add("max", "1.0");
+    bonded.add("step", "0.01");
+    const double b_step = 0.01;
+    std::pair<double, double> b_range =
+        SampledRange(bonds, b_step, min_samples);
+    votca::tools::Property &b_fmatch = bonded.add("fmatch", "");
+    b_fmatch.add("min", std::to_string(b_range.first));
+    b_fmatch.add("max", std::to_string(b_range.second));
+    b_fmatch.add("step", std::to_string(b_step));
+    b_fmatch.add("out_step", std::to_string(b_step));
+    bonded.add("inverse", "").add("imc", "").add("group", "none");
+  }
+  return options;
+}
+
+std::unique_ptr<Replica> CsgBenchmark::CreateReplica() {
+  auto replica = std::make_unique<Replica>();
+  Topology &top = replica->atomistic;
+  for (Index m = 0; m < nmolecules_; m++) {
+    Molecule *mol = top.CreateMolecule("MOL");
+    for (Index i = 0; i < chain_length_; i++) {
+      for (Index k = 0; k < atoms_per_bead_; k++) {
+        std::string name = "A" + std::to_string(k + 1);
+        Bead *atom = top.CreateBead(Bead::spherical, name, "A", i, 1.0, 0.0);
+        mol->AddBead(atom, std::to_string(i + 1) + ":MON:" + name);
+      }
+    }
+  }
+  top.setBox(box_);
+  replica->map = cg_engine_.CreateCGTopology(top, replica->cg);
+  replica->cg.setBox(box_);
+  return replica;
+}
+
+/// Molecules start at random points of the cell, polymers continue as a
+/// random walk with fixed bond length. Atoms are scattered around their bead
+/// and get random forces, positions are wrapped into a periodic box.
+Frame CsgBenchmark::GenerateFrame(Index step) const {
+  std::mt19937 rng(std::mt19937::result_type(seed_ + step));
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  auto gaussian = [&]() {
+    return Eigen::Vector3d(normal(rng), normal(rng), normal(rng));
+  };
+
+  Eigen::Matrix3d inverse = Eigen::Matrix3d::Zero();
+  if (Periodic()) {
+    inverse = box_.inverse();
+  }
+  Frame frame;
+  Index natoms = nmolecules_ * chain_length_ * atoms_per_bead_;
+  frame.pos.reserve(natoms);
+  frame.force.reserve(natoms);
+  for (Index m = 0; m < nmolecules_; m++) {
+    Eigen::Vector3d center =
+        cell_ * Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng));
+    for (Index i = 0; i < chain_length_; i++) {
+      if (i > 0) {
+        center += bond_length * gaussian().normalized();
+      }
+      for (Index k = 0; k < atoms_per_bead_; k++) {
+        Eigen::Vector3d pos = center + atom_spread * gaussian();
+        if (Periodic()) {
+          Eigen::Vector3d shift = (inverse * pos).array().floor();
+          pos -= box_ * shift;
+        }
+        frame.pos.push_back(pos);
+        frame.force.push_back(10.0 * gaussian());
+      }
+    }
+  }
+  return frame;
+}
+
+/// maps the atomistic frame and lists all bead pairs within the cutoff
+/// without exclusions, those are the input of the exclusion and histogram
+/// kernels and the pair counts of imc and fmatch. The pair distances and
+/// bond lengths also set the force matching grids.
+Frame CsgBenchmark::MapFrame(const Frame &frame, Replica &replica) const {
+  LoadFrame(frame, 0, replica.atomistic);
+  replica.map->Apply();
+  Frame cg_frame;
+  for (Index i = 0; i < replica.cg.BeadCount(); i++) {
+    cg_frame.pos.push_back(replica.cg.getBead(i)->getPos());
+    cg_frame.force.push_back(replica.cg.getBead(i)->getF());
+  }
+
+  BeadList beads;
+  beads.Generate(replica.cg, "*");
+  std::unique_ptr<NBList> nb;
+  if (Periodic()) {
+    nb = std::make_unique<NBListGrid>();
+  } else {
+    nb = std::make_unique<NBList>();
+  }
+  nb->setCutoff(cutoff_);
+  nb->Generate(beads, false);
+  for (BeadPair *pair : *nb) {
+    cg_frame.pairs.emplace_back(pair->first()->getId(),
+                                pair->second()->getId());
+    cg_frame.dist.push_back(pair->dist());
+  }
+  for (Interaction *bond : replica.cg.BondedInteractions()) {
+    cg_frame.bonds.push_back(bond->EvaluateVar(replica.cg));
+  }
+  return cg_frame;
+}
+
+void CsgBenchmark::Run() {
+  Index nbeads = nmolecules_ * chain_length_;
+  double length = std::cbrt(double(nbeads) / density_);
+  cell_ = length * Eigen::Matrix3d::Identity();
+  if (boxtype_ == "triclinic") {
+    cell_.col(1) << 0.3 * length, length, 0.0;
+    cell_.col(2) << 0.2 * length, 0.1 * length, length;
+  }
+  box_ = Periodic() ? cell_ : Eigen::Matrix3d::Zero();
+
+  std::string mapping = MappingXML();
+  cg_engine_.LoadMoleculeType(mapping);
+  std::filesystem::remove(mapping);
+
+  Index nreplicas = *std::max_element(threads_.begin(), threads_.end());
+  std::vector<std::unique_ptr<Replica>> replicas;
+  for (Index i = 0; i < nreplicas; i++) {
+    replicas.push_back(CreateReplica());
+  }
+  double half_box = 0.5 * replicas[0]->cg.ShortestBoxSize();
+  if (Periodic() && std::max(cutoff_, cutoff_3body_) > half_box) {
+    throw std::runtime_error(
+        "cutoff is larger than half the box, increase --beads or lower "
+        "--density");
+  }
+
+  atomistic_frames_.clear();
+  cg_frames_.clear();
+  Index npairs = 0;
+  for (Index f = 0; f < nframes_; f++) {
+    atomistic_frames_.push_back(GenerateFrame(f));
+    cg_frames_.push_back(MapFrame(atomistic_frames_.back(), *replicas[0]));
+    npairs += Index(cg_frames_.back().pairs.size());
+  }
+
+  votca::tools::Property output("csg_benchmark", "", "");
+  votca::tools::Property &system = output.add("system", "");
+  system.add("type", system_);
+  system.add("box", boxtype_);
+  system.add("molecules", std::to_string(nmolecules_));
+  system.add("beads", std::to_string(nbeads));
+  system.add("atoms", std::to_string(replicas[0]->atomistic.BeadCount()));
+  system.add("box_length", std::to_string(length));
+  system.add("cutoff", std::to_string(cutoff_));
+  system.add("cutoff_3body", std::to_string(cutoff_3body_));
+  system.add("frames", std::to_string(nframes_));
+  system.add("pairs_per_frame", std::to_string(npairs / nframes_));
+  std::cout << "system:" << system_ << " box:" << boxtype_
+            << " beads:" << nbeads << " pairs/frame:" << npairs / nframes_
+            << std::endl;
+
+  votca::tools::Property interactions = InteractionOptions();
+  for (const std::string &name : kernels_) {
+    std::unique_ptr<BenchmarkKernel> kernel;
+    if (name == "nblist") {
+      kernel = std::make_unique<NBListKernel<NBList>>(name, "pairs", cutoff_);
+    } else if (name == "nblistgrid") {
+      kernel =
+          std::make_unique<NBListKernel<NBListGrid>>(name, "pairs", cutoff_);
+    } else if (name == "nblistgrid_3body") {
+      kernel = std::make_unique<NBListKernel<NBListGrid_3Body>>(
+          name, "triples", cutoff_3body_);
+    } else if (name == "topologymap") {
+      kernel = std::make_unique<TopologyMapKernel>();
+    } else if (name == "exclusionlist") {
+      kernel = std::make_unique<ExclusionListKernel>();
+    } else if (name == "histogram") {
+      kernel = std::make_unique<HistogramKernel>(cutoff_);
+    } else if (name == "imc") {
+      kernel = std::make_unique<ImcKernel>(interactions);
+    } else {
+      kernel = std::make_unique<ForceMatchingKernel>(interactions);
+    }
+    output.add(RunKernel(*kernel, threads_, atomistic_frames_, cg_frames_,
+                         replicas));
+  }
+
+  std::ofstream ofs(OptionsMap()["out"].as<std::string>());
+  ofs << output << std::endl;
+}
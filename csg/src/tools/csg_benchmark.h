@@ -0,0 +1,119 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_CSG_CSG_BENCHMARK_H
+#define VOTCA_CSG_CSG_BENCHMARK_H
+
+// Standard includes
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// VOTCA includes
+#include <votca/tools/application.h>
+#include <votca/tools/property.h>
+
+// Local VOTCA includes
+#include "votca/csg/cgengine.h"
+#include "votca/csg/topology.h"
+#include "votca/csg/topologymap.h"
+#include "votca/csg/version.h"
+
+/**
+    \brief Measures the throughput of the csg analysis kernels on synthetic
+    systems
+
+    A Lennard-Jones liquid or a polymer melt is generated in memory and the
+    neighbour searches, the mapping, the exclusions, the histograms and the
+    frame evaluation of csg_stat (imc) and csg_fmatch are timed for a set of
+    frames. Frames are distributed round robin over the threads and each
+    thread owns a copy of the topologies, as for the workers of
+    CsgApplication.
+ *
+ **/
+class CsgBenchmark : public votca::tools::Application {
+ public:
+  std::string ProgramName() override { return "csg_benchmark"; }
+  void HelpText(std::ostream &out) override {
+    out << "Benchmark the csg analysis kernels on synthetic systems";
+  }
+
+  void ShowHelpText(std::ostream &out) override {
+    std::string name = ProgramName();
+    if (VersionString() != "") {
+      name = name + ", version " + VersionString();
+    }
+
+    votca::csg::HelpTextHeader(name);
+    HelpText(out);
+
+    out << "\n\n" << VisibleOptions() << std::endl;
+  }
+
+  bool EvaluateOptions() override;
+  void Initialize() override;
+  void Run() override;
+
+  /// atomistic and coarse-grained topology of one thread
+  struct Replica {
+    votca::csg::Topology atomistic;
+    votca::csg::Topology cg;
+    std::unique_ptr<votca::csg::TopologyMap> map;
+  };
+
+  /// positions and forces of all beads in one frame, coarse-grained frames
+  /// also store all bead pairs within the cutoff and the bond lengths
+  struct Frame {
+    std::vector<Eigen::Vector3d> pos;
+    std::vector<Eigen::Vector3d> force;
+    std::vector<std::pair<votca::Index, votca::Index>> pairs;
+    std::vector<double> dist;
+    std::vector<double> bonds;
+  };
+
+ private:
+  std::string MappingXML();
+  votca::tools::Property InteractionOptions() const;
+  std::unique_ptr<Replica> CreateReplica();
+  Frame GenerateFrame(votca::Index step) const;
+  Frame MapFrame(const Frame &frame, Replica &replica) const;
+  bool Periodic() const { return boxtype_ != "open"; }
+
+  std::string system_;
+  std::string boxtype_;
+  votca::Index nmolecules_;
+  votca::Index chain_length_;
+  votca::Index atoms_per_bead_;
+  votca::Index nframes_;
+  votca::Index seed_;
+  double density_;
+  double cutoff_;
+  double cutoff_3body_;
+  std::vector<votca::Index> threads_;
+  std::vector<std::string> kernels_;
+
+  /// box of the topology, zero for an open system
+  Eigen::Matrix3d box_;
+  /// volume the beads are placed in, equal to box_ for periodic systems
+  Eigen::Matrix3d cell_;
+  votca::csg::CGEngine cg_engine_;
+  std::vector<Frame> atomistic_frames_;
+  std::vector<Frame> cg_frames_;
+};
+
+#endif  // VOTCA_CSG_CSG_BENCHMARK_H
@@ -1,5 +1,5 @@
 /*
- * Copyright 2009-2021 The VOTCA Development Team (http://www.votca.org)
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,9 +15,17 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+
 // VOTCA includes
 #include <votca/tools/constants.h>
 #include <votca/tools/histogramnew.h>
+#include <votca/tools/perthread.h>
+#include <votca/tools/property.h>
 #include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
@@ -26,11 +34,99 @@
 using namespace std;
 using namespace votca::csg;
 
+/**
+ * \brief one density profile, i.e. a selection of beads and an axis
+ *
+ * 1d profiles along a box axis or radial from a reference point are
+ * accumulated in a histogram, 3d densities (axis xyz) on a voxel grid spanned
+ * by the box vectors.
+ */
+struct DensityProfile {
+  string out;
+  string axisname;
+  string dens_type;
+  string molname;
+  string filter;
+  double step;
+  double scale;
+  double rmax = -1;
+  bool has_ref = false;
+  Eigen::Vector3d ref = Eigen::Vector3d::Zero();
+
+  // set up in BeginEvaluate
+  bool grid = false;
+  Eigen::Vector3d axis = Eigen::Vector3d::Zero();
+  double area = 0;
+  votca::Index nbin = 0;
+  std::array<votca::Index, 3> ngrid = {0, 0, 0};
+  Eigen::Matrix3d box = Eigen::Matrix3d::Zero();
+
+  votca::Index VoxelCount() const { return ngrid[0] * ngrid[1] * ngrid[2]; }
+
+  /// sets up empty accumulators for this profile
+  void InitializeAccumulators(votca::tools::HistogramNew &dist,
+                              std::vector<double> &voxels) const {
+    voxels.assign(grid ? VoxelCount() : 0, 0.0);
+    if (!grid) {
+      dist.setPeriodic(axisname != "r");
+      dist.Initialize(0, rmax, nbin);
+    }
+  }
+};
+
+/**
+ * \brief accumulated data of all profiles
+ *
+ * Every thread fills its own accumulator, they are merged once at the end
+ * or, when writing blocks, frame by frame in the order of the trajectory.
+ */
+struct DensityAccumulator {
+  std::vector<votca::tools::HistogramNew> dists;
+  std::vector<std::vector<double>> voxels;
+  votca::Index frames = 0;
+
+  /// sets up empty accumulators for the profiles
+  void Initialize(const std::vector<DensityProfile> &profiles) {
+    dists.resize(profiles.size());
+    voxels.resize(profiles.size());
+    for (std::size_t p = 0; p < profiles.size(); p++) {
+      profiles[p].InitializeAccumulators(dists[p], voxels[p]);
+    }
+    frames = 0;
+  }
+
+  void Merge(const DensityAccumulator &other) {
+    for (std::size_t p = 0; p < dists.size(); p++) {
+      if (voxels[p].empty()) {
+        dists[p].Merge(other.dists[p]);
+        continue;
+      }
+      for (std::size_t i = 0; i < voxels[p].size(); i++) {
+        voxels[p][i] += other.voxels[p][i];
+      }
+    }
+    frames += other.frames;
+  }
+};
+
 class CsgDensityApp : public CsgApplication {
   string ProgramName() override { return "csg_density"; }
   void HelpText(ostream &out) override {
-    out << "Calculates the mass density distribution along a box axis or "
-           "radial density profile from reference point";
+    out << "Calculates the mass density distribution along a box axis, a "
+           "radial density profile from a reference point or a 3d density "
+           "map (cube file).\n"
+           "Several profiles can be calculated in a single pass over the "
+           "trajectory by listing them in an xml file given by --profiles:\n"
+           "<density>\n"
+           "  <profile>\n"
+           "    <out>water.dens.z</out>\n"
+           "    <axis>z</axis>\n"
+           "    <molname>SOL</molname>\n"
+           "  </profile>\n"
+           "  ...\n"
+           "</density>\n"
+           "The elements of a profile are named like the options below, "
+           "missing elements default to the values of the options.";
   }
 
   // some program options are added here
@@ -41,35 +137,58 @@ class CsgDensityApp : public CsgApplication {
   bool DoMapping() override { return true; }
   bool DoMappingDefault(void) override { return false; }
 
+  // frames are accumulated per thread, only blocks need the frames in order
+  bool DoThreaded() override { return true; }
+  bool SynchronizeThreads() override {
+    return OptionsMap().count("block-length") > 0;
+  }
+
   // write out results in EndEvaluate
   void EndEvaluate() override;
   void BeginEvaluate(Topology *top, Topology *top_atom) override;
-  void EvalConfiguration(Topology *top, Topology *top_ref) override;
 
   bool EvaluateOptions() override {
     CsgApplication::EvaluateOptions();
-    CheckRequired("out", "no output topology specified");
+    if (!OptionsMap().count("profiles")) {
+      CheckRequired("out", "no output topology specified");
+    }
     CheckRequired("trj", "no trajectory file specified");
     return true;
   };
 
+  std::unique_ptr<CsgApplication::Worker> ForkWorker() override;
+  void MergeWorker(CsgApplication::Worker *worker) override;
+
  protected:
+  class Worker : public CsgApplication::Worker {
+   public:
+    void EvalConfiguration(Topology *top, Topology *top_ref) override;
+
+    CsgDensityApp *density_ = nullptr;
+  };
+
   string filter_, out_;
-  votca::tools::HistogramNew dist_;
   string dens_type_;
-  double rmax_;
-  votca::Index nbin_;
-  double scale_;
   double step_;
-  votca::Index frames_;
+  double scale_;
   votca::Index nblock_;
   votca::Index block_length_;
   Eigen::Vector3d ref_;
-  Eigen::Vector3d axis_;
   string axisname_;
   string molname_;
-  double area_;
-  void WriteDensity(votca::Index nframes, const string &suffix = "");
+  // the profiles are not changed while the workers run, the accumulated
+  // data is kept separately, one accumulator per worker
+  std::vector<DensityProfile> profiles_;
+  votca::tools::PerThread<DensityAccumulator> accumulators_;
+  // frames of the current block, see SynchronizeThreads
+  DensityAccumulator block_;
+
+  void LoadProfiles();
+  void SetupProfile(DensityProfile &profile, const Eigen::Matrix3d &box) const;
+  void WriteDensity(DensityAccumulator &density, const string &suffix = "");
+  void WriteCube(const DensityProfile &profile,
+                 const std::vector<double> &voxels, votca::Index nframes,
+                 const string &filename) const;
 };
 
 int main(int argc, char **argv) {
@@ -77,120 +196,290 @@ int main(int argc, char **argv) {
   return app.Exec(argc, argv);
 }
 
-void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
+void CsgDensityApp::LoadProfiles() {
+  DensityProfile defaults;
+  defaults.out = out_;
+  defaults.axisname = axisname_;
+  defaults.dens_type = dens_type_;
+  defaults.molname = molname_;
+  defaults.filter = filter_;
+  defaults.step = step_;
+  defaults.scale = scale_;
+  if (OptionsMap().count("rmax")) {
+    defaults.rmax = OptionsMap()["rmax"].as<double>();
+  }
+  if (OptionsMap().count("ref")) {
+    defaults.has_ref = true;
+    defaults.ref = ref_;
+  }
+
+  profiles_.clear();
+  if (!OptionsMap().count("profiles")) {
+    profiles_.push_back(defaults);
+    return;
+  }
+
+  votca::tools::Property options;
+  options.LoadFromXML(OptionsMap()["profiles"].as<string>());
+  for (const votca::tools::Property *p : options.Select("density.profile")) {
+    DensityProfile profile = defaults;
+    profile.out = p->get("out").as<string>();
+    profile.axisname =
+        p->ifExistsReturnElseReturnDefault<string>("axis", profile.axisname);
+    profile.dens_type =
+        p->ifExistsReturnElseReturnDefault<string>("type", profile.dens_type);
+    profile.molname =
+        p->ifExistsReturnElseReturnDefault<string>("molname", profile.molname);
+    profile.filter =
+        p->ifExistsReturnElseReturnDefault<string>("filter", profile.filter);
+    profile.step =
+        p->ifExistsReturnElseReturnDefault<double>("step", profile.step);
+    profile.scale =
+        p->ifExistsReturnElseReturnDefault<double>("scale", profile.scale);
+    profile.rmax =
+        p->ifExistsReturnElseReturnDefault<double>("rmax", profile.rmax);
+    if (p->exists("ref")) {
+      profile.has_ref = true;
+      profile.ref = p->get("ref").as<Eigen::Vector3d>();
+    }
+    profiles_.push_back(profile);
+  }
+  if (profiles_.empty()) {
+    throw std::runtime_error("no density.profile found in " +
+                             OptionsMap()["profiles"].as<string>());
+  }
+}
 
-  Eigen::Matrix3d box = top->getBox();
+void CsgDensityApp::SetupProfile(DensityProfile &profile,
+                                 const Eigen::Matrix3d &box) const {
   Eigen::Vector3d a = box.col(0);
   Eigen::Vector3d b = box.col(1);
   Eigen::Vector3d c = box.col(2);
 
-  dist_.setPeriodic(true);
-  axis_ = Eigen::Vector3d::Zero();
-  area_ = 0;
-  if (axisname_ == "x") {
-    axis_ = Eigen::Vector3d::UnitX();
-    rmax_ = a.norm();
-    area_ = b.cross(c).norm();
-  } else if (axisname_ == "y") {
-    axis_ = Eigen::Vector3d::UnitY();
-    rmax_ = b.norm();
-    area_ = a.cross(c).norm();
-  } else if (axisname_ == "z") {
-    axis_ = Eigen::Vector3d::UnitZ();
-    rmax_ = c.norm();
-    area_ = a.cross(b).norm();
-  } else if (axisname_ == "r") {
-    dist_.setPeriodic(false);
-    rmax_ = min(min((a / 2).norm(), (b / 2).norm()), (c / 2).norm());
+  profile.axis = Eigen::Vector3d::Zero();
+  profile.area = 0;
+  double rmax = 0;
+  if (profile.axisname == "x") {
+    profile.axis = Eigen::Vector3d::UnitX();
+    rmax = a.norm();
+    profile.area = b.cross(c).norm();
+  } else if (profile.axisname == "y") {
+    profile.axis = Eigen::Vector3d::UnitY();
+    rmax = b.norm();
+    profile.area = a.cross(c).norm();
+  } else if (profile.axisname == "z") {
+    profile.axis = Eigen::Vector3d::UnitZ();
+    rmax = c.norm();
+    profile.area = a.cross(b).norm();
+  } else if (profile.axisname == "r") {
+    rmax = min(min((a / 2).norm(), (b / 2).norm()), (c / 2).norm());
+  } else if (profile.axisname == "xyz") {
+    profile.grid = true;
   } else {
     throw std::runtime_error("unknown axis type");
   }
 
-  if (OptionsMap().count("rmax")) {
-    rmax_ = OptionsMap()["rmax"].as<double>();
+  if (profile.axisname == "r") {
+    if (!profile.has_ref) {
+      profile.ref = a / 2 + b / 2 + c / 2;
+    }
+    cout << "Using referece point: " << profile.ref << endl;
+  } else if (profile.has_ref) {
+    throw std::runtime_error(
+        "reference center can only be used in case of spherical density");
   }
 
-  if (OptionsMap().count("block-length")) {
-    block_length_ = OptionsMap()["block-length"].as<votca::Index>();
-  } else {
-    block_length_ = 0;
+  cout << "profile: " << profile.out << endl;
+  cout << "axis: " << profile.axisname << endl;
+  if (profile.grid) {
+    if (std::abs(box.determinant()) == 0) {
+      throw std::runtime_error("3d densities need a periodic box");
+    }
+    profile.box = box;
+    for (votca::Index i = 0; i < 3; i++) {
+      profile.ngrid[i] = std::max(
+          votca::Index(std::round(box.col(i).norm() / profile.step)),
+          votca::Index(1));
+    }
+    cout << "Grid: " << profile.ngrid[0] << "x" << profile.ngrid[1] << "x"
+         << profile.ngrid[2] << endl;
+    return;
   }
 
-  if (axisname_ == "r") {
-    if (!OptionsMap().count("ref")) {
-      ref_ = a / 2 + b / 2 + c / 2;
-    }
-    cout << "Using referece point: " << ref_ << endl;
-  } else if (OptionsMap().count("ref")) {
-    throw std::runtime_error(
-        "reference center can only be used in case of spherical density");
+  if (profile.rmax > 0) {
+    rmax = profile.rmax;
   }
+  profile.rmax = rmax;
+  profile.nbin = (votca::Index)floor(profile.rmax / profile.step);
+
+  cout << "rmax: " << profile.rmax << endl;
+  cout << "Bins: " << profile.nbin << endl;
+}
 
-  nbin_ = (votca::Index)floor(rmax_ / step_);
-  dist_.Initialize(0, rmax_, nbin_);
+void CsgDensityApp::BeginEvaluate(Topology *top, Topology *) {
+  LoadProfiles();
+  for (DensityProfile &profile : profiles_) {
+    SetupProfile(profile, top->getBox());
+  }
+  // the workers are numbered 0 to nthreads-1
+  block_.Initialize(profiles_);
+  accumulators_ =
+      votca::tools::PerThread<DensityAccumulator>(nthreads_, block_);
 
-  cout << "rmax: " << rmax_ << endl;
-  cout << "axis: " << axisname_ << endl;
-  cout << "Bins: " << nbin_ << endl;
-  frames_ = 0;
+  if (OptionsMap().count("block-length")) {
+    block_length_ = OptionsMap()["block-length"].as<votca::Index>();
+  } else {
+    block_length_ = 0;
+  }
   nblock_ = 0;
 }
 
-void CsgDensityApp::EvalConfiguration(Topology *top, Topology *) {
-  // loop over all molecules
-  bool did_something = false;
-  for (const auto &mol : top->Molecules()) {
-    if (!votca::tools::wildcmp(molname_, mol.getName())) {
-      continue;
+std::unique_ptr<CsgApplication::Worker> CsgDensityApp::ForkWorker() {
+  // workers are forked before BeginEvaluate, their accumulators are set up
+  // there
+  auto worker = std::make_unique<CsgDensityApp::Worker>();
+  worker->density_ = this;
+  return worker;
+}
+
+void CsgDensityApp::Worker::EvalConfiguration(Topology *top, Topology *) {
+  const std::vector<DensityProfile> &profiles = density_->profiles_;
+  DensityAccumulator &density = density_->accumulators_[getId()];
+
+  for (std::size_t p = 0; p < profiles.size(); p++) {
+    const DensityProfile &profile = profiles[p];
+    bool mass = (profile.dens_type == "mass");
+    // the grid follows the box, a bead lands in the same voxel of the
+    // fractional coordinates in every frame
+    Eigen::Matrix3d to_fractional = Eigen::Matrix3d::Zero();
+    double voxel_scale = 0;
+    if (profile.grid) {
+      Eigen::Matrix3d box = top->getBox();
+      to_fractional = box.inverse();
+      voxel_scale =
+          double(density.voxels[p].size()) / std::abs(box.determinant());
     }
-    votca::Index N = mol.BeadCount();
-    for (votca::Index i = 0; i < N; i++) {
-      const Bead *b = mol.getBead(i);
-      if (!votca::tools::wildcmp(filter_, b->getName())) {
+
+    bool did_something = false;
+    for (const auto &mol : top->Molecules()) {
+      if (!votca::tools::wildcmp(profile.molname, mol.getName())) {
         continue;
       }
-      double r;
-      if (axisname_ == "r") {
-        r = (top->BCShortestConnection(ref_, b->getPos()).norm());
-      } else {
-        r = b->getPos().dot(axis_);
-      }
-      if (dens_type_ == "mass") {
-        dist_.Process(r, b->getMass());
-      } else {
-        dist_.Process(r, 1.0);
+      votca::Index N = mol.BeadCount();
+      for (votca::Index i = 0; i < N; i++) {
+        const Bead *b = mol.getBead(i);
+        if (!votca::tools::wildcmp(profile.filter, b->getName())) {
+          continue;
+        }
+        double weight = mass ? b->getMass() : 1.0;
+        did_something = true;
+        if (profile.grid) {
+          Eigen::Vector3d s = to_fractional * b->getPos();
+          votca::Index voxel = 0;
+          for (votca::Index d = 0; d < 3; d++) {
+            votca::Index n = profile.ngrid[d];
+            votca::Index k =
+                votca::Index(floor((s[d] - floor(s[d])) * double(n)));
+            voxel = voxel * n + std::min(k, n - 1);
+          }
+          density.voxels[p][voxel] += weight * voxel_scale;
+          continue;
+        }
+        double r;
+        if (profile.axisname == "r") {
+          r = (top->BCShortestConnection(profile.ref, b->getPos()).norm());
+        } else {
+          r = b->getPos().dot(profile.axis);
+        }
+        density.dists[p].Process(r, weight);
       }
-      did_something = true;
+    }
+    if (!did_something) {
+      throw std::runtime_error("No molecule in selection of " + profile.out);
     }
   }
-  frames_++;
-  if (!did_something) {
-    throw std::runtime_error("No molecule in selection");
+  density.frames++;
+}
+
+void CsgDensityApp::MergeWorker(CsgApplication::Worker *worker) {
+  // without blocks the accumulators are reduced once in EndEvaluate
+  if (block_length_ == 0) {
+    return;
   }
-  if (block_length_ != 0) {
-    if ((nframes_ % block_length_) == 0) {
-      nblock_++;
-      string suffix = string("_") + boost::lexical_cast<string>(nblock_);
-      WriteDensity(block_length_, suffix);
-      dist_.Clear();
-    }
+  // blocks are merged frame by frame, see SynchronizeThreads
+  DensityAccumulator &density = accumulators_[worker->getId()];
+  if (density.frames == 0) {
+    return;
+  }
+  block_.Merge(density);
+  density.Initialize(profiles_);
+  if (block_.frames == block_length_) {
+    nblock_++;
+    string suffix = string("_") + boost::lexical_cast<string>(nblock_);
+    WriteDensity(block_, suffix);
+    block_.Initialize(profiles_);
   }
 }
 
 // output everything when processing frames is done
-void CsgDensityApp::WriteDensity(votca::Index nframes, const string &suffix) {
-  if (axisname_ == "r") {
-    dist_.data().y() =
-        scale_ /
-        (double(nframes) * rmax_ / (double)nbin_ * 4 * votca::tools::conv::Pi) *
-        dist_.data().y().cwiseQuotient(dist_.data().x().cwiseAbs2());
+void CsgDensityApp::WriteDensity(DensityAccumulator &density,
+                                 const string &suffix) {
+  votca::Index nframes = density.frames;
+  for (std::size_t p = 0; p < profiles_.size(); p++) {
+    const DensityProfile &profile = profiles_[p];
+    if (profile.grid) {
+      WriteCube(profile, density.voxels[p], nframes, profile.out + suffix);
+      continue;
+    }
+    votca::tools::HistogramNew &dist = density.dists[p];
+    if (profile.axisname == "r") {
+      dist.data().y() =
+          profile.scale /
+          (double(nframes) * profile.rmax / (double)profile.nbin * 4 *
+           votca::tools::conv::Pi) *
+          dist.data().y().cwiseQuotient(dist.data().x().cwiseAbs2());
 
-  } else {
-    dist_.data().y() = scale_ /
-                       ((double)nframes * area_ * rmax_ / (double)nbin_) *
-                       dist_.data().y();
+    } else {
+      dist.data().y() = profile.scale /
+                        ((double)nframes * profile.area * profile.rmax /
+                         (double)profile.nbin) *
+                        dist.data().y();
+    }
+    dist.data().Save(profile.out + suffix);
+  }
+}
+
+// gaussian cube format, lengths in bohr, the origin of the grid is the
+// origin of the box
+void CsgDensityApp::WriteCube(const DensityProfile &profile,
+                              const std::vector<double> &voxels,
+                              votca::Index nframes,
+                              const string &filename) const {
+  std::ofstream out(filename);
+  if (!out.is_open()) {
+    throw std::runtime_error("could not open " + filename + " for writing");
+  }
+  out << "csg_density " << profile.dens_type << " density of "
+      << profile.molname << ":" << profile.filter << "\n";
+  out << "averaged over " << nframes << " frames, units of the input / nm^3\n";
+  out << std::fixed << std::setprecision(6);
+  out << std::setw(5) << 0 << std::setw(12) << 0.0 << std::setw(12) << 0.0
+      << std::setw(12) << 0.0 << "\n";
+  for (votca::Index d = 0; d < 3; d++) {
+    Eigen::Vector3d voxel = profile.box.col(d) / double(profile.ngrid[d]) *
+                            votca::tools::conv::nm2bohr;
+    out << std::setw(5) << profile.ngrid[d] << std::setw(12) << voxel.x()
+        << std::setw(12) << voxel.y() << std::setw(12) << voxel.z() << "\n";
+  }
+  out << std::scientific << std::setprecision(5);
+  double scale = profile.scale / double(nframes);
+  votca::Index nz = profile.ngrid[2];
+  for (std::size_t i = 0; i < voxels.size(); i++) {
+    out << std::setw(13) << scale * voxels[i];
+    if ((votca::Index(i) % nz) % 6 == 5 || votca::Index(i) % nz == nz - 1) {
+      out << "\n";
+    }
   }
-  dist_.data().Save(out_ + suffix);
 }
 
 namespace Eigen {
@@ -226,7 +515,8 @@ std::istream &operator>>(std::istream &in, Vector3d &v) {
 
 void CsgDensityApp::EndEvaluate() {
   if (block_length_ == 0) {
-    WriteDensity(frames_);
+    DensityAccumulator density = accumulators_.Reduce();
+    WriteDensity(density);
   }
 }
 
@@ -240,13 +530,13 @@ void CsgDensityApp::Initialize() {
       "density type: mass or number")(
       "axis",
       boost::program_options::value<string>(&axisname_)->default_value("r"),
-      "[x|y|z|r] density axis (r=spherical)")(
+      "[x|y|z|r|xyz] density axis (r=spherical, xyz=3d cube file)")(
       "step",
       boost::program_options::value<double>(&step_)->default_value(0.01),
-      "spacing of density")("block-length",
-                            boost::program_options::value<votca::Index>(),
-                            "  write blocks of this length, the averages are "
-                            "cleared after every write")(
+      "spacing of density (edge length of the voxels for axis xyz)")(
+      "block-length", boost::program_options::value<votca::Index>(),
+      "  write blocks of this length, the averages are "
+      "cleared after every write")(
       "out", boost::program_options::value<string>(&out_), "Output file")(
       "rmax", boost::program_options::value<double>(),
       "rmax (default for [r] =min of all box vectors/2, else l )")(
@@ -260,5 +550,7 @@ void CsgDensityApp::Initialize() {
       boost::program_options::value<string>(&filter_)->default_value("*"),
       "filter bead names")(
       "ref", boost::program_options::value<Eigen::Vector3d>(&ref_),
-      "reference zero point");
+      "reference zero point")(
+      "profiles", boost::program_options::value<string>(),
+      "xml file with several profiles calculated in one pass");
 }
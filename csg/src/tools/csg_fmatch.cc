@@ -36,11 +36,6 @@
 // Local private includes
 #include "csg_fmatch.h"
 
-int main(int argc, char **argv) {
-  CGForceMatching app;
-  return app.Exec(argc, argv);
-}
-
 void CGForceMatching::Initialize(void) {
   CsgApplication::Initialize();
   AddProgramOptions()("options", boost::program_options::value<string>(),
@@ -195,7 +195,7 @@ class CGForceMatching : public CsgApplication {
   /// interactions to matrix  A_
   void EvalNonbonded_Threebody(Topology *conf, SplineInfo *sinfo);
   /// \brief Write results to output files
-  void WriteOutFiles();
+  virtual void WriteOutFiles();
 
   void OpenForcesTrajectory();
 
@@ -19,6 +19,7 @@
 #include <fstream>
 
 // VOTCA includes
+#include <votca/tools/linalg.h>
 #include <votca/tools/table.h>
 
 // Local VOTCA includes
@@ -77,7 +78,7 @@ void CG_IMC_solve::Run() {
   // We could add and invert but for stability reasons we will diagonalize the
   // matrix which is symmetric by construction
 
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(ATA);
+  votca::tools::EigenSystem es = votca::tools::linalg_eigenvalues(ATA);
 
   Eigen::VectorXd inv_diag = Eigen::VectorXd::Zero(es.eigenvalues().size());
   double etol = 1e-12;
@@ -0,0 +1,21 @@
+0 -nan i
+0.107621 0 i
+0.215242 0 i
+0.322863 1.862026532 i
+0.430484 0 i
+0.538105 2.010988654 i
+0.645726 2.327533165 i
+0.753347 1.368019493 i
+0.860968 1.047389924 i
+0.968589 0.8275673474 i
+1.07621 2.34615343 i
+1.183831 1.384978412 i
+1.291452 0.9310132658 i
+1.399073 0.9916117624 i
+1.506694 1.026014619 i
+1.614315 1.564102287 i
+1.721936 1.374699275 i
+1.829557 1.217726694 i
+1.937178 1.241351021 i
+2.044799 1.439073137 i
+2.15242 1.256867909 i
@@ -80,8 +80,12 @@ class AkimaSpline : public Spline {
 
   // Calculate the function derivative
   double CalculateDerivative(double r) override;
-  using Spline::Calculate;
-  using Spline::CalculateDerivative;
+
+  // Calculate the function values for a whole array of points
+  Eigen::VectorXd Calculate(const Eigen::VectorXd &r) override;
+
+  // Calculate the function derivatives for a whole array of points
+  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &r) override;
 
  protected:
   // p1,p2,p3,p4 and t1,t2 (same identifiers as in Akima paper, page 591)
@@ -149,6 +149,8 @@ class Application {
   boost::program_options::variables_map op_vm_;
   /// get input parameters from file, location may be specified in command line
   void ParseCommandLine(int argc, char **argv);
+  /// writes the Profiler report requested with --profile
+  void WriteProfile(const std::string &filename) const;
 
   /// program options without the Hidden group
   boost::program_options::options_description visible_options_;
@@ -29,6 +29,8 @@ class Average {
  public:
   void Process(const T &value);
   void Clear();
+  /// adds the values processed by another average
+  void Merge(const Average<T> &other);
   template <typename iterator_type>
   void ProcessRange(const iterator_type &begin, const iterator_type &end);
 
@@ -58,6 +60,18 @@ inline void Average<T>::Clear() {
   m2_ = 0;
 }
 
+template <typename T>
+inline void Average<T>::Merge(const Average<T> &other) {
+  if (other.n_ == 0) {
+    return;
+  }
+  size_t n = n_ + other.n_;
+  av_ = av_ * ((double)n_ / (double)n) +
+        other.av_ * ((double)other.n_ / (double)n);
+  n_ = n;
+  m2_ += other.m2_;
+}
+
 template <typename T>
 template <typename iterator_type>
 void Average<T>::ProcessRange(const iterator_type &begin,
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_BLOCKAVERAGE_H
+#define VOTCA_TOOLS_BLOCKAVERAGE_H
+
+// Standard includes
+#include <vector>
+
+// Local VOTCA includes
+#include "runningaverage.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief error of the mean of a correlated time series by block averaging
+ *
+ * The blocking transformation of Flyvbjerg and Petersen, J. Chem. Phys. 91,
+ * 461 (1989): on level 0 every value is a block, each level halves the number
+ * of blocks by averaging pairs of neighbouring blocks of the level below.
+ * The naive error of the mean grows with the level until the blocks are
+ * longer than the correlation time. Only a RunningAverage of the block means
+ * of each level is stored, so the memory grows with log2 of the series
+ * length.
+ *
+ * Merge approximates appending another series, e.g. the frames processed by
+ * another thread. Blocks do not span the boundary between both series, only
+ * the two incomplete trailing blocks of a level are paired. The result is
+ * exact only if the length of the first series is a multiple of the block
+ * length of every level, otherwise the blocks of the higher levels differ
+ * from those of the concatenated series.
+ */
+class BlockAverage {
+ public:
+  /// process the next value of the series
+  void Process(double value);
+
+  /// approximately appends the series processed by another block average
+  void Merge(const BlockAverage &other);
+
+  void Clear() { levels_.clear(); }
+
+  /// number of processed values
+  Index getN() const { return levels_.empty() ? 0 : levels_[0].blocks.getN(); }
+  double getAvg() const;
+
+  /// number of blocking levels
+  Index getLevels() const { return Index(levels_.size()); }
+  /// number of blocks on a level
+  Index getBlocks(Index level) const { return levels_[level].blocks.getN(); }
+  /// naive error of the mean on a level
+  double getLevelError(Index level) const;
+
+  /**
+   * \brief error of the mean, the largest error of all levels with at least
+   * min_blocks blocks
+   *
+   * For a series that is long compared to the correlation time the error
+   * reaches a plateau, which is this estimate.
+   */
+  double getError(Index min_blocks = 16) const;
+
+ private:
+  struct Level {
+    /// mean and variance of the block means
+    RunningAverage blocks;
+    /// first block of an incomplete pair
+    bool has_pending = false;
+    double pending = 0.0;
+  };
+
+  /// adds a block to a level and passes completed pairs up
+  void AddBlock(Index level, double block);
+
+  std::vector<Level> levels_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_BLOCKAVERAGE_H
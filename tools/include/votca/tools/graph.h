@@ -21,6 +21,7 @@
 #define VOTCA_TOOLS_GRAPH_H
 
 // Standard includes
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -47,16 +48,21 @@ class Graph {
   std::unordered_map<Index, GraphNode> nodes_;
 
   /// This is the id of the graph to graphs that contain the same content
-  /// are considered equal
-  std::string id_;
+  /// are considered equal, it is only recalculated when it is requested.
+  /// The mutex guards the cache, so const graphs can be shared by threads.
+  mutable std::string id_;
+  mutable bool id_up_to_date_ = true;
+  mutable std::mutex id_mutex_;
 
  protected:
-  /// Calculate the id of the graph
-  void calcId_();
+  /// Mark the id of the graph as outdated, it is recalculated on demand
+  void invalidateId_() { id_up_to_date_ = false; }
 
  public:
   Graph() : id_(""){};
   virtual ~Graph() = default;
+  Graph(const Graph& graph);
+  Graph& operator=(const Graph& graph);
   /// Constructor
   /// @param edges - vector of edges where each edge is composed of two
   /// s (vertex ids) describing a link between the vertices
@@ -97,7 +103,7 @@ class Graph {
   }
 
   /// Returns the id of graph
-  std::string getId() const { return id_; }
+  std::string getId() const;
 
   /// Returns all the edges in the graph
   virtual std::vector<Edge> getEdges() { return edge_container_.getEdges(); }
@@ -89,7 +89,7 @@ class GraphVisitor {
   /// The next edge to be explored, note that when this function
   /// is called it removes the edge from the visitors queue and will
   /// no longer be accessible with a second call to nextEdge
-  Edge nextEdge(Graph graph);
+  Edge nextEdge(const Graph& graph);
 
   /// Get the set of all the vertices that have been explored
   std::set<Index> getExploredVertices() const;
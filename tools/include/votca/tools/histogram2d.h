@@ -0,0 +1,126 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_HISTOGRAM2D_H
+#define VOTCA_TOOLS_HISTOGRAM2D_H
+
+// Local VOTCA includes
+#include "eigen.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ *  \brief bin centered histogram of pairs of values
+ *
+ *  Each axis is binned like HistogramNew: the bins are centered at min and
+ *  max of the axis, or, for a periodic axis, max is the periodic image of
+ *  min and the values wrap around.
+ *
+ *      Histogram2D hist;
+ *      hist.Initialize(0.0, 1.0, 11, -180.0, 180.0, 36);
+ *      hist.setPeriodic(false, true);
+ *      hist.Process(0.5, 170.0);
+ */
+class Histogram2D {
+ public:
+  /**
+   * \brief Initialize the histogram, a periodic axis has to be set before
+   * @param xmin center of the first bin along x
+   * @param xmax center of the last bin along x
+   * @param nx number of bins along x
+   * @param ymin center of the first bin along y
+   * @param ymax center of the last bin along y
+   * @param ny number of bins along y
+   */
+  void Initialize(double xmin, double xmax, Index nx, double ymin, double ymax,
+                  Index ny);
+
+  /**
+   * \brief set whether the axes are periodic
+   */
+  void setPeriodic(bool periodic_x, bool periodic_y) {
+    x_.periodic = periodic_x;
+    y_.periodic = periodic_y;
+  }
+
+  /**
+   * \brief process a data point
+   * \param x value along x
+   * \param y value along y
+   * \param scale weight of the point, values outside a non periodic axis
+   * are ignored
+   */
+  void Process(double x, double y, double scale = 1.0);
+
+  /**
+   * \brief adds the counts of another histogram with the same bins
+   */
+  void Merge(const Histogram2D &other);
+
+  /**
+   * \brief normalize the histogram that the integral is 1
+   */
+  void Normalize();
+
+  /**
+   * \brief clear all data
+   */
+  void Clear() { data_.setZero(); }
+
+  Index getNBinsX() const { return x_.nbins; }
+  Index getNBinsY() const { return y_.nbins; }
+  double getStepX() const { return x_.step; }
+  double getStepY() const { return y_.step; }
+
+  /// center of bin i along x
+  double getX(Index i) const { return x_.min + double(i) * x_.step; }
+  /// center of bin j along y
+  double getY(Index j) const { return y_.min + double(j) * y_.step; }
+
+  /**
+   * \brief get access to content of histogram
+   * \return matrix with the bins along x in the rows and along y in the
+   * columns
+   */
+  Eigen::MatrixXd &data() { return data_; }
+  const Eigen::MatrixXd &data() const { return data_; }
+
+ private:
+  struct Axis {
+    double min = 0;
+    double max = 0;
+    double step = 0;
+    bool periodic = false;
+    Index nbins = 0;
+
+    void Initialize(double min_value, double max_value, Index number_bins);
+    /// bin of v, -1 if it is outside a non periodic axis
+    Index Bin(double v) const;
+    bool operator==(const Axis &other) const;
+  };
+
+  Axis x_;
+  Axis y_;
+  Eigen::MatrixXd data_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_HISTOGRAM2D_H
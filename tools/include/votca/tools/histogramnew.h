@@ -150,6 +150,14 @@ class HistogramNew {
    */
   void Clear();
 
+  /**
+   * \brief adds the counts of another histogram with the same bins
+   *
+   * Threads can fill their own copy of a histogram and merge them once at
+   * the end, e.g. with PerThread.
+   */
+  void Merge(const HistogramNew &other);
+
   /**
    * \brief get access to content of histogram
    * \return table object with bins in x and values in y
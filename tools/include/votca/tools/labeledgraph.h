@@ -0,0 +1,99 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_LABELEDGRAPH_H
+#define VOTCA_TOOLS_LABELEDGRAPH_H
+
+// Standard includes
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Local VOTCA includes
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+class Graph;
+
+/**
+ * \brief Compact graph with integer vertex labels used to compare topologies
+ *
+ * The vertices are numbered 0 ... N-1 and the adjacency is stored in
+ * compressed sparse row form. On construction the vertex labels are refined
+ * Weisfeiler-Lehman style, every vertex gets a new label hashed from its own
+ * label and the sorted labels of its neighbours, until the number of distinct
+ * labels stops growing. The hash of the graph is built from the sorted
+ * refined labels and does not depend on the numbering of the vertices, so
+ * equivalent graphs always have the same hash. Different graphs can collide,
+ * isIsomorphic resolves this by searching for a vertex mapping that respects
+ * the refined labels and the edges.
+ *
+ * E.g. the chain A - B - A has the same hash however its vertices are
+ * numbered, whereas the chain A - A - B has a different one.
+ */
+class LabeledGraph {
+ public:
+  LabeledGraph() = default;
+
+  /// Constructor
+  /// @param labels - label of each vertex, the vertex index is the position
+  /// @param edges - pairs of vertex indices that are connected
+  LabeledGraph(std::vector<std::uint64_t> labels,
+               const std::vector<std::pair<Index, Index>>& edges);
+
+  /// Builds the labelled graph from a graph, the vertices are numbered in
+  /// ascending order of their ids and labelled by the string ids of the nodes
+  explicit LabeledGraph(const Graph& graph);
+
+  Index VertexCount() const noexcept { return Index(labels_.size()); }
+  Index EdgeCount() const noexcept { return Index(neighbors_.size()) / 2; }
+
+  /// Hash that is identical for all graphs with the same topology and labels
+  std::uint64_t getHash() const noexcept { return hash_; }
+
+  /// Returns the vertices directly connected to `vertex` in ascending order
+  std::vector<Index> getNeighVertices(Index vertex) const;
+
+  /// Determines if the two vertices are connected by an edge
+  bool edgeExist(Index vertex1, Index vertex2) const;
+
+  /// Determines if a vertex mapping exists that maps the labels and edges of
+  /// this graph onto those of `graph`
+  bool isIsomorphic(const LabeledGraph& graph) const;
+
+  /// Hash of a string that is stable between runs, usable as vertex label
+  static std::uint64_t hashLabel(const std::string& label);
+
+ private:
+  void refineLabels_();
+
+  std::vector<std::uint64_t> labels_;
+  /// labels after the refinement
+  std::vector<std::uint64_t> colors_;
+  std::vector<Index> offsets_{0};
+  std::vector<Index> neighbors_;
+  std::uint64_t hash_ = 0;
+};
+
+}  // namespace tools
+}  // namespace votca
+#endif  // VOTCA_TOOLS_LABELEDGRAPH_H
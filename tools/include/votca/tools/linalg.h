@@ -39,6 +39,46 @@ Eigen::VectorXd linalg_constrained_qrsolve(const Eigen::MatrixXd& A,
                                            const Eigen::VectorXd& b,
                                            const Eigen::MatrixXd& constr);
 
+/**
+ * \brief solves A*x=b for a tridiagonal matrix A
+ * @return x, one column per column of b
+ * @param lower subdiagonal, lower(i)=A(i+1,i)
+ * @param diag diagonal of A
+ * @param upper superdiagonal, upper(i)=A(i,i+1)
+ * @param b inhomogenity, one system per column
+ *
+ * This function implements the Thomas algorithm, which does not pivot, so A
+ * should be diagonally dominant. Throws if a pivot vanishes.
+ */
+Eigen::MatrixXd linalg_tridiagonal_solve(const Eigen::VectorXd& lower,
+                                         const Eigen::VectorXd& diag,
+                                         const Eigen::VectorXd& upper,
+                                         const Eigen::MatrixXd& b);
+
+/**
+ * \brief eigenvalues and eigenvectors of a symmetric matrix
+ * @return eigenvalues in ascending order and eigenvectors as columns, info
+ * is not Eigen::Success if the solver failed
+ * @param A symmetric matrix, only the lower triangle is used
+ *
+ * If VOTCA was configured with the LAPACK eigensolver (EIGENSOLVER option),
+ * the divide and conquer solver dsyevd is used, which runs on the threads
+ * of the BLAS library. Otherwise Eigen's SelfAdjointEigenSolver is used.
+ */
+EigenSystem linalg_eigenvalues(const Eigen::MatrixXd& A);
+
+/**
+ * \brief lowest eigenvalues and eigenvectors of a symmetric matrix
+ * @return the nmax lowest eigenvalues in ascending order and their
+ * eigenvectors
+ * @param A symmetric matrix, only the lower triangle is used
+ * @param nmax number of eigenpairs
+ *
+ * With LAPACK the MRRR solver dsyevr only computes the requested eigenpairs,
+ * Eigen's SelfAdjointEigenSolver computes all of them.
+ */
+EigenSystem linalg_eigenvalues(const Eigen::MatrixXd& A, Index nmax);
+
 }  // namespace tools
 }  // namespace votca
 
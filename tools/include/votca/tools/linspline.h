@@ -55,8 +55,12 @@ class LinSpline : public Spline {
 
   // Calculate the function derivative
   double CalculateDerivative(double r) override;
-  using Spline::Calculate;
-  using Spline::CalculateDerivative;
+
+  // Calculate the function values for a whole array of points
+  Eigen::VectorXd Calculate(const Eigen::VectorXd &r) override;
+
+  // Calculate the function derivatives for a whole array of points
+  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &r) override;
 
  protected:
   // a,b for piecewise splines: ax+b
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_NUMBERPARSER_H
+#define VOTCA_TOOLS_NUMBERPARSER_H
+
+// Standard includes
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief returns the next line of text and advances text behind it
+ *
+ * Works on a view of an in-memory buffer, so no copy of the line is made.
+ * Windows end-of-line characters are removed like in tools::getline.
+ */
+inline std::string_view NextLine(std::string_view &text) {
+  std::size_t end = text.find('\n');
+  std::string_view line = text.substr(0, end);
+  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  return line;
+}
+
+/**
+ * \brief returns the next word separated by spaces or tabs and advances text
+ * behind it, returns an empty view if there is no word left
+ */
+inline std::string_view NextWord(std::string_view &text) {
+  std::size_t start = text.find_first_not_of(" \t\r\n");
+  if (start == std::string_view::npos) {
+    text = std::string_view();
+    return text;
+  }
+  text.remove_prefix(start);
+  std::size_t end = text.find_first_of(" \t\r\n");
+  std::string_view word = text.substr(0, end);
+  text.remove_prefix(word.size());
+  return word;
+}
+
+/**
+ * \brief converts a word into a number
+ *
+ * Uses std::from_chars, which neither allocates nor depends on the locale and
+ * is much faster than boost::lexical_cast or stringstreams. The whole word has
+ * to be a valid number, otherwise a std::runtime_error is thrown.
+ */
+template <typename T>
+inline T ParseNumber(std::string_view word) {
+  static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                "ParseNumber only works for numbers");
+  // from_chars does not accept a leading '+'
+  std::string_view number = word;
+  if (!number.empty() && number.front() == '+') {
+    number.remove_prefix(1);
+  }
+  T result = T(0);
+  bool failed = number.empty();
+#if !defined(__cpp_lib_to_chars)
+  // older standard libraries only implement std::from_chars for integers
+  if constexpr (std::is_floating_point<T>::value) {
+    std::string copy(number);
+    char *last = nullptr;
+    result = T(std::strtod(copy.c_str(), &last));
+    failed = failed || (last != copy.c_str() + copy.size());
+  } else
+#endif
+  {
+    const char *end = number.data() + number.size();
+    auto [ptr, ec] = std::from_chars(number.data(), end, result);
+    failed = failed || (ec != std::errc() || ptr != end);
+  }
+  if (failed) {
+    throw std::runtime_error("invalid type: Cannot convert '" +
+                             std::string(word) + "' to a number");
+  }
+  return result;
+}
+
+/**
+ * \brief reads the next word from text and converts it into a number
+ */
+template <typename T>
+inline T ParseNextNumber(std::string_view &text) {
+  return ParseNumber<T>(NextWord(text));
+}
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_NUMBERPARSER_H
@@ -59,6 +59,9 @@ class OptionsHandler {
 
   /**
    * \brief Loads default options stored in defaults_path_
+   *
+   * The parsed defaults with resolved links are cached for the whole program
+   * run, so repeated calls only copy the cached tree.
    */
   Property LoadDefaults(const std::string &calculatorname) const;
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_PERTHREAD_H
+#define VOTCA_TOOLS_PERTHREAD_H
+
+// Standard includes
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+// Local VOTCA includes
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief one accumulator per thread, reduced once at the end
+ *
+ * Every thread updates its own copy without locking, e.g. the copy of
+ * omp_get_thread_num(). The copies are aligned to cache lines, so small
+ * accumulators like RunningAverage of neighbouring threads do not share a
+ * cache line. T has to provide Merge(const T &), like HistogramNew,
+ * Histogram2D, RunningAverage, BlockAverage and Average.
+ *
+ *     PerThread<RunningAverage> avg(OPENMP::getMaxThreads());
+ *     #pragma omp parallel for
+ *     for (Index i = 0; i < n; i++) {
+ *       avg[OPENMP::getThreadId()].Process(values[i]);
+ *     }
+ *     RunningAverage total = avg.Reduce();
+ */
+template <typename T>
+class PerThread {
+ public:
+  /// size of a cache line in bytes
+  static constexpr std::size_t CacheLineSize = 64;
+
+  PerThread() = default;
+  /**
+   * \param nthreads number of threads
+   * \param initial accumulator every thread starts with, e.g. an
+   * initialized histogram
+   */
+  explicit PerThread(Index nthreads, const T &initial = T())
+      : slots_(nthreads, Slot{initial}) {}
+
+  Index size() const { return Index(slots_.size()); }
+
+  T &operator[](Index thread) { return slots_[thread].value; }
+  const T &operator[](Index thread) const { return slots_[thread].value; }
+
+  /// merges the accumulators of all threads in the order of the threads
+  T Reduce() const {
+    if (slots_.empty()) {
+      throw std::runtime_error("PerThread::Reduce: there are no threads");
+    }
+    T result = slots_[0].value;
+    for (Index i = 1; i < size(); i++) {
+      result.Merge(slots_[i].value);
+    }
+    return result;
+  }
+
+ private:
+  struct alignas(CacheLineSize) Slot {
+    T value;
+  };
+
+  std::vector<Slot> slots_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_PERTHREAD_H
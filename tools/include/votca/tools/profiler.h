@@ -0,0 +1,120 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_PROFILER_H
+#define VOTCA_TOOLS_PROFILER_H
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+// Local VOTCA includes
+#include "property.h"
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief Collects the timings of the code regions marked by ScopedTimer
+ *
+ * Every thread records its own tree of regions, a region is identified by
+ * its name and the regions it is nested in. For each region the number of
+ * calls, the total time, the self time, i.e. the total time without the
+ * nested regions, and the processed bytes are kept. Profiling is switched
+ * off by default, then a ScopedTimer only costs a relaxed atomic load.
+ */
+class Profiler {
+ public:
+  enum Format { TEXT, JSON };
+
+  static void Enable(bool enable = true) {
+    enabled_.store(enable, std::memory_order_relaxed);
+  }
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /// sets the counters of all threads to zero
+  static void Reset();
+
+  /// regions of all threads merged by name and nesting, as <profile> with
+  /// nested <region> elements that carry the counters as attributes
+  static Property Report();
+
+  /// regions the calling thread finished since its last call, e.g. during a
+  /// single job. These regions are still part of Report.
+  static Property TakeThreadReport();
+
+  static void WriteReport(std::ostream &out, const Property &report,
+                          Format format);
+
+  /// the recorded data, defined in profiler.cc
+  struct Region;
+  struct ThreadData;
+
+ private:
+  friend class ScopedTimer;
+
+  static ThreadData &LocalThreadData();
+
+  static std::atomic<bool> enabled_;
+};
+
+/**
+ * \brief Times the enclosing scope as region `name` of the Profiler
+ *
+ * The name is copied when a thread enters the region the first time. Timers
+ * have to be stopped in the reverse order they were started, on the thread
+ * that started them.
+ */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const char *name, Index bytes = 0) {
+    if (Profiler::isEnabled()) {
+      Start(name, bytes);
+    }
+  }
+  ~ScopedTimer() { Stop(); }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  /// adds to the bytes processed in the region
+  void AddBytes(Index bytes);
+
+  /// ends the region before the end of the scope
+  void Stop() {
+    if (region_) {
+      Finish();
+    }
+  }
+
+ private:
+  void Start(const char *name, Index bytes);
+  void Finish();
+
+  Profiler::ThreadData *thread_ = nullptr;
+  Profiler::Region *region_ = nullptr;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_PROFILER_H
@@ -26,6 +26,8 @@
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Third party includes
 #include <boost/algorithm/string/trim.hpp>
@@ -41,6 +43,33 @@
 namespace votca {
 namespace tools {
 
+/**
+ * \brief key of a property split into its parts once
+ *
+ * Property::get, exists and Select have to split string keys at "." on every
+ * call. A PropertyPath is split on construction and can be reused for
+ * lookups in many property trees, e.g.
+ *
+ * static const PropertyPath tasks_path("options.eqm.tasks");
+ * for (const Property &job : jobs) { job.get(tasks_path); }
+ */
+class PropertyPath {
+ public:
+  explicit PropertyPath(const std::string &key);
+
+  /// the key the path was created from
+  const std::string &str() const { return key_; }
+  /// the names of the properties along the path
+  const std::vector<std::string> &names() const { return names_; }
+  /// whether a name contains the wildcards "*" or "?" used by Select
+  bool hasWildcards() const { return has_wildcards_; }
+
+ private:
+  std::string key_;
+  std::vector<std::string> names_;
+  bool has_wildcards_ = false;
+};
+
 /**
  * \brief class to manage program options with xml serialization functionality
  *
@@ -111,6 +140,8 @@ class Property {
    */
   Property &get(const std::string &key);
   const Property &get(const std::string &key) const;
+  Property &get(const PropertyPath &path);
+  const Property &get(const PropertyPath &path) const;
 
   /**
    * \brief adds new or gets existing property
@@ -130,6 +161,7 @@ class Property {
    * @return true or false
    */
   bool exists(const std::string &key) const;
+  bool exists(const PropertyPath &path) const;
 
   template <typename T>
   T ifExistsReturnElseReturnDefault(const std::string &key,
@@ -145,6 +177,8 @@ class Property {
    */
   std::vector<Property *> Select(const std::string &filter);
   std::vector<const Property *> Select(const std::string &filter) const;
+  std::vector<Property *> Select(const PropertyPath &filter);
+  std::vector<const Property *> Select(const PropertyPath &filter) const;
 
   /**
    * \brief reference to value of property
@@ -265,10 +299,26 @@ class Property {
 
   void LoadFromXML(std::string filename);
 
+  /**
+   * \brief adds the xml elements in the string as children of the property
+   *
+   * The string has to hold a single root element, e.g. a part of a larger
+   * xml file.
+   */
+  void LoadFromXMLString(const std::string &xml);
+
   static Index getIOindex() { return IOindex; };
 
  private:
-  std::map<std::string, std::vector<Index>> map_;
+  /// Returns the property at key or nullptr if it does not exist
+  const Property *find_(std::string_view key) const;
+  const Property *find_(const PropertyPath &path) const;
+  template <class PropertyPtr>
+  static std::vector<PropertyPtr> Select_(PropertyPtr root,
+                                          const PropertyPath &filter);
+
+  // std::less<> allows to look up children by std::string_view
+  std::map<std::string, std::vector<Index>, std::less<>> map_;
   std::map<std::string, std::string> attributes_;
   std::vector<Property> properties_;
 
@@ -320,21 +370,20 @@ inline void Property::setAttribute(const std::string &attribute,
 template <typename T>
 inline T Property::ifExistsReturnElseReturnDefault(const std::string &key,
                                                    T defaultvalue) const {
-  T result;
-  if (this->exists(key)) {
-    result = this->get(key).as<T>();
-  } else {
-    result = defaultvalue;
+  const Property *p = find_(key);
+  if (p) {
+    return p->as<T>();
   }
-  return result;
+  return defaultvalue;
 }
 
 template <>
 inline std::string Property::ifExistsReturnElseReturnDefault(
     const std::string &key, std::string defaultvalue) const {
   std::string result;
-  if (this->exists(key)) {
-    result = this->get(key).as<std::string>();
+  const Property *p = find_(key);
+  if (p) {
+    result = p->as<std::string>();
     if (result.empty()) {
       result = defaultvalue;
     }
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_RUNNINGAVERAGE_H
+#define VOTCA_TOOLS_RUNNINGAVERAGE_H
+
+// Local VOTCA includes
+#include "types.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief weighted mean and variance of a series of values
+ *
+ * The values are accumulated with Welford's update, which, unlike summing
+ * up the squares, does not lose precision if the variance is small compared
+ * to the mean. Two averages are combined exactly with Merge, so threads can
+ * process values independently and are reduced once at the end.
+ */
+class RunningAverage {
+ public:
+  /**
+   * \brief process a value
+   * \param value value to add
+   * \param weight weight of the value
+   */
+  void Process(double value, double weight = 1.0);
+
+  /// adds the values processed by another average
+  void Merge(const RunningAverage &other);
+
+  void Clear();
+
+  /// number of processed values
+  Index getN() const { return n_; }
+  /// sum of the weights
+  double getWeight() const { return weight_; }
+  double getAvg() const { return avg_; }
+
+  /// weighted variance of the values, sum_i w_i (x_i - avg)^2 / sum_i w_i
+  double getVariance() const;
+  /// square root of the variance
+  double getSig() const;
+  /// standard error of the mean for uncorrelated values
+  double getErr() const;
+
+ private:
+  Index n_ = 0;
+  double weight_ = 0.0;
+  double avg_ = 0.0;
+  /// sum of the weighted squared deviations from the mean
+  double m2_ = 0.0;
+};
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_RUNNINGAVERAGE_H
@@ -113,7 +113,7 @@ class Spline {
    * \param x vector of data values
    * \return vector of y value
    */
-  Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd Calculate(const Eigen::VectorXd &x);
 
   /**
    * \brief Calculate y values for given x values on the derivative of the
@@ -121,7 +121,7 @@ class Spline {
    * \param x vector of data values
    * \return vector of y value
    */
-  Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
+  virtual Eigen::VectorXd CalculateDerivative(const Eigen::VectorXd &x);
 
   /**
    * \brief Print spline values (using Calculate()) on output "out" on the
@@ -135,6 +135,9 @@ class Spline {
    * \brief Determine the index of the interval containing value r
    * \param r
    * \return interval index
+   *
+   * On equidistant grids the index is computed directly, otherwise it is
+   * found by bisection.
    */
   Index getInterval(double r);
 
@@ -150,8 +153,14 @@ class Spline {
   /**
    * \brief Get the grid array x
    * \return pointer to the corresponding array
+   *
+   * The grid is analysed again on the next getInterval() call, so do not keep
+   * the reference around to modify the grid later.
    */
-  Eigen::VectorXd &getX() { return r_; }
+  Eigen::VectorXd &getX() {
+    grid_size_ = -1;
+    return r_;
+  }
   const Eigen::VectorXd &getX() const { return r_; }
   /**
    * \brief Get the spline data  f_
@@ -168,9 +177,24 @@ class Spline {
   // const Eigen::VectorXd &getSplineF2() const { return  f_; }
 
  protected:
+  // sets the grid points, use this instead of assigning r_ directly
+  void setGrid(const Eigen::VectorXd &x) {
+    r_ = x;
+    AnalyzeGrid();
+  }
+
   eBoundary boundaries_ = eBoundary::splineNormal;
   // the grid points
   Eigen::VectorXd r_;
+
+ private:
+  // checks if r_ is equidistant, so getInterval can skip the search
+  void AnalyzeGrid();
+
+  // size of r_ when it was analysed, -1 if it has to be analysed again
+  Index grid_size_ = -1;
+  bool uniform_ = false;
+  double inv_h_ = 0.0;
 };
 
 }  // namespace tools
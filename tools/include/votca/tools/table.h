@@ -103,6 +103,7 @@ class Table {
 
   Eigen::VectorXd &x() { return x_; }
   Eigen::VectorXd &y() { return y_; }
+  const Eigen::VectorXd &y() const { return y_; }
   std::vector<char> &flags() { return flags_; }
   Eigen::VectorXd &yerr() { return yerr_; }
 
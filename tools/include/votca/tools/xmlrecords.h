@@ -0,0 +1,66 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef VOTCA_TOOLS_XMLRECORDS_H
+#define VOTCA_TOOLS_XMLRECORDS_H
+
+// Standard includes
+#include <functional>
+#include <ios>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Local VOTCA includes
+#include "property.h"
+
+namespace votca {
+namespace tools {
+
+/**
+ * \brief A record read by ReadXMLRecords
+ *
+ * element holds the xml element of the record with all its children apart
+ * from the skipped ones. For those only the byte range [begin, end) of the
+ * child element in the file is stored, by name.
+ */
+struct XMLRecord {
+  Property element;
+  std::map<std::string, std::pair<std::streamoff, std::streamoff>> skipped;
+};
+
+/**
+ * \brief Streams the records of a large xml file one at a time
+ *
+ * Every element at `record_path`, e.g. "jobs.job", is passed to `callback`
+ * as soon as its end tag is parsed, so only a single record is held in
+ * memory. Children of a record with a name in `skip` are not parsed at all,
+ * the stored byte range allows to read them later with
+ * Property::LoadFromXMLString.
+ */
+void ReadXMLRecords(const std::string &filename,
+                    const std::string &record_path,
+                    const std::vector<std::string> &skip,
+                    const std::function<void(XMLRecord &)> &callback);
+
+}  // namespace tools
+}  // namespace votca
+
+#endif  // VOTCA_TOOLS_XMLRECORDS_H
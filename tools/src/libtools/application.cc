@@ -16,6 +16,7 @@
  */
 
 // Standard includes
+#include <fstream>
 #include <iostream>
 
 // Third party includes
@@ -24,6 +25,7 @@
 // Local VOTCA includes
 #include "votca/tools/application.h"
 #include "votca/tools/globals.h"
+#include "votca/tools/profiler.h"
 #include "votca/tools/propertyiomanipulator.h"
 #include "votca/tools/version.h"
 
@@ -61,6 +63,10 @@ int Application::Exec(int argc, char **argv) {
     AddProgramOptions()("verbose", "  be loud and noisy");
     AddProgramOptions()("verbose1", "  be very loud and noisy");
     AddProgramOptions()("verbose2,v", "  be extremly loud and noisy");
+    AddProgramOptions()(
+        "profile", boost::program_options::value<std::string>(),
+        "  write the time spent in the instrumented regions to this file, "
+        "as json if the name ends with .json");
 
     Initialize();  // initialize program-specific parameters
 
@@ -89,11 +95,20 @@ int Application::Exec(int argc, char **argv) {
       return -1;
     }
 
+    if (op_vm_.count("profile")) {
+      Profiler::Enable();
+    }
+
     if (continue_execution_) {
+      ScopedTimer timer(ProgramName().c_str());
       Run();
     } else {
       cout << "Done - stopping here\n";
     }
+
+    if (op_vm_.count("profile")) {
+      WriteProfile(op_vm_["profile"].as<std::string>());
+    }
   } catch (std::exception &error) {
     cerr << "an error occurred:\n" << error.what() << endl;
     return -1;
@@ -145,6 +160,17 @@ void Application::ParseCommandLine(int argc, char **argv) {
   }
 }
 
+void Application::WriteProfile(const string &filename) const {
+  std::ofstream ofs(filename);
+  if (!ofs.is_open()) {
+    throw runtime_error("Could not open profile file " + filename);
+  }
+  bool json = filename.size() >= 5 &&
+              filename.compare(filename.size() - 5, 5, ".json") == 0;
+  Profiler::WriteReport(ofs, Profiler::Report(),
+                        json ? Profiler::JSON : Profiler::TEXT);
+}
+
 void Application::CheckRequired(const string &option_name,
                                 const string &error_msg) {
   if (!op_vm_.count(option_name)) {
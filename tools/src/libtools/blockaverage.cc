@@ -0,0 +1,91 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+
+// Local VOTCA includes
+#include "votca/tools/blockaverage.h"
+
+namespace votca {
+namespace tools {
+
+void BlockAverage::AddBlock(Index level, double block) {
+  while (true) {
+    if (level == Index(levels_.size())) {
+      levels_.emplace_back();
+    }
+    Level &l = levels_[level];
+    l.blocks.Process(block);
+    if (!l.has_pending) {
+      l.pending = block;
+      l.has_pending = true;
+      return;
+    }
+    block = 0.5 * (l.pending + block);
+    l.has_pending = false;
+    level++;
+  }
+}
+
+void BlockAverage::Process(double value) { AddBlock(0, value); }
+
+void BlockAverage::Merge(const BlockAverage &other) {
+  for (Index level = 0; level < other.getLevels(); level++) {
+    if (level == getLevels()) {
+      levels_.emplace_back();
+    }
+    const Level &from = other.levels_[level];
+    Level &into = levels_[level];
+    into.blocks.Merge(from.blocks);
+    if (!from.has_pending) {
+      continue;
+    }
+    if (into.has_pending) {
+      into.has_pending = false;
+      AddBlock(level + 1, 0.5 * (into.pending + from.pending));
+    } else {
+      into.pending = from.pending;
+      into.has_pending = true;
+    }
+  }
+}
+
+double BlockAverage::getAvg() const {
+  if (levels_.empty()) {
+    return 0.0;
+  }
+  return levels_[0].blocks.getAvg();
+}
+
+double BlockAverage::getLevelError(Index level) const {
+  return levels_[level].blocks.getErr();
+}
+
+double BlockAverage::getError(Index min_blocks) const {
+  double error = 0.0;
+  for (Index level = 0; level < getLevels(); level++) {
+    if (level > 0 && getBlocks(level) < min_blocks) {
+      break;
+    }
+    error = std::max(error, getLevelError(level));
+  }
+  return error;
+}
+
+}  // namespace tools
+}  // namespace votca
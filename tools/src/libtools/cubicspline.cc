@@ -16,8 +16,10 @@
  */
 
 // Standard includes
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 // Local VOTCA includes
 #include "votca/tools/cubicspline.h"
@@ -45,42 +47,61 @@ void CubicSpline::Interpolate(const Eigen::VectorXd &x,
   const Index N = x.size();
 
   // copy the grid points into f
-  r_ = x;
+  setGrid(x);
   f_ = y;
   Eigen::VectorXd temp = Eigen::VectorXd::Zero(N);
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, N);
-
+  // the smoothing conditions couple neighbouring points only
+  Eigen::VectorXd lower = Eigen::VectorXd::Zero(N - 1);
+  Eigen::VectorXd diag = Eigen::VectorXd::Zero(N);
+  Eigen::VectorXd upper = Eigen::VectorXd::Zero(N - 1);
   for (Index i = 0; i < N - 2; ++i) {
     temp(i + 1) =
         -(A_prime_l(i) * f_(i) + (B_prime_l(i) - A_prime_r(i)) * f_(i + 1) -
           B_prime_r(i) * f_(i + 2));
 
-    A(i + 1, i) = C_prime_l(i);
-    A(i + 1, i + 1) = D_prime_l(i) - C_prime_r(i);
-    A(i + 1, i + 2) = -D_prime_r(i);
+    lower(i) = C_prime_l(i);
+    diag(i + 1) = D_prime_l(i) - C_prime_r(i);
+    upper(i + 1) = -D_prime_r(i);
   }
 
   switch (boundaries_) {
     case splineNormal:
-      A(0, 0) = 1;
-      A(N - 1, N - 1) = 1;
+      diag(0) = 1;
+      diag(N - 1) = 1;
+      f2_ = linalg_tridiagonal_solve(lower, diag, upper, temp);
       break;
-    case splinePeriodic:
+    case splinePeriodic: {
+      // the corner elements break the band structure
+      Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, N);
+      A.diagonal() = diag;
+      A.diagonal(-1) = lower;
+      A.diagonal(1) = upper;
       A(0, 0) = 1;
       A(0, N - 1) = -1;
       A(N - 1, 0) = 1;
       A(N - 1, N - 1) = -1;
-      break;
+      Eigen::HouseholderQR<Eigen::MatrixXd> QR(A);
+      f2_ = QR.solve(temp);
+    } break;
     case splineDerivativeZero:
       throw std::runtime_error(
           "erro in CubicSpline::Interpolate: case splineDerivativeZero not "
           "implemented yet");
       break;
   }
+}
 
-  Eigen::HouseholderQR<Eigen::MatrixXd> QR(A);
-  f2_ = QR.solve(temp);
+// The smoothing conditions B*(f,f'') = 0 from AddBCToFitMatrix read
+// R*f + M*f'' = 0 with tridiagonal R and M. Unless the boundaries are periodic
+// M is regular, so f'' = -M^-1*R*f.
+Eigen::MatrixXd CubicSpline::SmoothingTransform() {
+  const Index ngrid = r_.size();
+  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(ngrid, 2 * ngrid);
+  AddBCToFitMatrix(B, 0);
+  Eigen::MatrixXd M = B.rightCols(ngrid);
+  return linalg_tridiagonal_solve(M.diagonal(-1), M.diagonal(),
+                                  M.diagonal(1), -B.leftCols(ngrid));
 }
 
 void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
@@ -99,16 +120,47 @@ void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
   // and b[i]=0 for i>=N (for smoothing condition)
   // A[i,j] contains the data fitting + the spline smoothing conditions
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, 2 * ngrid);
-  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(
-      ngrid, 2 * ngrid);  // Matrix with smoothing conditions
-
-  // Construct smoothing matrix
-  AddBCToFitMatrix(B, 0);
-  // construct the matrix to fit the points and the vector b
-  AddToFitMatrix(A, x, 0);
-  // now do a constrained qr solve
-  Eigen::VectorXd sol = linalg_constrained_qrsolve(A, y, B);
+  Eigen::VectorXd sol;
+  if (boundaries_ == splinePeriodic) {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, 2 * ngrid);
+    Eigen::MatrixXd B = Eigen::MatrixXd::Zero(
+        ngrid, 2 * ngrid);  // Matrix with smoothing conditions
+
+    // Construct smoothing matrix
+    AddBCToFitMatrix(B, 0);
+    // construct the matrix to fit the points and the vector b
+    AddToFitMatrix(A, x, 0);
+    // now do a constrained qr solve
+    sol = linalg_constrained_qrsolve(A, y, B);
+  } else {
+    // eliminate f'' with the smoothing conditions, which leaves a least
+    // squares problem for f only
+    Eigen::MatrixXd T = SmoothingTransform();
+    Eigen::MatrixXd G = Eigen::MatrixXd::Zero(N, ngrid);
+    // same check as in linalg_constrained_qrsolve
+    std::vector<bool> has_data(2 * ngrid, false);
+    for (Index i = 0; i < N; ++i) {
+      Index spi = getInterval(x(i));
+      double a = A(x(i), spi);
+      double b = B(x(i), spi);
+      double c = C(x(i), spi);
+      double d = D(x(i), spi);
+      G.row(i) = c * T.row(spi) + d * T.row(spi + 1);
+      G(i, spi) += a;
+      G(i, spi + 1) += b;
+      has_data[spi] = has_data[spi] || a != 0.0;
+      has_data[spi + 1] = has_data[spi + 1] || b != 0.0;
+      has_data[ngrid + spi] = has_data[ngrid + spi] || c != 0.0;
+      has_data[ngrid + spi + 1] = has_data[ngrid + spi + 1] || d != 0.0;
+    }
+    if (std::find(has_data.begin(), has_data.end(), false) != has_data.end()) {
+      throw std::runtime_error("constrained_qrsolve_zero_column_in_matrix");
+    }
+    Eigen::HouseholderQR<Eigen::MatrixXd> QR(G);
+    sol.resize(2 * ngrid);
+    sol.head(ngrid) = QR.solve(y);
+    sol.tail(ngrid) = T * sol.head(ngrid);
+  }
 
 #ifndef __INTEL_LLVM_COMPILER
   /* isnan/isinf is always false in fast floating point modes on intel */
@@ -128,61 +180,101 @@ void CubicSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
 
 double CubicSpline::Calculate(double r) {
   Index interval = getInterval(r);
-  return A(r) * f_[interval] + B(r) * f_[interval + 1] + C(r) * f2_[interval] +
-         D(r) * f2_[interval + 1];
+  return A(r, interval) * f_[interval] + B(r, interval) * f_[interval + 1] +
+         C(r, interval) * f2_[interval] + D(r, interval) * f2_[interval + 1];
 }
 
 double CubicSpline::CalculateDerivative(double r) {
   Index interval = getInterval(r);
-  return Aprime(r) * f_[interval] + Bprime(r) * f_[interval + 1] +
-         Cprime(r) * f2_[interval] + Dprime(r) * f2_[interval + 1];
+  return Aprime(r, interval) * f_[interval] +
+         Bprime(r, interval) * f_[interval + 1] +
+         Cprime(r, interval) * f2_[interval] +
+         Dprime(r, interval) * f2_[interval + 1];
+}
+
+// the intervals are looked up first, the polynomials are then evaluated for
+// all points at once
+Eigen::VectorXd CubicSpline::Calculate(const Eigen::VectorXd &r) {
+  Eigen::ArrayXd xxi(r.size()), h(r.size()), f0(r.size()), f1(r.size()),
+      f20(r.size()), f21(r.size());
+  for (Index k = 0; k < r.size(); ++k) {
+    Index i = getInterval(r(k));
+    xxi(k) = r(k) - r_[i];
+    h(k) = r_[i + 1] - r_[i];
+    f0(k) = f_[i];
+    f1(k) = f_[i + 1];
+    f20(k) = f2_[i];
+    f21(k) = f2_[i + 1];
+  }
+  Eigen::ArrayXd b = xxi / h;
+  Eigen::ArrayXd xxi3 = xxi * xxi * xxi / h;
+  return ((1.0 - b) * f0 + b * f1 +
+          (0.5 * xxi * xxi - (1.0 / 6.0) * xxi3 - (1.0 / 3.0) * xxi * h) * f20 +
+          ((1.0 / 6.0) * xxi3 - (1.0 / 6.0) * xxi * h) * f21)
+      .matrix();
+}
+
+Eigen::VectorXd CubicSpline::CalculateDerivative(const Eigen::VectorXd &r) {
+  Eigen::ArrayXd xxi(r.size()), h(r.size()), f0(r.size()), f1(r.size()),
+      f20(r.size()), f21(r.size());
+  for (Index k = 0; k < r.size(); ++k) {
+    Index i = getInterval(r(k));
+    xxi(k) = r(k) - r_[i];
+    h(k) = r_[i + 1] - r_[i];
+    f0(k) = f_[i];
+    f1(k) = f_[i + 1];
+    f20(k) = f2_[i];
+    f21(k) = f2_[i + 1];
+  }
+  Eigen::ArrayXd xxi2 = xxi * xxi / h;
+  return ((f1 - f0) / h + (xxi - 0.5 * xxi2 - h / 3) * f20 +
+          (0.5 * xxi2 - (1.0 / 6.0) * h) * f21)
+      .matrix();
 }
 
-double CubicSpline::A(double r) {
-  return (1.0 - (r - r_[getInterval(r)]) /
-                    (r_[getInterval(r) + 1] - r_[getInterval(r)]));
+double CubicSpline::A(double r, Index i) const {
+  return (1.0 - (r - r_[i]) / (r_[i + 1] - r_[i]));
 }
 
-double CubicSpline::Aprime(double r) {
-  return -1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::Aprime(double, Index i) const {
+  return -1.0 / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::B(double r) {
-  return (r - r_[getInterval(r)]) /
-         (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::B(double r, Index i) const {
+  return (r - r_[i]) / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::Bprime(double r) {
-  return 1.0 / (r_[getInterval(r) + 1] - r_[getInterval(r)]);
+double CubicSpline::Bprime(double, Index i) const {
+  return 1.0 / (r_[i + 1] - r_[i]);
 }
 
-double CubicSpline::C(double r) {
+double CubicSpline::C(double r, Index i) const {
 
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (0.5 * xxi * xxi - (1.0 / 6.0) * xxi * xxi * xxi / h -
           (1.0 / 3.0) * xxi * h);
 }
 
-double CubicSpline::Cprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+double CubicSpline::Cprime(double r, Index i) const {
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (xxi - 0.5 * xxi * xxi / h - h / 3);
 }
 
-double CubicSpline::D(double r) {
+double CubicSpline::D(double r, Index i) const {
 
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return ((1.0 / 6.0) * xxi * xxi * xxi / h - (1.0 / 6.0) * xxi * h);
 }
 
-double CubicSpline::Dprime(double r) {
-  double xxi = r - r_[getInterval(r)];
-  double h = r_[getInterval(r) + 1] - r_[getInterval(r)];
+double CubicSpline::Dprime(double r, Index i) const {
+  double xxi = r - r_[i];
+  double h = r_[i + 1] - r_[i];
 
   return (0.5 * xxi * xxi / h - (1.0 / 6.0) * h);
 }
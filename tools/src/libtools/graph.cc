@@ -53,11 +53,29 @@ Graph::Graph(vector<Edge> edges, unordered_map<Index, GraphNode> nodes) {
       edge_container_.addVertex(id_and_node.first);
     }
   }
-  calcId_();
+  invalidateId_();
+}
+
+Graph::Graph(const Graph& graph)
+    : edge_container_(graph.edge_container_), nodes_(graph.nodes_) {
+  lock_guard<mutex> lock(graph.id_mutex_);
+  id_ = graph.id_;
+  id_up_to_date_ = graph.id_up_to_date_;
+}
+
+Graph& Graph::operator=(const Graph& graph) {
+  if (this != &graph) {
+    edge_container_ = graph.edge_container_;
+    nodes_ = graph.nodes_;
+    lock_guard<mutex> lock(graph.id_mutex_);
+    id_ = graph.id_;
+    id_up_to_date_ = graph.id_up_to_date_;
+  }
+  return *this;
 }
 
 bool Graph::operator!=(const Graph& graph) const {
-  return id_.compare(graph.id_);
+  return getId().compare(graph.getId());
 }
 
 bool Graph::operator==(const Graph& graph) const { return !(*(this) != graph); }
@@ -87,7 +105,7 @@ vector<pair<Index, GraphNode>> Graph::getNeighNodes(Index vertex) const {
 void Graph::setNode(Index vertex, GraphNode& graph_node) {
   assert(nodes_.count(vertex) && "Can only set a node that already exists");
   nodes_[vertex] = graph_node;
-  calcId_();
+  invalidateId_();
 }
 
 void Graph::setNode(std::pair<Index, GraphNode>& id_and_node) {
@@ -117,24 +135,34 @@ vector<Index> Graph::getJunctions() const {
   return junctions;
 }
 
-void Graph::clearNodes() { nodes_.clear(); }
+void Graph::clearNodes() {
+  nodes_.clear();
+  invalidateId_();
+}
 
 void Graph::copyNodes(Graph& graph) {
   assert(nodes_.size() == 0);
   for (const pair<const Index, GraphNode>& id_and_node : graph.nodes_) {
     this->nodes_[id_and_node.first] = id_and_node.second;
   }
+  invalidateId_();
 }
 
-void Graph::calcId_() {
-  auto nodes = getNodes();
-  sort(nodes.begin(), nodes.end(), cmpVertNodePair);
-  string struct_Id_temp = "";
-  for (const pair<Index, GraphNode>& id_and_node : nodes) {
-    struct_Id_temp.append(id_and_node.second.getStringId());
+string Graph::getId() const {
+  lock_guard<mutex> lock(id_mutex_);
+  if (!id_up_to_date_) {
+    vector<string> node_ids;
+    for (const pair<Index, GraphNode>& id_and_node : getNodes()) {
+      node_ids.push_back(id_and_node.second.getStringId());
+    }
+    sort(node_ids.begin(), node_ids.end());
+    id_.clear();
+    for (const string& node_id : node_ids) {
+      id_.append(node_id);
+    }
+    id_up_to_date_ = true;
   }
-  id_ = struct_Id_temp;
-  return;
+  return id_;
 }
 
 Index Graph::getDegree(Index vertex) const {
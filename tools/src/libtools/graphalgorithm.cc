@@ -19,6 +19,7 @@
 
 // Standard includes
 #include <list>
+#include <unordered_map>
 
 // Local VOTCA includes
 #include "votca/tools/graph.h"
@@ -246,6 +247,10 @@ vector<Graph> decoupleIsolatedSubGraphs(Graph graph) {
   const std::vector<Index>& vertices = graph.getVertices();
   // bool vector to see if vertex is already part of graph
   std::vector<bool> vertex_analysed = std::vector<bool>(vertices.size(), false);
+  unordered_map<Index, Index> vertex_positions;
+  for (Index j = 0; j < Index(vertices.size()); j++) {
+    vertex_positions[vertices[j]] = j;
+  }
 
   std::vector<Graph> subGraphs;
   Index i = 0;
@@ -261,15 +266,7 @@ vector<Graph> decoupleIsolatedSubGraphs(Graph graph) {
         graph_visitor_breadth_first.getExploredVertices();
 
     for (Index vertex : sub_graph_explored_vertices) {
-      for (Index j = 0; j < Index(vertices.size()); j++) {
-        if (vertex_analysed[j]) {
-          continue;
-        }
-        if (vertex == vertices[j]) {
-          vertex_analysed[j] = true;
-          break;
-        }
-      }
+      vertex_analysed[vertex_positions.at(vertex)] = true;
     }
 
     set<Edge> sub_graph_edges;
@@ -84,7 +84,7 @@ void GraphVisitor::exec(Graph& graph, Edge edge) {
   exploreNode(vertex_and_node, graph, edge);
 }
 
-Edge GraphVisitor::nextEdge(Graph graph) {
+Edge GraphVisitor::nextEdge(const Graph& graph) {
 
   // Get the edge and at the same time remove it from whatever queue it is in
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <cmath>
+#include <stdexcept>
+
+// Local VOTCA includes
+#include "votca/tools/histogram2d.h"
+
+namespace votca {
+namespace tools {
+
+void Histogram2D::Axis::Initialize(double min_value, double max_value,
+                                   Index number_bins) {
+  min = min_value;
+  max = max_value;
+  nbins = number_bins;
+  if (periodic) {
+    step = (max - min) / double(nbins);
+  } else {
+    step = (max - min) / (double(nbins) - 1.0);
+  }
+  if (nbins == 1) {
+    step = 1;
+  }
+}
+
+Index Histogram2D::Axis::Bin(double v) const {
+  Index i = (Index)std::floor((v - min) / step + 0.5);
+  if (i < 0 || i >= nbins) {
+    if (!periodic) {
+      return -1;
+    }
+    i %= nbins;
+    if (i < 0) {
+      i += nbins;
+    }
+  }
+  return i;
+}
+
+bool Histogram2D::Axis::operator==(const Axis &other) const {
+  return min == other.min && max == other.max && nbins == other.nbins &&
+         periodic == other.periodic;
+}
+
+void Histogram2D::Initialize(double xmin, double xmax, Index nx, double ymin,
+                             double ymax, Index ny) {
+  x_.Initialize(xmin, xmax, nx);
+  y_.Initialize(ymin, ymax, ny);
+  data_ = Eigen::MatrixXd::Zero(nx, ny);
+}
+
+void Histogram2D::Process(double x, double y, double scale) {
+  Index i = x_.Bin(x);
+  Index j = y_.Bin(y);
+  if (i < 0 || j < 0) {
+    return;
+  }
+  data_(i, j) += scale;
+}
+
+void Histogram2D::Merge(const Histogram2D &other) {
+  if (!(x_ == other.x_) || !(y_ == other.y_)) {
+    throw std::runtime_error(
+        "Histogram2D::Merge: histograms have different bins");
+  }
+  data_ += other.data_;
+}
+
+void Histogram2D::Normalize() {
+  double area = data_.cwiseAbs().sum() * x_.step * y_.step;
+  data_ *= 1.0 / area;
+}
+
+}  // namespace tools
+}  // namespace votca
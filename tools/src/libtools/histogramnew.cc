@@ -17,6 +17,7 @@
 
 // Standard includes
 #include <algorithm>
+#include <stdexcept>
 
 // Local VOTCA includes
 #include "votca/tools/histogramnew.h"
@@ -93,5 +94,14 @@ void HistogramNew::Clear() {
   data_.yerr() = Eigen::VectorXd::Zero(nbins_);
 }
 
+void HistogramNew::Merge(const HistogramNew &other) {
+  if (nbins_ != other.nbins_ || min_ != other.min_ || max_ != other.max_ ||
+      periodic_ != other.periodic_) {
+    throw std::runtime_error(
+        "HistogramNew::Merge: histograms have different bins");
+  }
+  data_.y() += other.data_.y();
+}
+
 }  // namespace tools
 }  // namespace votca
@@ -0,0 +1,329 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+// Local VOTCA includes
+#include "votca/tools/graph.h"
+#include "votca/tools/labeledgraph.h"
+
+using namespace std;
+
+namespace votca {
+namespace tools {
+
+///////////////////////////////////////////////////////////
+// Local Functions
+///////////////////////////////////////////////////////////
+/// splitmix64 finalizer, spreads the bits of x over the whole word
+static uint64_t mix_(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/// Order dependent combination of a hash with a new value
+static uint64_t combine_(uint64_t seed, uint64_t value) {
+  return mix_(seed ^ (mix_(value) + (seed << 6) + (seed >> 2)));
+}
+
+static Index countDistinct_(vector<uint64_t> values) {
+  sort(values.begin(), values.end());
+  return Index(distance(values.begin(), unique(values.begin(), values.end())));
+}
+
+///////////////////////////////////////////////////////////
+// Private Functions
+///////////////////////////////////////////////////////////
+void LabeledGraph::refineLabels_() {
+  const Index nvertices = VertexCount();
+  colors_.resize(nvertices);
+  for (Index v = 0; v < nvertices; ++v) {
+    colors_[v] = mix_(labels_[v]);
+  }
+  Index nclasses = countDistinct_(colors_);
+  vector<uint64_t> new_colors(nvertices);
+  vector<uint64_t> neigh_colors;
+  // Every round either splits a class or leaves the partition unchanged, so
+  // at most nvertices rounds are needed
+  for (Index round = 0; round < nvertices; ++round) {
+    for (Index v = 0; v < nvertices; ++v) {
+      neigh_colors.clear();
+      for (Index i = offsets_[v]; i < offsets_[v + 1]; ++i) {
+        neigh_colors.push_back(colors_[neighbors_[i]]);
+      }
+      sort(neigh_colors.begin(), neigh_colors.end());
+      uint64_t color = colors_[v];
+      for (uint64_t neigh_color : neigh_colors) {
+        color = combine_(color, neigh_color);
+      }
+      new_colors[v] = color;
+    }
+    colors_.swap(new_colors);
+    Index nclasses_new = countDistinct_(colors_);
+    if (nclasses_new == nclasses) {
+      break;
+    }
+    nclasses = nclasses_new;
+  }
+
+  vector<uint64_t> sorted_colors = colors_;
+  sort(sorted_colors.begin(), sorted_colors.end());
+  hash_ = combine_(mix_(uint64_t(nvertices)), uint64_t(EdgeCount()));
+  for (uint64_t color : sorted_colors) {
+    hash_ = combine_(hash_, color);
+  }
+}
+
+///////////////////////////////////////////////////////////
+// Public Functions
+///////////////////////////////////////////////////////////
+LabeledGraph::LabeledGraph(vector<uint64_t> labels,
+                           const vector<pair<Index, Index>>& edges)
+    : labels_(std::move(labels)) {
+  const Index nvertices = VertexCount();
+  vector<pair<Index, Index>> unique_edges;
+  unique_edges.reserve(edges.size());
+  for (const pair<Index, Index>& edge : edges) {
+    if (edge.first < 0 || edge.first >= nvertices || edge.second < 0 ||
+        edge.second >= nvertices) {
+      throw invalid_argument("Edge " + to_string(edge.first) + " " +
+                             to_string(edge.second) +
+                             " refers to a vertex that does not exist in the "
+                             "labeled graph.");
+    }
+    unique_edges.push_back(minmax(edge.first, edge.second));
+  }
+  sort(unique_edges.begin(), unique_edges.end());
+  unique_edges.erase(unique(unique_edges.begin(), unique_edges.end()),
+                     unique_edges.end());
+
+  offsets_.assign(nvertices + 1, 0);
+  for (const pair<Index, Index>& edge : unique_edges) {
+    ++offsets_[edge.first + 1];
+    ++offsets_[edge.second + 1];
+  }
+  for (Index v = 0; v < nvertices; ++v) {
+    offsets_[v + 1] += offsets_[v];
+  }
+  neighbors_.resize(offsets_.back());
+  vector<Index> fill(offsets_.begin(), offsets_.end() - 1);
+  for (const pair<Index, Index>& edge : unique_edges) {
+    neighbors_[fill[edge.first]++] = edge.second;
+    neighbors_[fill[edge.second]++] = edge.first;
+  }
+  for (Index v = 0; v < nvertices; ++v) {
+    sort(neighbors_.begin() + offsets_[v],
+         neighbors_.begin() + offsets_[v + 1]);
+  }
+  refineLabels_();
+}
+
+LabeledGraph::LabeledGraph(const Graph& graph) {
+  vector<Index> vertices = graph.getVertices();
+  sort(vertices.begin(), vertices.end());
+  unordered_map<Index, Index> vertex_to_index;
+  vector<uint64_t> labels;
+  labels.reserve(vertices.size());
+  for (Index vertex : vertices) {
+    vertex_to_index[vertex] = Index(labels.size());
+    labels.push_back(hashLabel(graph.getNode(vertex).getStringId()));
+  }
+  vector<pair<Index, Index>> edges;
+  for (Index vertex : vertices) {
+    for (Index neigh_vertex : graph.getNeighVertices(vertex)) {
+      if (vertex <= neigh_vertex) {
+        edges.emplace_back(vertex_to_index[vertex],
+                           vertex_to_index.at(neigh_vertex));
+      }
+    }
+  }
+  *this = LabeledGraph(std::move(labels), edges);
+}
+
+vector<Index> LabeledGraph::getNeighVertices(Index vertex) const {
+  return vector<Index>(neighbors_.begin() + offsets_[vertex],
+                       neighbors_.begin() + offsets_[vertex + 1]);
+}
+
+bool LabeledGraph::edgeExist(Index vertex1, Index vertex2) const {
+  return binary_search(neighbors_.begin() + offsets_[vertex1],
+                       neighbors_.begin() + offsets_[vertex1 + 1], vertex2);
+}
+
+bool LabeledGraph::isIsomorphic(const LabeledGraph& graph) const {
+  const Index nvertices = VertexCount();
+  if (hash_ != graph.hash_ || nvertices != graph.VertexCount() ||
+      EdgeCount() != graph.EdgeCount()) {
+    return false;
+  }
+
+  if (nvertices == 0) {
+    return true;
+  }
+
+  // Vertices of the other graph grouped by their refined label
+  vector<pair<uint64_t, Index>> by_color(nvertices);
+  for (Index v = 0; v < nvertices; ++v) {
+    by_color[v] = {graph.colors_[v], v};
+  }
+  sort(by_color.begin(), by_color.end());
+  auto colorRange = [&by_color, nvertices](uint64_t color) {
+    return make_pair(lower_bound(by_color.begin(), by_color.end(),
+                                 make_pair(color, Index(-1))),
+                     upper_bound(by_color.begin(), by_color.end(),
+                                 make_pair(color, nvertices)));
+  };
+
+  // Map the vertices in breadth first order, so apart from the first vertex
+  // of each connected component every vertex has an already mapped neighbour
+  // which restricts its candidates to the neighbours of that image. Each
+  // component is started from a vertex with the rarest refined label.
+  vector<Index> starts(nvertices);
+  for (Index v = 0; v < nvertices; ++v) {
+    starts[v] = v;
+  }
+  vector<Index> class_size(nvertices);
+  for (Index v = 0; v < nvertices; ++v) {
+    auto range = colorRange(colors_[v]);
+    class_size[v] = Index(distance(range.first, range.second));
+  }
+  stable_sort(starts.begin(), starts.end(), [&class_size](Index a, Index b) {
+    return class_size[a] < class_size[b];
+  });
+  vector<Index> order;
+  order.reserve(nvertices);
+  vector<Index> parent(nvertices, -1);
+  vector<bool> visited(nvertices, false);
+  for (Index start : starts) {
+    if (visited[start]) {
+      continue;
+    }
+    queue<Index> que;
+    que.push(start);
+    visited[start] = true;
+    while (!que.empty()) {
+      Index v = que.front();
+      que.pop();
+      order.push_back(v);
+      for (Index i = offsets_[v]; i < offsets_[v + 1]; ++i) {
+        Index w = neighbors_[i];
+        if (!visited[w]) {
+          visited[w] = true;
+          parent[w] = v;
+          que.push(w);
+        }
+      }
+    }
+  }
+
+  vector<Index> image(nvertices, -1);
+  vector<bool> used(nvertices, false);
+  auto candidatesOf = [&](Index v) {
+    vector<Index> candidates;
+    if (parent[v] >= 0) {
+      Index p = image[parent[v]];
+      for (Index i = graph.offsets_[p]; i < graph.offsets_[p + 1]; ++i) {
+        Index c = graph.neighbors_[i];
+        if (!used[c] && graph.colors_[c] == colors_[v]) {
+          candidates.push_back(c);
+        }
+      }
+    } else {
+      auto range = colorRange(colors_[v]);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (!used[it->second]) {
+          candidates.push_back(it->second);
+        }
+      }
+    }
+    return candidates;
+  };
+  auto feasible = [&](Index v, Index c) {
+    if (labels_[v] != graph.labels_[c] ||
+        offsets_[v + 1] - offsets_[v] !=
+            graph.offsets_[c + 1] - graph.offsets_[c]) {
+      return false;
+    }
+    for (Index i = offsets_[v]; i < offsets_[v + 1]; ++i) {
+      Index w = neighbors_[i];
+      if (w == v) {
+        if (!graph.edgeExist(c, c)) {
+          return false;
+        }
+      } else if (image[w] >= 0 && !graph.edgeExist(image[w], c)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Iterative backtracking, depth is the position in order
+  vector<vector<Index>> candidates(nvertices);
+  vector<Index> next(nvertices, 0);
+  Index depth = 0;
+  candidates[0] = candidatesOf(order[0]);
+  while (depth >= 0) {
+    if (depth == nvertices) {
+      return true;
+    }
+    Index v = order[depth];
+    if (image[v] >= 0) {
+      used[image[v]] = false;
+      image[v] = -1;
+    }
+    bool advanced = false;
+    while (next[depth] < Index(candidates[depth].size())) {
+      Index c = candidates[depth][next[depth]++];
+      if (feasible(v, c)) {
+        image[v] = c;
+        used[c] = true;
+        ++depth;
+        if (depth < nvertices) {
+          candidates[depth] = candidatesOf(order[depth]);
+          next[depth] = 0;
+        }
+        advanced = true;
+        break;
+      }
+    }
+    if (!advanced) {
+      --depth;
+    }
+  }
+  return false;
+}
+
+uint64_t LabeledGraph::hashLabel(const string& label) {
+  // 64 bit FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : label) {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+}  // namespace tools
+}  // namespace votca
@@ -17,14 +17,147 @@
 
 // Standard includes
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 // Local VOTCA includes
 #include "votca/tools/linalg.h"
 
+#if defined(USE_LAPACK_EIGENSOLVER) && !defined(MKL_FOUND)
+// Fortran interface of LAPACK, mkl.h declares them for MKL
+extern "C" {
+void dsyevd_(const char *jobz, const char *uplo, const int *n, double *a,
+             const int *lda, double *w, double *work, const int *lwork,
+             int *iwork, const int *liwork, int *info);
+void dsyevr_(const char *jobz, const char *range, const char *uplo,
+             const int *n, double *a, const int *lda, const double *vl,
+             const double *vu, const int *il, const int *iu,
+             const double *abstol, int *m, double *w, double *z,
+             const int *ldz, int *isuppz, double *work, const int *lwork,
+             int *iwork, const int *liwork, int *info);
+}
+#endif
+
 namespace votca {
 namespace tools {
 
+#ifdef USE_LAPACK_EIGENSOLVER
+namespace {
+
+#ifdef MKL_FOUND
+using lapack_int = MKL_INT;
+#else
+using lapack_int = int;
+#endif
+
+lapack_int LapackSize(Index size) {
+  if (size > Index(std::numeric_limits<lapack_int>::max())) {
+    throw std::runtime_error("linalg_eigenvalues: matrix too large for LAPACK");
+  }
+  return lapack_int(size);
+}
+
+Eigen::ComputationInfo LapackInfo(lapack_int info) {
+  if (info < 0) {
+    return Eigen::InvalidInput;
+  }
+  return (info == 0) ? Eigen::Success : Eigen::NoConvergence;
+}
+
+}  // namespace
+#endif
+
+EigenSystem linalg_eigenvalues(const Eigen::MatrixXd &A) {
+  EigenSystem result;
+  if (A.rows() == 0) {
+    result.eigenvalues().resize(0);
+    result.eigenvectors().resize(0, 0);
+    return result;
+  }
+#ifdef USE_LAPACK_EIGENSOLVER
+  lapack_int n = LapackSize(A.rows());
+  result.eigenvectors() = A;
+  result.eigenvalues().resize(n);
+  // workspace query
+  lapack_int lwork = -1;
+  lapack_int liwork = -1;
+  double work_size = 0;
+  lapack_int iwork_size = 0;
+  lapack_int info = 0;
+  dsyevd_("V", "L", &n, result.eigenvectors().data(), &n,
+          result.eigenvalues().data(), &work_size, &lwork, &iwork_size,
+          &liwork, &info);
+  lwork = lapack_int(work_size);
+  liwork = iwork_size;
+  std::vector<double> work(lwork);
+  std::vector<lapack_int> iwork(liwork);
+  dsyevd_("V", "L", &n, result.eigenvectors().data(), &n,
+          result.eigenvalues().data(), work.data(), &lwork, iwork.data(),
+          &liwork, &info);
+  result.info() = LapackInfo(info);
+#else
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(A);
+  result.eigenvalues() = es.eigenvalues();
+  result.eigenvectors() = es.eigenvectors();
+  result.info() = es.info();
+#endif
+  return result;
+}
+
+EigenSystem linalg_eigenvalues(const Eigen::MatrixXd &A, Index nmax) {
+  if (nmax >= A.rows()) {
+    return linalg_eigenvalues(A);
+  }
+  EigenSystem result;
+  if (nmax <= 0) {
+    result.eigenvalues().resize(0);
+    result.eigenvectors().resize(A.rows(), 0);
+    return result;
+  }
+#ifdef USE_LAPACK_EIGENSOLVER
+  lapack_int n = LapackSize(A.rows());
+  lapack_int il = 1;
+  lapack_int iu = lapack_int(nmax);
+  // the matrix is overwritten by dsyevr
+  Eigen::MatrixXd a = A;
+  result.eigenvalues().resize(n);
+  result.eigenvectors().resize(n, iu);
+  double unused = 0.0;
+  // let LAPACK choose the tolerance
+  double abstol = 0.0;
+  lapack_int m = 0;
+  std::vector<lapack_int> isuppz(2 * std::size_t(iu));
+  // workspace query
+  lapack_int lwork = -1;
+  lapack_int liwork = -1;
+  double work_size = 0;
+  lapack_int iwork_size = 0;
+  lapack_int info = 0;
+  dsyevr_("V", "I", "L", &n, a.data(), &n, &unused, &unused, &il, &iu,
+          &abstol, &m, result.eigenvalues().data(),
+          result.eigenvectors().data(), &n, isuppz.data(), &work_size, &lwork,
+          &iwork_size, &liwork, &info);
+  lwork = lapack_int(work_size);
+  liwork = iwork_size;
+  std::vector<double> work(lwork);
+  std::vector<lapack_int> iwork(liwork);
+  dsyevr_("V", "I", "L", &n, a.data(), &n, &unused, &unused, &il, &iu,
+          &abstol, &m, result.eigenvalues().data(),
+          result.eigenvectors().data(), &n, isuppz.data(), work.data(), &lwork,
+          iwork.data(), &liwork, &info);
+  result.eigenvalues().conservativeResize(m);
+  result.eigenvectors().conservativeResize(n, m);
+  result.info() = LapackInfo(info);
+#else
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(A);
+  result.eigenvalues() = es.eigenvalues().head(nmax);
+  result.eigenvectors() = es.eigenvectors().leftCols(nmax);
+  result.info() = es.info();
+#endif
+  return result;
+}
+
 Eigen::VectorXd linalg_constrained_qrsolve(const Eigen::MatrixXd &A,
                                            const Eigen::VectorXd &b,
                                            const Eigen::MatrixXd &constr) {
@@ -63,5 +196,38 @@ Eigen::VectorXd linalg_constrained_qrsolve(const Eigen::MatrixXd &A,
   return QR.householderQ() * result;
 }
 
+Eigen::MatrixXd linalg_tridiagonal_solve(const Eigen::VectorXd &lower,
+                                         const Eigen::VectorXd &diag,
+                                         const Eigen::VectorXd &upper,
+                                         const Eigen::MatrixXd &b) {
+  const Index n = diag.size();
+  if (lower.size() != n - 1 || upper.size() != n - 1 || b.rows() != n) {
+    throw std::invalid_argument(
+        "linalg_tridiagonal_solve: sizes of the bands and b do not match");
+  }
+  // forward elimination, c holds the modified superdiagonal
+  Eigen::VectorXd c = Eigen::VectorXd::Zero(n);
+  Eigen::MatrixXd x = b;
+  for (Index i = 0; i < n; i++) {
+    double pivot = diag(i);
+    if (i > 0) {
+      pivot -= lower(i - 1) * c(i - 1);
+      x.row(i) -= lower(i - 1) * x.row(i - 1);
+    }
+    if (pivot == 0.0) {
+      throw std::runtime_error("linalg_tridiagonal_solve: zero pivot");
+    }
+    if (i < n - 1) {
+      c(i) = upper(i) / pivot;
+    }
+    x.row(i) /= pivot;
+  }
+  // back substitution
+  for (Index i = n - 2; i >= 0; i--) {
+    x.row(i) -= c(i) * x.row(i + 1);
+  }
+  return x;
+}
+
 }  // namespace tools
 }  // namespace votca
@@ -37,6 +37,24 @@ double LinSpline::CalculateDerivative(double r) {
   return a(interval);
 }
 
+Eigen::VectorXd LinSpline::Calculate(const Eigen::VectorXd &r) {
+  Eigen::ArrayXd ai(r.size()), bi(r.size());
+  for (Index k = 0; k < r.size(); ++k) {
+    Index interval = getInterval(r(k));
+    ai(k) = a(interval);
+    bi(k) = b(interval);
+  }
+  return (ai * r.array() + bi).matrix();
+}
+
+Eigen::VectorXd LinSpline::CalculateDerivative(const Eigen::VectorXd &r) {
+  Eigen::VectorXd y(r.size());
+  for (Index k = 0; k < r.size(); ++k) {
+    y(k) = a(getInterval(r(k)));
+  }
+  return y;
+}
+
 void LinSpline::Interpolate(const Eigen::VectorXd &x,
                             const Eigen::VectorXd &y) {
   if (x.size() != y.size()) {
@@ -53,11 +71,8 @@ void LinSpline::Interpolate(const Eigen::VectorXd &x,
 
   const Index N = x.size();
 
-  // adjust the grid
-  r_.resize(N);
-
   // copy the grid points into f
-  r_ = x;
+  setGrid(x);
 
   // LINEAR SPLINE: a(i) * x + b(i)
   // where i=number of interval
@@ -94,20 +109,38 @@ void LinSpline::Fit(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
   // the condition y=s_i(x) is to be satisfied at all input points:
   // therefore b=y and u=vector of all unknown y(i)
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, ngrid);
-
-  // construct matrix A
+  // Every row of A has two neighbouring entries, so the normal equations
+  // A^T*A*u = A^T*b are tridiagonal
+  Eigen::VectorXd diag = Eigen::VectorXd::Zero(ngrid);
+  Eigen::VectorXd offdiag = Eigen::VectorXd::Zero(ngrid - 1);
+  Eigen::VectorXd rhs = Eigen::VectorXd::Zero(ngrid);
   for (Index i = 0; i < N; i++) {
     Index interval = getInterval(x(i));
-    A(i, interval) =
-        1 - (x(i) - r_(interval)) / (r_(interval + 1) - r_(interval));
-    A(i, interval + 1) =
-        (x(i) - r_(interval)) / (r_(interval + 1) - r_(interval));
+    double w1 = (x(i) - r_(interval)) / (r_(interval + 1) - r_(interval));
+    double w0 = 1 - w1;
+    diag(interval) += w0 * w0;
+    diag(interval + 1) += w1 * w1;
+    offdiag(interval) += w0 * w1;
+    rhs(interval) += w0 * y(i);
+    rhs(interval + 1) += w1 * y(i);
   }
 
-  // now do a qr solve
-  Eigen::HouseholderQR<Eigen::MatrixXd> QR(A);
-  Eigen::VectorXd sol = QR.solve(y);
+  Eigen::VectorXd sol;
+  if ((diag.array() > 0.0).all()) {
+    sol = linalg_tridiagonal_solve(offdiag, diag, offdiag, rhs);
+  } else {
+    // grid points without data, keep the least squares solution of the qr
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(N, ngrid);
+    for (Index i = 0; i < N; i++) {
+      Index interval = getInterval(x(i));
+      A(i, interval) =
+          1 - (x(i) - r_(interval)) / (r_(interval + 1) - r_(interval));
+      A(i, interval + 1) =
+          (x(i) - r_(interval)) / (r_(interval + 1) - r_(interval));
+    }
+    Eigen::HouseholderQR<Eigen::MatrixXd> QR(A);
+    sol = QR.solve(y);
+  }
 
   // vector "sol" contains all y-values of fitted linear splines at each
   // interval border
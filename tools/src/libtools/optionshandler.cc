@@ -20,6 +20,8 @@
 #include "votca/tools/propertyiomanipulator.h"
 #include "votca/tools/tokenizer.h"
 #include <algorithm>
+#include <map>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
@@ -36,6 +38,21 @@ static bool IsValidCast(const tools::Property &prop) {
   }
 }
 
+/// Parses an xml file only once per program run, later calls return a copy
+/// of the parsed tree. The default files do not change while a program runs.
+static Property LoadXMLCached(const std::string &file_path) {
+  static std::mutex cache_mutex;
+  static std::map<std::string, Property> cache;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto iter = cache.find(file_path);
+  if (iter == cache.end()) {
+    Property xml;
+    xml.LoadFromXML(file_path);
+    iter = cache.emplace(file_path, std::move(xml)).first;
+  }
+  return iter->second;
+}
+
 void OptionsHandler::ResolveLinks(Property &prop) const {
 
   if (prop.hasAttribute("link")) {
@@ -43,8 +60,7 @@ void OptionsHandler::ResolveLinks(Property &prop) const {
     for (std::string path : tok) {
       std::string relative_path = "subpackages/" + path;
       std::string file_path = defaults_path_ + relative_path;
-      tools::Property package;
-      package.LoadFromXML(file_path);
+      tools::Property package = LoadXMLCached(file_path);
       const tools::Property &options = *(package.begin());
       for (Property::const_AttributeIterator attr = options.firstAttribute();
            attr != options.lastAttribute(); ++attr) {
@@ -138,13 +154,20 @@ void OptionsHandler::CleanAttributes(
 }
 
 // load the xml description of the calculator (with defaults and test values)
+// the defaults with resolved links are cached per file like the xml files
 Property OptionsHandler::LoadDefaults(const std::string &calculatorname) const {
-  Property defaults_all;
+  static std::mutex cache_mutex;
+  static std::map<std::string, Property> cache;
   std::string defaults_file_path =
       defaults_path_ + "/" + calculatorname + ".xml";
-  defaults_all.LoadFromXML(defaults_file_path);
-  ResolveLinks(defaults_all);
-  return defaults_all;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto iter = cache.find(defaults_file_path);
+  if (iter == cache.end()) {
+    Property defaults_all = LoadXMLCached(defaults_file_path);
+    ResolveLinks(defaults_all);
+    iter = cache.emplace(defaults_file_path, std::move(defaults_all)).first;
+  }
+  return iter->second;
 }
 
 void OptionsHandler::InjectDefaultsAsValues(Property &defaults) const {
@@ -0,0 +1,326 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Local VOTCA includes
+#include "votca/tools/profiler.h"
+
+namespace votca {
+namespace tools {
+
+std::atomic<bool> Profiler::enabled_{false};
+
+struct Profiler::Region {
+  std::string name;
+  Region *parent = nullptr;
+  std::vector<std::unique_ptr<Region>> children;
+  Index calls = 0;
+  std::chrono::nanoseconds::rep time = 0;
+  Index bytes = 0;
+  /// counters at the last TakeThreadReport
+  Index taken_calls = 0;
+  std::chrono::nanoseconds::rep taken_time = 0;
+  Index taken_bytes = 0;
+  /// number of threads that entered the region, only set for merged trees
+  Index threads = 0;
+
+  Region *Child(const char *child_name) {
+    for (std::unique_ptr<Region> &child : children) {
+      if (child->name == child_name) {
+        return child.get();
+      }
+    }
+    children.push_back(std::make_unique<Region>());
+    children.back()->name = child_name;
+    children.back()->parent = this;
+    return children.back().get();
+  }
+};
+
+struct Profiler::ThreadData {
+  /// guards the tree against Report and Reset from other threads
+  std::mutex mutex;
+  Region root;
+  Region *current = &root;
+};
+
+namespace {
+
+/// all threads that ever entered a region, their data is kept after the
+/// thread ended so it is still part of the report
+struct ThreadRegistry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<Profiler::ThreadData>> threads;
+};
+
+ThreadRegistry &Registry() {
+  static ThreadRegistry registry;
+  return registry;
+}
+
+std::string Seconds(std::chrono::nanoseconds::rep time) {
+  std::ostringstream s;
+  s << std::setprecision(6) << double(time) * 1e-9;
+  return s.str();
+}
+
+}  // namespace
+
+Profiler::ThreadData &Profiler::LocalThreadData() {
+  thread_local ThreadData *data = nullptr;
+  if (!data) {
+    ThreadRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(std::make_unique<ThreadData>());
+    data = registry.threads.back().get();
+  }
+  return *data;
+}
+
+void ScopedTimer::Start(const char *name, Index bytes) {
+  thread_ = &Profiler::LocalThreadData();
+  {
+    std::lock_guard<std::mutex> lock(thread_->mutex);
+    region_ = thread_->current->Child(name);
+    region_->bytes += bytes;
+    thread_->current = region_;
+  }
+  start_ = std::chrono::steady_clock::now();
+}
+
+void ScopedTimer::Finish() {
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(thread_->mutex);
+  region_->calls++;
+  region_->time +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+          .count();
+  thread_->current = region_->parent;
+  region_ = nullptr;
+}
+
+void ScopedTimer::AddBytes(Index bytes) {
+  if (region_) {
+    std::lock_guard<std::mutex> lock(thread_->mutex);
+    region_->bytes += bytes;
+  }
+}
+
+namespace {
+
+void ResetRegion(Profiler::Region &region) {
+  region.calls = region.taken_calls = 0;
+  region.time = region.taken_time = 0;
+  region.bytes = region.taken_bytes = 0;
+  for (auto &child : region.children) {
+    ResetRegion(*child);
+  }
+}
+
+/// whether the region or one of its nested regions finished since the
+/// last Reset
+bool HasCalls(const Profiler::Region &region) {
+  return region.calls > 0 ||
+         std::any_of(region.children.begin(), region.children.end(),
+                     [](const auto &child) { return HasCalls(*child); });
+}
+
+/// adds the counters of `from` to the tree `into`
+void MergeRegion(const Profiler::Region &from, Profiler::Region &into) {
+  for (const auto &child : from.children) {
+    if (!HasCalls(*child)) {
+      continue;
+    }
+    Profiler::Region *merged = into.Child(child->name.c_str());
+    merged->calls += child->calls;
+    merged->time += child->time;
+    merged->bytes += child->bytes;
+    if (child->calls > 0) {
+      merged->threads++;
+    }
+    MergeRegion(*child, *merged);
+  }
+}
+
+/// moves the counters since the last call of the tree `from` into `into`
+/// and returns whether any region changed
+bool TakeRegion(Profiler::Region &from, Profiler::Region &into) {
+  bool changed = false;
+  for (auto &child : from.children) {
+    Profiler::Region taken;
+    taken.name = child->name;
+    taken.calls = child->calls - child->taken_calls;
+    taken.time = child->time - child->taken_time;
+    taken.bytes = child->bytes - child->taken_bytes;
+    taken.threads = (taken.calls > 0) ? 1 : 0;
+    child->taken_calls = child->calls;
+    child->taken_time = child->time;
+    child->taken_bytes = child->bytes;
+    bool nested = TakeRegion(*child, taken);
+    if (taken.calls > 0 || nested) {
+      into.children.push_back(std::make_unique<Profiler::Region>());
+      *into.children.back() = std::move(taken);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void AddRegions(const Profiler::Region &region, Property &prop) {
+  for (const auto &child : region.children) {
+    std::chrono::nanoseconds::rep nested = 0;
+    for (const auto &grandchild : child->children) {
+      nested += grandchild->time;
+    }
+    Property &entry = prop.add("region", "");
+    entry.setAttribute("name", child->name);
+    entry.setAttribute("calls", child->calls);
+    entry.setAttribute("total", Seconds(child->time));
+    entry.setAttribute("self", Seconds(std::max(
+                                   child->time - nested,
+                                   std::chrono::nanoseconds::rep(0))));
+    entry.setAttribute("bytes", child->bytes);
+    entry.setAttribute("threads", child->threads);
+    AddRegions(*child, entry);
+  }
+}
+
+Index NameWidth(const Property &prop, Index level) {
+  Index width = 0;
+  for (const Property *region : prop.Select("region")) {
+    Index name_length =
+        Index(region->getAttribute<std::string>("name").size()) + 2 * level;
+    width = std::max({width, name_length, NameWidth(*region, level + 1)});
+  }
+  return width;
+}
+
+void WriteText(std::ostream &out, const Property &prop, Index level,
+               Index width) {
+  for (const Property *region : prop.Select("region")) {
+    std::string name = std::string(2 * level, ' ') +
+                       region->getAttribute<std::string>("name");
+    out << std::left << std::setw(int(width)) << name << std::right;
+    for (const char *counter : {"calls", "total", "self", "bytes", "threads"}) {
+      out << " " << std::setw(12) << region->getAttribute<std::string>(counter);
+    }
+    out << "\n";
+    WriteText(out, *region, level + 1, width);
+  }
+}
+
+std::string JSONString(const std::string &value) {
+  std::string escaped = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped + "\"";
+}
+
+void WriteJSON(std::ostream &out, const Property &prop,
+               const std::string &indent) {
+  out << "[";
+  std::vector<const Property *> regions = prop.Select("region");
+  for (std::size_t i = 0; i < regions.size(); i++) {
+    const Property &region = *regions[i];
+    out << (i == 0 ? "\n" : ",\n") << indent << "  {\"name\": "
+        << JSONString(region.getAttribute<std::string>("name"));
+    for (const char *counter : {"calls", "total", "self", "bytes", "threads"}) {
+      out << ", \"" << counter
+          << "\": " << region.getAttribute<std::string>(counter);
+    }
+    out << ", \"regions\": ";
+    WriteJSON(out, region, indent + "  ");
+    out << "}";
+  }
+  if (!regions.empty()) {
+    out << "\n" << indent;
+  }
+  out << "]";
+}
+
+}  // namespace
+
+void Profiler::Reset() {
+  ThreadRegistry &registry = Registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto &thread : registry.threads) {
+    std::lock_guard<std::mutex> thread_lock(thread->mutex);
+    ResetRegion(thread->root);
+  }
+}
+
+Property Profiler::Report() {
+  Region merged;
+  {
+    ThreadRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto &thread : registry.threads) {
+      std::lock_guard<std::mutex> thread_lock(thread->mutex);
+      MergeRegion(thread->root, merged);
+    }
+  }
+  Property report("profile", "", "");
+  AddRegions(merged, report);
+  return report;
+}
+
+Property Profiler::TakeThreadReport() {
+  ThreadData &thread = LocalThreadData();
+  Region taken;
+  {
+    std::lock_guard<std::mutex> lock(thread.mutex);
+    TakeRegion(thread.root, taken);
+  }
+  Property report("profile", "", "");
+  AddRegions(taken, report);
+  return report;
+}
+
+void Profiler::WriteReport(std::ostream &out, const Property &report,
+                           Format format) {
+  if (format == JSON) {
+    out << "{\"regions\": ";
+    WriteJSON(out, report, "");
+    out << "}\n";
+    return;
+  }
+  Index width = std::max(NameWidth(report, 0), Index(6));
+  out << std::left << std::setw(int(width)) << "region" << std::right;
+  for (const char *counter :
+       {"calls", "total[s]", "self[s]", "bytes", "threads"}) {
+    out << " " << std::setw(12) << counter;
+  }
+  out << "\n";
+  WriteText(out, report, 0, width);
+}
+
+}  // namespace tools
+}  // namespace votca
@@ -45,34 +45,60 @@ using namespace std;
 // ostream modifier defines the output format, level, indentation
 const Index Property::IOindex = std::ios_base::xalloc();
 
-const Property &Property::get(const string &key) const {
-  Tokenizer tok(key, ".");
-  Tokenizer::iterator n = tok.begin();
-  if (n == tok.end()) {
-    return *this;
+/// Calls func for every non empty part of key separated by "."
+template <class Func>
+static void ForEachName(std::string_view key, Func func) {
+  while (!key.empty()) {
+    std::size_t dot = key.find('.');
+    std::string_view name = key.substr(0, dot);
+    if (!name.empty()) {
+      func(name);
+    }
+    if (dot == std::string_view::npos) {
+      break;
+    }
+    key.remove_prefix(dot + 1);
   }
+}
 
-  const Property *p;
-  map<string, std::vector<Index>>::const_iterator iter;
-  if (*n == "") {
-    p = this;
-  } else {
-    iter = map_.find(*n);
-    if (iter == map_.end()) {
-      throw std::runtime_error("property not found: " + key);
+PropertyPath::PropertyPath(const std::string &key) : key_(key) {
+  ForEachName(key_, [this](std::string_view name) {
+    names_.emplace_back(name);
+    if (name.find_first_of("*?") != std::string_view::npos) {
+      has_wildcards_ = true;
     }
-    p = &properties_[iter->second.back()];
-  }
-  ++n;
-  try {
-    for (; n != tok.end(); ++n) {
-      p = &p->get(*n);
+  });
+}
+
+const Property *Property::find_(std::string_view key) const {
+  const Property *p = this;
+  ForEachName(key, [&p](std::string_view name) {
+    if (p) {
+      auto iter = p->map_.find(name);
+      p = (iter == p->map_.end()) ? nullptr
+                                  : &p->properties_[iter->second.back()];
     }
-  } catch (std::runtime_error &) {  // catch here to get full key in
-                                    // exception
-    throw std::runtime_error("property not found: " + key);
+  });
+  return p;
+}
+
+const Property *Property::find_(const PropertyPath &path) const {
+  const Property *p = this;
+  for (const std::string &name : path.names()) {
+    auto iter = p->map_.find(name);
+    if (iter == p->map_.end()) {
+      return nullptr;
+    }
+    p = &p->properties_[iter->second.back()];
   }
+  return p;
+}
 
+const Property &Property::get(const string &key) const {
+  const Property *p = find_(key);
+  if (!p) {
+    throw std::runtime_error("property not found: " + key);
+  }
   return *p;
 }
 
@@ -80,6 +106,18 @@ Property &Property::get(const string &key) {
   return const_cast<Property &>(static_cast<const Property &>(*this).get(key));
 }
 
+const Property &Property::get(const PropertyPath &path) const {
+  const Property *p = find_(path);
+  if (!p) {
+    throw std::runtime_error("property not found: " + path.str());
+  }
+  return *p;
+}
+
+Property &Property::get(const PropertyPath &path) {
+  return const_cast<Property &>(static_cast<const Property &>(*this).get(path));
+}
+
 Property &Property::set(const std::string &key, const std::string &value) {
   Property &p = get(key);
   p.value() = value;
@@ -120,12 +158,11 @@ bool Property::hasAttribute(const std::string &attribute) const {
 }
 
 bool Property::exists(const std::string &key) const {
-  try {
-    get(key);
-  } catch (std::exception &) {
-    return false;
-  }
-  return true;
+  return find_(key) != nullptr;
+}
+
+bool Property::exists(const PropertyPath &path) const {
+  return find_(path) != nullptr;
 }
 
 void FixPath(tools::Property &prop, std::string path) {
@@ -154,53 +191,64 @@ Property &Property::add(const Property &other) {
 }
 
 Property &Property::getOradd(const std::string &key) {
-  if (exists(key)) {
-    return get(key);
+  const Property *p = find_(key);
+  if (p) {
+    return const_cast<Property &>(*p);
   } else {
     return addTree(key, "");
   }
 }
 
-std::vector<const Property *> Property::Select(const string &filter) const {
-  Tokenizer tok(filter, ".");
-  std::vector<const Property *> selection;
-  if (tok.begin() == tok.end()) {
+template <class PropertyPtr>
+std::vector<PropertyPtr> Property::Select_(PropertyPtr root,
+                                           const PropertyPath &filter) {
+  std::vector<PropertyPtr> selection;
+  if (filter.names().empty()) {
     return selection;
   }
-  selection.push_back(this);
-  for (const auto &n : tok) {
-    std::vector<const Property *> selected;
-    for (const Property *p : selection) {
-      for (const Property &child : *p) {
-        if (wildcmp(n, child.name())) {
-          selected.push_back(&child);
+  selection.push_back(root);
+  std::vector<PropertyPtr> selected;
+  for (const std::string &name : filter.names()) {
+    selected.clear();
+    bool wildcard = filter.hasWildcards() &&
+                    name.find_first_of("*?") != std::string::npos;
+    for (PropertyPtr p : selection) {
+      if (wildcard) {
+        for (auto &child : *p) {
+          if (wildcmp(name, child.name())) {
+            selected.push_back(&child);
+          }
+        }
+      } else {
+        // without wildcards the matching children are known from map_
+        auto iter = p->map_.find(name);
+        if (iter != p->map_.end()) {
+          for (Index index : iter->second) {
+            selected.push_back(&p->properties_[index]);
+          }
         }
       }
     }
-    selection = selected;
+    selection.swap(selected);
   }
   return selection;
 }
 
+std::vector<const Property *> Property::Select(const string &filter) const {
+  return Select_(this, PropertyPath(filter));
+}
+
 std::vector<Property *> Property::Select(const string &filter) {
-  Tokenizer tok(filter, ".");
-  std::vector<Property *> selection;
-  if (tok.begin() == tok.end()) {
-    return selection;
-  }
-  selection.push_back(this);
-  for (const auto &n : tok) {
-    std::vector<Property *> selected;
-    for (Property *p : selection) {
-      for (Property &child : *p) {
-        if (wildcmp(n, child.name())) {
-          selected.push_back(&child);
-        }
-      }
-    }
-    selection = selected;
-  }
-  return selection;
+  return Select_(this, PropertyPath(filter));
+}
+
+std::vector<const Property *> Property::Select(
+    const PropertyPath &filter) const {
+  return Select_(this, filter);
+}
+
+std::vector<Property *> Property::Select(const PropertyPath &filter) {
+  return Select_(this, filter);
 }
 
 void Property::deleteAttribute(const std::string &attribute) {
@@ -273,6 +321,34 @@ void Property::LoadFromXML(string filename) {
   XML_ParserFree(parser);
 }
 
+void Property::LoadFromXMLString(const std::string &xml) {
+  if (xml.length() > (size_t)std::numeric_limits<int>::max()) {
+    throw std::runtime_error("Property::LoadFromXMLString: xml is too long");
+  }
+  XML_Parser parser = XML_ParserCreate(nullptr);
+  if (!parser) {
+    throw std::runtime_error("Couldn't allocate memory for xml parser");
+  }
+
+  XML_UseParserAsHandlerArg(parser);
+  XML_SetElementHandler(parser, start_hndl, end_hndl);
+  XML_SetCharacterDataHandler(parser, char_hndl);
+
+  stack<Property *> pstack;
+  pstack.push(this);
+
+  XML_SetUserData(parser, (void *)&pstack);
+  if (!XML_Parse(parser, xml.c_str(), (int)xml.length(), true)) {
+    std::string message =
+        "Parse error at line " +
+        boost::lexical_cast<string>(XML_GetCurrentLineNumber(parser)) + "\n" +
+        XML_ErrorString(XML_GetErrorCode(parser));
+    XML_ParserFree(parser);
+    throw std::ios_base::failure(message);
+  }
+  XML_ParserFree(parser);
+}
+
 void PrintNodeTXT(std::ostream &out, const Property &p, const Index start_level,
                   Index level = 0, string prefix = "", string offset = "") {
   if ((p.value() != "") || p.HasChildren()) {
@@ -293,7 +293,7 @@ void ReducedGraph::init_(vector<ReducedEdge> reduced_edges,
 
   edge_container_ = EdgeContainer(edges);
 
-  calcId_();
+  invalidateId_();
 }
 
 /******************************************************************************
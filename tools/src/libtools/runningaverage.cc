@@ -0,0 +1,73 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <cmath>
+
+// Local VOTCA includes
+#include "votca/tools/runningaverage.h"
+
+namespace votca {
+namespace tools {
+
+void RunningAverage::Process(double value, double weight) {
+  if (weight == 0.0) {
+    return;
+  }
+  n_++;
+  weight_ += weight;
+  double delta = value - avg_;
+  avg_ += delta * weight / weight_;
+  m2_ += weight * delta * (value - avg_);
+}
+
+void RunningAverage::Merge(const RunningAverage &other) {
+  if (other.n_ == 0) {
+    return;
+  }
+  if (n_ == 0) {
+    *this = other;
+    return;
+  }
+  double weight = weight_ + other.weight_;
+  double delta = other.avg_ - avg_;
+  avg_ += delta * other.weight_ / weight;
+  m2_ += other.m2_ + delta * delta * weight_ * other.weight_ / weight;
+  weight_ = weight;
+  n_ += other.n_;
+}
+
+void RunningAverage::Clear() { *this = RunningAverage(); }
+
+double RunningAverage::getVariance() const {
+  if (weight_ == 0.0) {
+    return 0.0;
+  }
+  return m2_ / weight_;
+}
+
+double RunningAverage::getSig() const { return std::sqrt(getVariance()); }
+
+double RunningAverage::getErr() const {
+  if (n_ < 2) {
+    return 0.0;
+  }
+  return std::sqrt(getVariance() / double(n_ - 1));
+}
+
+}  // namespace tools
+}  // namespace votca
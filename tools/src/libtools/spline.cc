@@ -15,6 +15,10 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
 // Local VOTCA includes
 #include "votca/tools/spline.h"
 
@@ -34,6 +38,7 @@ Index Spline::GenerateGrid(double min, double max, double h) {
     r_[i++] = r_init;
   }
   r_[i] = max;
+  AnalyzeGrid();
   return r_.size();
 }
 
@@ -59,20 +64,52 @@ void Spline::Print(std::ostream &out, double interval) {
   }
 }
 
+void Spline::AnalyzeGrid() {
+  grid_size_ = r_.size();
+  uniform_ = false;
+  if (r_.size() < 2) {
+    return;
+  }
+  double h = (r_[r_.size() - 1] - r_[0]) / double(r_.size() - 1);
+  if (!(h > 0.0)) {
+    return;
+  }
+  // the guess only has to be within one interval, the exact interval is then
+  // found by comparing with the neighbouring grid points
+  for (Index i = 1; i < r_.size(); ++i) {
+    if (std::abs(r_[i] - r_[0] - double(i) * h) > 0.25 * h) {
+      return;
+    }
+  }
+  uniform_ = true;
+  inv_h_ = 1.0 / h;
+}
+
+// returns the largest i <= N-2 with r_[i] <= r, or 0 if there is none
 Index Spline::getInterval(double r) {
-  if (r < r_[0]) {
+  if (grid_size_ != r_.size()) {
+    AnalyzeGrid();
+  }
+  const Index last = r_.size() - 2;
+  if (!(r > r_[0])) {
     return 0;
   }
-  if (r > r_[r_.size() - 2]) {
-    return r_.size() - 2;
+  if (r >= r_[last]) {
+    return last;
   }
-  Index i;
-  for (i = 0; i < r_.size(); ++i) {
-    if (r_[i] > r) {
-      break;
+  if (uniform_) {
+    Index i = std::min(Index((r - r_[0]) * inv_h_), last);
+    while (r_[i] > r) {
+      --i;
+    }
+    while (r_[i + 1] <= r) {
+      ++i;
     }
+    return i;
   }
-  return i - 1;
+  const double *begin = r_.data() + 1;
+  const double *end = r_.data() + last;
+  return Index(std::upper_bound(begin, end, r) - begin);
 }
 
 double Spline::getGridPoint(int i) {
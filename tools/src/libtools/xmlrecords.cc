@@ -0,0 +1,196 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <stack>
+#include <stdexcept>
+
+// Third party includes
+#include <expat.h>
+
+// Local VOTCA includes
+#include "votca/tools/tokenizer.h"
+#include "votca/tools/xmlrecords.h"
+
+namespace votca {
+namespace tools {
+
+namespace {
+
+/// State of the expat handlers while records are streamed
+struct RecordParser {
+  XML_Parser parser;
+  std::vector<std::string> record_path;
+  std::string record_parent_path;
+  const std::vector<std::string> *skip;
+  const std::function<void(XMLRecord &)> *callback;
+
+  /// depth of the current element, the root element has depth 1
+  Index depth = 0;
+  /// number of open elements that match the start of record_path
+  Index path_matched = 0;
+  XMLRecord record;
+  std::stack<Property *> open;
+  /// depth of the skipped element that is currently read, -1 if none
+  Index skip_depth = -1;
+  std::string skip_name;
+  std::streamoff skip_begin = 0;
+  /// exceptions must not be thrown through the C code of expat
+  std::exception_ptr error = nullptr;
+
+  std::streamoff Position() const {
+    return std::streamoff(XML_GetCurrentByteIndex(parser));
+  }
+  std::streamoff EndPosition() const {
+    return Position() + std::streamoff(XML_GetCurrentByteCount(parser));
+  }
+};
+
+void StartRecordElement(void *data, const char *el, const char **attr) {
+  RecordParser &p = *static_cast<RecordParser *>(data);
+  ++p.depth;
+  if (p.skip_depth >= 0 || p.error) {
+    return;
+  }
+  Index record_depth = Index(p.record_path.size());
+  if (!p.open.empty()) {
+    if (p.depth == record_depth + 1 &&
+        std::find(p.skip->begin(), p.skip->end(), el) != p.skip->end()) {
+      p.skip_depth = p.depth;
+      p.skip_name = el;
+      p.skip_begin = p.Position();
+      return;
+    }
+    Property &child = p.open.top()->add(el, "");
+    for (Index i = 0; attr[i]; i += 2) {
+      child.setAttribute(attr[i], attr[i + 1]);
+    }
+    p.open.push(&child);
+    return;
+  }
+  if (p.path_matched == p.depth - 1 && p.depth <= record_depth &&
+      p.record_path[p.depth - 1] == el) {
+    p.path_matched = p.depth;
+    if (p.depth == record_depth) {
+      p.record = XMLRecord();
+      p.record.element = Property(el, "", p.record_parent_path);
+      for (Index i = 0; attr[i]; i += 2) {
+        p.record.element.setAttribute(attr[i], attr[i + 1]);
+      }
+      p.open.push(&p.record.element);
+    }
+  }
+}
+
+void EndRecordElement(void *data, const char *) {
+  RecordParser &p = *static_cast<RecordParser *>(data);
+  if (p.error) {
+    --p.depth;
+    return;
+  }
+  if (p.skip_depth == p.depth) {
+    p.record.skipped[p.skip_name] = {p.skip_begin, p.EndPosition()};
+    p.skip_depth = -1;
+  } else if (p.skip_depth < 0 && !p.open.empty()) {
+    p.open.pop();
+    if (p.open.empty()) {
+      try {
+        (*p.callback)(p.record);
+      } catch (...) {
+        p.error = std::current_exception();
+        XML_StopParser(p.parser, XML_FALSE);
+      }
+    }
+  }
+  if (p.path_matched == p.depth) {
+    p.path_matched = p.depth - 1;
+  }
+  --p.depth;
+}
+
+void RecordCharacters(void *data, const char *txt, int txtlen) {
+  RecordParser &p = *static_cast<RecordParser *>(data);
+  if (p.skip_depth < 0 && !p.open.empty()) {
+    p.open.top()->value().append(txt, txtlen);
+  }
+}
+
+}  // namespace
+
+void ReadXMLRecords(const std::string &filename,
+                    const std::string &record_path,
+                    const std::vector<std::string> &skip,
+                    const std::function<void(XMLRecord &)> &callback) {
+  std::ifstream fl(filename, std::ios::binary);
+  if (!fl.is_open()) {
+    throw std::ios_base::failure("Error on open xml file: " + filename);
+  }
+
+  RecordParser state;
+  state.record_path = Tokenizer(record_path, ".").ToVector();
+  if (state.record_path.empty()) {
+    throw std::invalid_argument("ReadXMLRecords: empty record path");
+  }
+  for (std::size_t i = 0; i + 1 < state.record_path.size(); ++i) {
+    if (i > 0) {
+      state.record_parent_path += ".";
+    }
+    state.record_parent_path += state.record_path[i];
+  }
+  state.skip = &skip;
+  state.callback = &callback;
+
+  state.parser = XML_ParserCreate(nullptr);
+  if (!state.parser) {
+    throw std::runtime_error("Couldn't allocate memory for xml parser");
+  }
+  XML_SetUserData(state.parser, &state);
+  XML_SetElementHandler(state.parser, StartRecordElement, EndRecordElement);
+  XML_SetCharacterDataHandler(state.parser, RecordCharacters);
+
+  const std::size_t chunk_size = 1 << 16;
+  std::vector<char> buffer(chunk_size);
+  bool done = false;
+  while (!done) {
+    fl.read(buffer.data(), std::streamsize(chunk_size));
+    std::streamsize count = fl.gcount();
+    done = fl.eof() || count == 0;
+    XML_Status status =
+        XML_Parse(state.parser, buffer.data(), int(count), done);
+    if (state.error) {
+      XML_ParserFree(state.parser);
+      std::rethrow_exception(state.error);
+    }
+    if (status != XML_STATUS_OK) {
+      std::string message =
+          filename + ": Parse error at line " +
+          std::to_string(XML_GetCurrentLineNumber(state.parser)) + "\n" +
+          XML_ErrorString(XML_GetErrorCode(state.parser));
+      XML_ParserFree(state.parser);
+      throw std::ios_base::failure(message);
+    }
+  }
+  XML_ParserFree(state.parser);
+}
+
+}  // namespace tools
+}  // namespace votca
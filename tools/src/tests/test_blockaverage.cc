@@ -0,0 +1,124 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE blockaverage_test
+
+// Standard includes
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/blockaverage.h"
+
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(blockaverage_test)
+
+std::vector<double> Series(Index n, Index correlation_length) {
+  std::mt19937 generator(5);
+  std::normal_distribution<double> distribution(1.0, 2.0);
+  std::vector<double> values(n);
+  for (Index i = 0; i < n; i++) {
+    values[i] =
+        (i % correlation_length == 0) ? distribution(generator) : values[i - 1];
+  }
+  return values;
+}
+
+BOOST_AUTO_TEST_CASE(levels_test) {
+  BlockAverage block;
+  BOOST_CHECK_EQUAL(block.getN(), 0);
+  BOOST_CHECK_EQUAL(block.getError(), 0.0);
+  for (double x : {1.0, 2.0, 3.0, 4.0, 5.0}) {
+    block.Process(x);
+  }
+  BOOST_CHECK_EQUAL(block.getN(), 5);
+  BOOST_CHECK_EQUAL(block.getAvg(), 3.0);
+  BOOST_CHECK_EQUAL(block.getLevels(), 3);
+  BOOST_CHECK_EQUAL(block.getBlocks(1), 2);
+  BOOST_CHECK_EQUAL(block.getBlocks(2), 1);
+  // block means 1.5 and 3.5
+  BOOST_CHECK_CLOSE(block.getLevelError(1), 1.0, 1e-12);
+  BOOST_CHECK_CLOSE(block.getLevelError(0), std::sqrt(2.0 / 4.0), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(correlated_test) {
+  std::vector<double> values = Series(1 << 14, 16);
+  BlockAverage block;
+  for (double x : values) {
+    block.Process(x);
+  }
+  // the naive error underestimates the error by sqrt(16)
+  double naive = block.getLevelError(0);
+  BOOST_CHECK_CLOSE(block.getLevelError(4), 4.0 * naive, 10);
+  BOOST_CHECK(block.getError() >= block.getLevelError(4));
+  BOOST_CHECK(block.getError() < 6.0 * naive);
+}
+
+BOOST_AUTO_TEST_CASE(offset_test) {
+  // a large mean must not swamp the small variance of the blocks
+  std::vector<double> values = Series(1024, 4);
+  BlockAverage block;
+  BlockAverage shifted;
+  for (double x : values) {
+    block.Process(x);
+    shifted.Process(x + 1e9);
+  }
+  for (Index level = 0; level < block.getLevels(); level++) {
+    BOOST_CHECK_CLOSE(shifted.getLevelError(level), block.getLevelError(level),
+                      1e-3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(merge_test) {
+  std::vector<double> values = Series(256, 4);
+  BlockAverage all;
+  BlockAverage first;
+  BlockAverage second;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    all.Process(values[i]);
+    (i < 128 ? first : second).Process(values[i]);
+  }
+  first.Merge(second);
+  BOOST_CHECK_EQUAL(first.getN(), all.getN());
+  BOOST_CHECK_CLOSE(first.getAvg(), all.getAvg(), 1e-12);
+  BOOST_REQUIRE_EQUAL(first.getLevels(), all.getLevels());
+  for (Index level = 0; level < all.getLevels(); level++) {
+    BOOST_CHECK_EQUAL(first.getBlocks(level), all.getBlocks(level));
+    BOOST_CHECK_CLOSE(first.getLevelError(level), all.getLevelError(level),
+                      1e-9);
+  }
+
+  // incomplete blocks at the end of both series are paired
+  BlockAverage odd1;
+  BlockAverage odd2;
+  odd1.Process(1.0);
+  odd2.Process(3.0);
+  odd1.Merge(odd2);
+  BOOST_CHECK_EQUAL(odd1.getLevels(), 2);
+  BOOST_CHECK_EQUAL(odd1.getBlocks(1), 1);
+  BOOST_CHECK_EQUAL(odd1.getAvg(), 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
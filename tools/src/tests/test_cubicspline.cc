@@ -27,6 +27,7 @@
 
 // Local VOTCA includes
 #include "votca/tools/cubicspline.h"
+#include "votca/tools/linalg.h"
 
 using namespace votca::tools;
 
@@ -189,4 +190,80 @@ BOOST_AUTO_TEST_CASE(cubicspline_matrix_test) {
   BOOST_CHECK_EQUAL(equalMatrix, true);
 }
 
+BOOST_AUTO_TEST_CASE(cubicspline_interval_test) {
+
+  // reference: the largest grid point left of r, clamped to the intervals
+  auto interval_ref = [](const Eigen::VectorXd& grid, double r) {
+    votca::Index i = 0;
+    while (i < grid.size() - 2 && grid(i + 1) <= r) {
+      ++i;
+    }
+    return i;
+  };
+
+  CubicSpline uniform;
+  uniform.GenerateGrid(0.3, 1.2, 0.01);
+  Eigen::VectorXd nonuniform_x = Eigen::VectorXd::Zero(20);
+  for (votca::Index i = 0; i < nonuniform_x.size(); ++i) {
+    nonuniform_x(i) = 0.3 + 0.9 * std::pow(double(i) / 19.0, 2);
+  }
+  CubicSpline nonuniform;
+  nonuniform.setBCInt(0);
+  nonuniform.Interpolate(nonuniform_x, nonuniform_x.array().sin().matrix());
+
+  for (CubicSpline* spline : {&uniform, &nonuniform}) {
+    const Eigen::VectorXd grid = spline->getX();
+    bool equal = true;
+    for (votca::Index i = 0; i < grid.size(); ++i) {
+      equal = equal &&
+              spline->getInterval(grid(i)) == interval_ref(grid, grid(i));
+    }
+    for (double r = 0.0; r < 1.5; r += 0.0037) {
+      equal = equal && spline->getInterval(r) == interval_ref(grid, r);
+    }
+    BOOST_CHECK_EQUAL(equal, true);
+  }
+
+  Eigen::VectorXd rs = Eigen::VectorXd::LinSpaced(50, 0.2, 1.3);
+  Eigen::VectorXd values = nonuniform.Calculate(rs);
+  Eigen::VectorXd derivatives = nonuniform.CalculateDerivative(rs);
+  for (votca::Index i = 0; i < rs.size(); ++i) {
+    BOOST_CHECK_CLOSE(values(i), nonuniform.Calculate(rs(i)), 1e-10);
+    BOOST_CHECK_CLOSE(derivatives(i), nonuniform.CalculateDerivative(rs(i)),
+                      1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cubicspline_fit_derivativezero_test) {
+
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(40, 0.0, 2.0);
+  Eigen::VectorXd y = (3 * x).array().cos().matrix();
+  CubicSpline cspline;
+  cspline.setBCInt(2);
+  cspline.GenerateGrid(0.0, 2.0, 0.25);
+  cspline.Fit(x, y);
+
+  // solve the constrained problem with both f and f'' as unknowns instead
+  votca::Index ngrid = cspline.getX().size();
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(x.size(), 2 * ngrid);
+  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(ngrid, 2 * ngrid);
+  cspline.AddBCToFitMatrix(B, 0);
+  cspline.AddToFitMatrix(A, x, 0);
+  Eigen::VectorXd sol = linalg_constrained_qrsolve(A, y, B);
+  CubicSpline ref;
+  ref.setBCInt(2);
+  ref.GenerateGrid(0.0, 2.0, 0.25);
+  ref.setSplineData(sol.head(ngrid), sol.tail(ngrid));
+
+  Eigen::VectorXd rs = Eigen::VectorXd::LinSpaced(17, 0.0, 2.0);
+  bool equal = ref.Calculate(rs).isApprox(cspline.Calculate(rs), 1e-8);
+  if (!equal) {
+    std::cout << "result value" << std::endl;
+    std::cout << cspline.Calculate(rs).transpose() << std::endl;
+    std::cout << "ref value" << std::endl;
+    std::cout << ref.Calculate(rs).transpose() << std::endl;
+  }
+  BOOST_CHECK_EQUAL(equal, true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
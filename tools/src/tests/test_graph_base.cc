@@ -23,6 +23,7 @@
 #include <cmath>
 #include <exception>
 #include <iostream>
+#include <thread>
 
 // Third party includes
 #include <boost/test/unit_test.hpp>
@@ -631,6 +632,26 @@ BOOST_AUTO_TEST_CASE(id_test) {
     m_gn[5] = gn5;
     Graph g4(vec_ed, m_gn);
     BOOST_CHECK(g != g4);
+
+    /// Copies carry the id along, also when it still has to be calculated
+    Graph g5(g4);
+    BOOST_CHECK_EQUAL(g5.getId(), g4.getId());
+    g5 = g;
+    BOOST_CHECK_EQUAL(g5.getId(), str);
+
+    /// The id of a const graph can be requested by several threads at once
+    const Graph g6(vec_ed, m_gn);
+    vector<string> ids(4);
+    vector<std::thread> workers;
+    for (std::size_t i = 0; i < ids.size(); i++) {
+      workers.emplace_back([&g6, &ids, i]() { ids[i] = g6.getId(); });
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    for (const string& id : ids) {
+      BOOST_CHECK_EQUAL(id, g4.getId());
+    }
   }
 }
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE histogram2d_test
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/histogram2d.h"
+
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(histogram2d_test)
+
+BOOST_AUTO_TEST_CASE(process_test) {
+  Histogram2D hist;
+  hist.Initialize(0.0, 10.0, 11, -1.0, 1.0, 3);
+  BOOST_CHECK_EQUAL(hist.getNBinsX(), 11);
+  BOOST_CHECK_EQUAL(hist.getNBinsY(), 3);
+  BOOST_CHECK_EQUAL(hist.getStepX(), 1.0);
+  BOOST_CHECK_EQUAL(hist.getStepY(), 1.0);
+  BOOST_CHECK_EQUAL(hist.getX(3), 3.0);
+  BOOST_CHECK_EQUAL(hist.getY(0), -1.0);
+
+  hist.Process(2.9, 0.2);
+  hist.Process(3.4, -0.4, 2.0);
+  // outside of the non periodic axes
+  hist.Process(11.0, 0.0);
+  hist.Process(5.0, 1.6);
+  BOOST_CHECK_EQUAL(hist.data()(3, 1), 3.0);
+  BOOST_CHECK_EQUAL(hist.data().sum(), 3.0);
+
+  hist.Normalize();
+  BOOST_CHECK_CLOSE(hist.data().sum(), 1.0, 1e-12);
+  hist.Clear();
+  BOOST_CHECK_EQUAL(hist.data().sum(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(periodic_test) {
+  Histogram2D hist;
+  hist.setPeriodic(false, true);
+  hist.Initialize(0.0, 1.0, 2, -180.0, 180.0, 36);
+  BOOST_CHECK_EQUAL(hist.getStepY(), 10.0);
+  hist.Process(0.0, 178.0);
+  hist.Process(0.0, -182.0);
+  hist.Process(1.0, 540.0);
+  BOOST_CHECK_EQUAL(hist.data()(0, 0), 2.0);
+  BOOST_CHECK_EQUAL(hist.data()(1, 0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(merge_test) {
+  Histogram2D hist1;
+  hist1.Initialize(0.0, 1.0, 2, 0.0, 1.0, 2);
+  Histogram2D hist2 = hist1;
+  hist1.Process(0.0, 1.0);
+  hist2.Process(0.0, 1.0, 0.5);
+  hist2.Process(1.0, 0.0);
+  hist1.Merge(hist2);
+  BOOST_CHECK_EQUAL(hist1.data()(0, 1), 1.5);
+  BOOST_CHECK_EQUAL(hist1.data()(1, 0), 1.0);
+
+  Histogram2D other;
+  other.Initialize(0.0, 1.0, 2, 0.0, 2.0, 2);
+  BOOST_CHECK_THROW(hist1.Merge(other), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -114,4 +114,21 @@ BOOST_AUTO_TEST_CASE(minmax_test) {
   BOOST_CHECK_EQUAL(static_cast<votca::Index>(hn.getMaxBinVal()), 2);
 }
 
+BOOST_AUTO_TEST_CASE(merge_test) {
+  HistogramNew hn1;
+  hn1.Initialize(0.0, 10.0, 11);
+  HistogramNew hn2 = hn1;
+  hn1.Process(2.0);
+  hn2.Process(2.0, 0.5);
+  hn2.Process(7.0);
+  hn1.Merge(hn2);
+  BOOST_CHECK_EQUAL(hn1.data().y(2), 1.5);
+  BOOST_CHECK_EQUAL(hn1.data().y(7), 1.0);
+  BOOST_CHECK_EQUAL(hn1.data().y().sum(), 2.5);
+
+  HistogramNew other;
+  other.Initialize(0.0, 10.0, 10);
+  BOOST_CHECK_THROW(hn1.Merge(other), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE labeledgraph_test
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/graph.h"
+#include "votca/tools/labeledgraph.h"
+
+using namespace std;
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(labeledgraph_test)
+
+BOOST_AUTO_TEST_CASE(constructor_test) {
+  LabeledGraph empty;
+  BOOST_CHECK_EQUAL(empty.VertexCount(), 0);
+  BOOST_CHECK(empty.isIsomorphic(LabeledGraph()));
+
+  // Duplicate edges are only stored once
+  LabeledGraph g({1, 2, 1}, {{0, 1}, {2, 1}, {1, 0}});
+  BOOST_CHECK_EQUAL(g.VertexCount(), 3);
+  BOOST_CHECK_EQUAL(g.EdgeCount(), 2);
+  BOOST_CHECK(g.edgeExist(1, 2));
+  BOOST_CHECK(!g.edgeExist(0, 2));
+  vector<Index> neigh = g.getNeighVertices(1);
+  BOOST_CHECK(neigh == vector<Index>({0, 2}));
+
+  BOOST_CHECK_THROW(LabeledGraph({1, 2}, {{0, 2}}), invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(hash_test) {
+  // A - B - A with different numbering of the vertices
+  LabeledGraph g1({1, 2, 1}, {{0, 1}, {1, 2}});
+  LabeledGraph g2({2, 1, 1}, {{1, 0}, {0, 2}});
+  BOOST_CHECK_EQUAL(g1.getHash(), g2.getHash());
+  BOOST_CHECK(g1.isIsomorphic(g2));
+
+  // A - A - B
+  LabeledGraph g3({1, 1, 2}, {{0, 1}, {1, 2}});
+  BOOST_CHECK(g1.getHash() != g3.getHash());
+  BOOST_CHECK(!g1.isIsomorphic(g3));
+
+  // A six ring and two three rings can not be told apart by the refinement
+  // alone, the verification has to reject them
+  vector<uint64_t> labels(6, 1);
+  LabeledGraph ring6(labels, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0}});
+  LabeledGraph rings3(labels,
+                      {{0, 1}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}});
+  BOOST_CHECK_EQUAL(ring6.getHash(), rings3.getHash());
+  BOOST_CHECK(!ring6.isIsomorphic(rings3));
+  LabeledGraph ring6_shuffled(labels,
+                              {{3, 0}, {0, 5}, {5, 1}, {1, 4}, {4, 2}, {2, 3}});
+  BOOST_CHECK(ring6.isIsomorphic(ring6_shuffled));
+}
+
+BOOST_AUTO_TEST_CASE(graph_test) {
+  unordered_map<string, string> name_c = {{"Name", "C"}};
+  unordered_map<string, string> name_h = {{"Name", "H"}};
+  GraphNode carbon;
+  carbon.setStr(name_c);
+  GraphNode hydrogen;
+  hydrogen.setStr(name_h);
+
+  // Methyl group with vertex ids that are not contiguous
+  unordered_map<Index, GraphNode> nodes = {
+      {10, carbon}, {3, hydrogen}, {7, hydrogen}, {12, hydrogen}};
+  Graph methyl({Edge(10, 3), Edge(10, 7), Edge(12, 10)}, nodes);
+  LabeledGraph g1(methyl);
+  BOOST_CHECK_EQUAL(g1.VertexCount(), 4);
+  BOOST_CHECK_EQUAL(g1.EdgeCount(), 3);
+
+  unordered_map<Index, GraphNode> nodes2 = {
+      {0, hydrogen}, {1, hydrogen}, {2, carbon}, {5, hydrogen}};
+  Graph methyl2({Edge(2, 0), Edge(1, 2), Edge(2, 5)}, nodes2);
+  LabeledGraph g2(methyl2);
+  BOOST_CHECK_EQUAL(g1.getHash(), g2.getHash());
+  BOOST_CHECK(g1.isIsomorphic(g2));
+
+  Graph chain({Edge(2, 0), Edge(0, 1), Edge(2, 5)}, nodes2);
+  LabeledGraph g3(chain);
+  BOOST_CHECK(g1.getHash() != g3.getHash());
+  BOOST_CHECK(!g1.isIsomorphic(g3));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -68,4 +68,80 @@ BOOST_AUTO_TEST_CASE(linalg_constrained_qrsolve_test) {
   BOOST_CHECK_EQUAL(equal, true);
 }
 
+BOOST_AUTO_TEST_CASE(linalg_tridiagonal_solve_test) {
+
+  votca::Index size = 7;
+  Eigen::VectorXd lower = Eigen::VectorXd::Random(size - 1);
+  Eigen::VectorXd upper = Eigen::VectorXd::Random(size - 1);
+  Eigen::VectorXd diag = Eigen::VectorXd::Constant(size, 4.0);
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(size, size);
+  A.diagonal() = diag;
+  A.diagonal(-1) = lower;
+  A.diagonal(1) = upper;
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(size, 2);
+
+  Eigen::MatrixXd x = linalg_tridiagonal_solve(lower, diag, upper, b);
+  Eigen::MatrixXd x_ref = A.partialPivLu().solve(b);
+
+  bool equal = x_ref.isApprox(x, 1e-12);
+  if (!equal) {
+    std::cout << "result" << std::endl;
+    std::cout << x << std::endl;
+    std::cout << "ref" << std::endl;
+    std::cout << x_ref << std::endl;
+  }
+  BOOST_CHECK_EQUAL(equal, true);
+
+  diag(0) = 0.0;
+  upper(0) = 0.0;
+  BOOST_CHECK_THROW(linalg_tridiagonal_solve(lower, diag, upper, b),
+                    std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(linalg_eigenvalues_test) {
+  votca::Index size = 40;
+  Eigen::MatrixXd R = Eigen::MatrixXd::Random(size, size);
+  Eigen::MatrixXd A = R + R.transpose();
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> ref(A);
+  EigenSystem result = linalg_eigenvalues(A);
+  BOOST_CHECK_EQUAL(result.info(), Eigen::Success);
+  BOOST_CHECK(result.eigenvalues().isApprox(ref.eigenvalues(), 1e-10));
+  Eigen::MatrixXd V = result.eigenvectors();
+  BOOST_CHECK(
+      (A * V).isApprox(V * result.eigenvalues().asDiagonal(), 1e-10));
+  BOOST_CHECK((V.transpose() * V)
+                  .isApprox(Eigen::MatrixXd::Identity(size, size), 1e-10));
+
+  // only the lower triangle is used
+  Eigen::MatrixXd lower = A.triangularView<Eigen::Lower>();
+  BOOST_CHECK(linalg_eigenvalues(lower).eigenvalues().isApprox(
+      ref.eigenvalues(), 1e-10));
+
+  BOOST_CHECK_EQUAL(linalg_eigenvalues(Eigen::MatrixXd(0, 0)).info(),
+                    Eigen::Success);
+}
+
+BOOST_AUTO_TEST_CASE(linalg_eigenvalues_nmax_test) {
+  votca::Index size = 50;
+  votca::Index nmax = 6;
+  Eigen::MatrixXd R = Eigen::MatrixXd::Random(size, size);
+  Eigen::MatrixXd A = R + R.transpose();
+
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> ref(A);
+  EigenSystem result = linalg_eigenvalues(A, nmax);
+  BOOST_CHECK_EQUAL(result.info(), Eigen::Success);
+  BOOST_REQUIRE_EQUAL(result.eigenvalues().size(), nmax);
+  BOOST_REQUIRE_EQUAL(result.eigenvectors().cols(), nmax);
+  BOOST_CHECK(
+      result.eigenvalues().isApprox(ref.eigenvalues().head(nmax), 1e-10));
+  Eigen::MatrixXd V = result.eigenvectors();
+  BOOST_CHECK(
+      (A * V).isApprox(V * result.eigenvalues().asDiagonal(), 1e-10));
+
+  BOOST_CHECK_EQUAL(linalg_eigenvalues(A, size + 3).eigenvalues().size(),
+                    size);
+  BOOST_CHECK_EQUAL(linalg_eigenvalues(A, 0).eigenvectors().cols(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE numberparser_test
+
+// Standard includes
+#include <string>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/numberparser.h"
+#include "votca/tools/types.h"
+
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(numberparser_test)
+
+BOOST_AUTO_TEST_CASE(nextline_test) {
+  std::string text = "first line\r\nsecond\n\nlast";
+  std::string_view view = text;
+  BOOST_CHECK_EQUAL(NextLine(view), "first line");
+  BOOST_CHECK_EQUAL(NextLine(view), "second");
+  BOOST_CHECK_EQUAL(NextLine(view), "");
+  BOOST_CHECK_EQUAL(NextLine(view), "last");
+  BOOST_CHECK(view.empty());
+}
+
+BOOST_AUTO_TEST_CASE(nextword_test) {
+  std::string text = "  1 \t type   3.5e-2 ";
+  std::string_view view = text;
+  BOOST_CHECK_EQUAL(NextWord(view), "1");
+  BOOST_CHECK_EQUAL(NextWord(view), "type");
+  BOOST_CHECK_EQUAL(NextWord(view), "3.5e-2");
+  BOOST_CHECK_EQUAL(NextWord(view), "");
+  BOOST_CHECK(view.empty());
+}
+
+BOOST_AUTO_TEST_CASE(parsenumber_test) {
+  BOOST_CHECK_EQUAL(ParseNumber<votca::Index>("42"), 42);
+  BOOST_CHECK_EQUAL(ParseNumber<votca::Index>("-7"), -7);
+  BOOST_CHECK_EQUAL(ParseNumber<votca::Index>("+7"), 7);
+  BOOST_CHECK_CLOSE(ParseNumber<double>("-2.912328"), -2.912328, 1e-12);
+  BOOST_CHECK_CLOSE(ParseNumber<double>("1.5E+03"), 1500.0, 1e-12);
+  BOOST_CHECK_CLOSE(ParseNumber<double>("+0.25"), 0.25, 1e-12);
+
+  std::string line = "3 0.5 -1e-3";
+  std::string_view view = line;
+  BOOST_CHECK_EQUAL(ParseNextNumber<votca::Index>(view), 3);
+  BOOST_CHECK_CLOSE(ParseNextNumber<double>(view), 0.5, 1e-12);
+  BOOST_CHECK_CLOSE(ParseNextNumber<double>(view), -1e-3, 1e-12);
+
+  BOOST_CHECK_THROW(ParseNumber<double>("1.0x"), std::runtime_error);
+  BOOST_CHECK_THROW(ParseNumber<double>(""), std::runtime_error);
+  BOOST_CHECK_THROW(ParseNumber<votca::Index>("1.5"), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
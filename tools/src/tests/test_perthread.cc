@@ -0,0 +1,82 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE perthread_test
+
+// Standard includes
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/histogramnew.h"
+#include "votca/tools/perthread.h"
+#include "votca/tools/runningaverage.h"
+
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(perthread_test)
+
+BOOST_AUTO_TEST_CASE(alignment_test) {
+  PerThread<RunningAverage> avg(3);
+  BOOST_CHECK_EQUAL(avg.size(), 3);
+  for (Index i = 0; i < avg.size(); i++) {
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(&avg[i]);
+    BOOST_CHECK_EQUAL(address % PerThread<RunningAverage>::CacheLineSize, 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(reduce_test) {
+  HistogramNew initial;
+  initial.Initialize(0.0, 3.0, 4);
+  const Index nthreads = 4;
+  PerThread<HistogramNew> hist(nthreads, initial);
+  PerThread<RunningAverage> avg(nthreads);
+
+  std::vector<std::thread> threads;
+  for (Index t = 0; t < nthreads; t++) {
+    threads.emplace_back([&hist, &avg, t]() {
+      for (Index i = 0; i < 1000; i++) {
+        hist[t].Process(double(t));
+        avg[t].Process(double(t));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  HistogramNew total = hist.Reduce();
+  for (Index t = 0; t < nthreads; t++) {
+    BOOST_CHECK_EQUAL(total.data().y(t), 1000.0);
+  }
+  RunningAverage average = avg.Reduce();
+  BOOST_CHECK_EQUAL(average.getN(), 4000);
+  BOOST_CHECK_CLOSE(average.getAvg(), 1.5, 1e-12);
+  BOOST_CHECK_CLOSE(average.getVariance(), 1.25, 1e-12);
+
+  PerThread<RunningAverage> empty;
+  BOOST_CHECK_THROW(empty.Reduce(), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
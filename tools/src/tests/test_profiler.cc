@@ -0,0 +1,162 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE profiler_test
+
+// Standard includes
+#include <sstream>
+#include <thread>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/profiler.h"
+
+using namespace votca::tools;
+using votca::Index;
+
+BOOST_AUTO_TEST_SUITE(profiler_test)
+
+BOOST_AUTO_TEST_CASE(disabled) {
+  Profiler::Enable(false);
+  Profiler::Reset();
+  {
+    ScopedTimer timer("disabled");
+    timer.AddBytes(10);
+  }
+  BOOST_CHECK(Profiler::Report().Select("region").empty());
+}
+
+BOOST_AUTO_TEST_CASE(nested_regions) {
+  Profiler::Enable();
+  Profiler::Reset();
+  {
+    ScopedTimer outer("outer");
+    for (Index i = 0; i < 3; i++) {
+      ScopedTimer inner("inner", 8);
+    }
+    ScopedTimer other("other");
+    other.AddBytes(5);
+    other.Stop();
+  }
+  Profiler::Enable(false);
+
+  Property report = Profiler::Report();
+  std::vector<Property *> regions = report.Select("region");
+  BOOST_REQUIRE_EQUAL(regions.size(), 1);
+  Property &outer = *regions[0];
+  BOOST_CHECK_EQUAL(outer.getAttribute<std::string>("name"), "outer");
+  BOOST_CHECK_EQUAL(outer.getAttribute<Index>("calls"), 1);
+  BOOST_CHECK_EQUAL(outer.getAttribute<Index>("threads"), 1);
+  BOOST_CHECK(outer.getAttribute<double>("self") <=
+              outer.getAttribute<double>("total"));
+
+  std::vector<Property *> nested = outer.Select("region");
+  BOOST_REQUIRE_EQUAL(nested.size(), 2);
+  BOOST_CHECK_EQUAL(nested[0]->getAttribute<std::string>("name"), "inner");
+  BOOST_CHECK_EQUAL(nested[0]->getAttribute<Index>("calls"), 3);
+  BOOST_CHECK_EQUAL(nested[0]->getAttribute<Index>("bytes"), 24);
+  BOOST_CHECK_EQUAL(nested[1]->getAttribute<std::string>("name"), "other");
+  BOOST_CHECK_EQUAL(nested[1]->getAttribute<Index>("bytes"), 5);
+
+  Profiler::Reset();
+  BOOST_CHECK(Profiler::Report().Select("region").empty());
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+  Profiler::Enable();
+  Profiler::Reset();
+  std::vector<std::thread> workers;
+  for (Index i = 0; i < 2; i++) {
+    workers.emplace_back([]() { ScopedTimer timer("work", 1); });
+  }
+  for (std::thread &thread : workers) {
+    thread.join();
+  }
+  Profiler::Enable(false);
+
+  std::vector<Property *> regions = Profiler::Report().Select("region");
+  BOOST_REQUIRE_EQUAL(regions.size(), 1);
+  BOOST_CHECK_EQUAL(regions[0]->getAttribute<Index>("calls"), 2);
+  BOOST_CHECK_EQUAL(regions[0]->getAttribute<Index>("threads"), 2);
+  BOOST_CHECK_EQUAL(regions[0]->getAttribute<Index>("bytes"), 2);
+}
+
+BOOST_AUTO_TEST_CASE(thread_report) {
+  Profiler::Enable();
+  Profiler::Reset();
+  {
+    ScopedTimer jobs("jobs");
+    {
+      ScopedTimer job("job");
+    }
+    Property first = Profiler::TakeThreadReport();
+    std::vector<Property *> regions = first.Select("region");
+    BOOST_REQUIRE_EQUAL(regions.size(), 1);
+    // the enclosing region is still running
+    BOOST_CHECK_EQUAL(regions[0]->getAttribute<Index>("calls"), 0);
+    BOOST_CHECK_EQUAL(regions[0]->Select("region").size(), 1);
+    BOOST_CHECK(Profiler::TakeThreadReport().Select("region").empty());
+    {
+      ScopedTimer job("job");
+    }
+    Property second = Profiler::TakeThreadReport();
+    BOOST_CHECK_EQUAL(
+        second.get("region.region").getAttribute<Index>("calls"), 1);
+  }
+  Profiler::Enable(false);
+
+  // the report of all threads still holds both jobs
+  Property report = Profiler::Report();
+  BOOST_CHECK_EQUAL(report.get("region.region").getAttribute<Index>("calls"),
+                    2);
+}
+
+BOOST_AUTO_TEST_CASE(write_report) {
+  Profiler::Enable();
+  Profiler::Reset();
+  {
+    ScopedTimer outer("outer");
+    ScopedTimer inner("inner \"quoted\"");
+  }
+  Profiler::Enable(false);
+  Property report = Profiler::Report();
+
+  std::stringstream text;
+  Profiler::WriteReport(text, report, Profiler::TEXT);
+  std::string line;
+  std::getline(text, line);
+  BOOST_CHECK_EQUAL(line.substr(0, 6), "region");
+  std::getline(text, line);
+  BOOST_CHECK_EQUAL(line.substr(0, 5), "outer");
+  std::getline(text, line);
+  BOOST_CHECK_EQUAL(line.substr(0, 7), "  inner");
+
+  std::stringstream json;
+  Profiler::WriteReport(json, report, Profiler::JSON);
+  std::string output = json.str();
+  BOOST_CHECK_EQUAL(output.substr(0, 13), "{\"regions\": [");
+  BOOST_CHECK(output.find("\"name\": \"outer\", \"calls\": 1") !=
+              std::string::npos);
+  BOOST_CHECK(output.find("\"name\": \"inner \\\"quoted\\\"\"") !=
+              std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
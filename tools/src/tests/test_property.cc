@@ -206,4 +206,36 @@ BOOST_AUTO_TEST_CASE(addTree) {
   BOOST_CHECK(three.exists("a.b.c"));
 }
 
+BOOST_AUTO_TEST_CASE(propertypath) {
+  Property prop;
+  Property& b = prop.addTree("a.b", "");
+  b.add("c", "1");
+  b.add("c", "2");
+  b.add("d", "3");
+
+  PropertyPath path(".a..b.c");
+  BOOST_CHECK_EQUAL(path.str(), ".a..b.c");
+  BOOST_CHECK_EQUAL(path.names().size(), 3);
+  BOOST_CHECK(!path.hasWildcards());
+  BOOST_CHECK(prop.exists(path));
+  BOOST_CHECK_EQUAL(prop.get(path).as<votca::Index>(), 2);
+  BOOST_CHECK_EQUAL(prop.Select(path).size(), 2);
+
+  PropertyPath wildcard_path("a.b.*");
+  BOOST_CHECK(wildcard_path.hasWildcards());
+  std::vector<const Property*> selection =
+      static_cast<const Property&>(prop).Select(wildcard_path);
+  BOOST_REQUIRE_EQUAL(selection.size(), 3);
+  BOOST_CHECK_EQUAL(selection[2]->value(), "3");
+
+  PropertyPath missing("a.e");
+  BOOST_CHECK(!prop.exists(missing));
+  BOOST_CHECK_THROW(prop.get(missing), std::runtime_error);
+  BOOST_CHECK_EQUAL(
+      prop.ifExistsReturnElseReturnDefault<votca::Index>("a.e", 5), 5);
+  BOOST_CHECK_EQUAL(
+      prop.ifExistsReturnElseReturnDefault<votca::Index>("a.b.d", 5), 3);
+  BOOST_CHECK_EQUAL(&prop.getOradd("a.b.d"), &prop.get("a.b.d"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
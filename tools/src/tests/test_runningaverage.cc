@@ -0,0 +1,97 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE runningaverage_test
+
+// Standard includes
+#include <cmath>
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/runningaverage.h"
+
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(runningaverage_test)
+
+BOOST_AUTO_TEST_CASE(process_test) {
+  RunningAverage avg;
+  BOOST_CHECK_EQUAL(avg.getN(), 0);
+  BOOST_CHECK_EQUAL(avg.getVariance(), 0.0);
+  for (double x : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    avg.Process(x);
+  }
+  BOOST_CHECK_EQUAL(avg.getN(), 8);
+  BOOST_CHECK_CLOSE(avg.getAvg(), 5.0, 1e-12);
+  BOOST_CHECK_CLOSE(avg.getVariance(), 4.0, 1e-12);
+  BOOST_CHECK_CLOSE(avg.getSig(), 2.0, 1e-12);
+  BOOST_CHECK_CLOSE(avg.getErr(), std::sqrt(4.0 / 7.0), 1e-12);
+
+  avg.Clear();
+  BOOST_CHECK_EQUAL(avg.getN(), 0);
+  BOOST_CHECK_EQUAL(avg.getAvg(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(weight_test) {
+  RunningAverage weighted;
+  weighted.Process(1.0, 3.0);
+  weighted.Process(5.0, 1.0);
+  RunningAverage repeated;
+  for (double x : {1.0, 1.0, 1.0, 5.0}) {
+    repeated.Process(x);
+  }
+  BOOST_CHECK_EQUAL(weighted.getWeight(), 4.0);
+  BOOST_CHECK_CLOSE(weighted.getAvg(), repeated.getAvg(), 1e-12);
+  BOOST_CHECK_CLOSE(weighted.getVariance(), repeated.getVariance(), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(precision_test) {
+  // the sum of the squares would lose all digits of the variance
+  RunningAverage avg;
+  for (double x : {1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16}) {
+    avg.Process(x);
+  }
+  BOOST_CHECK_CLOSE(avg.getVariance(), 22.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(merge_test) {
+  std::vector<double> values = {0.5, 1.5, -2.0, 3.25, 8.0, 1.0, 0.0};
+  RunningAverage all;
+  RunningAverage first;
+  RunningAverage second;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    all.Process(values[i], double(i + 1));
+    (i < 3 ? first : second).Process(values[i], double(i + 1));
+  }
+  RunningAverage empty;
+  first.Merge(empty);
+  first.Merge(second);
+  BOOST_CHECK_EQUAL(first.getN(), all.getN());
+  BOOST_CHECK_CLOSE(first.getWeight(), all.getWeight(), 1e-12);
+  BOOST_CHECK_CLOSE(first.getAvg(), all.getAvg(), 1e-12);
+  BOOST_CHECK_CLOSE(first.getVariance(), all.getVariance(), 1e-12);
+
+  empty.Merge(all);
+  BOOST_CHECK_CLOSE(empty.getAvg(), all.getAvg(), 1e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE xmlrecords_test
+
+// Standard includes
+#include <fstream>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/tools/xmlrecords.h"
+
+using namespace votca::tools;
+
+BOOST_AUTO_TEST_SUITE(xmlrecords_test)
+
+BOOST_AUTO_TEST_CASE(read_records) {
+  std::string content =
+      "<jobs>\n"
+      "\t<job>\n"
+      "\t\t<id>1</id>\n"
+      "\t\t<input><a>x</a><b/></input>\n"
+      "\t\t<status>AVAILABLE</status>\n"
+      "\t</job>\n"
+      "\t<other><job><id>5</id></job></other>\n"
+      "\t<job flag=\"yes\">\n"
+      "\t\t<id>2</id>\n"
+      "\t\t<input/>\n"
+      "\t\t<output><c>3</c></output>\n"
+      "\t</job>\n"
+      "</jobs>\n";
+  std::ofstream xmlfile("test_xmlrecords.xml");
+  xmlfile << content;
+  xmlfile.close();
+
+  std::vector<XMLRecord> records;
+  ReadXMLRecords("test_xmlrecords.xml", "jobs.job", {"input", "output"},
+                 [&records](XMLRecord &record) { records.push_back(record); });
+
+  BOOST_REQUIRE_EQUAL(records.size(), 2);
+  const Property &job1 = records[0].element;
+  BOOST_CHECK_EQUAL(job1.name(), "job");
+  BOOST_CHECK_EQUAL(job1.path(), "jobs");
+  BOOST_CHECK_EQUAL(job1.get("id").as<votca::Index>(), 1);
+  BOOST_CHECK_EQUAL(job1.get("status").as<std::string>(), "AVAILABLE");
+  BOOST_CHECK(!job1.exists("input"));
+  BOOST_REQUIRE_EQUAL(records[0].skipped.count("input"), 1);
+  auto range = records[0].skipped.at("input");
+  BOOST_CHECK_EQUAL(content.substr(range.first, range.second - range.first),
+                    "<input><a>x</a><b/></input>");
+
+  const Property &job2 = records[1].element;
+  BOOST_CHECK_EQUAL(job2.getAttribute<std::string>("flag"), "yes");
+  BOOST_CHECK_EQUAL(job2.get("id").as<votca::Index>(), 2);
+  range = records[1].skipped.at("input");
+  BOOST_CHECK_EQUAL(content.substr(range.first, range.second - range.first),
+                    "<input/>");
+  range = records[1].skipped.at("output");
+  std::string output =
+      content.substr(range.first, range.second - range.first);
+  BOOST_CHECK_EQUAL(output, "<output><c>3</c></output>");
+
+  Property parsed;
+  parsed.LoadFromXMLString(output);
+  BOOST_CHECK_EQUAL(parsed.get("output.c").as<votca::Index>(), 3);
+  BOOST_CHECK_THROW(parsed.LoadFromXMLString("<output>"),
+                    std::ios_base::failure);
+
+  BOOST_CHECK_THROW(
+      ReadXMLRecords("test_xmlrecords.xml", "jobs.job", {},
+                     [](XMLRecord &) { throw std::runtime_error("stop"); }),
+      std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
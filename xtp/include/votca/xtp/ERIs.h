@@ -38,17 +38,21 @@ class ERIs {
   void Initialize(const AOBasis& dftbasis, const AOBasis& auxbasis);
   void Initialize_4c(const AOBasis& dftbasis);
 
-  Eigen::MatrixXd CalculateERIs_3c(const Eigen::MatrixXd& DMAT) const;
+  // auxiliary functions whose contribution is bound to be smaller than error
+  // are skipped, which makes builds from small density differences cheap
+  Eigen::MatrixXd CalculateERIs_3c(const Eigen::MatrixXd& DMAT,
+                                   double error = 0.0) const;
 
   std::array<Eigen::MatrixXd, 2> CalculateERIs_EXX_3c(
-      const Eigen::MatrixXd& occMos, const Eigen::MatrixXd& DMAT) const {
+      const Eigen::MatrixXd& occMos, const Eigen::MatrixXd& DMAT,
+      double error = 0.0) const {
     std::array<Eigen::MatrixXd, 2> result;
-    result[0] = CalculateERIs_3c(DMAT);
+    result[0] = CalculateERIs_3c(DMAT, error);
     if (occMos.rows() > 0 && occMos.cols() > 0) {
       assert(occMos.rows() == DMAT.rows() && "occMos.rows()==DMAT.rows()");
       result[1] = CalculateEXX_mos(occMos);
     } else {
-      result[1] = CalculateEXX_dmat(DMAT);
+      result[1] = CalculateEXX_dmat(DMAT, error);
     }
     return result;
   }
@@ -79,7 +83,8 @@ class ERIs {
   Index maxnprim_;
   Index maxL_;
 
-  Eigen::MatrixXd CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const;
+  Eigen::MatrixXd CalculateEXX_dmat(const Eigen::MatrixXd& DMAT,
+                                    double error) const;
   Eigen::MatrixXd CalculateEXX_mos(const Eigen::MatrixXd& occMos) const;
 
   std::vector<std::vector<libint2::ShellPair>> ComputeShellPairData(
@@ -94,6 +99,8 @@ class ERIs {
                                            double error) const;
 
   TCMatrix_dft threecenter_;
+  // Frobenius norms of the threecenter matrices, for screening
+  Eigen::VectorXd threecenter_norms_;
 
   Eigen::MatrixXd schwarzscreen_;  // Square matrix containing <ab|ab> for all
                                    // shells
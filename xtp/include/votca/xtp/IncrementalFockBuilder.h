@@ -48,7 +48,7 @@ class IncrementalFockBuilder {
       last_reset_iteration_ = iteration - 1;
       next_reset_threshold_ = DiisError / 10.0;
       XTP_LOG(Log::error, log_)
-          << TimeStamp() << " Using incremental 4c build from here"
+          << TimeStamp() << " Using incremental Fock build from here"
           << std::flush;
     }
   }
@@ -60,17 +60,22 @@ class IncrementalFockBuilder {
       K.setZero();
       Ddiff_ = dmat;
     }
+    incremental_build_ =
+        incremental_Fbuild_started_ && !reset_incremental_fock_formation_;
   }
 
   const Eigen::MatrixXd& getDmat_diff() const { return Ddiff_; }
 
+  // true if getDmat_diff is a difference of densities and not the full one
+  bool isIncremental() const { return incremental_build_; }
+
   void UpdateCriteria(double DiisError, Index Iteration) {
     if (reset_incremental_fock_formation_ && incremental_Fbuild_started_) {
       reset_incremental_fock_formation_ = false;
       last_reset_iteration_ = Iteration;
       next_reset_threshold_ = DiisError / 10.0;
       XTP_LOG(Log::error, log_)
-          << TimeStamp() << " Reset incremental 4c build" << std::flush;
+          << TimeStamp() << " Reset incremental Fock build" << std::flush;
     }
   }
 
@@ -95,6 +100,7 @@ class IncrementalFockBuilder {
   Eigen::MatrixXd Dlast_;
 
   bool reset_incremental_fock_formation_ = false;
+  bool incremental_build_ = false;
   bool incremental_Fbuild_started_ = false;
   double next_reset_threshold_ = 0.0;
   Index last_reset_iteration_ = 0;
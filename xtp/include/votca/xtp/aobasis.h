@@ -21,6 +21,10 @@
 #ifndef VOTCA_XTP_AOBASIS_H
 #define VOTCA_XTP_AOBASIS_H
 
+// Standard includes
+#include <memory>
+#include <mutex>
+
 // Local VOTCA includes
 #include "aoshell.h"
 
@@ -76,6 +80,11 @@ class AOBasis {
   std::vector<std::vector<Index>> ComputeShellPairs(
       double threshold = 1e-20) const;
 
+  /// same as GenerateLibintBasis/ComputeShellPairs with the default
+  /// threshold, but computed once and kept until the basis changes
+  const std::vector<libint2::Shell>& LibintBasis() const;
+  const std::vector<std::vector<Index>>& ShellPairs() const;
+
   AOShell& addShell(const Shell& shell, const QMAtom& atom, Index startIndex);
 
   const std::string& Name() const { return name_; }
@@ -96,6 +105,17 @@ class AOBasis {
  private:
   void FillFuncperAtom();
 
+  // all integral routines need the libint shells and the significant shell
+  // pairs, copies of a basis share them until one of them is modified
+  struct LibintCache {
+    std::once_flag shells_flag;
+    std::vector<libint2::Shell> shells;
+    std::once_flag pairs_flag;
+    std::vector<std::vector<Index>> pairs;
+  };
+  void InvalidateCache() { cache_ = std::make_shared<LibintCache>(); }
+  std::shared_ptr<LibintCache> cache_ = std::make_shared<LibintCache>();
+
   std::vector<AOShell> aoshells_;
 
   std::vector<Index> FuncperAtom_;
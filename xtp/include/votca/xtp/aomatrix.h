@@ -27,6 +27,15 @@
 namespace votca {
 namespace xtp {
 
+class AOOverlap;
+class AOKinetic;
+class AODipole;
+
+/// fills the requested matrices (nullptr to skip one) in a single pass over
+/// the shell pairs of aobasis, the dipole integrals give the overlap for free
+void FillOneBodyMatrices(const AOBasis& aobasis, AOOverlap* overlap,
+                         AOKinetic* kinetic, AODipole* dipole);
+
 class AOMatrix {
  public:
   virtual void Fill(const AOBasis& aobasis) = 0;
@@ -41,6 +50,8 @@ class AOKinetic : public AOMatrix {
   const Eigen::MatrixXd& Matrix() const { return aomatrix_; }
 
  private:
+  friend void FillOneBodyMatrices(const AOBasis&, AOOverlap*, AOKinetic*,
+                                  AODipole*);
   Eigen::MatrixXd aomatrix_;
 };
 
@@ -52,6 +63,9 @@ class AOOverlap : public AOMatrix {
   const Eigen::MatrixXd& Matrix() const { return aomatrix_; }
 
   Eigen::MatrixXd singleShellOverlap(const AOShell& shell) const;
+  /// overlap <bra_i|ket_j> between two basis sets, e.g. the same basis at
+  /// two different geometries
+  Eigen::MatrixXd CrossOverlap(const AOBasis& bra, const AOBasis& ket) const;
   Index Removedfunctions() const { return removedfunctions; }
   double SmallestEigenValue() const { return smallestEigenvalue; }
 
@@ -59,6 +73,8 @@ class AOOverlap : public AOMatrix {
   Eigen::MatrixXd Sqrt();
 
  private:
+  friend void FillOneBodyMatrices(const AOBasis&, AOOverlap*, AOKinetic*,
+                                  AODipole*);
   Index removedfunctions;
   double smallestEigenvalue;
   Eigen::MatrixXd aomatrix_;
@@ -98,6 +114,8 @@ class AODipole : public AOMatrix {
   }  // definition of a center around which the moment should be calculated
 
  private:
+  friend void FillOneBodyMatrices(const AOBasis&, AOOverlap*, AOKinetic*,
+                                  AODipole*);
   std::array<Eigen::MatrixXd, 3> aomatrix_;
   std::array<libint2::Shell::real_t, 3> r_ = {0, 0, 0};
 };
@@ -65,9 +65,21 @@ class AOMultipole : public AOPotential<double> {
  public:
   void FillPotential(const AOBasis& aobasis, const QMMolecule& atoms);
   void FillPotential(const AOBasis& aobasis, const Eigen::Vector3d& r);
+  /**
+   * \brief potential of the external sites
+   *
+   * With a farfield_tolerance > 0 only the sites close to the basis functions
+   * are integrated individually. Sites further away than twice the extent of
+   * the basis are replaced by a set of equivalent charges on a sphere, which
+   * reproduce their potential inside the basis. The sites in between are
+   * sorted into an octree and every cell with
+   * (cell radius / distance)^3 < farfield_tolerance is merged into one site
+   * carrying the multipoles of the cell up to the quadrupole.
+   */
   void FillPotential(
       const AOBasis& aobasis,
-      const std::vector<std::unique_ptr<StaticSite>>& externalsites);
+      const std::vector<std::unique_ptr<StaticSite>>& externalsites,
+      double farfield_tolerance = 0.0);
 
  protected:
   void FillBlock(Eigen::Block<Eigen::MatrixXd>& matrix,
@@ -77,6 +89,20 @@ class AOMultipole : public AOPotential<double> {
  private:
   void setSite(const StaticSite* site) { site_ = site; };
 
+  static void PartitionSites(const std::vector<const StaticSite*>& sites,
+                             const Eigen::Vector3d& qmcenter, double qmradius,
+                             double farfield_tolerance,
+                             std::vector<const StaticSite*>& nearsites,
+                             std::vector<StaticSite>& farsites);
+
+  static std::vector<StaticSite> EquivalentCharges(
+      const std::vector<const StaticSite*>& sites,
+      const Eigen::Vector3d& qmcenter, double qmradius, double radius,
+      Index npoints);
+
+  static StaticSite CombineSites(const std::vector<const StaticSite*>& sites,
+                                 const Eigen::Vector3d& center);
+
   const StaticSite* site_;
 };
 
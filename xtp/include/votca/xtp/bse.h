@@ -62,6 +62,8 @@ class BSE {
     bool use_Hqp_offdiag;
     Index max_dyn_iter;
     double dyn_tolerance;
+    // memory in MB for the slice copies of each BSE operator
+    double max_slice_memory = 1024;
   };
 
   void configure(const options& opt, const Eigen::VectorXd& RPAEnergies,
@@ -35,6 +35,8 @@ struct BSEOperator_Options {
   Index qpmin;
   Index vmin;
   Index cmax;
+  /// memory in MB the copies of the Mmn slices of one operator may use
+  double max_slice_memory = 1024;
 };
 
 template <Index cqp, Index cx, Index cd, Index cd2>
@@ -47,8 +49,9 @@ class BSE_OPERATOR final : public MatrixFreeOperator {
 
   void configure(BSEOperator_Options opt);
 
-  // This method sets up the diagonal of the hermitian BSE hamiltonian.
-  // Otherwise see the matmul function
+  // This method sets up the diagonal of the hermitian BSE hamiltonian. It is
+  // only computed once and then reused by every solver working on this
+  // operator. Otherwise see the matmul function
   Eigen::VectorXd diagonal() const;
   /*
    * This is the main routine for setting up the hermitian parts of the BSE
@@ -58,11 +61,23 @@ class BSE_OPERATOR final : public MatrixFreeOperator {
    * arguements Different parts of the hamiltonian can be constructed. In
    * general it is inefficient to set them up independently (unless you need it
    * for analysis) thus the function combines all parts.
+   *
+   * For the few vectors a Davidson iteration needs, all parts are applied in
+   * one pass per valence index on contiguous copies of the Mmn slices, which
+   * are built on first use and cost about ctotal*(ctotal+2*vtotal)*auxsize
+   * doubles. For many vectors, if the copies would exceed max_slice_memory or
+   * if GPUs are used, the operator is built row by row instead.
    */
   Eigen::MatrixXd matmul(const Eigen::MatrixXd& input) const;
 
  private:
   Eigen::VectorXd Hqp_row(Index v1, Index c1) const;
+  Eigen::VectorXd compute_diagonal() const;
+
+  bool use_fused(Index nvecs) const;
+  Eigen::MatrixXd matmul_rows(const Eigen::MatrixXd& input) const;
+  Eigen::MatrixXd matmul_fused(const Eigen::MatrixXd& input) const;
+  void setup_slices() const;
 
   BSEOperator_Options opt_;
   Index bse_size_;
@@ -73,6 +88,15 @@ class BSE_OPERATOR final : public MatrixFreeOperator {
   const Eigen::VectorXd& epsilon_0_inv_;
   const TCMatrix_gwbse& Mmn_;
   const Eigen::MatrixXd& Hqp_;
+
+  // column c holds M[c](c',a) with c' fast, size (ctotal*auxsize) x ctotal
+  mutable Eigen::MatrixXd Mcc_;
+  // column c holds M[c](v',a) with v' fast, size (vtotal*auxsize) x ctotal
+  mutable Eigen::MatrixXd Mcv_;
+  // row vc.I(v,c) holds M[v](c,a), size bse_size x auxsize
+  mutable Eigen::MatrixXd Mvc_;
+  mutable bool slices_ready_ = false;
+  mutable Eigen::VectorXd diag_;
 };
 
 // type defs for the different operators
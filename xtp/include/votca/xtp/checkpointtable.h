@@ -95,7 +95,7 @@ class CptTable {
     inited_ = true;
   }
 
-  void write(void* buffer, const std::size_t& startIdx,
+  void write(const void* buffer, const std::size_t& startIdx,
              const std::size_t& endIdx) {
 
     if (!inited_) {
@@ -111,7 +111,8 @@ class CptTable {
     hsize_t fStart[2] = {s, 0};
     hsize_t fCount[2] = {l, 1};
 
-    hsize_t mStart[2] = {s, 0};
+    // the buffer only holds the rows [startIdx, endIdx)
+    hsize_t mStart[2] = {0, 0};
     hsize_t mCount[2] = {l, 1};
 
     hsize_t mDim[2] = {l, 1};
@@ -129,7 +130,7 @@ class CptTable {
     }
   }
 
-  void writeToRow(void* buffer, const std::size_t idx) {
+  void writeToRow(const void* buffer, const std::size_t idx) {
     write(buffer, idx, idx + 1);
   }
 
@@ -154,7 +155,8 @@ class CptTable {
     hsize_t fStart[2] = {s, 0};
     hsize_t fCount[2] = {l, 1};
 
-    hsize_t mStart[2] = {s, 0};
+    // the buffer only holds the rows [startIdx, endIdx)
+    hsize_t mStart[2] = {0, 0};
     hsize_t mCount[2] = {l, 1};
 
     hsize_t mDim[2] = {l, 1};
@@ -21,6 +21,9 @@
 #ifndef VOTCA_XTP_CUBEFILE_WRITER_H
 #define VOTCA_XTP_CUBEFILE_WRITER_H
 
+// Standard includes
+#include <functional>
+
 // Local VOTCA includes
 #include "logger.h"
 #include "orbitals.h"
@@ -41,10 +44,30 @@ class CubeFile_Writer {
   void WriteFile(const std::string& filename, const Orbitals& orb,
                  QMState state, bool dostateonly) const;
 
+  /// writes the cube of states[i] to filenames[i], the AO values are only
+  /// evaluated once per gridbox for all states
+  void WriteFiles(const std::vector<std::string>& filenames,
+                  const Orbitals& orb, const std::vector<QMState>& states,
+                  bool dostateonly) const;
+
+  /// writes the grid, the molecule and all states to one hdf5 file, each
+  /// state is a group with a "values" table in cube order
+  void WriteHDF5(const std::string& filename, const Orbitals& orb,
+                 const std::vector<QMState>& states, bool dostateonly) const;
+
  private:
-  std::vector<std::vector<double> > CalculateValues(
-      const Orbitals& orb, QMState state, bool dostateonly,
-      const Regular_Grid& grid) const;
+  // receives the values of all states for a contiguous range of gridpoints
+  using BlockSink = std::function<void(const Eigen::MatrixXd&, Index)>;
+
+  Regular_Grid SetupGrid(const Orbitals& orb, const AOBasis& basis) const;
+
+  // evaluates all states blockwise in grid order and hands each block to sink
+  void CalculateValues(const Orbitals& orb, const std::vector<QMState>& states,
+                       bool dostateonly, const Regular_Grid& grid,
+                       const BlockSink& sink) const;
+
+  void WriteHeader(std::ostream& out, const Orbitals& orb, QMState state,
+                   bool dostateonly, const Regular_Grid& grid) const;
 
   Eigen::Array<Index, 3, 1> steps_;
   double padding_;
@@ -137,6 +137,9 @@ class DFTEngine {
   // numerical integration Vxc
   std::string grid_name_;
 
+  // external multipoles further away are treated approximately
+  double multipole_farfield_tolerance_ = 0.0;
+
   // AO Matrices
   AOOverlap dftAOoverlap_;
 
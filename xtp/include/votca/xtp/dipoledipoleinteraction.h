@@ -22,6 +22,7 @@
 // Local VOTCA includes
 #include "eeinteractor.h"
 #include "eigen.h"
+#include "threadreduction.h"
 
 namespace votca {
 namespace xtp {
@@ -123,9 +124,12 @@ class DipoleDipoleInteraction
     assert(v.size() == size_ &&
            "input vector has the wrong size for multiply with operator");
     const Index segment_size = Index(sites_.size());
-    Eigen::VectorXd result = Eigen::VectorXd::Zero(size_);
-#pragma omp parallel for schedule(dynamic) reduction(+ : result)
+    // every thread accumulates into its own vector, they are merged pairwise
+    std::vector<Eigen::VectorXd> partials(
+        OPENMP::getMaxThreads(), Eigen::VectorXd::Zero(size_));
+#pragma omp parallel for schedule(dynamic)
     for (Index i = 0; i < segment_size; i++) {
+      Eigen::VectorXd& result = partials[OPENMP::getThreadId()];
       const PolarSite& site1 = *sites_[i];
       result.segment<3>(3 * i) += site1.getPInv() * v.segment<3>(3 * i);
       for (Index j = i + 1; j < segment_size; j++) {
@@ -135,8 +139,8 @@ class DipoleDipoleInteraction
         result.segment<3>(3 * j) += block.transpose() * v.segment<3>(3 * i);
       }
     }
-
-    return result;
+    TreeReduce(partials);
+    return partials[0];
   }
 
  private:
@@ -65,6 +65,8 @@ class Esp2multipole {
   bool use_CHELPG_;
   bool do_svd_ = false;
   double conditionnumber_;
+  bool use_ri_ = false;
+  double ri_farfield_tolerance_ = 0.0;
 
   Logger& log_;
   std::vector<std::pair<Index, Index> > pairconstraint_;  //  pairconstraint[i]
@@ -49,6 +49,13 @@ class Espfit {
     conditionnumber_ = conditionnumber;
   }
 
+  /// evaluate the electronic potential with the density fitted to the
+  /// auxiliary basis instead of integrating it numerically
+  void setUseRI(double farfield_tolerance) {
+    use_ri_ = true;
+    ri_farfield_tolerance_ = farfield_tolerance;
+  }
+
   void setPairConstraint(std::vector<std::pair<Index, Index> > pairconstraint) {
     pairconstraint_ = pairconstraint;
   }
@@ -64,6 +71,8 @@ class Espfit {
   Logger& log_;
   bool do_svd_ = true;
   double conditionnumber_ = 1e-8;
+  bool use_ri_ = false;
+  double ri_farfield_tolerance_ = 0.0;
 
   std::vector<std::pair<Index, Index> > pairconstraint_;  //  pairconstraint[i]
                                                           //  is all the
@@ -75,6 +84,13 @@ class Espfit {
 
   void EvalNuclearPotential(const QMMolecule& atoms, Grid& grid);
 
+  // both return the number of electrons
+  double EvalElectronicPotential(const Orbitals& orbitals,
+                                 const Eigen::MatrixXd& dmat,
+                                 const std::string& gridsize, Grid& grid);
+  double EvalElectronicPotentialRI(const Orbitals& orbitals,
+                                   const Eigen::MatrixXd& dmat, Grid& grid);
+
   // Fits partial charges to Potential on a grid, constrains net charge
   StaticSegment FitPartialCharges(const Orbitals& orbitals, const Grid& grid,
                                   double netcharge);
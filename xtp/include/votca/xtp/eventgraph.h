@@ -0,0 +1,98 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_EVENTGRAPH_H
+#define VOTCA_XTP_EVENTGRAPH_H
+
+// Standard includes
+#include <vector>
+
+// Local VOTCA includes
+#include "checkpoint.h"
+#include "eigen.h"
+#include "qmnblist.h"
+#include "qmstate.h"
+#include "rate_engine.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Hopping events of all sites in compressed sparse row layout
+ *
+ * The events of site i are the entries [EventsBegin(i), EventsEnd(i)) of the
+ * flat destination, dr and rate arrays. Every pair of the neighbourlist gives
+ * one event on each of its two sites, the events of a site appear in the
+ * order of the pairs. Everything a rate depends on apart from temperature
+ * and field is stored per event, so that all rates can be recomputed in
+ * place for new conditions without touching the neighbourlist again. The
+ * GNodes of a KMC run read their events directly from these arrays.
+ */
+class EventGraph {
+ public:
+  EventGraph() = default;
+  EventGraph(const QMNBList& nblist, Index nsites, QMStateType carriertype);
+
+  Index NumberOfSites() const { return Index(offsets_.size()) - 1; }
+  Index NumberOfEvents() const { return Index(destinations_.size()); }
+  QMStateType CarrierType() const { return carriertype_; }
+
+  Index EventsBegin(Index site) const { return offsets_[site]; }
+  Index EventsEnd(Index site) const { return offsets_[site + 1]; }
+  Index EventCount(Index site) const {
+    return offsets_[site + 1] - offsets_[site];
+  }
+
+  Index Destination(Index event) const { return destinations_[event]; }
+  /// id of the pair in the neighbourlist this event belongs to
+  Index PairId(Index event) const { return pairids_[event]; }
+  /// true if the event hops from Seg1 to Seg2 of its pair
+  bool isForward(Index event) const { return forward_[event] != 0; }
+  Eigen::Vector3d DeltaR(Index event) const { return dr_.col(event); }
+  double Rate(Index event) const { return rates_[event]; }
+  const std::vector<double>& Rates() const { return rates_; }
+  const std::vector<Index>& Destinations() const { return destinations_; }
+  /// dr of all events, one column per event
+  const Eigen::Matrix3Xd& DeltaRs() const { return dr_; }
+
+  /// \brief recomputes the rates of all events for the conditions of
+  /// rate_engine and returns the sites with at least one changed rate
+  std::vector<Index> UpdateRates(const Rate_Engine& rate_engine);
+
+  void WriteToCpt(CheckpointWriter& w) const;
+  void ReadFromCpt(CheckpointReader& r);
+
+ private:
+  QMStateType carriertype_;
+  std::vector<Index> offsets_ = {0};
+  std::vector<Index> destinations_;
+  std::vector<Index> pairids_;
+  Eigen::Matrix3Xd dr_;
+  std::vector<int> forward_;
+  std::vector<double> jeff2_;
+  std::vector<double> dG_site_;
+  std::vector<double> reorg_;
+  std::vector<double> rates_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_EVENTGRAPH_H
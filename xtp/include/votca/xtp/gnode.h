@@ -22,7 +22,6 @@
 // Local VOTCA includes
 #include "glink.h"
 #include "huffmantree.h"
-#include "qmpair.h"
 #include "segment.h"
 
 namespace votca {
@@ -44,19 +43,32 @@ class GNode {
   Index getId() const { return id_; }
   void UpdateOccupationTime(double deltat) { occupationtime_ += deltat; }
 
-  const std::vector<GLink>& Events() const { return events_; }
   double OccupationTime() const { return occupationtime_; }
 
   double getEscapeRate() const { return escape_rate_; }
   void InitEscapeRate();
   void AddDecayEvent(double decayrate);
-  void AddEventfromQmPair(const QMPair& pair, std::vector<GNode>& nodes,
-                          double rate);
   double getSitenergy() const { return siteenergy_; }
 
-  GLink* findHoppingDestination(double p) const;
+  /// \brief the hopping events of this node are the entries [0, nevents) of
+  /// the destination, rate and dr arrays of an event graph
+  ///
+  /// Nothing is copied, destinations index into nodes and dr holds three
+  /// coordinates per event.
+  void setEvents(GNode* nodes, const Index* destinations, const double* rates,
+                 const double* dr, Index nevents);
+  /// number of events, a decay event comes after the hopping events
+  Index EventCount() const { return nevents_ + (hasdecay_ ? 1 : 0); }
+  GLink Event(Index event) const;
+
+  GLink findHoppingDestination(double p) const;
   void MakeHuffTree();
-  void AddEvent(GNode* seg2, const Eigen::Vector3d& dr, double rate);
+  /// \brief rebuilds escape rate and huffman tree after the rates in the
+  /// event arrays changed
+  void UpdateEventRates() {
+    InitEscapeRate();
+    MakeHuffTree();
+  }
 
  private:
   Index id_ = 0;
@@ -67,10 +79,18 @@ class GNode {
   double siteenergy_;
   Eigen::Vector3d position_;
   bool injectable_ = true;
-  std::vector<GLink> events_;
+  GNode* nodes_ = nullptr;
+  const Index* destinations_ = nullptr;
+  const double* rates_ = nullptr;
+  const double* dr_ = nullptr;
+  Index nevents_ = 0;
+  double decayrate_ = 0.0;
 
-  huffmanTree<GLink> hTree;
+  huffmanTree hTree;
 
+  double Rate(Index event) const {
+    return event < nevents_ ? rates_[event] : decayrate_;
+  }
   void organizeProbabilities(Index id, double add);
   void moveProbabilities(Index id);
 };
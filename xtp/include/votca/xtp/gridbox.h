@@ -24,6 +24,7 @@
 // Local VOTCA includes
 #include "aoshell.h"
 #include "grid_containers.h"
+#include "threadreduction.h"
 
 namespace votca {
 namespace xtp {
@@ -38,6 +39,9 @@ class GridBox {
   void FindSignificantShells(const AOBasis& basis);
   AOShell::AOValues CalcAOValues(const Eigen::Vector3d& point) const;
 
+  // AO values of all gridpoints, one row per gridpoint
+  Eigen::MatrixXd CalcAOValueMatrix() const;
+
   const std::vector<Eigen::Vector3d>& getGridPoints() const { return grid_pos; }
 
   const std::vector<double>& getGridWeights() const { return weights; }
@@ -76,9 +80,16 @@ class GridBox {
 
   Eigen::VectorXd ReadFromBigVector(const Eigen::VectorXd& bigvector) const;
 
+  // rows of the significant AOs, all columns
+  Eigen::MatrixXd ReadRowsFromBigMatrix(const Eigen::MatrixXd& bigmatrix) const;
+
   void AddtoBigMatrix(Eigen::MatrixXd& bigmatrix,
                       const Eigen::MatrixXd& smallmatrix) const;
 
+  // thread safe version for boxes processed in parallel
+  void AddtoBigMatrix(TiledAccumulator& bigmatrix,
+                      const Eigen::MatrixXd& smallmatrix) const;
+
   static bool compareGridboxes(GridBox& box1, GridBox& box2) {
     if (box1.Matrixsize() != box2.Matrixsize()) {
       return false;
@@ -21,45 +21,57 @@
 #include <cstdlib>
 #include <list>
 #include <queue>
+#include <stdexcept>
 #include <vector>
 
+// VOTCA includes
+#include <votca/tools/types.h>
+
 namespace votca {
 namespace xtp {
 
-template <class T>
+/**
+ * \brief Huffman tree over the events 0 to n-1 of a site
+ *
+ * The tree only stores event indices, the rates stay with the caller and are
+ * only read while the tree is made.
+ */
 class huffmanTree {
 
  public:
-  void makeTree() {
-    if (!events) {
+  /// builds the tree for the events with the rates values
+  void makeTree(const std::vector<double> &values) {
+    if (values.empty()) {
       throw std::runtime_error(
-          "Error in Huffmantree::makeTree : Pointer to Events not set!");
+          "Error in Huffmantree::makeTree : No events to build the tree of!");
     }
 
     // queue of the nodes, sorted by probability
-    auto compare = [](huffmanNode<T> *n1, huffmanNode<T> *n2) {
+    auto compare = [](huffmanNode *n1, huffmanNode *n2) {
       return n1->probability > n2->probability;
     };
 
     // priority queues, because the algorithm always needs the element with the
     // smallest probability. Also, it keep adding nodes to it, so it would we
     // very inefficient to sort it in every iteration.
-    std::priority_queue<huffmanNode<T> *, std::vector<huffmanNode<T> *>,
+    std::priority_queue<huffmanNode *, std::vector<huffmanNode *>,
                         decltype(compare)>
         queue(compare);
 
-    htree = std::vector<huffmanNode<T>>(
-        events->size() % 2 ? events->size() : events->size() - 1);
+    htree = std::vector<huffmanNode>(values.size() % 2 ? values.size()
+                                                        : values.size() - 1);
 
-    auto comp2 = [](T *e1, T *e2) { return e1->getValue() > e2->getValue(); };
-    std::priority_queue<T *, std::vector<T *>, decltype(comp2)> eventQueue(
+    auto comp2 = [&values](Index e1, Index e2) {
+      return values[e1] > values[e2];
+    };
+    std::priority_queue<Index, std::vector<Index>, decltype(comp2)> eventQueue(
         comp2);
     sum_of_values = 0.0;
 
     Index firstEmptyFieldIndex = 0;
-    for (T &e : *events) {
-      eventQueue.push(&e);
-      sum_of_values += e.getValue();
+    for (Index e = 0; e < Index(values.size()); e++) {
+      eventQueue.push(e);
+      sum_of_values += values[e];
     }
     while (eventQueue.size() > 1) {
       htree[firstEmptyFieldIndex].isOnLastLevel = true;
@@ -68,8 +80,8 @@ class huffmanTree {
       htree[firstEmptyFieldIndex].rightLeaf = eventQueue.top();
       eventQueue.pop();
       htree[firstEmptyFieldIndex].probability =
-          (htree[firstEmptyFieldIndex].leftLeaf->getValue() +
-           htree[firstEmptyFieldIndex].rightLeaf->getValue()) /
+          (values[htree[firstEmptyFieldIndex].leftLeaf] +
+           values[htree[firstEmptyFieldIndex].rightLeaf]) /
           sum_of_values;
       queue.push(&(htree[firstEmptyFieldIndex]));
       firstEmptyFieldIndex++;
@@ -79,7 +91,7 @@ class huffmanTree {
       htree[firstEmptyFieldIndex].rightLeaf = eventQueue.top();
       htree[firstEmptyFieldIndex].leftLeaf = eventQueue.top();
       htree[firstEmptyFieldIndex].probability =
-          htree[firstEmptyFieldIndex].leftLeaf->getValue() / sum_of_values;
+          values[htree[firstEmptyFieldIndex].leftLeaf] / sum_of_values;
       queue.push(&(htree[firstEmptyFieldIndex]));
       firstEmptyFieldIndex++;
     }
@@ -87,8 +99,8 @@ class huffmanTree {
     // now connect the hnodes, making a new one for every connection:
     // always take the two nodes with the smallest probability and "combine"
     // them, repeat, until just one node (the root) is left.
-    huffmanNode<T> *h1;
-    huffmanNode<T> *h2;
+    huffmanNode *h1;
+    huffmanNode *h2;
     while (queue.size() > 1) {
       h1 = queue.top();
       queue.pop();
@@ -104,17 +116,19 @@ class huffmanTree {
     // reorganize the probabilities: in every node, add the probability of one
     // subtree ("small") to all nodes of the other subtree.
     addProbabilityFromRightSubtreeToLeftSubtree(&htree[htree.size() - 1], 0);
-    moveProbabilitiesFromRightSubtreesOneLevelUp(&htree[htree.size() - 1]);
+    moveProbabilitiesFromRightSubtreesOneLevelUp(&htree[htree.size() - 1],
+                                                 values);
     treeIsMade = true;
   }
 
-  T *findHoppingDestination(double p) const {
+  /// index of the event for the uniform random number p
+  Index findHoppingDestination(double p) const {
     if (!treeIsMade) {
       throw std::runtime_error(
           "Tried to find Hopping Destination without initializing the "
           "Huffmantree first!");
     }
-    const huffmanNode<T> *node = &htree.back();
+    const huffmanNode *node = &htree.back();
     while (!node->isOnLastLevel) {
       if (p > node->probability) {
         node = node->leftChild;
@@ -125,22 +139,20 @@ class huffmanTree {
     return (p > node->probability ? node->leftLeaf : node->rightLeaf);
   }
 
-  void setEvents(std::vector<T> *v) { this->events = v; }
-
  private:
-  template <class S>
   struct huffmanNode {
-    // huffmanNode * for the inner nodes, T * for the nodes on the last level
-    // before the leafs (The T themselves represent the "leaf" level)
+    // huffmanNode * for the inner nodes, event indices for the nodes on the
+    // last level before the leafs (The events themselves represent the "leaf"
+    // level)
     huffmanNode *leftChild;
     huffmanNode *rightChild;
-    S *rightLeaf;
-    S *leftLeaf;
+    Index rightLeaf;
+    Index leftLeaf;
     double probability;
     bool isOnLastLevel = false;
   };
 
-  void addProbabilityFromRightSubtreeToLeftSubtree(huffmanNode<T> *n,
+  void addProbabilityFromRightSubtreeToLeftSubtree(huffmanNode *n,
                                                    double add) {
     // for each node, adds the probability of the right childnode to the left
     // childnode and every node under it. if the Tree would look like this (with
@@ -186,7 +198,8 @@ class huffmanTree {
     addProbabilityFromRightSubtreeToLeftSubtree(n->rightChild, add);
   }
 
-  void moveProbabilitiesFromRightSubtreesOneLevelUp(huffmanNode<T> *n) {
+  void moveProbabilitiesFromRightSubtreesOneLevelUp(
+      huffmanNode *n, const std::vector<double> &values) {
     // moves the Probabilities on the right subtrees one level up.
     // if the Tree would look like this (with the Numbers representing the
     // probability of every node) before calling this function
@@ -215,18 +228,17 @@ class huffmanTree {
     // to traverse the tree; the algorithm now is "while (!n.isLeaf())
     // n=p>n.p?n.left:n.right"
     if (n->isOnLastLevel) {
-      n->probability -= n->leftLeaf->getValue() / sum_of_values;
+      n->probability -= values[n->leftLeaf] / sum_of_values;
     } else {
       n->probability = n->rightChild->probability;
-      moveProbabilitiesFromRightSubtreesOneLevelUp(n->rightChild);
-      moveProbabilitiesFromRightSubtreesOneLevelUp(n->leftChild);
+      moveProbabilitiesFromRightSubtreesOneLevelUp(n->rightChild, values);
+      moveProbabilitiesFromRightSubtreesOneLevelUp(n->leftChild, values);
     }
   }
 
-  std::vector<huffmanNode<T>> htree;
+  std::vector<huffmanNode> htree;
   bool treeIsMade = false;
   double sum_of_values = 0.0;
-  std::vector<T> *events = nullptr;
 };
 
 }  // namespace xtp
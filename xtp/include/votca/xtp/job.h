@@ -22,12 +22,18 @@
 #define VOTCA_XTP_JOB_H
 
 // Standard includes
+#include <array>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
 
 // VOTCA includes
 #include <votca/tools/property.h>
+#include <votca/tools/xmlrecords.h>
+
+// Local VOTCA includes
+#include "jobpayload.h"
 
 namespace votca {
 namespace xtp {
@@ -40,6 +46,13 @@ class Job {
   Job(const tools::Property &prop);
   Job(Index id, const std::string &tag, const tools::Property &input,
       JobStatus status);
+  /// Job from a record of LOAD_JOBS, input and output are only read from
+  /// file when they are accessed
+  Job(const tools::XMLRecord &record, std::shared_ptr<const JobFile> file);
+
+  /// byte ranges of input and output in a written job file, see ToStream
+  using PayloadRanges =
+      std::array<std::pair<std::streamoff, std::streamoff>, 2>;
 
   std::string ConvertStatus(JobStatus) const;
   JobStatus ConvertStatus(std::string) const;
@@ -78,14 +91,21 @@ class Job {
   };
 
   void Reset();
-  void ToStream(std::ofstream &ofs) const;
+  /// Writes the job as xml, input and output that were not accessed yet are
+  /// copied verbatim from the job file. Their byte ranges in ofs are returned
+  /// and can be passed to RebasePayloads once the file is written.
+  PayloadRanges ToStream(std::ofstream &ofs) const;
+  /// input and output that were not accessed yet are read from `file` at
+  /// `ranges` from now on
+  void RebasePayloads(const std::shared_ptr<const JobFile> &file,
+                      const PayloadRanges &ranges) const;
   void UpdateFrom(const Job &ext);
   void UpdateFromResult(const JobResult &res);
 
   Index getId() const { return id_; }
   std::string getTag() const { return tag_; }
-  tools::Property &getInput() { return input_; }
-  const tools::Property &getInput() const { return input_; }
+  tools::Property &getInput() { return input_.get(); }
+  const tools::Property &getInput() const { return input_.get(); }
   const JobStatus &getStatus() const { return status_; }
   std::string getStatusStr() const { return ConvertStatus(status_); }
 
@@ -125,7 +145,7 @@ class Job {
   }
   const tools::Property &getOutput() const {
     assert(has_output_ && "Job has no output");
-    return output_;
+    return output_.get();
   }
   const std::string &getError() const {
     assert(has_error_ && "Job has no error");
@@ -138,14 +158,14 @@ class Job {
   std::string tag_;
   JobStatus status_;
   Index attemptsCount_ = 0;
-  tools::Property input_;
+  JobPayload input_;
 
   // Generated during runtime
   std::string host_;
   bool has_host_ = false;
   std::string time_;
   bool has_time_ = false;
-  tools::Property output_;
+  JobPayload output_;
   bool has_error_ = false;
   bool has_output_ = false;
   std::string error_;
@@ -0,0 +1,112 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_JOBPAYLOAD_H
+#define VOTCA_XTP_JOBPAYLOAD_H
+
+// Standard includes
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+// VOTCA includes
+#include <votca/tools/property.h>
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Job file that stays open to read the payloads of its jobs
+ *
+ * The file is kept open, so the payloads can still be read after the job
+ * file was replaced by a newer version via WRITE_JOBS.
+ */
+class JobFile {
+ public:
+  explicit JobFile(const std::string& filename);
+
+  const std::string& getFilename() const { return filename_; }
+
+  /// returns the bytes [begin, end) of the file
+  std::string Read(std::streamoff begin, std::streamoff end) const;
+
+ private:
+  std::string filename_;
+  mutable std::ifstream file_;
+  mutable std::mutex mutex_;
+};
+
+/**
+ * \brief Input or output of a job that can be read from a job file on first
+ * access
+ *
+ * After setSource only the byte range of the payload in the job file is
+ * stored. It is parsed into a tools::Property when get is called and copied
+ * verbatim when the job file is written again. Accessing the payload is
+ * thread safe, assigning it is not.
+ */
+class JobPayload {
+ public:
+  JobPayload() = default;
+  JobPayload(const tools::Property& prop) : prop_(prop) {}
+
+  JobPayload(const JobPayload& other) { *this = other; }
+  JobPayload& operator=(const JobPayload& other);
+  JobPayload& operator=(const tools::Property& prop);
+
+  /// bytes [begin, end) of file hold the xml element of the payload
+  void setSource(std::shared_ptr<const JobFile> file, std::streamoff begin,
+                 std::streamoff end);
+
+  bool isPending() const;
+
+  /// parses the payload if it is still pending
+  const tools::Property& get() const;
+  tools::Property& get();
+
+  /// writes the xml element of the payload indented by `indent`. Pending
+  /// payloads are copied from the job file without parsing them, for those
+  /// the byte range of the element in ofs is returned, otherwise {-1, -1}.
+  std::pair<std::streamoff, std::streamoff> ToStream(
+      std::ofstream& ofs, const std::string& indent) const;
+
+  /// A pending payload that was copied to [begin, end) of `file` is read from
+  /// there from now on, so the old job file can be closed
+  void Rebase(std::shared_ptr<const JobFile> file, std::streamoff begin,
+              std::streamoff end) const;
+
+ private:
+  struct Source {
+    std::shared_ptr<const JobFile> file;
+    std::streamoff begin;
+    std::streamoff end;
+  };
+
+  mutable tools::Property prop_;
+  mutable std::shared_ptr<const Source> source_ = nullptr;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_JOBPAYLOAD_H
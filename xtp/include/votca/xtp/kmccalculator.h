@@ -26,6 +26,7 @@
 
 // Local VOTCA includes
 #include "chargecarrier.h"
+#include "eventgraph.h"
 #include "gnode.h"
 #include "logger.h"
 #include "qmcalculator.h"
@@ -49,6 +50,9 @@ class KMCCalculator : public QMCalculator {
   QMStateType carriertype_;
 
   void LoadGraph(Topology& top);
+  /// \brief recomputes all rates for a new temperature and field, only
+  /// sites whose rates changed rebuild their huffman trees
+  void UpdateRates(double temperature, const Eigen::Vector3d& field);
   virtual void RunVSSM() = 0;
 
   void ParseCommonOptions(const tools::Property& options);
@@ -60,7 +64,7 @@ class KMCCalculator : public QMCalculator {
                       const std::vector<GNode*>& forbiddenlist) const;
   bool CheckSurrounded(const GNode& node,
                        const std::vector<GNode*>& forbiddendests) const;
-  const GLink& ChooseHoppingDest(const GNode& node);
+  GLink ChooseHoppingDest(const GNode& node);
   Chargecarrier* ChooseAffectedCarrier(double cumulated_rate);
 
   void WriteOccupationtoFile(double simtime, std::string filename);
@@ -69,6 +73,7 @@ class KMCCalculator : public QMCalculator {
   void RandomlyCreateCharges();
   void RandomlyAssignCarriertoSite(Chargecarrier& Charge);
   std::vector<GNode> nodes_;
+  EventGraph graph_;
   std::vector<Chargecarrier> carriers_;
 
   tools::Random RandomVariable_;
@@ -0,0 +1,141 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_LAZYCPTDATA_H
+#define VOTCA_XTP_LAZYCPTDATA_H
+
+// Standard includes
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Local VOTCA includes
+#include "checkpointreader.h"
+
+namespace votca {
+namespace xtp {
+
+/// HDF5 is not thread safe, all pending values are read under this lock
+inline std::mutex& LazyCptReadMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+/**
+ * \brief A value that can be read from a checkpoint on first access
+ *
+ * After setSource the dataset is only read when the value is accessed via *
+ * or ->, until then the reader keeps the checkpoint file open. Copying a
+ * pending value reads it first, so only one object ever holds the file.
+ * Several threads may access pending values at the same time, the reads of
+ * all values share one lock. Other HDF5 calls of the program are not
+ * serialized with them, assigning the value is not thread safe.
+ */
+template <typename T>
+class LazyCptData {
+ public:
+  LazyCptData() = default;
+  LazyCptData(const T& value) : value_(value) {}
+
+  LazyCptData(const LazyCptData& other) { *this = other; }
+  LazyCptData(LazyCptData&& other) noexcept { *this = std::move(other); }
+
+  LazyCptData& operator=(const LazyCptData& other) {
+    if (this != &other) {
+      other.Load();
+      std::scoped_lock lock(mutex_, other.mutex_);
+      value_ = other.value_;
+      source_.reset();
+      pending_ = false;
+    }
+    return *this;
+  }
+
+  LazyCptData& operator=(LazyCptData&& other) noexcept {
+    if (this != &other) {
+      std::scoped_lock lock(mutex_, other.mutex_);
+      value_ = std::move(other.value_);
+      source_ = std::move(other.source_);
+      pending_.store(other.pending_.load());
+      other.pending_ = false;
+    }
+    return *this;
+  }
+
+  LazyCptData& operator=(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value_ = value;
+    source_.reset();
+    pending_ = false;
+    return *this;
+  }
+
+  /// dataset name in r is read on first access
+  void setSource(const CheckpointReader& r, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source_ = std::make_shared<const Source>(Source{r, name});
+    pending_ = true;
+  }
+
+  bool isPending() const { return pending_.load(std::memory_order_acquire); }
+
+  /// reads the dataset if it is still pending and releases the file
+  void Load() const {
+    if (!isPending()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.load(std::memory_order_relaxed)) {
+      // releasing the reader closes HDF5 objects, too
+      std::lock_guard<std::mutex> read_lock(LazyCptReadMutex());
+      source_->reader(value_, source_->name);
+      source_.reset();
+      pending_.store(false, std::memory_order_release);
+    }
+  }
+
+  const T& operator*() const {
+    Load();
+    return value_;
+  }
+  T& operator*() {
+    Load();
+    return value_;
+  }
+  const T* operator->() const { return &(**this); }
+  T* operator->() { return &(**this); }
+
+ private:
+  struct Source {
+    CheckpointReader reader;
+    std::string name;
+  };
+
+  mutable T value_;
+  mutable std::shared_ptr<const Source> source_ = nullptr;
+  mutable std::atomic<bool> pending_ = false;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_LAZYCPTDATA_H
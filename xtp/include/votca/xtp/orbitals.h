@@ -31,6 +31,7 @@
 #include "checkpoint.h"
 #include "classicalsegment.h"
 #include "eigen.h"
+#include "lazycptdata.h"
 #include "qmmolecule.h"
 #include "qmstate.h"
 
@@ -42,6 +43,9 @@ namespace xtp {
  *
  * The Orbitals class stores orbital id, energy, MO coefficients, basis set
  *
+ * When read from a checkpoint, the MOs, QP and BSE eigensystems and the
+ * embedding matrices are only read from the file on first access, the
+ * file stays open until then.
  */
 class Orbitals {
  public:
@@ -53,13 +57,13 @@ class Orbitals {
 
   void setEmbeddedMOs(tools::EigenSystem &system) { mos_embedding_ = system; }
 
-  const tools::EigenSystem &getEmbeddedMOs() const { return mos_embedding_; }
+  const tools::EigenSystem &getEmbeddedMOs() const { return *mos_embedding_; }
 
   void setTruncMOsFullBasis(const Eigen::MatrixXd &expandedMOs) {
     expandedMOs_ = expandedMOs;
   }
 
-  const Eigen::MatrixXd getTruncMOsFullBasis() const { return expandedMOs_; }
+  const Eigen::MatrixXd getTruncMOsFullBasis() const { return *expandedMOs_; }
 
   Index getBasisSetSize() const { return dftbasis_.AOBasisSize(); }
 
@@ -103,10 +107,12 @@ class Orbitals {
   void setQMpackage(const std::string &qmpackage) { qm_package_ = qmpackage; }
 
   // access to DFT molecular orbital energies, new, tested
-  bool hasMOs() const { return (mos_.eigenvalues().size() > 0) ? true : false; }
+  bool hasMOs() const {
+    return (mos_->eigenvalues().size() > 0) ? true : false;
+  }
 
-  const tools::EigenSystem &MOs() const { return mos_; }
-  tools::EigenSystem &MOs() { return mos_; }
+  const tools::EigenSystem &MOs() const { return *mos_; }
+  tools::EigenSystem &MOs() { return *mos_; }
 
   // determine (pseudo-)degeneracy of a DFT molecular orbital
   std::vector<Index> CheckDegeneracy(Index level,
@@ -115,19 +121,19 @@ class Orbitals {
   Index NumberofStates(QMStateType type) const {
     switch (type.Type()) {
       case QMStateType::Singlet:
-        return Index(BSE_singlet_.eigenvalues().size());
+        return Index(BSE_singlet_->eigenvalues().size());
         break;
       case QMStateType::Triplet:
-        return Index(BSE_triplet_.eigenvalues().size());
+        return Index(BSE_triplet_->eigenvalues().size());
         break;
       case QMStateType::KSstate:
-        return Index(mos_.eigenvalues().size());
+        return Index(mos_->eigenvalues().size());
         break;
       case QMStateType::PQPstate:
         return Index(QPpert_energies_.size());
         break;
       case QMStateType::DQPstate:
-        return Index(QPdiag_.eigenvalues().size());
+        return Index(QPdiag_->eigenvalues().size());
         break;
       default:
         return 1;
@@ -283,28 +289,28 @@ class Orbitals {
   // access to diagonalized QP energies and wavefunctions
 
   bool hasQPdiag() const {
-    return (QPdiag_.eigenvalues().size() > 0) ? true : false;
+    return (QPdiag_->eigenvalues().size() > 0) ? true : false;
   }
-  const tools::EigenSystem &QPdiag() const { return QPdiag_; }
-  tools::EigenSystem &QPdiag() { return QPdiag_; }
+  const tools::EigenSystem &QPdiag() const { return *QPdiag_; }
+  tools::EigenSystem &QPdiag() { return *QPdiag_; }
 
   bool hasBSETriplets() const {
-    return (BSE_triplet_.eigenvectors().cols() > 0) ? true : false;
+    return (BSE_triplet_->eigenvectors().cols() > 0) ? true : false;
   }
 
-  const tools::EigenSystem &BSETriplets() const { return BSE_triplet_; }
+  const tools::EigenSystem &BSETriplets() const { return *BSE_triplet_; }
 
-  tools::EigenSystem &BSETriplets() { return BSE_triplet_; }
+  tools::EigenSystem &BSETriplets() { return *BSE_triplet_; }
 
   // access to singlet energies and wave function coefficients
 
   bool hasBSESinglets() const {
-    return (BSE_singlet_.eigenvectors().cols() > 0) ? true : false;
+    return (BSE_singlet_->eigenvectors().cols() > 0) ? true : false;
   }
 
-  const tools::EigenSystem &BSESinglets() const { return BSE_singlet_; }
+  const tools::EigenSystem &BSESinglets() const { return *BSE_singlet_; }
 
-  tools::EigenSystem &BSESinglets() { return BSE_singlet_; }
+  tools::EigenSystem &BSESinglets() { return *BSE_singlet_; }
 
   // access to BSE energies with dynamical screening
   bool hasBSESinglets_dynamic() const {
@@ -371,6 +377,9 @@ class Orbitals {
 
   void ReadFromCpt(const std::string &filename);
 
+  /// reads all datasets still pending from ReadFromCpt and closes the file
+  void LoadPendingData() const;
+
   void WriteToCpt(CheckpointWriter w) const;
   void WriteBasisSetsToCpt(CheckpointWriter w) const;
   void ReadFromCpt(CheckpointReader r);
@@ -392,7 +401,9 @@ class Orbitals {
     active_electrons_ = active_electrons;
   }
 
-  const Eigen::MatrixXd &getInactiveDensity() const { return inactivedensity_; }
+  const Eigen::MatrixXd &getInactiveDensity() const {
+    return *inactivedensity_;
+  }
   void setInactiveDensity(Eigen::MatrixXd inactivedensity) {
     inactivedensity_ = inactivedensity;
   }
@@ -421,14 +432,14 @@ class Orbitals {
 
   std::string CalcType_ = "NoEmbedding";
 
-  tools::EigenSystem mos_;
-  tools::EigenSystem mos_embedding_;
+  LazyCptData<tools::EigenSystem> mos_;
+  LazyCptData<tools::EigenSystem> mos_embedding_;
 
   Eigen::MatrixXd lmos_;
   Eigen::VectorXd lmos_energies_;
   Index active_electrons_;
-  Eigen::MatrixXd inactivedensity_;
-  Eigen::MatrixXd expandedMOs_;
+  LazyCptData<Eigen::MatrixXd> inactivedensity_;
+  LazyCptData<Eigen::MatrixXd> expandedMOs_;
 
   QMMolecule atoms_;
 
@@ -462,11 +473,11 @@ class Orbitals {
   Eigen::VectorXd QPpert_energies_;
 
   // quasiparticle energies and coefficients after diagonalization
-  tools::EigenSystem QPdiag_;
+  LazyCptData<tools::EigenSystem> QPdiag_;
 
-  tools::EigenSystem BSE_singlet_;
+  LazyCptData<tools::EigenSystem> BSE_singlet_;
   std::vector<Eigen::Vector3d> transition_dipoles_;
-  tools::EigenSystem BSE_triplet_;
+  LazyCptData<tools::EigenSystem> BSE_triplet_;
 
   // singlet and triplet energies after perturbative dynamical screening
   Eigen::VectorXd BSE_singlet_energies_dynamic_;
@@ -27,29 +27,64 @@
 namespace votca {
 namespace xtp {
 
+/**
+ * \brief Pipek-Mezey localization of the occupied orbitals
+ *
+ * The atomic populations are stored sparsely, an orbital only keeps the
+ * atoms on which its coefficients or their overlap projections exceed
+ * population_threshold, which bounds the neglected population elements by
+ * that threshold. Three optimizers are available:
+ * - jacobi-sweeps: 2x2 rotations of the pair with the largest penalty, or
+ *   with parallel_rotations of all non-overlapping pairs above the
+ *   convergence limit at once
+ * - unitary-optimizer: conjugate gradients on the unitary group with a
+ *   polynomial line search
+ * - gradient-ascent: conjugate gradients on the unitary group with an
+ *   Armijo backtracking line search. Every step increases the bounded PM
+ *   functional and the search direction is reset to the gradient if it is
+ *   not sufficiently ascending, so the gradient norm goes to zero. It is
+ *   converged once the squared gradient norm is below the convergence limit.
+ */
 class PMLocalization {
  public:
   PMLocalization(Logger &log, const tools::Property &options) : log_(log) {
     nrOfIterations_ = options.get(".max_iterations").as<Index>();
     convergence_limit_ = options.get(".convergence_limit").as<double>();
     method_ = options.get(".method").as<std::string>();
+    population_threshold_ = options.ifExistsReturnElseReturnDefault<double>(
+        ".population_threshold", population_threshold_);
+    parallel_rotations_ = options.ifExistsReturnElseReturnDefault<bool>(
+        ".parallel_rotations", parallel_rotations_);
   };
   void computePML(Orbitals &orbitals);
   void computePML_UT(Orbitals &orbitals);
   void computePML_JS(Orbitals &orbitals);
+  void computePML_GA(Orbitals &orbitals);
 
  private:
+  // populations of one orbital on the atoms it has weight on
+  struct OrbitalPopulation {
+    std::vector<Index> atoms;  // sorted
+    std::vector<double> pops;
+    double sumsq = 0.0;  // sum of pops^2
+  };
+
+  // charge matrix of one atom between the orbitals with weight on it
+  struct AtomPopulation {
+    std::vector<Index> orbitals;
+    Eigen::MatrixXd Q;
+  };
+
   Logger &log_;
 
   std::string method_;
 
   // functions for unitary optimizer
   double cost(const Eigen::MatrixXd &W,
-              const std::vector<Eigen::MatrixXd> &Sat_all,
-              const Index nat) const;
+              const std::vector<AtomPopulation> &Sat_all) const;
   std::pair<double, Eigen::MatrixXd> cost_derivative(
-      const Eigen::MatrixXd &W, const std::vector<Eigen::MatrixXd> &Sat_all,
-      const Index nat) const;
+      const Eigen::MatrixXd &W,
+      const std::vector<AtomPopulation> &Sat_all) const;
 
   Eigen::VectorXd fit_polynomial(const Eigen::VectorXd &x,
                                  const Eigen::VectorXd &y) const;
@@ -60,29 +95,42 @@ class PMLocalization {
                            const Eigen::VectorXcd &eval,
                            const Eigen::MatrixXcd &evec) const;
 
-  std::vector<Eigen::MatrixXd> setup_pop_matrices(
-      const Eigen::MatrixXd &occ_orbitals);
+  std::vector<AtomPopulation> setup_pop_matrices(
+      const Eigen::MatrixXd &occ_orbitals,
+      const Eigen::MatrixXd &s_occ_orbitals) const;
 
   double inner_prod(const Eigen::MatrixXd &A, const Eigen::MatrixXd &B) const {
     return (0.5 * A.transpose() * B).trace();
   }
 
   // functions for Jacobi sweeps
-  Eigen::MatrixX2d rotateorbitals(const Eigen::MatrixX2d &maxorbs, Index s,
-                                  Index t);
+  double rotation_angle(Index s, Index t) const;
+  void rotateorbitals(Index s, Index t, double gamma);
+  std::vector<std::pair<Index, Index>> select_rotation_pairs() const;
 
   void initial_penalty();
-  void update_penalty(Index s, Index t);
+  void update_penalty(const std::vector<Index> &rotated);
+  void pair_penalty(Index s, Index t);
   void check_orthonormality();
   Eigen::VectorXd calculate_lmo_energies(const Orbitals &orbitals);
   std::pair<Eigen::MatrixXd, Eigen::VectorXd> sort_lmos(
       const Eigen::VectorXd &energies);
-
-  Eigen::VectorXd pop_per_atom(const Eigen::VectorXd &orbital);
-  Eigen::Vector2d offdiag_penalty_elements(const Eigen::MatrixXd &s_overlap,
-                                           Index s, Index t);
+  void store_lmos(Orbitals &orbitals);
+
+  void setup_overlap(const Orbitals &orbitals);
+  bool has_weight(const Eigen::MatrixXd &orbitals,
+                  const Eigen::MatrixXd &s_orbitals, Index s,
+                  Index atom) const;
+  // population of the pair s,t on atom, orbitals and s_orbitals=S*orbitals
+  double pair_pop(const Eigen::MatrixXd &orbitals,
+                  const Eigen::MatrixXd &s_orbitals, Index s, Index t,
+                  Index atom) const;
+  OrbitalPopulation pop_per_atom(Index s) const;
+  Eigen::Vector2d offdiag_penalty_elements(Index s, Index t) const;
 
   Eigen::MatrixXd localized_orbitals_;
+  // overlap_ * localized_orbitals_
+  Eigen::MatrixXd s_localized_orbitals_;
 
   AOBasis aobasis_;
   Eigen::MatrixXd overlap_;
@@ -92,7 +140,7 @@ class PMLocalization {
   Eigen::MatrixXd A_;
   Eigen::MatrixXd B_;
   Eigen::MatrixXd PM_penalty_;
-  Eigen::MatrixXd MullikenPop_orb_per_atom_;
+  std::vector<OrbitalPopulation> MullikenPop_orb_per_atom_;
 
   // variables for unitary optimization
   Eigen::MatrixXd W_;
@@ -107,9 +155,12 @@ class PMLocalization {
   double G_threshold_ = 1e-5;
 
   std::vector<Index> numfuncpatom_;
+  std::vector<Index> atomstart_;
 
   Index nrOfIterations_ = 0;
   double convergence_limit_ = 0.0;
+  double population_threshold_ = 1e-8;
+  bool parallel_rotations_ = false;
 };
 
 }  // namespace xtp
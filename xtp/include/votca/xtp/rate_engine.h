@@ -42,10 +42,21 @@ class Rate_Engine {
 
   PairRates Rate(const QMPair& pair, QMStateType carriertype) const;
 
+  /// \brief rates of many hopping events at once
+  ///
+  /// event i hops along dr.col(i) with the site energy difference dG_site(i)
+  /// and the reorganisation energy reorg(i)
+  Eigen::VectorXd Rates(const Eigen::Ref<const Eigen::VectorXd>& jeff2,
+                        const Eigen::Ref<const Eigen::VectorXd>& dG_site,
+                        const Eigen::Ref<const Eigen::VectorXd>& reorg,
+                        const Eigen::Ref<const Eigen::Matrix3Xd>& dr,
+                        QMStateType carriertype) const;
+
   friend std::ostream& operator<<(std::ostream& out,
                                   const Rate_Engine& rate_engine);
 
  private:
+  double Charge(QMStateType carriertype) const;
   double Marcusrate(double Jeff2, double deltaG, double reorg) const;
   std::string ratetype_ = "marcus";
   double temperature_ = 0.0;                         // units:Hartree
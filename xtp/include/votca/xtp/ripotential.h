@@ -0,0 +1,97 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_RIPOTENTIAL_H
+#define VOTCA_XTP_RIPOTENTIAL_H
+
+// Standard includes
+#include <array>
+#include <vector>
+
+// Local VOTCA includes
+#include "aobasis.h"
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Electrostatic potential of an electron density fitted to an
+ * auxiliary basis
+ *
+ * The density matrix is fitted once in the Coulomb metric,
+ * c = V^-1 (P|mu nu) D_mu nu, afterwards the potential at a point only
+ * requires the potentials of the auxiliary functions, which are known
+ * analytically. Points far away from the density can optionally be
+ * evaluated from the multipole moments of the fitted density up to the
+ * quadrupole.
+ */
+class RIPotential {
+ public:
+  RIPotential(const AOBasis& dftbasis, const AOBasis& auxbasis)
+      : dftbasis_(dftbasis), auxbasis_(auxbasis){};
+
+  /// fits the density of dmat to the auxiliary basis
+  void FitDensity(const Eigen::MatrixXd& dmat);
+
+  /// points for which (density extent/distance)^3 < tolerance are evaluated
+  /// from the multipole moments of the fitted density, 0 switches this off
+  void setFarfieldTolerance(double tolerance) {
+    farfield_tolerance_ = tolerance;
+  }
+
+  /// potential of the electrons, i.e. negative, at the positions
+  Eigen::VectorXd Potential(
+      const std::vector<Eigen::Vector3d>& positions) const;
+
+  const Eigen::VectorXd& Coefficients() const { return coefficients_; }
+
+  /// number of electrons in the fitted density
+  double FittedElectrons() const { return moments_[0]; }
+
+ private:
+  // (P|mu nu) D_mu nu for all auxiliary functions P
+  Eigen::VectorXd ContractThreeCenter(const Eigen::MatrixXd& dmat) const;
+
+  // sum_P c_P (P|1/|r-r_i||1) for the positions r_i with index in indices
+  Eigen::VectorXd AuxiliaryPotential(
+      const std::vector<Eigen::Vector3d>& positions,
+      const std::vector<Index>& indices) const;
+
+  // moments of all auxiliary functions around center_, in the order
+  // 1, x, y, z, xx, xy, xz, yy, yz, zz
+  std::array<Eigen::VectorXd, 10> AuxiliaryMoments() const;
+
+  double FarfieldPotential(const Eigen::Vector3d& position) const;
+
+  const AOBasis& dftbasis_;
+  const AOBasis& auxbasis_;
+  double farfield_tolerance_ = 0.0;
+
+  Eigen::VectorXd coefficients_;
+  Eigen::Vector3d center_ = Eigen::Vector3d::Zero();
+  double extent_ = 0.0;
+  std::array<double, 10> moments_ = {0};
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_RIPOTENTIAL_H
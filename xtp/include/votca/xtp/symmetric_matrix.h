@@ -48,6 +48,18 @@ class Symmetric_Matrix {
 
   double TraceofProd(const Symmetric_Matrix& a) const;
 
+  // Frobenius norm of the full matrix
+  double FrobeniusNorm() const;
+
+  // the stored triangle as one vector, for elementwise operations between
+  // matrices of the same size
+  Eigen::Map<Eigen::VectorXd> Packed() {
+    return Eigen::Map<Eigen::VectorXd>(data.data(), Index(data.size()));
+  }
+  Eigen::Map<const Eigen::VectorXd> Packed() const {
+    return Eigen::Map<const Eigen::VectorXd>(data.data(), Index(data.size()));
+  }
+
   void AddtoEigenMatrix(Eigen::MatrixXd& full, double factor = 1.0) const;
 
   void AddtoEigenUpperMatrix(
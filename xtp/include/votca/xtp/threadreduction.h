@@ -0,0 +1,99 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_THREADREDUCTION_H
+#define VOTCA_XTP_THREADREDUCTION_H
+
+// Standard includes
+#include <mutex>
+#include <vector>
+
+// Local VOTCA includes
+#include "eigen.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Sums the contributions of several OpenMP threads into one matrix
+ *
+ * The matrix is split into square tiles, each guarded by its own lock. A
+ * thread adds its contribution tile by tile, starting at a tile that depends
+ * on its thread id, so threads rarely wait for each other. The lock is only
+ * taken for the addition, work done for a tile beforehand runs unlocked.
+ * Unlike an OpenMP reduction no thread needs a private copy of the whole
+ * matrix and there is no serial merge at the end of the parallel region.
+ */
+class TiledAccumulator {
+ public:
+  TiledAccumulator(Index rows, Index cols, Index tilesize = 128);
+
+  /// adds block to the matrix starting at (row, col), thread safe
+  void Add(Index row, Index col,
+           const Eigen::Ref<const Eigen::MatrixXd>& block);
+
+  /// adds the upper triangle, including the diagonal, of alpha * A^T * B to
+  /// the square result, thread safe. Each tile of the product is computed
+  /// just before it is added, so the full product is never stored. The lower
+  /// triangle of the result is not touched.
+  void AddUpperProduct(double alpha,
+                       const Eigen::Ref<const Eigen::MatrixXd>& A,
+                       const Eigen::Ref<const Eigen::MatrixXd>& B);
+
+  const Eigen::MatrixXd& Matrix() const { return result_; }
+
+ private:
+  template <class Func>
+  void ForTiles(Index row, Index col, Index rows, Index cols, bool upperonly,
+                const Func& func);
+
+  Index tilesize_;
+  Index rowtiles_;
+  Index coltiles_;
+  Eigen::MatrixXd result_;
+  std::vector<std::mutex> locks_;
+};
+
+/**
+ * \brief Sums n partial results into the first one in log2(n) parallel steps
+ *
+ * add(i, j) has to add partial j to partial i, it is called for disjoint
+ * pairs from several threads at the same time.
+ */
+template <class AddFunc>
+void TreeReduce(Index n, const AddFunc& add) {
+  for (Index stride = 1; stride < n; stride *= 2) {
+#pragma omp parallel for schedule(static)
+    for (Index i = 0; i < n - stride; i += 2 * stride) {
+      add(i, i + stride);
+    }
+  }
+}
+
+template <class T>
+void TreeReduce(std::vector<T>& partials) {
+  TreeReduce(Index(partials.size()),
+             [&](Index i, Index j) { partials[i] += partials[j]; });
+}
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_THREADREDUCTION_H
@@ -56,6 +56,7 @@ std::vector<Index> AOBasis::getMapToBasisFunctions() const {
 
 AOShell& AOBasis::addShell(const Shell& shell, const QMAtom& atom,
                            Index startIndex) {
+  InvalidateCache();
   aoshells_.push_back(AOShell(shell, atom, startIndex));
   return aoshells_.back();
 }
@@ -71,6 +72,7 @@ const std::vector<const AOShell*> AOBasis::getShellsofAtom(Index AtomId) const {
 }
 
 void AOBasis::add(const AOBasis& other) {
+  InvalidateCache();
   Index atomindex_offset = Index(FuncperAtom_.size());
   for (AOShell shell : other) {
     shell.atomindex_ += atomindex_offset;
@@ -125,13 +127,29 @@ std::vector<libint2::Shell> AOBasis::GenerateLibintBasis() const {
   return libintshells;
 }
 
+const std::vector<libint2::Shell>& AOBasis::LibintBasis() const {
+  std::shared_ptr<LibintCache> cache = cache_;
+  std::call_once(cache->shells_flag,
+                 [&]() { cache->shells = GenerateLibintBasis(); });
+  return cache->shells;
+}
+
+const std::vector<std::vector<Index>>& AOBasis::ShellPairs() const {
+  std::shared_ptr<LibintCache> cache = cache_;
+  std::call_once(cache->pairs_flag,
+                 [&]() { cache->pairs = ComputeShellPairs(); });
+  return cache->pairs;
+}
+
 void AOBasis::UpdateShellPositions(const QMMolecule& mol) {
+  InvalidateCache();
   for (AOShell& shell : aoshells_) {
     shell.pos_ = mol[shell.getAtomIndex()].getPos();
   }
 }
 
 void AOBasis::clear() {
+  InvalidateCache();
   name_ = "";
   aoshells_.clear();
   FuncperAtom_.clear();
@@ -19,6 +19,10 @@
 
 // Standard includes
 #include <vector>
+
+// VOTCA includes
+#include <votca/tools/linalg.h>
+
 // Local VOTCA includes
 #include "votca/xtp/aomatrix.h"
 
@@ -26,7 +30,7 @@ namespace votca {
 namespace xtp {
 
 Eigen::MatrixXd AOOverlap::Pseudo_InvSqrt(double etol) {
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(aomatrix_);
+  tools::EigenSystem es = tools::linalg_eigenvalues(aomatrix_);
   smallestEigenvalue = es.eigenvalues()(0);
   Eigen::VectorXd diagonal = Eigen::VectorXd::Zero(es.eigenvalues().size());
   removedfunctions = 0;
@@ -53,7 +57,7 @@ Eigen::MatrixXd AOOverlap::Sqrt() {
 Eigen::MatrixXd AOCoulomb::Pseudo_InvSqrt_GWBSE(const AOOverlap& auxoverlap,
                                                 double etol) {
 
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eo(auxoverlap.Matrix());
+  tools::EigenSystem eo = tools::linalg_eigenvalues(auxoverlap.Matrix());
   removedfunctions = 0;
   Eigen::VectorXd diagonal_overlap =
       Eigen::VectorXd::Zero(eo.eigenvalues().size());
@@ -68,7 +72,7 @@ Eigen::MatrixXd AOCoulomb::Pseudo_InvSqrt_GWBSE(const AOOverlap& auxoverlap,
                           eo.eigenvectors().transpose();
 
   Eigen::MatrixXd ortho = Ssqrt * aomatrix_ * Ssqrt;
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(ortho);
+  tools::EigenSystem es = tools::linalg_eigenvalues(ortho);
   Eigen::VectorXd diagonal = Eigen::VectorXd::Zero(es.eigenvalues().size());
 
   for (Index i = 0; i < diagonal.size(); ++i) {
@@ -86,7 +90,7 @@ Eigen::MatrixXd AOCoulomb::Pseudo_InvSqrt_GWBSE(const AOOverlap& auxoverlap,
 }
 
 Eigen::MatrixXd AOCoulomb::Pseudo_InvSqrt(double etol) {
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(aomatrix_);
+  tools::EigenSystem es = tools::linalg_eigenvalues(aomatrix_);
   Eigen::VectorXd diagonal = Eigen::VectorXd::Zero(es.eigenvalues().size());
   removedfunctions = 0;
   for (Index i = 0; i < diagonal.size(); ++i) {
@@ -17,6 +17,11 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
 // Local VOTCA includes
 #include "votca/xtp/aopotential.h"
 #include "votca/xtp/aotransform.h"
@@ -25,6 +30,43 @@
 namespace votca {
 namespace xtp {
 
+namespace {
+
+// potential of a point multipole, the quadrupole enters with the same
+// convention as in AOMultipole::FillBlock
+double SitePotential(const StaticSite& site, const Eigen::Vector3d& r) {
+  const Eigen::Vector3d R = r - site.getPos();
+  const double invR2 = 1.0 / R.squaredNorm();
+  const double invR = std::sqrt(invR2);
+  double potential = site.getCharge() * invR;
+  potential += site.getDipole().dot(R) * invR * invR2;
+  if (site.getRank() > 1) {
+    potential += 0.75 * R.dot(site.CalculateCartesianMultipole() * R) * invR *
+                 invR2 * invR2;
+  }
+  return potential;
+}
+
+// roughly evenly spaced points on a sphere (Fibonacci lattice)
+std::vector<Eigen::Vector3d> SpherePoints(Index npoints,
+                                          const Eigen::Vector3d& center,
+                                          double radius) {
+  const double pi = boost::math::constants::pi<double>();
+  const double golden_angle = pi * (3.0 - std::sqrt(5.0));
+  std::vector<Eigen::Vector3d> points;
+  points.reserve(npoints);
+  for (Index i = 0; i < npoints; i++) {
+    double z = 1.0 - (2.0 * double(i) + 1.0) / double(npoints);
+    double rho = std::sqrt(1.0 - z * z);
+    double phi = golden_angle * double(i);
+    points.push_back(center + radius * Eigen::Vector3d(rho * std::cos(phi),
+                                                       rho * std::sin(phi), z));
+  }
+  return points;
+}
+
+}  // namespace
+
 void AOMultipole::FillBlock(Eigen::Block<Eigen::MatrixXd>& matrix,
                             const AOShell& shell_row,
                             const AOShell& shell_col) const {
@@ -2104,16 +2146,193 @@ void AOMultipole::FillPotential(const AOBasis& aobasis,
   return;
 }
 
+StaticSite AOMultipole::CombineSites(
+    const std::vector<const StaticSite*>& sites,
+    const Eigen::Vector3d& center) {
+  // The quadrupole tensor of a StaticSite acts in FillBlock like a set of
+  // charges with traceless second moment 0.5*theta (see the six monopole
+  // comparison in test_aopotential), so the shifted moments are collected as
+  // traceless second moments and multiplied by 2 at the end.
+  double charge = 0.0;
+  Eigen::Vector3d dipole = Eigen::Vector3d::Zero();
+  Eigen::Matrix3d secondmoment = Eigen::Matrix3d::Zero();
+  for (const StaticSite* site : sites) {
+    const Eigen::Vector3d d = site->getPos() - center;
+    const double q = site->getCharge();
+    const Eigen::Vector3d p = site->getDipole();
+    charge += q;
+    dipole += p + q * d;
+    const Eigen::Matrix3d pd = p * d.transpose();
+    secondmoment += 0.5 * site->CalculateCartesianMultipole() + pd +
+                    pd.transpose() + q * d * d.transpose();
+  }
+  secondmoment -= secondmoment.trace() / 3.0 * Eigen::Matrix3d::Identity();
+
+  Vector9d multipoles = Vector9d::Zero();
+  multipoles(0) = charge;
+  multipoles.segment<3>(1) = dipole;
+  multipoles.segment<5>(4) =
+      StaticSite::CalculateSphericalMultipole(2.0 * secondmoment);
+  StaticSite combined(-1, "X", center);
+  combined.setMultipole(multipoles, 2);
+  return combined;
+}
+
+void AOMultipole::PartitionSites(const std::vector<const StaticSite*>& sites,
+                                 const Eigen::Vector3d& qmcenter,
+                                 double qmradius, double farfield_tolerance,
+                                 std::vector<const StaticSite*>& nearsites,
+                                 std::vector<StaticSite>& farsites) {
+  if (sites.size() == 1) {
+    nearsites.push_back(sites.front());
+    return;
+  }
+  Eigen::Vector3d min = sites.front()->getPos();
+  Eigen::Vector3d max = min;
+  for (const StaticSite* site : sites) {
+    min = min.cwiseMin(site->getPos());
+    max = max.cwiseMax(site->getPos());
+  }
+  const Eigen::Vector3d center = 0.5 * (min + max);
+  double radius = 0.0;
+  for (const StaticSite* site : sites) {
+    radius = std::max(radius, (site->getPos() - center).norm());
+  }
+  const double distance = (center - qmcenter).norm() - qmradius;
+  if (distance > 0 && std::pow(radius / distance, 3) < farfield_tolerance) {
+    farsites.push_back(CombineSites(sites, center));
+    return;
+  }
+  // sites on top of each other cannot be split any further
+  const Index leafsize = 8;
+  if (Index(sites.size()) <= leafsize || radius < 1e-9) {
+    nearsites.insert(nearsites.end(), sites.begin(), sites.end());
+    return;
+  }
+  std::array<std::vector<const StaticSite*>, 8> octants;
+  for (const StaticSite* site : sites) {
+    const Eigen::Vector3d& pos = site->getPos();
+    Index octant = (pos.x() >= center.x() ? 1 : 0) +
+                   (pos.y() >= center.y() ? 2 : 0) +
+                   (pos.z() >= center.z() ? 4 : 0);
+    octants[octant].push_back(site);
+  }
+  for (const std::vector<const StaticSite*>& octant : octants) {
+    if (!octant.empty()) {
+      PartitionSites(octant, qmcenter, qmradius, farfield_tolerance,
+                     nearsites, farsites);
+    }
+  }
+}
+
+std::vector<StaticSite> AOMultipole::EquivalentCharges(
+    const std::vector<const StaticSite*>& sites,
+    const Eigen::Vector3d& qmcenter, double qmradius, double radius,
+    Index npoints) {
+  // potential of the sites on a check sphere around the basis functions
+  const std::vector<Eigen::Vector3d> checkpoints =
+      SpherePoints(2 * npoints, qmcenter, qmradius);
+  Eigen::VectorXd potential = Eigen::VectorXd::Zero(2 * npoints);
+#pragma omp parallel for
+  for (Index i = 0; i < 2 * npoints; i++) {
+    for (const StaticSite* site : sites) {
+      potential(i) += SitePotential(*site, checkpoints[i]);
+    }
+  }
+
+  // charges on a larger sphere reproducing this potential, inside the check
+  // sphere both potentials are then the same harmonic function
+  const std::vector<Eigen::Vector3d> equivpoints =
+      SpherePoints(npoints, qmcenter, radius);
+  Eigen::MatrixXd coulomb(2 * npoints, npoints);
+  for (Index i = 0; i < 2 * npoints; i++) {
+    for (Index j = 0; j < npoints; j++) {
+      coulomb(i, j) = 1.0 / (checkpoints[i] - equivpoints[j]).norm();
+    }
+  }
+  Eigen::BDCSVD<Eigen::MatrixXd> svd(coulomb,
+                                     Eigen::ComputeThinU | Eigen::ComputeThinV);
+  svd.setThreshold(1e-12);
+  Eigen::VectorXd charges = svd.solve(potential);
+
+  std::vector<StaticSite> equivalentsites;
+  equivalentsites.reserve(npoints);
+  for (Index j = 0; j < npoints; j++) {
+    equivalentsites.emplace_back(-1, "X", equivpoints[j]);
+    equivalentsites.back().setCharge(charges(j));
+  }
+  return equivalentsites;
+}
+
 void AOMultipole::FillPotential(
     const AOBasis& aobasis,
-    const std::vector<std::unique_ptr<StaticSite>>& externalsites) {
+    const std::vector<std::unique_ptr<StaticSite>>& externalsites,
+    double farfield_tolerance) {
   aopotential_ =
       Eigen::MatrixXd::Zero(aobasis.AOBasisSize(), aobasis.AOBasisSize());
+  if (farfield_tolerance <= 0.0 || externalsites.empty()) {
+    for (const std::unique_ptr<StaticSite>& site : externalsites) {
+      setSite(site.get());
+      aopotential_ -= Fill(aobasis);
+    }
+    return;
+  }
+  if (farfield_tolerance >= 1.0) {
+    throw std::runtime_error(
+        "AOMultipole: the farfield tolerance has to be smaller than 1");
+  }
+
+  // the region the basis functions live in, a shell extends to the radius
+  // at which its most diffuse gaussian dropped to farfield_tolerance
+  Eigen::Vector3d qmcenter = Eigen::Vector3d::Zero();
+  for (const AOShell& shell : aobasis) {
+    qmcenter += shell.getPos();
+  }
+  qmcenter /= double(aobasis.getNumofShells());
+  double qmradius = 0.0;
+  for (const AOShell& shell : aobasis) {
+    double extent =
+        std::sqrt(-std::log(farfield_tolerance) / shell.getMinDecay());
+    qmradius = std::max(qmradius, (shell.getPos() - qmcenter).norm() + extent);
+  }
+
+  // sites beyond twice the radius are replaced by equivalent charges, the
+  // number of charges grows with the number of digits requested, roughly
+  // resolving the angular momenta l with 0.5^l > farfield_tolerance
+  const double gridradius = 2.0 * qmradius;
+  const double digits = -std::log2(farfield_tolerance);
+  const Index npoints =
+      std::clamp(Index(std::ceil(digits * digits)), Index(16), Index(400));
+  std::vector<const StaticSite*> sites;
+  std::vector<const StaticSite*> gridsites;
   for (const std::unique_ptr<StaticSite>& site : externalsites) {
-    setSite(site.get());
-    aopotential_ -= Fill(aobasis);
+    if ((site->getPos() - qmcenter).norm() > gridradius) {
+      gridsites.push_back(site.get());
+    } else {
+      sites.push_back(site.get());
+    }
+  }
+  std::vector<const StaticSite*> nearsites;
+  std::vector<StaticSite> farsites;
+  if (!sites.empty()) {
+    PartitionSites(sites, qmcenter, qmradius, farfield_tolerance, nearsites,
+                   farsites);
+  }
+  if (!gridsites.empty()) {
+    std::vector<StaticSite> equivalentsites =
+        EquivalentCharges(gridsites, qmcenter, qmradius, gridradius, npoints);
+    farsites.insert(farsites.end(), equivalentsites.begin(),
+                    equivalentsites.end());
   }
 
+  for (const StaticSite* site : nearsites) {
+    setSite(site);
+    aopotential_ -= Fill(aobasis);
+  }
+  for (const StaticSite& site : farsites) {
+    setSite(&site);
+    aopotential_ -= Fill(aobasis);
+  }
   return;
 }
 
@@ -22,6 +22,7 @@
 
 // VOTCA includes
 #include <votca/tools/constants.h>
+#include <votca/tools/linalg.h>
 
 // Local VOTCA includes
 #include "votca/xtp/aomatrix.h"
@@ -600,7 +601,7 @@ Eigen::MatrixXd BSECoupling::Perturbation(
     Eigen::MatrixXd transformation =
         Eigen::MatrixXd::Identity(J_dimer.rows(), J_dimer.cols());
     Eigen::MatrixXd Ct = J_dimer.bottomRightCorner(ct, ct);
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(Ct);
+    tools::EigenSystem es = tools::linalg_eigenvalues(Ct);
     transformation.bottomRightCorner(ct, ct) = es.eigenvectors();
     Ct.resize(0, 0);
 
@@ -658,7 +659,7 @@ Eigen::MatrixXd BSECoupling::Perturbation(
 
 Eigen::MatrixXd BSECoupling::Fulldiag(const Eigen::MatrixXd& J_dimer) const {
   Index bse_exc = levA_ + levB_;
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(J_dimer);
+  tools::EigenSystem es = tools::linalg_eigenvalues(J_dimer);
   XTP_LOG(Log::debug, *pLog_)
       << "---------------------------------------" << flush;
   XTP_LOG(Log::debug, *pLog_) << "Eigenvectors of J" << flush;
@@ -106,10 +106,12 @@ void EAnalyze::SiteHist(QMStateType state) const {
 
   double MAX = *std::max_element(Es.begin(), Es.end());
   double MIN = *std::min_element(Es.begin(), Es.end());
-  double sum = std::accumulate(Es.begin(), Es.end(), 0.0);
-  double AVG = sum / double(Es.size());
-  double sq_sum = std::inner_product(Es.begin(), Es.end(), Es.begin(), 0.0);
-  double STD = std::sqrt(sq_sum / double(Es.size()) - AVG * AVG);
+  tools::RunningAverage average;
+  for (double E : Es) {
+    average.Process(E);
+  }
+  double AVG = average.getAvg();
+  double STD = average.getSig();
 
   // Prepare bins
   Index BIN = Index((MAX - MIN) / resolution_sites_ + 0.5) + 1;
@@ -179,10 +181,12 @@ void EAnalyze::PairHist(const Topology &top, QMStateType state) const {
 
   double MAX = *std::max_element(dE.begin(), dE.end());
   double MIN = *std::min_element(dE.begin(), dE.end());
-  double sum = std::accumulate(dE.begin(), dE.end(), 0.0);
-  double AVG = sum / double(dE.size());
-  double sq_sum = std::inner_product(dE.begin(), dE.end(), dE.begin(), 0.0);
-  double STD = std::sqrt(sq_sum / double(dE.size()) - AVG * AVG);
+  tools::RunningAverage average;
+  for (double E : dE) {
+    average.Process(E);
+  }
+  double AVG = average.getAvg();
+  double STD = average.getSig();
   Index BIN = Index((MAX - MIN) / resolution_pairs_ + 0.5) + 1;
 
   std::string filename2 = "eanalyze.pairhist_" + state.ToString() + ".out";
@@ -208,11 +212,13 @@ void EAnalyze::SiteCorr(const Topology &top, QMStateType state) const {
     Es.push_back(seg->getSiteEnergy(state) * tools::conv::hrt2ev);
   }
 
-  double sum = std::accumulate(Es.begin(), Es.end(), 0.0);
-  double AVG = sum / double(Es.size());
-  double sq_sum = std::inner_product(Es.begin(), Es.end(), Es.begin(), 0.0);
-  double VAR = sq_sum / double(Es.size()) - AVG * AVG;
-  double STD = std::sqrt(VAR);
+  tools::RunningAverage average;
+  for (double E : Es) {
+    average.Process(E);
+  }
+  double AVG = average.getAvg();
+  double VAR = average.getVariance();
+  double STD = average.getSig();
 
   // Collect inter-site distances, correlation product
   tools::Table tabcorr;
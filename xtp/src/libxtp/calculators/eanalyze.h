@@ -28,6 +28,7 @@
 
 // VOTCA includes
 #include <votca/tools/histogramnew.h>
+#include <votca/tools/runningaverage.h>
 #include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
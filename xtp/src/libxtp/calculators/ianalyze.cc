@@ -17,10 +17,10 @@
 
 // Standard includes
 #include <cmath>
-#include <numeric>
 
 // VOTCA includes
 #include <votca/tools/histogramnew.h>
+#include <votca/tools/runningaverage.h>
 
 // Local VOTCA includes
 #include "votca/xtp/qmstate.h"
@@ -124,10 +124,12 @@ void IAnalyze::IHist(Topology &top, QMStateType state) {
 
   double MAX = *std::max_element(J2s.begin(), J2s.end());
   double MIN = *std::min_element(J2s.begin(), J2s.end());
-  double sum = std::accumulate(J2s.begin(), J2s.end(), 0.0);
-  double AVG = sum / double(J2s.size());
-  double sq_sum = std::inner_product(J2s.begin(), J2s.end(), J2s.begin(), 0.0);
-  double STD = std::sqrt(sq_sum / double(J2s.size()) - AVG * AVG);
+  tools::RunningAverage average;
+  for (double J2 : J2s) {
+    average.Process(J2);
+  }
+  double AVG = average.getAvg();
+  double STD = average.getSig();
   // Prepare bins
   Index BIN = Index((MAX - MIN) / resolution_logJ2_ + 0.5) + 1;
 
@@ -173,18 +175,19 @@ void IAnalyze::IRdependence(Topology &top, QMStateType state) {
 
   // Prepare R bins
   Index pointsR = Index((MAXR - MINR) / resolution_spatial_);
-  std::vector<std::vector<double>> rJ2;
-  rJ2.resize(pointsR);
+  std::vector<tools::RunningAverage> rJ2(pointsR);
 
-  // Loop over distance
-  for (Index i = 0; i < pointsR; ++i) {
+  // sort the Js into the R range they lie within, Js on the bounds of a
+  // range are left out
+  for (Index j = 0; j < Index(J2s.size()); ++j) {
+    Index i = Index(std::floor((distances[j] - MINR) / resolution_spatial_));
+    if (i < 0 || i >= pointsR) {
+      continue;
+    }
     double thisMINR = MINR + double(i) * resolution_spatial_;
     double thisMAXR = MINR + double(i + 1) * resolution_spatial_;
-    // now count Js that lie within this R range
-    for (Index j = 0; j < Index(J2s.size()); ++j) {
-      if (thisMINR < distances[j] && distances[j] < thisMAXR) {
-        rJ2[i].push_back(J2s[j]);
-      }
+    if (thisMINR < distances[j] && distances[j] < thisMAXR) {
+      rJ2[i].Process(J2s[j]);
     }
   }
 
@@ -194,14 +197,8 @@ void IAnalyze::IRdependence(Topology &top, QMStateType state) {
 
   // make plot values
   for (Index i = 0; i < Index(rJ2.size()); i++) {
-    const std::vector<double> &vec = rJ2[i];
-    double sum = std::accumulate(vec.begin(), vec.end(), 0.0);
-    double AVG = sum / double(vec.size());
     double thisR = MINR + (double(i) + 0.5) * resolution_spatial_;
-    double sq_sum =
-        std::inner_product(vec.begin(), vec.end(), vec.begin(), 0.0);
-    double STD = std::sqrt(sq_sum / double(vec.size()) - AVG * AVG);
-    tab.set(i, thisR, AVG, ' ', STD);
+    tab.set(i, thisR, rJ2[i].getAvg(), ' ', rJ2[i].getSig());
   }
   std::string filename = "ianalyze.ispatial_" + state.ToString() + ".out";
   std::string comment =
@@ -71,7 +71,8 @@ void KMCLifetime::WriteDecayProbability(std::string filename) {
   for (unsigned i = 0; i < nodes_.size(); i++) {
     GNode& node = nodes_[i];
     if (node.canDecay()) {
-      for (const GLink& event : node.Events()) {
+      for (Index e = 0; e < node.EventCount(); e++) {
+        GLink event = node.Event(e);
         if (event.isDecayEvent()) {
           decayrates[i] = event.getRate();
         } else {
@@ -296,8 +297,7 @@ void KMCLifetime::RunVSSM() {
         // LEVEL 2
 
         newnode = nullptr;
-        const GLink& event =
-            ChooseHoppingDest(affectedcarrier->getCurrentNode());
+        GLink event = ChooseHoppingDest(affectedcarrier->getCurrentNode());
 
         if (event.isDecayEvent()) {
           const Eigen::Vector3d& dr_travelled =
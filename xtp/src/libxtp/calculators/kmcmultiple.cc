@@ -359,8 +359,7 @@ void KMCMultiple::RunVSSM() {
       while (true) {
         // LEVEL 2
 
-        const GLink& event =
-            ChooseHoppingDest(affectedcarrier->getCurrentNode());
+        GLink event = ChooseHoppingDest(affectedcarrier->getCurrentNode());
         newnode = event.getDestination();
 
         if (newnode == nullptr) {
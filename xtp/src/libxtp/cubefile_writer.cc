@@ -17,80 +17,127 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+
 // Local VOTCA includes
+#include "votca/xtp/checkpoint.h"
 #include "votca/xtp/cubefile_writer.h"
-#include "votca/xtp/amplitude_integration.h"
-#include "votca/xtp/density_integration.h"
 #include "votca/xtp/regular_grid.h"
 
 namespace votca {
 namespace xtp {
 
-std::vector<std::vector<double>> CubeFile_Writer::CalculateValues(
-    const Orbitals& orb, QMState state, bool dostateonly,
-    const Regular_Grid& grid) const {
+namespace {
+// one double per gridpoint, stored as a checkpoint table
+struct GridValue {
+  struct data {
+    double value;
+  };
+  static void SetupCptTable(CptTable& table) {
+    table.addCol<double>("value", HOFFSET(data, value));
+  }
+};
+}  // namespace
 
-  bool do_amplitude = (state.Type().isSingleParticleState());
-  if (do_amplitude) {
-    Eigen::VectorXd amplitude;
-    if (state.Type() == QMStateType::DQPstate) {
-      Index amplitudeindex = state.StateIdx() - orb.getGWAmin();
-      amplitude = orb.CalculateQParticleAORepresentation().col(amplitudeindex);
-    } else if (state.Type() == QMStateType::LMOstate) {
-      amplitude = orb.getLMOs().col(state.StateIdx());
+Regular_Grid CubeFile_Writer::SetupGrid(const Orbitals& orb,
+                                        const AOBasis& basis) const {
+  Regular_Grid grid;
+  Eigen::Array3d padding = Eigen::Array3d::Ones() * padding_;
+  grid.GridSetup(steps_, padding, orb.QMAtoms(), basis);
+  return grid;
+}
+
+void CubeFile_Writer::CalculateValues(const Orbitals& orb,
+                                      const std::vector<QMState>& states,
+                                      bool dostateonly,
+                                      const Regular_Grid& grid,
+                                      const BlockSink& sink) const {
+
+  // all single particle states are evaluated together as one matrix product
+  // per gridbox, every density needs its own density matrix
+  std::vector<Index> amplitude_states;
+  std::vector<Eigen::VectorXd> amplitude_columns;
+  std::vector<Index> density_states;
+  std::vector<Eigen::MatrixXd> densities;
+  for (Index i = 0; i < Index(states.size()); i++) {
+    const QMState& state = states[i];
+    if (state.Type().isSingleParticleState()) {
+      amplitude_states.push_back(i);
+      if (state.Type() == QMStateType::DQPstate) {
+        Index amplitudeindex = state.StateIdx() - orb.getGWAmin();
+        amplitude_columns.push_back(
+            orb.CalculateQParticleAORepresentation().col(amplitudeindex));
+      } else if (state.Type() == QMStateType::LMOstate) {
+        amplitude_columns.push_back(orb.getLMOs().col(state.StateIdx()));
+      } else {
+        amplitude_columns.push_back(
+            orb.MOs().eigenvectors().col(state.StateIdx()));
+      }
     } else {
-      amplitude = orb.MOs().eigenvectors().col(state.StateIdx());
+      density_states.push_back(i);
+      if (state.Type().isExciton() && dostateonly) {
+        densities.push_back(orb.DensityMatrixWithoutGS(state));
+      } else {
+        densities.push_back(orb.DensityMatrixFull(state));
+      }
     }
-    AmplitudeIntegration<Regular_Grid> ampl(grid);
-    return ampl.IntegrateAmplitude(amplitude);
-  } else {
-    Eigen::MatrixXd mat;
-    if (state.Type().isExciton() && dostateonly) {
-      mat = orb.DensityMatrixWithoutGS(state);
-    } else {
-      mat = orb.DensityMatrixFull(state);
+  }
+  Eigen::MatrixXd amplitudes;
+  if (!amplitude_columns.empty()) {
+    amplitudes.resize(amplitude_columns[0].size(),
+                      Index(amplitude_columns.size()));
+    for (Index j = 0; j < amplitudes.cols(); j++) {
+      amplitudes.col(j) = amplitude_columns[j];
     }
-    DensityIntegration<Regular_Grid> density(grid);
-    density.IntegrateDensity(mat);
-    return density.getDensities();
   }
-}
 
-std::vector<double> FlattenValues(
-    const std::vector<std::vector<double>>& gridvalues) {
-  Index size = 0;
-  for (const auto& box : gridvalues) {
-    size += Index(box.size());
+  // the gridboxes are in cube order, so a range of boxes is a contiguous
+  // range of the cube and can be written as soon as it is done
+  std::vector<Index> offsets(grid.getBoxesSize() + 1, 0);
+  for (Index i = 0; i < grid.getBoxesSize(); i++) {
+    offsets[i + 1] = offsets[i] + grid[i].size();
   }
-  std::vector<double> result;
-  result.reserve(size);
-  for (const auto& box : gridvalues) {
-    result.insert(result.end(), box.begin(), box.end());
+  const Index boxes_per_block = 64;
+  for (Index first = 0; first < grid.getBoxesSize();
+       first += boxes_per_block) {
+    Index last = std::min(first + boxes_per_block, grid.getBoxesSize());
+    Eigen::MatrixXd values = Eigen::MatrixXd::Zero(
+        offsets[last] - offsets[first], Index(states.size()));
+#pragma omp parallel for schedule(dynamic)
+    for (Index i = first; i < last; ++i) {
+      const GridBox& box = grid[i];
+      if (!box.Matrixsize()) {
+        continue;
+      }
+      const Eigen::MatrixXd ao = box.CalcAOValueMatrix();
+      const Eigen::Map<const Eigen::VectorXd> weights(
+          box.getGridWeights().data(), box.size());
+      const Index row = offsets[i] - offsets[first];
+      if (!amplitude_states.empty()) {
+        const Eigen::MatrixXd ampl =
+            ao * box.ReadRowsFromBigMatrix(amplitudes);
+        for (Index j = 0; j < Index(amplitude_states.size()); j++) {
+          values.col(amplitude_states[j]).segment(row, box.size()) =
+              ampl.col(j).cwiseProduct(weights);
+        }
+      }
+      for (Index j = 0; j < Index(density_states.size()); j++) {
+        const Eigen::MatrixXd ao_dmat =
+            ao * box.ReadFromBigMatrix(densities[j]);
+        values.col(density_states[j]).segment(row, box.size()) =
+            ao_dmat.cwiseProduct(ao).rowwise().sum().cwiseProduct(weights);
+      }
+    }
+    sink(values, offsets[first]);
   }
-  return result;
 }
 
-void CubeFile_Writer::WriteFile(const std::string& filename,
-                                const Orbitals& orb, QMState state,
-                                bool dostateonly) const {
-
-  Regular_Grid grid;
-  Eigen::Array3d padding = Eigen::Array3d::Ones() * padding_;
-  AOBasis basis = orb.getDftBasis();
-  XTP_LOG(Log::info, log_) << " Loaded DFT Basis Set " << orb.getDFTbasisName()
-                           << std::flush;
-  grid.GridSetup(steps_, padding, orb.QMAtoms(), basis);
-  XTP_LOG(Log::info, log_) << " Calculating Gridvalues " << std::flush;
-  auto temp = CalculateValues(orb, state, dostateonly, grid);
-  std::vector<double> grid_values = FlattenValues(temp);
-  XTP_LOG(Log::info, log_) << " Calculated Gridvalues " << std::flush;
+void CubeFile_Writer::WriteHeader(std::ostream& out, const Orbitals& orb,
+                                  QMState state, bool dostateonly,
+                                  const Regular_Grid& grid) const {
   bool do_amplitude = (state.Type().isSingleParticleState());
-  std::ofstream out(filename);
-  if (!out.is_open()) {
-    throw std::runtime_error("Bad file handle: " + filename);
-  }
-
-  // write cube header
   if (state.isTransition()) {
     out << boost::format("Transition state: %1$s \n") % state.ToString();
   } else if (do_amplitude) {
@@ -135,23 +182,103 @@ void CubeFile_Writer::WriteFile(const std::string& filename,
   if (do_amplitude) {
     out << boost::format("  1 %1$d \n") % (state.StateIdx() + 1);
   }
+}
 
-  Eigen::TensorMap<Eigen::Tensor<double, 3>> gridvalues(
-      grid_values.data(), steps.z(), steps.y(), steps.x());
-  for (Index ix = 0; ix < steps.x(); ix++) {
-    for (Index iy = 0; iy < steps.y(); iy++) {
-      Index Nrecord = 0;
-      for (Index iz = 0; iz < steps.z(); iz++) {
-        out << boost::format("%1$E ") % gridvalues(iz, iy, ix);
-        Nrecord++;
-        if (Nrecord == 6 || iz == (steps.z() - 1)) {
-          out << "\n";
-          Nrecord = 0;
-        }
-      }
+void CubeFile_Writer::WriteFile(const std::string& filename,
+                                const Orbitals& orb, QMState state,
+                                bool dostateonly) const {
+  WriteFiles({filename}, orb, {state}, dostateonly);
+}
+
+void CubeFile_Writer::WriteFiles(const std::vector<std::string>& filenames,
+                                 const Orbitals& orb,
+                                 const std::vector<QMState>& states,
+                                 bool dostateonly) const {
+  if (filenames.size() != states.size()) {
+    throw std::runtime_error(
+        "CubeFile_Writer: number of files and states differ");
+  }
+  // the gridboxes point to the shells of basis
+  AOBasis basis = orb.getDftBasis();
+  XTP_LOG(Log::info, log_) << " Loaded DFT Basis Set " << orb.getDFTbasisName()
+                           << std::flush;
+  Regular_Grid grid = SetupGrid(orb, basis);
+
+  std::vector<std::ofstream> outs;
+  for (Index i = 0; i < Index(states.size()); i++) {
+    outs.emplace_back(filenames[i]);
+    if (!outs.back().is_open()) {
+      throw std::runtime_error("Bad file handle: " + filenames[i]);
     }
+    WriteHeader(outs.back(), orb, states[i], dostateonly, grid);
+  }
+
+  // values are written x slowest, z fastest, with a newline after 6 values
+  // and at the end of every z row
+  const Index zsteps = grid.getSteps().z();
+  XTP_LOG(Log::info, log_) << " Calculating Gridvalues " << std::flush;
+  CalculateValues(
+      orb, states, dostateonly, grid,
+      [&](const Eigen::MatrixXd& values, Index offset) {
+        char buffer[32];
+        for (Index i = 0; i < Index(outs.size()); i++) {
+          std::string text;
+          text.reserve(14 * values.rows());
+          for (Index p = 0; p < values.rows(); p++) {
+            Index iz = (offset + p) % zsteps;
+            std::snprintf(buffer, sizeof(buffer), "%E ", values(p, i));
+            text += buffer;
+            if ((iz + 1) % 6 == 0 || iz == zsteps - 1) {
+              text += '\n';
+            }
+          }
+          outs[i] << text;
+        }
+      });
+  XTP_LOG(Log::info, log_) << " Calculated Gridvalues " << std::flush;
+}
+
+void CubeFile_Writer::WriteHDF5(const std::string& filename,
+                                const Orbitals& orb,
+                                const std::vector<QMState>& states,
+                                bool dostateonly) const {
+  // the gridboxes point to the shells of basis
+  AOBasis basis = orb.getDftBasis();
+  XTP_LOG(Log::info, log_) << " Loaded DFT Basis Set " << orb.getDFTbasisName()
+                           << std::flush;
+  Regular_Grid grid = SetupGrid(orb, basis);
+
+  CheckpointFile cpf(filename, CheckpointAccessLevel::CREATE);
+  CheckpointWriter w = cpf.getWriter();
+  Eigen::Array<Index, 3, 1> steps = grid.getSteps();
+  w(steps.x(), "xsteps");
+  w(steps.y(), "ysteps");
+  w(steps.z(), "zsteps");
+  Eigen::Vector3d stepsizes = grid.getStepSizes().matrix();
+  w(stepsizes, "stepsizes");
+  w(grid.getStartingPoint(), "start");
+  w(dostateonly, "diff2gs");
+  CheckpointWriter molwriter = w.openChild("molecule");
+  orb.QMAtoms().WriteToCpt(molwriter);
+
+  std::vector<CptTable> tables;
+  for (const QMState& state : states) {
+    CheckpointWriter statewriter = w.openChild(state.ToString());
+    statewriter(state.Type().isSingleParticleState(), "amplitude");
+    tables.push_back(statewriter.openTable<GridValue>(
+        "values", std::size_t(grid.getGridSize())));
   }
-  out.close();
+
+  XTP_LOG(Log::info, log_) << " Calculating Gridvalues " << std::flush;
+  CalculateValues(orb, states, dostateonly, grid,
+                  [&](const Eigen::MatrixXd& values, Index offset) {
+                    for (Index i = 0; i < Index(tables.size()); i++) {
+                      tables[i].write(values.col(i).data(),
+                                      std::size_t(offset),
+                                      std::size_t(offset + values.rows()));
+                    }
+                  });
+  XTP_LOG(Log::info, log_) << " Calculated Gridvalues " << std::flush;
 }
 
 }  // namespace xtp
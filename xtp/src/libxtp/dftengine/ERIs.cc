@@ -17,22 +17,30 @@
  *
  */
 
+// Standard includes
+#include <algorithm>
+
 // Local VOTCA includes
 #include "votca/xtp/ERIs.h"
 #include "votca/xtp/aobasis.h"
 #include "votca/xtp/symmetric_matrix.h"
+#include "votca/xtp/threadreduction.h"
 namespace votca {
 namespace xtp {
 
 void ERIs::Initialize(const AOBasis& dftbasis, const AOBasis& auxbasis) {
   threecenter_.Fill(auxbasis, dftbasis);
+  threecenter_norms_ = Eigen::VectorXd(threecenter_.size());
+  for (Index i = 0; i < threecenter_.size(); i++) {
+    threecenter_norms_(i) = threecenter_[i].FrobeniusNorm();
+  }
   return;
 }
 
 void ERIs::Initialize_4c(const AOBasis& dftbasis) {
 
-  basis_ = dftbasis.GenerateLibintBasis();
-  shellpairs_ = dftbasis.ComputeShellPairs();
+  basis_ = dftbasis.LibintBasis();
+  shellpairs_ = dftbasis.ShellPairs();
   starts_ = dftbasis.getMapToBasisFunctions();
   maxnprim_ = dftbasis.getMaxNprim();
   maxL_ = dftbasis.getMaxL();
@@ -77,51 +85,92 @@ Eigen::MatrixXd ERIs::ComputeShellBlockNorm(const Eigen::MatrixXd& dmat) const {
   return result.selfadjointView<Eigen::Upper>();
 }
 
-Eigen::MatrixXd ERIs::CalculateERIs_3c(const Eigen::MatrixXd& DMAT) const {
+Eigen::MatrixXd ERIs::CalculateERIs_3c(const Eigen::MatrixXd& DMAT,
+                                       double error) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd ERIs2 = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
   Symmetric_Matrix dmat_sym = Symmetric_Matrix(DMAT);
-#pragma omp parallel for schedule(guided) reduction(+ : ERIs2)
+  const double dmat_norm = dmat_sym.FrobeniusNorm();
+
+  // |Tr(I_P D)| <= |I_P| |D|, so the contribution of function P is at most
+  // |I_P|^2 |D| and the trace can be skipped for small density differences.
+  // The skipped contributions add up to at most error.
+  const double threshold = error / double(threecenter_.size());
+  Eigen::VectorXd factors = Eigen::VectorXd::Zero(threecenter_.size());
+#pragma omp parallel for schedule(guided)
   for (Index i = 0; i < threecenter_.size(); i++) {
-    const Symmetric_Matrix& threecenter = threecenter_[i];
-    // Trace over prod::DMAT,I(l)=componentwise product over
-    const double factor = threecenter.TraceofProd(dmat_sym);
-    Eigen::SelfAdjointView<Eigen::MatrixXd, Eigen::Upper> m =
-        ERIs2.selfadjointView<Eigen::Upper>();
-    threecenter.AddtoEigenUpperMatrix(m, factor);
+    const double norm = threecenter_norms_(i);
+    if (norm * norm * dmat_norm < threshold) {
+      continue;
+    }
+    const double factor = threecenter_[i].TraceofProd(dmat_sym);
+    if (std::abs(factor) * norm >= threshold) {
+      factors(i) = factor;
+    }
+  }
+  std::vector<Index> significant;
+  for (Index i = 0; i < threecenter_.size(); i++) {
+    if (factors(i) != 0.0) {
+      significant.push_back(i);
+    }
   }
 
-  return ERIs2.selfadjointView<Eigen::Upper>();
+  // every thread owns a contiguous chunk of the packed triangle, so the
+  // threads never write to the same memory and no reduction is needed
+  Symmetric_Matrix ERIs2 = Symmetric_Matrix(DMAT.rows());
+  Eigen::Map<Eigen::VectorXd> result = ERIs2.Packed();
+  result.setZero();
+  const Index chunksize = 2048;
+  const Index nchunks = (result.size() + chunksize - 1) / chunksize;
+#pragma omp parallel for schedule(static)
+  for (Index c = 0; c < nchunks; c++) {
+    const Index start = c * chunksize;
+    const Index size = std::min(chunksize, result.size() - start);
+    for (Index i : significant) {
+      result.segment(start, size) +=
+          factors(i) * threecenter_[i].Packed().segment(start, size);
+    }
+  }
+  return ERIs2.FullMatrix();
 }
 
-Eigen::MatrixXd ERIs::CalculateEXX_dmat(const Eigen::MatrixXd& DMAT) const {
+Eigen::MatrixXd ERIs::CalculateEXX_dmat(const Eigen::MatrixXd& DMAT,
+                                        double error) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(DMAT.rows(), DMAT.cols());
+  const double dmat_norm = DMAT.norm();
+  const double threshold = error / double(threecenter_.size());
+  TiledAccumulator EXX(DMAT.rows(), DMAT.cols());
 
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
+#pragma omp parallel for schedule(guided)
   for (Index i = 0; i < threecenter_.size(); i++) {
-    const Eigen::MatrixXd threecenter = threecenter_[i].UpperMatrix();
-    EXX -= threecenter.selfadjointView<Eigen::Upper>() * DMAT *
-           threecenter.selfadjointView<Eigen::Upper>();
+    // |I_P D I_P| <= |I_P|^2 |D|
+    const double norm = threecenter_norms_(i);
+    if (norm * norm * dmat_norm < threshold) {
+      continue;
+    }
+    const Eigen::MatrixXd threecenter = threecenter_[i].FullMatrix();
+    const Eigen::MatrixXd DxTC = DMAT * threecenter;
+    // I_P is symmetric, so -I_P D I_P = -I_P^T DxTC, the result is symmetric
+    // and only its upper triangle is computed, tile by tile
+    EXX.AddUpperProduct(-1.0, threecenter, DxTC);
   }
-  return EXX;
+  return EXX.Matrix().selfadjointView<Eigen::Upper>();
 }
 
 Eigen::MatrixXd ERIs::CalculateEXX_mos(const Eigen::MatrixXd& occMos) const {
   assert(threecenter_.size() > 0 &&
          "Please call Initialize before running this");
-  Eigen::MatrixXd EXX = Eigen::MatrixXd::Zero(occMos.rows(), occMos.rows());
+  TiledAccumulator EXX(occMos.rows(), occMos.rows());
 
-#pragma omp parallel for schedule(guided) reduction(+ : EXX)
+#pragma omp parallel for schedule(guided)
   for (Index i = 0; i < threecenter_.size(); i++) {
     const Eigen::MatrixXd TCxMOs_T =
         occMos.transpose() *
         threecenter_[i].UpperMatrix().selfadjointView<Eigen::Upper>();
-    EXX -= TCxMOs_T.transpose() * TCxMOs_T;
+    EXX.AddUpperProduct(-2.0, TCxMOs_T, TCxMOs_T);
   }
-  return 2 * EXX;
+  return EXX.Matrix().selfadjointView<Eigen::Upper>();
 }
 
 }  // namespace xtp
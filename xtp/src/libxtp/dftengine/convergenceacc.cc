@@ -17,6 +17,9 @@
  *
  */
 
+// VOTCA includes
+#include <votca/tools/linalg.h>
+
 // Local VOTCA includes
 #include "votca/xtp/convergenceacc.h"
 
@@ -164,7 +167,7 @@ tools::EigenSystem ConvergenceAcc::SolveFockmatrix(
     const Eigen::MatrixXd& H) const {
   // transform to orthogonal for
   Eigen::MatrixXd H_ortho = Sminusahalf.transpose() * H * Sminusahalf;
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(H_ortho);
+  tools::EigenSystem es = tools::linalg_eigenvalues(H_ortho);
 
   if (es.info() != Eigen::ComputationInfo::Success) {
     throw std::runtime_error("Matrix Diagonalisation failed. DiagInfo" +
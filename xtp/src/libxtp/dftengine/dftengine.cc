@@ -25,6 +25,7 @@
 // VOTCA includes
 #include <votca/tools/constants.h>
 #include <votca/tools/elements.h>
+#include <votca/tools/profiler.h>
 
 // Local VOTCA includes
 #include "votca/xtp/IncrementalFockBuilder.h"
@@ -64,6 +65,8 @@ void DFTEngine::Initialize(tools::Property& options) {
   initial_guess_ = options.get(".initial_guess").as<std::string>();
 
   grid_name_ = options.get(key_xtpdft + ".integration_grid").as<std::string>();
+  multipole_farfield_tolerance_ =
+      options.get(key_xtpdft + ".multipole_farfield_tolerance").as<double>();
   xc_functional_name_ = options.get(".functional").as<std::string>();
 
   if (options.exists(key_xtpdft + ".externaldensity")) {
@@ -159,12 +162,14 @@ void DFTEngine::CalcElDipole(const Orbitals& orb) const {
 std::array<Eigen::MatrixXd, 2> DFTEngine::CalcERIs_EXX(
     const Eigen::MatrixXd& MOCoeff, const Eigen::MatrixXd& Dmat,
     double error) const {
+  tools::ScopedTimer timer("DFTEngine::CalcERIs_EXX");
   if (!auxbasis_name_.empty()) {
     if (conv_accelerator_.getUseMixing() || MOCoeff.rows() == 0) {
-      return ERIs_.CalculateERIs_EXX_3c(Eigen::MatrixXd::Zero(0, 0), Dmat);
+      return ERIs_.CalculateERIs_EXX_3c(Eigen::MatrixXd::Zero(0, 0), Dmat,
+                                        error);
     } else {
       Eigen::MatrixXd occblock = MOCoeff.leftCols(numofelectrons_ / 2);
-      return ERIs_.CalculateERIs_EXX_3c(occblock, Dmat);
+      return ERIs_.CalculateERIs_EXX_3c(occblock, Dmat, error);
     }
   } else {
     return ERIs_.CalculateERIs_EXX_4c(Dmat, error);
@@ -173,8 +178,9 @@ std::array<Eigen::MatrixXd, 2> DFTEngine::CalcERIs_EXX(
 
 Eigen::MatrixXd DFTEngine::CalcERIs(const Eigen::MatrixXd& Dmat,
                                     double error) const {
+  tools::ScopedTimer timer("DFTEngine::CalcERIs");
   if (!auxbasis_name_.empty()) {
-    return ERIs_.CalculateERIs_3c(Dmat);
+    return ERIs_.CalculateERIs_3c(Dmat, error);
   } else {
     return ERIs_.CalculateERIs_4c(Dmat, error);
   }
@@ -207,6 +213,7 @@ tools::EigenSystem DFTEngine::ModelPotentialGuess(
 }
 
 bool DFTEngine::Evaluate(Orbitals& orb) {
+  tools::ScopedTimer timer("DFTEngine::Evaluate");
   Prepare(orb);
   Mat_p_Energy H0 = SetupH0(orb.QMAtoms());
   tools::EigenSystem MOs;
@@ -253,10 +260,9 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
     K = Eigen::MatrixXd::Zero(Dmat.rows(), Dmat.cols());
   }
 
+  // J and K are linear in the density, so both the 4c and the RI build can
+  // work on density differences once the SCF is close to convergence
   double start_incremental_F_threshold = 1e-4;
-  if (!auxbasis_name_.empty()) {
-    start_incremental_F_threshold = 0.0;  // Disable if RI is used
-  }
   IncrementalFockBuilder incremental_fock(*pLog_, start_incremental_F_threshold,
                                           fock_matrix_reset_);
   incremental_fock.Configure(Dmat);
@@ -265,7 +271,9 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
     XTP_LOG(Log::error, *pLog_) << std::flush;
     XTP_LOG(Log::error, *pLog_) << TimeStamp() << " Iteration " << this_iter + 1
                                 << " of " << max_iter_ << std::flush;
+    tools::ScopedTimer vxc_timer("DFTEngine::IntegrateVXC");
     Mat_p_Energy e_vxc = vxcpotential.IntegrateVXC(Dmat);
+    vxc_timer.Stop();
     XTP_LOG(Log::info, *pLog_)
         << TimeStamp() << " Filled DFT Vxc matrix " << std::flush;
 
@@ -282,8 +290,14 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
     double integral_error =
         std::min(conv_accelerator_.getDIIsError() * 1e-5, 1e-5);
     if (ScaHFX_ > 0) {
+      // the occupied MOs only represent the full density, a density
+      // difference needs the density matrix based exchange
+      Eigen::MatrixXd MOCoeff = MOs.eigenvectors();
+      if (incremental_fock.isIncremental()) {
+        MOCoeff.resize(0, 0);
+      }
       std::array<Eigen::MatrixXd, 2> both = CalcERIs_EXX(
-          MOs.eigenvectors(), incremental_fock.getDmat_diff(), integral_error);
+          MOCoeff, incremental_fock.getDmat_diff(), integral_error);
       J += both[0];
       H += J;
       Etwo += 0.5 * Dmat.cwiseProduct(J).sum();
@@ -367,6 +381,7 @@ bool DFTEngine::Evaluate(Orbitals& orb) {
 }
 
 Mat_p_Energy DFTEngine::SetupH0(const QMMolecule& mol) const {
+  tools::ScopedTimer timer("DFTEngine::SetupH0");
 
   AOKinetic dftAOkinetic;
 
@@ -550,10 +565,8 @@ Eigen::MatrixXd DFTEngine::RunAtomicDFT_unrestricted(
   AOECP dftAOECP;
   ERIs ERIs_atom;
 
-  // DFT AOOverlap matrix
-
-  dftAOoverlap.Fill(dftbasis);
-  dftAOkinetic.Fill(dftbasis);
+  // DFT overlap and kinetic energy in one pass
+  FillOneBodyMatrices(dftbasis, &dftAOoverlap, &dftAOkinetic, nullptr);
 
   dftAOESP.FillPotential(dftbasis, atom);
   ERIs_atom.Initialize_4c(dftbasis);
@@ -796,6 +809,7 @@ void DFTEngine::ConfigOrbfile(Orbitals& orb) {
 }
 
 void DFTEngine::Prepare(Orbitals& orb, Index numofelectrons) {
+  tools::ScopedTimer timer("DFTEngine::Prepare");
   QMMolecule& mol = orb.QMAtoms();
 
   XTP_LOG(Log::error, *pLog_)
@@ -876,6 +890,7 @@ void DFTEngine::Prepare(Orbitals& orb, Index numofelectrons) {
 }
 
 Vxc_Potential<Vxc_Grid> DFTEngine::SetupVxc(const QMMolecule& mol) {
+  tools::ScopedTimer timer("DFTEngine::SetupVxc");
   ScaHFX_ = Vxc_Potential<Vxc_Grid>::getExactExchange(xc_functional_name_);
   if (ScaHFX_ > 0) {
     XTP_LOG(Log::error, *pLog_)
@@ -989,7 +1004,7 @@ Mat_p_Energy DFTEngine::IntegrateExternalMultipoles(
   Mat_p_Energy result(dftbasis_.AOBasisSize(), dftbasis_.AOBasisSize());
   AOMultipole dftAOESP;
 
-  dftAOESP.FillPotential(dftbasis_, multipoles);
+  dftAOESP.FillPotential(dftbasis_, multipoles, multipole_farfield_tolerance_);
   XTP_LOG(Log::error, *pLog_)
       << TimeStamp() << " Filled DFT external multipole potential matrix"
       << std::flush;
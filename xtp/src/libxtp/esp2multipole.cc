@@ -79,6 +79,12 @@ void Esp2multipole::Initialize(tools::Property& options) {
     conditionnumber_ = options.get(".svd.conditionnumber").as<double>();
   }
 
+  if (options.exists(".density_fit")) {
+    use_ri_ = true;
+    ri_farfield_tolerance_ =
+        options.get(".density_fit.farfield_tolerance").as<double>();
+  }
+
   return;
 }
 
@@ -124,6 +130,14 @@ StaticSegment Esp2multipole::Extractingcharges(const Orbitals& orbitals) const {
     if (do_svd_) {
       esp.setUseSVD(conditionnumber_);
     }
+    if (use_ri_) {
+      if (!orbitals.hasAuxbasisName()) {
+        throw std::runtime_error(
+            "CHELPG with density_fit requires an auxiliary basis in the "
+            "orbitals.");
+      }
+      esp.setUseRI(ri_farfield_tolerance_);
+    }
     result = esp.Fit2Density(orbitals, state_, gridsize_);
   }
 
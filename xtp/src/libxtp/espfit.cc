@@ -26,6 +26,7 @@
 #include "votca/xtp/espfit.h"
 #include "votca/xtp/grid.h"
 #include "votca/xtp/orbitals.h"
+#include "votca/xtp/ripotential.h"
 #include "votca/xtp/vxc_grid.h"
 
 namespace votca {
@@ -49,18 +50,12 @@ StaticSegment Espfit::Fit2Density(const Orbitals& orbitals,
   overlap.Fill(basis);
   double N_comp = dmat.cwiseProduct(overlap.Matrix()).sum();
 
-  Vxc_Grid numintgrid;
-  numintgrid.GridSetup(gridsize, orbitals.QMAtoms(), basis);
-  XTP_LOG(Log::info, log_) << TimeStamp() << " Setup " << gridsize
-                           << " Numerical Grid with "
-                           << numintgrid.getGridSize() << " gridpoints."
-                           << flush;
-  DensityIntegration<Vxc_Grid> numway(numintgrid);
-  double N = numway.IntegrateDensity(dmat);
-  XTP_LOG(Log::error, log_)
-      << TimeStamp()
-      << " Calculated Densities at Numerical Grid, Number of electrons is " << N
-      << flush;
+  double N = 0.0;
+  if (use_ri_) {
+    N = EvalElectronicPotentialRI(orbitals, dmat, grid);
+  } else {
+    N = EvalElectronicPotential(orbitals, dmat, gridsize, grid);
+  }
 
   if (std::abs(N - N_comp) > 0.001) {
     XTP_LOG(Log::error, log_) << "=======================" << flush;
@@ -68,22 +63,14 @@ StaticSegment Espfit::Fit2Density(const Orbitals& orbitals,
         << "WARNING: Calculated Densities at Numerical Grid, Number of "
            "electrons "
         << N << " is far away from the the real value " << N_comp
-        << ", you should increase the accuracy of the integration grid."
-        << flush;
+        << ", you should increase the accuracy of the "
+        << (use_ri_ ? "auxiliary basis." : "integration grid.") << flush;
     N = N_comp;
     XTP_LOG(Log::error, log_)
         << "WARNING: Electronnumber set to " << N << flush;
     XTP_LOG(Log::error, log_) << "=======================" << flush;
   }
 
-  XTP_LOG(Log::error, log_)
-      << TimeStamp() << " Calculating ESP at CHELPG grid points" << flush;
-#pragma omp parallel for
-  for (Index i = 0; i < grid.size(); i++) {
-    grid.getGridValues()(i) =
-        numway.IntegratePotential(grid.getGridPositions()[i]);
-  }
-
   XTP_LOG(Log::info, log_) << TimeStamp() << " Electron contribution calculated"
                            << flush;
   double netcharge = 0.0;
@@ -102,6 +89,53 @@ StaticSegment Espfit::Fit2Density(const Orbitals& orbitals,
   ;
 }
 
+double Espfit::EvalElectronicPotential(const Orbitals& orbitals,
+                                       const Eigen::MatrixXd& dmat,
+                                       const std::string& gridsize,
+                                       Grid& grid) {
+  AOBasis basis = orbitals.getDftBasis();
+  Vxc_Grid numintgrid;
+  numintgrid.GridSetup(gridsize, orbitals.QMAtoms(), basis);
+  XTP_LOG(Log::info, log_) << TimeStamp() << " Setup " << gridsize
+                           << " Numerical Grid with "
+                           << numintgrid.getGridSize() << " gridpoints."
+                           << flush;
+  DensityIntegration<Vxc_Grid> numway(numintgrid);
+  double N = numway.IntegrateDensity(dmat);
+  XTP_LOG(Log::error, log_)
+      << TimeStamp()
+      << " Calculated Densities at Numerical Grid, Number of electrons is " << N
+      << flush;
+
+  XTP_LOG(Log::error, log_)
+      << TimeStamp() << " Calculating ESP at CHELPG grid points" << flush;
+#pragma omp parallel for
+  for (Index i = 0; i < grid.size(); i++) {
+    grid.getGridValues()(i) =
+        numway.IntegratePotential(grid.getGridPositions()[i]);
+  }
+  return N;
+}
+
+double Espfit::EvalElectronicPotentialRI(const Orbitals& orbitals,
+                                         const Eigen::MatrixXd& dmat,
+                                         Grid& grid) {
+  AOBasis basis = orbitals.getDftBasis();
+  AOBasis auxbasis = orbitals.getAuxBasis();
+  RIPotential ripotential(basis, auxbasis);
+  ripotential.setFarfieldTolerance(ri_farfield_tolerance_);
+  ripotential.FitDensity(dmat);
+  double N = ripotential.FittedElectrons();
+  XTP_LOG(Log::error, log_)
+      << TimeStamp() << " Fitted density to " << auxbasis.AOBasisSize()
+      << " auxiliary functions, Number of electrons is " << N << flush;
+
+  XTP_LOG(Log::error, log_)
+      << TimeStamp() << " Calculating ESP at CHELPG grid points" << flush;
+  grid.getGridValues() = ripotential.Potential(grid.getGridPositions());
+  return N;
+}
+
 void Espfit::EvalNuclearPotential(const QMMolecule& atoms, Grid& grid) {
 
   const std::vector<Eigen::Vector3d>& gridpoints = grid.getGridPositions();
@@ -0,0 +1,143 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Local VOTCA includes
+#include "votca/xtp/eventgraph.h"
+
+namespace votca {
+namespace xtp {
+
+EventGraph::EventGraph(const QMNBList& nblist, Index nsites,
+                       QMStateType carriertype)
+    : carriertype_(carriertype) {
+
+  // counting sort of the events by their starting site, two passes over the
+  // pairs instead of growing one vector per site
+  offsets_ = std::vector<Index>(nsites + 1, 0);
+  for (const QMPair* pair : nblist) {
+    offsets_[pair->Seg1()->getId() + 1]++;
+    offsets_[pair->Seg2()->getId() + 1]++;
+  }
+  for (Index i = 0; i < nsites; i++) {
+    offsets_[i + 1] += offsets_[i];
+  }
+
+  Index nevents = offsets_.back();
+  destinations_.resize(nevents);
+  pairids_.resize(nevents);
+  forward_.resize(nevents);
+  dr_.resize(3, nevents);
+  jeff2_.resize(nevents);
+  dG_site_.resize(nevents);
+  reorg_.resize(nevents);
+  rates_.assign(nevents, 0.0);
+
+  std::vector<Index> next(offsets_.begin(), offsets_.end() - 1);
+  for (const QMPair* pair : nblist) {
+    double reorg12 =
+        pair->getReorg12(carriertype) + pair->getLambdaO(carriertype);
+    double reorg21 =
+        pair->getReorg21(carriertype) - pair->getLambdaO(carriertype);
+    if (std::abs(reorg12) < 1e-12 || std::abs(reorg21) < 1e-12) {
+      throw std::runtime_error(
+          "Reorganisation energy for a pair is extremely close to zero,\n"
+          " you probably forgot to import reorganisation energies into your "
+          "state "
+          "file.");
+    }
+    double J2 = pair->getJeff2(carriertype);
+    double dE12 = pair->getdE12(carriertype);
+    Index id1 = pair->Seg1()->getId();
+    Index id2 = pair->Seg2()->getId();
+
+    Index e12 = next[id1]++;
+    destinations_[e12] = id2;
+    pairids_[e12] = pair->getId();
+    forward_[e12] = 1;
+    dr_.col(e12) = pair->R();
+    jeff2_[e12] = J2;
+    dG_site_[e12] = dE12;
+    reorg_[e12] = reorg12;
+
+    Index e21 = next[id2]++;
+    destinations_[e21] = id1;
+    pairids_[e21] = pair->getId();
+    forward_[e21] = 0;
+    dr_.col(e21) = -pair->R();
+    jeff2_[e21] = J2;
+    dG_site_[e21] = -dE12;
+    reorg_[e21] = reorg21;
+  }
+}
+
+std::vector<Index> EventGraph::UpdateRates(const Rate_Engine& rate_engine) {
+  Index nevents = NumberOfEvents();
+  Eigen::VectorXd rates = rate_engine.Rates(
+      Eigen::Map<const Eigen::VectorXd>(jeff2_.data(), nevents),
+      Eigen::Map<const Eigen::VectorXd>(dG_site_.data(), nevents),
+      Eigen::Map<const Eigen::VectorXd>(reorg_.data(), nevents), dr_,
+      carriertype_);
+  std::vector<Index> changed;
+  for (Index site = 0; site < NumberOfSites(); site++) {
+    bool site_changed = false;
+    for (Index e = EventsBegin(site); e < EventsEnd(site); e++) {
+      if (rates_[e] != rates[e]) {
+        rates_[e] = rates[e];
+        site_changed = true;
+      }
+    }
+    if (site_changed) {
+      changed.push_back(site);
+    }
+  }
+  return changed;
+}
+
+void EventGraph::WriteToCpt(CheckpointWriter& w) const {
+  w(carriertype_.ToString(), "carriertype");
+  w(NumberOfSites(), "sites");
+  w(NumberOfEvents(), "events");
+  w(offsets_, "offsets");
+  w(destinations_, "destinations");
+  w(pairids_, "pairids");
+  w(forward_, "forward");
+  w(dr_, "dr");
+  w(jeff2_, "jeff2");
+  w(dG_site_, "dG_site");
+  w(reorg_, "reorg");
+  w(rates_, "rates");
+}
+
+void EventGraph::ReadFromCpt(CheckpointReader& r) {
+  std::string carriertype;
+  r(carriertype, "carriertype");
+  carriertype_ = QMStateType(carriertype);
+  r(offsets_, "offsets");
+  r(destinations_, "destinations");
+  r(pairids_, "pairids");
+  r(forward_, "forward");
+  r(dr_, "dr");
+  r(jeff2_, "jeff2");
+  r(dG_site_, "dG_site");
+  r(reorg_, "reorg");
+  r(rates_, "rates");
+}
+
+}  // namespace xtp
+}  // namespace votca
@@ -29,6 +29,7 @@
 #include "tools/excitoncoupling.h"
 #include "tools/gencube.h"
 #include "tools/gpu_benchmark.h"
+#include "tools/kernel_benchmark.h"
 #include "tools/log2mps.h"
 #include "tools/mol2orb.h"
 #include "tools/molpol.h"
@@ -57,6 +58,7 @@ void QMToolFactory::RegisterAll(void) {
   QMTools().Register<Diabatization>("diabatization");
   QMTools().Register<Orb2Fchk>("orb2fchk");
   QMTools().Register<GPUBenchmark>("gpu_benchmark");
+  QMTools().Register<KernelBenchmark>("kernel_benchmark");
 }
 
 }  // namespace xtp
@@ -26,45 +26,45 @@ using namespace std;
 namespace votca {
 namespace xtp {
 void GNode::AddDecayEvent(double decayrate) {
-  events_.push_back(GLink(decayrate));
+  decayrate_ = decayrate;
   hasdecay_ = true;
 }
 
-void GNode::AddEvent(GNode* seg2, const Eigen::Vector3d& dr, double rate) {
-  events_.push_back(GLink(seg2, rate, dr));
+void GNode::setEvents(GNode* nodes, const Index* destinations,
+                      const double* rates, const double* dr, Index nevents) {
+  nodes_ = nodes;
+  destinations_ = destinations;
+  rates_ = rates;
+  dr_ = dr;
+  nevents_ = nevents;
+}
+
+GLink GNode::Event(Index event) const {
+  if (event == nevents_) {
+    assert(hasdecay_ && "Node has no decay event");
+    return GLink(decayrate_);
+  }
+  return GLink(&nodes_[destinations_[event]], rates_[event],
+               Eigen::Map<const Eigen::Vector3d>(dr_ + 3 * event));
 }
 
 void GNode::InitEscapeRate() {
   escape_rate_ = 0.0;
-  for (const auto& event : events_) {
-    escape_rate_ += event.getRate();
+  for (Index i = 0; i < EventCount(); i++) {
+    escape_rate_ += Rate(i);
   }
 }
 
-GLink* GNode::findHoppingDestination(double p) const {
-  return hTree.findHoppingDestination(p);
+GLink GNode::findHoppingDestination(double p) const {
+  return Event(hTree.findHoppingDestination(p));
 }
 
 void GNode::MakeHuffTree() {
-  hTree.setEvents(&events_);
-  hTree.makeTree();
-}
-
-void GNode::AddEventfromQmPair(const QMPair& pair, std::vector<GNode>& nodes,
-                               double rate) {
-  Index destination = 0;
-  Eigen::Vector3d dr = Eigen::Vector3d::Zero();
-  if (id_ == pair.Seg1()->getId()) {
-    destination = pair.Seg2()->getId();
-    dr = pair.R();
-  } else {
-    destination = pair.Seg1()->getId();
-    dr = -pair.R();
+  std::vector<double> rates(EventCount());
+  for (Index i = 0; i < EventCount(); i++) {
+    rates[i] = Rate(i);
   }
-
-  AddEvent(&nodes[destination], dr, rate);
-
-  return;
+  hTree.makeTree(rates);
 }
 
 }  // namespace xtp
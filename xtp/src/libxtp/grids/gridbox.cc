@@ -52,6 +52,14 @@ AOShell::AOValues GridBox::CalcAOValues(const Eigen::Vector3d& point) const {
   return result;
 }
 
+Eigen::MatrixXd GridBox::CalcAOValueMatrix() const {
+  Eigen::MatrixXd result(size(), Matrixsize());
+  for (Index p = 0; p < size(); ++p) {
+    result.row(p) = CalcAOValues(grid_pos[p]).values.transpose();
+  }
+  return result;
+}
+
 void GridBox::AddtoBigMatrix(Eigen::MatrixXd& bigmatrix,
                              const Eigen::MatrixXd& smallmatrix) const {
   for (Index i = 0; i < Index(ranges.size()); i++) {
@@ -65,6 +73,18 @@ void GridBox::AddtoBigMatrix(Eigen::MatrixXd& bigmatrix,
   return;
 }
 
+void GridBox::AddtoBigMatrix(TiledAccumulator& bigmatrix,
+                             const Eigen::MatrixXd& smallmatrix) const {
+  for (Index i = 0; i < Index(ranges.size()); i++) {
+    for (Index j = 0; j < Index(ranges.size()); j++) {
+      bigmatrix.Add(ranges[i].start, ranges[j].start,
+                    smallmatrix.block(inv_ranges[i].start, inv_ranges[j].start,
+                                      inv_ranges[i].size, inv_ranges[j].size));
+    }
+  }
+  return;
+}
+
 Eigen::MatrixXd GridBox::ReadFromBigMatrix(
     const Eigen::MatrixXd& bigmatrix) const {
   Eigen::MatrixXd matrix = Eigen::MatrixXd(matrix_size, matrix_size);
@@ -89,6 +109,16 @@ Eigen::VectorXd GridBox::ReadFromBigVector(
   return vector;
 }
 
+Eigen::MatrixXd GridBox::ReadRowsFromBigMatrix(
+    const Eigen::MatrixXd& bigmatrix) const {
+  Eigen::MatrixXd matrix = Eigen::MatrixXd(matrix_size, bigmatrix.cols());
+  for (Index i = 0; i < Index(ranges.size()); i++) {
+    matrix.middleRows(inv_ranges[i].start, inv_ranges[i].size) =
+        bigmatrix.middleRows(ranges[i].start, ranges[i].size);
+  }
+  return matrix;
+}
+
 void GridBox::PrepareForIntegration() {
   Index index = 0;
   aoranges = std::vector<GridboxRange>(0);
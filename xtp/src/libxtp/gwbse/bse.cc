@@ -23,6 +23,7 @@
 
 // VOTCA includes
 #include <votca/tools/linalg.h>
+#include <votca/tools/profiler.h>
 
 // Local VOTCA includes
 #include "votca/xtp/bse.h"
@@ -101,12 +102,13 @@ Eigen::MatrixXd BSE::AdjustHqpSize(const Eigen::MatrixXd& Hqp,
 
 void BSE::SetupDirectInteractionOperator(
     const Eigen::VectorXd& RPAInputEnergies, double energy) {
+  tools::ScopedTimer timer("BSE::SetupDirectInteractionOperator");
   RPA rpa = RPA(log_, Mmn_);
   rpa.configure(opt_.homo, opt_.rpamin, opt_.rpamax);
   rpa.setRPAInputEnergies(RPAInputEnergies);
 
-  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(
-      rpa.calculate_epsilon_r(energy));
+  tools::EigenSystem es =
+      tools::linalg_eigenvalues(rpa.calculate_epsilon_r(energy));
   Mmn_.MultiplyRightWithAuxMatrix(es.eigenvectors());
 
   epsilon_0_inv_ = Eigen::VectorXd::Zero(es.eigenvalues().size());
@@ -125,6 +127,7 @@ void BSE::configureBSEOperator(BSE_OPERATOR& H) const {
   opt.qpmin = opt_.qpmin;
   opt.rpamin = opt_.rpamin;
   opt.vmin = opt_.vmin;
+  opt.max_slice_memory = opt_.max_slice_memory;
   H.configure(opt);
 }
 
@@ -136,6 +139,7 @@ tools::EigenSystem BSE::Solve_triplets_TDA() const {
 }
 
 void BSE::Solve_singlets(Orbitals& orb) const {
+  tools::ScopedTimer timer("BSE::Solve_singlets");
   orb.setTDAApprox(opt_.useTDA);
   if (opt_.useTDA) {
     orb.BSESinglets() = Solve_singlets_TDA();
@@ -146,6 +150,7 @@ void BSE::Solve_singlets(Orbitals& orb) const {
 }
 
 void BSE::Solve_triplets(Orbitals& orb) const {
+  tools::ScopedTimer timer("BSE::Solve_triplets");
   orb.setTDAApprox(opt_.useTDA);
   if (opt_.useTDA) {
     orb.BSETriplets() = Solve_triplets_TDA();
@@ -179,22 +184,37 @@ TripletOperator_TDA BSE::getTripletOperator_TDA() const {
 
 template <typename BSE_OPERATOR>
 tools::EigenSystem BSE::solve_hermitian(BSE_OPERATOR& h) const {
+  tools::ScopedTimer timer("BSE::solve_hermitian");
 
   std::chrono::time_point<std::chrono::system_clock> start =
       std::chrono::system_clock::now();
 
   tools::EigenSystem result;
 
-  DavidsonSolver DS(log_);
-
-  DS.set_correction(opt_.davidson_correction);
-  DS.set_tolerance(opt_.davidson_tolerance);
-  DS.set_size_update(opt_.davidson_update);
-  DS.set_iter_max(opt_.davidson_maxiter);
-  DS.set_max_search_space(10 * opt_.nmax);
-  DS.solve(h, opt_.nmax);
-  result.eigenvalues() = DS.eigenvalues();
-  result.eigenvectors() = DS.eigenvectors();
+  Index max_search_space = 10 * opt_.nmax;
+  if (max_search_space >= h.size()) {
+    // the search space of Davidson would span the whole matrix, so only the
+    // lowest states of the dense matrix are computed
+    XTP_LOG(Log::info, log_)
+        << TimeStamp() << " Dense diagonalization of the BSE matrix" << flush;
+    Eigen::MatrixXd hfull =
+        h.matmul(Eigen::MatrixXd::Identity(h.size(), h.size()));
+    result = tools::linalg_eigenvalues(hfull, opt_.nmax);
+    if (result.info() != Eigen::Success) {
+      throw std::runtime_error("BSE: dense diagonalization failed");
+    }
+  } else {
+    DavidsonSolver DS(log_);
+
+    DS.set_correction(opt_.davidson_correction);
+    DS.set_tolerance(opt_.davidson_tolerance);
+    DS.set_size_update(opt_.davidson_update);
+    DS.set_iter_max(opt_.davidson_maxiter);
+    DS.set_max_search_space(max_search_space);
+    DS.solve(h, opt_.nmax);
+    result.eigenvalues() = DS.eigenvalues();
+    result.eigenvectors() = DS.eigenvectors();
+  }
 
   std::chrono::time_point<std::chrono::system_clock> end =
       std::chrono::system_clock::now();
@@ -229,6 +249,7 @@ tools::EigenSystem BSE::Solve_triplets_BTDA() const {
 template <typename BSE_OPERATOR_A, typename BSE_OPERATOR_B>
 tools::EigenSystem BSE::Solve_nonhermitian_Davidson(BSE_OPERATOR_A& Aop,
                                                     BSE_OPERATOR_B& Bop) const {
+  tools::ScopedTimer timer("BSE::Solve_nonhermitian_Davidson");
   std::chrono::time_point<std::chrono::system_clock> start =
       std::chrono::system_clock::now();
 
@@ -17,6 +17,9 @@
  *
  */
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/xtp/bse_operator.h"
 #include "votca/xtp/openmp_cuda.h"
@@ -34,6 +37,11 @@ void BSE_OPERATOR<cqp, cx, cd, cd2>::configure(BSEOperator_Options opt) {
   bse_ctotal_ = opt_.cmax - bse_cmin_ + 1;
   bse_size_ = bse_vtotal_ * bse_ctotal_;
   this->set_size(bse_size_);
+  Mcc_.resize(0, 0);
+  Mcv_.resize(0, 0);
+  Mvc_.resize(0, 0);
+  slices_ready_ = false;
+  diag_.resize(0);
 }
 
 template <Index cqp, Index cx, Index cd, Index cd2>
@@ -42,6 +50,174 @@ Eigen::MatrixXd BSE_OPERATOR<cqp, cx, cd, cd2>::matmul(
 
   static_assert(!(cd2 != 0 && cd != 0),
                 "Hamiltonian cannot contain Hd and Hd2 at the same time");
+  tools::ScopedTimer timer("BSE_OPERATOR::matmul",
+                           Index(input.size() * sizeof(double)));
+
+  if (use_fused(input.cols())) {
+    return matmul_fused(input);
+  }
+  return matmul_rows(input);
+}
+
+// compares the number of multiplications of both matmul variants, the
+// fused variant is only used if its slice copies fit into max_slice_memory
+template <Index cqp, Index cx, Index cd, Index cd2>
+bool BSE_OPERATOR<cqp, cx, cd, cd2>::use_fused(Index nvecs) const {
+  if (OpenMP_CUDA::UsingGPUs() > 0) {
+    return false;
+  }
+  double v = double(bse_vtotal_);
+  double c = double(bse_ctotal_);
+  double aux = double(Mmn_.auxsize());
+  double k = double(nvecs);
+
+  double slices = 0.0;
+  if (cd != 0) {
+    slices += c * c * aux;
+  }
+  if (cd2 != 0) {
+    slices += v * c * aux;
+  }
+  if (cx != 0 || cd2 != 0) {
+    slices += v * c * aux;
+  }
+  double megabytes = slices * double(sizeof(double)) / (1024.0 * 1024.0);
+  if (megabytes > opt_.max_slice_memory) {
+    return false;
+  }
+
+  double rows = v * c * v * c * k;
+  double fused = 0.0;
+  if (cd != 0 || cd2 != 0) {
+    rows += v * c * v * c * aux;
+    fused += v * c * aux * k * (v + c);
+  }
+  if (cx != 0) {
+    rows += 0.5 * v * c * v * c * (aux + 2 * k);
+    fused += 2 * v * c * aux * k;
+  }
+  if (cqp != 0) {
+    fused += v * c * k * (v + c);
+  }
+  return fused < rows;
+}
+
+template <Index cqp, Index cx, Index cd, Index cd2>
+void BSE_OPERATOR<cqp, cx, cd, cd2>::setup_slices() const {
+  if (slices_ready_) {
+    return;
+  }
+  Index auxsize = Mmn_.auxsize();
+  Index vmin = opt_.vmin - opt_.rpamin;
+  Index cmin = bse_cmin_ - opt_.rpamin;
+
+  if (cd != 0) {
+    Mcc_.resize(bse_ctotal_ * auxsize, bse_ctotal_);
+#pragma omp parallel for
+    for (Index c = 0; c < bse_ctotal_; c++) {
+      Eigen::Map<Eigen::MatrixXd>(Mcc_.col(c).data(), bse_ctotal_, auxsize) =
+          Mmn_[c + cmin].middleRows(cmin, bse_ctotal_);
+    }
+  }
+  if (cd2 != 0) {
+    Mcv_.resize(bse_vtotal_ * auxsize, bse_ctotal_);
+#pragma omp parallel for
+    for (Index c = 0; c < bse_ctotal_; c++) {
+      Eigen::Map<Eigen::MatrixXd>(Mcv_.col(c).data(), bse_vtotal_, auxsize) =
+          Mmn_[c + cmin].middleRows(vmin, bse_vtotal_);
+    }
+  }
+  if (cx != 0 || cd2 != 0) {
+    Mvc_.resize(bse_size_, auxsize);
+#pragma omp parallel for
+    for (Index v = 0; v < bse_vtotal_; v++) {
+      Mvc_.middleRows(v * bse_ctotal_, bse_ctotal_) =
+          Mmn_[v + vmin].middleRows(cmin, bse_ctotal_);
+    }
+  }
+  slices_ready_ = true;
+}
+
+/*
+ * All rows belonging to one valence index v1 are computed at once, so every
+ * iteration writes its own block of the result and no reduction is needed.
+ * With X_k the k-th input vector viewed as a ctotal x vtotal matrix:
+ *  Hqp: H_cc^T X_k(:,v1) - sum_v2 H_v2v1 X_k(:,v2)
+ *  Hd:  sum_c2a M[c1](c2,a) W_k(c2,a) with W_k = X_k M[v1](v,:) eps
+ *  Hd2: sum_v2a M[c1](v2,a) Y_k(v2,a) with Y_k = X_k^T M[v1](c,:) eps
+ *  Hx:  M[v1](c,:) Z with Z = sum_vc M[v](c,:)^T X(vc,:) computed upfront
+ */
+template <Index cqp, Index cx, Index cd, Index cd2>
+Eigen::MatrixXd BSE_OPERATOR<cqp, cx, cd, cd2>::matmul_fused(
+    const Eigen::MatrixXd& input) const {
+  setup_slices();
+  Index auxsize = Mmn_.auxsize();
+  Index nvecs = input.cols();
+  Index vmin = opt_.vmin - opt_.rpamin;
+
+  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(bse_size_, nvecs);
+  Eigen::MatrixXd Z;
+  if (cx != 0) {
+    Z = cx * (Mvc_.transpose() * input);
+  }
+  Eigen::MatrixXd Hcc_T;
+  if (cqp != 0) {
+    Hcc_T = cqp * Hqp_.block(bse_vtotal_, bse_vtotal_, bse_ctotal_,
+                             bse_ctotal_)
+                      .transpose();
+  }
+
+#pragma omp parallel
+  {
+    Index direct_rows = (cd != 0) ? bse_ctotal_ : bse_vtotal_;
+    Eigen::MatrixXd W;
+    if (cd != 0 || cd2 != 0) {
+      W.resize(direct_rows * auxsize, nvecs);
+    }
+#pragma omp for schedule(dynamic)
+    for (Index v1 = 0; v1 < bse_vtotal_; v1++) {
+      auto out = result.middleRows(v1 * bse_ctotal_, bse_ctotal_);
+      if (cqp != 0) {
+        out.noalias() +=
+            Hcc_T * input.middleRows(v1 * bse_ctotal_, bse_ctotal_);
+        for (Index v2 = 0; v2 < bse_vtotal_; v2++) {
+          if (Hqp_(v2, v1) != 0.0) {
+            out -= cqp * Hqp_(v2, v1) *
+                   input.middleRows(v2 * bse_ctotal_, bse_ctotal_);
+          }
+        }
+      }
+      if (cd != 0 || cd2 != 0) {
+        for (Index k = 0; k < nvecs; k++) {
+          Eigen::Map<const Eigen::MatrixXd> X(input.col(k).data(), bse_ctotal_,
+                                              bse_vtotal_);
+          Eigen::Map<Eigen::MatrixXd> Wk(W.col(k).data(), direct_rows,
+                                         auxsize);
+          if (cd != 0) {
+            Wk.noalias() = X * Mmn_[v1 + vmin].middleRows(vmin, bse_vtotal_);
+          } else {
+            Wk.noalias() = X.transpose() *
+                           Mvc_.middleRows(v1 * bse_ctotal_, bse_ctotal_);
+          }
+          Wk *= epsilon_0_inv_.asDiagonal();
+        }
+        if (cd != 0) {
+          out.noalias() -= cd * (Mcc_.transpose() * W);
+        } else {
+          out.noalias() -= cd2 * (Mcv_.transpose() * W);
+        }
+      }
+      if (cx != 0) {
+        out.noalias() += Mvc_.middleRows(v1 * bse_ctotal_, bse_ctotal_) * Z;
+      }
+    }
+  }
+  return result;
+}
+
+template <Index cqp, Index cx, Index cd, Index cd2>
+Eigen::MatrixXd BSE_OPERATOR<cqp, cx, cd, cd2>::matmul_rows(
+    const Eigen::MatrixXd& input) const {
 
   Index auxsize = Mmn_.auxsize();
   vc2index vc = vc2index(0, 0, bse_ctotal_);
@@ -132,6 +308,14 @@ Eigen::VectorXd BSE_OPERATOR<cqp, cx, cd, cd2>::Hqp_row(Index v1,
 
 template <Index cqp, Index cx, Index cd, Index cd2>
 Eigen::VectorXd BSE_OPERATOR<cqp, cx, cd, cd2>::diagonal() const {
+  if (diag_.size() != bse_size_) {
+    diag_ = compute_diagonal();
+  }
+  return diag_;
+}
+
+template <Index cqp, Index cx, Index cd, Index cd2>
+Eigen::VectorXd BSE_OPERATOR<cqp, cx, cd, cd2>::compute_diagonal() const {
 
   static_assert(!(cd2 != 0 && cd != 0),
                 "Hamiltonian cannot contain Hd and Hd2 at the same time");
@@ -142,7 +326,8 @@ Eigen::VectorXd BSE_OPERATOR<cqp, cx, cd, cd2>::diagonal() const {
 
   Eigen::VectorXd result = Eigen::VectorXd::Zero(bse_size_);
 
-#pragma omp parallel for schedule(dynamic) reduction(+ : result)
+  // every entry is written by exactly one iteration, no reduction needed
+#pragma omp parallel for schedule(dynamic)
   for (Index v = 0; v < bse_vtotal_; v++) {
     for (Index c = 0; c < bse_ctotal_; c++) {
 
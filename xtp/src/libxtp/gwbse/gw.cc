@@ -21,6 +21,9 @@
 #include <fstream>
 #include <iostream>
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/xtp/IndexParser.h"
 #include "votca/xtp/anderson_mixing.h"
@@ -142,8 +145,11 @@ Eigen::VectorXd GW::ScissorShift_DFTlevel(
 }
 
 void GW::CalculateGWPerturbation() {
-
-  Sigma_x_ = (1 - opt_.ScaHFX) * sigma_->CalcExchangeMatrix();
+  tools::ScopedTimer timer("GW::CalculateGWPerturbation");
+  {
+    tools::ScopedTimer exchange_timer("GW::ExchangeMatrix");
+    Sigma_x_ = (1 - opt_.ScaHFX) * sigma_->CalcExchangeMatrix();
+  }
   XTP_LOG(Log::error, log_)
       << TimeStamp() << " Calculated Hartree exchange contribution"
       << std::flush;
@@ -166,11 +172,15 @@ void GW::CalculateGWPerturbation() {
   for (Index i_gw = 0; i_gw < opt_.gw_sc_max_iterations; ++i_gw) {
 
     if (i_gw % opt_.reset_3c == 0 && i_gw != 0) {
+      tools::ScopedTimer rebuild_timer("GW::Rebuild3c");
       Mmn_.Rebuild();
       XTP_LOG(Log::info, log_)
           << TimeStamp() << " Rebuilding 3c integrals" << std::flush;
     }
-    sigma_->PrepareScreening();
+    {
+      tools::ScopedTimer screening_timer("GW::PrepareScreening");
+      sigma_->PrepareScreening();
+    }
     XTP_LOG(Log::info, log_)
         << TimeStamp() << " Calculated screening via RPA" << std::flush;
     XTP_LOG(Log::info, log_)
@@ -241,6 +251,7 @@ Eigen::VectorXd GW::getGWAResults() const {
 }
 
 Eigen::VectorXd GW::SolveQP(const Eigen::VectorXd& frequencies) const {
+  tools::ScopedTimer timer("GW::SolveQP");
   const Eigen::VectorXd intercepts =
       dft_energies_.segment(opt_.qpmin, qptotal_) + Sigma_x_.diagonal() -
       vxc_.diagonal();
@@ -421,6 +432,7 @@ bool GW::Converged(const Eigen::VectorXd& e1, const Eigen::VectorXd& e2,
 }
 
 void GW::CalculateHQP() {
+  tools::ScopedTimer timer("GW::CalculateHQP");
   Eigen::VectorXd diag_backup = Sigma_c_.diagonal();
   Sigma_c_ = sigma_->CalcCorrelationOffDiag(getGWAResults());
   Sigma_c_.diagonal() = diag_backup;
@@ -26,6 +26,7 @@
 // VOTCA includes
 #include <stdexcept>
 #include <votca/tools/constants.h>
+#include <votca/tools/profiler.h>
 
 // Local VOTCA includes
 #include "votca/xtp/basisset.h"
@@ -211,6 +212,8 @@ void GWBSE::Initialize(tools::Property& options) {
 
   bseopt_.davidson_maxiter = options.get("bse.davidson.maxiter").as<Index>();
 
+  bseopt_.max_slice_memory = options.get("bse.max_slice_memory").as<double>();
+
   bseopt_.useTDA = options.get("bse.useTDA").as<bool>();
   orbitals_.setTDAApprox(bseopt_.useTDA);
   if (!bseopt_.useTDA) {
@@ -542,6 +545,7 @@ Eigen::MatrixXd GWBSE::CalculateVXC(const AOBasis& dftbasis) {
 }
 
 bool GWBSE::Evaluate() {
+  tools::ScopedTimer timer("GWBSE::Evaluate");
 
   // set the parallelization
   XTP_LOG(Log::error, *pLog_) << TimeStamp() << " Using "
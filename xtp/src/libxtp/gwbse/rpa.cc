@@ -17,6 +17,9 @@
  *
  */
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/xtp/rpa.h"
 #include "votca/xtp/aomatrix.h"
@@ -155,6 +158,7 @@ Eigen::MatrixXd RPA::calculate_epsilon_r(std::complex<double> frequency) const {
 }
 
 RPA::rpa_eigensolution RPA::Diagonalize_H2p() const {
+  tools::ScopedTimer timer("RPA::Diagonalize_H2p");
   const Index lumo = homo_ + 1;
   const Index n_occ = lumo - rpamin_;
   const Index n_unocc = rpamax_ - lumo + 1;
@@ -19,13 +19,13 @@
 /// For an earlier history see ctp repo commit
 /// 77795ea591b29e664153f9404c8655ba28dc14e9
 
+// Standard includes
+#include <cstdio>
+
 // Third party includes
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
-// VOTCA includes
-#include <votca/tools/propertyiomanipulator.h>
-
 // Local VOTCA includes
 #include "votca/xtp/job.h"
 
@@ -72,6 +72,40 @@ Job::Job(Index id, const std::string &tag, const tools::Property &input,
   status_ = status;
 }
 
+Job::Job(const tools::XMLRecord &record, std::shared_ptr<const JobFile> file) {
+  const tools::Property &prop = record.element;
+  id_ = prop.get("id").as<Index>();
+  tag_ = prop.get("tag").as<std::string>();
+  auto input = record.skipped.find("input");
+  if (input == record.skipped.end()) {
+    throw std::runtime_error("Job " + std::to_string(id_) + " has no input");
+  }
+  input_.setSource(file, input->second.first, input->second.second);
+  if (prop.exists("status")) {
+    status_ = ConvertStatus(prop.get("status").as<std::string>());
+  } else {
+    status_ = AVAILABLE;
+  }
+
+  if (prop.exists("host")) {
+    host_ = prop.get("host").as<std::string>();
+    has_host_ = true;
+  }
+  if (prop.exists("time")) {
+    time_ = prop.get("time").as<std::string>();
+    has_time_ = true;
+  }
+  auto output = record.skipped.find("output");
+  if (output != record.skipped.end()) {
+    output_.setSource(file, output->second.first, output->second.second);
+    has_output_ = true;
+  }
+  if (prop.exists("error")) {
+    error_ = prop.get("error").as<std::string>();
+    has_error_ = true;
+  }
+}
+
 std::string Job::ConvertStatus(JobStatus status) const {
 
   std::string converted;
@@ -118,15 +152,14 @@ void Job::Reset() {
   return;
 }
 
-void Job::ToStream(std::ofstream &ofs) const {
+Job::PayloadRanges Job::ToStream(std::ofstream &ofs) const {
 
-  tools::PropertyIOManipulator iomXML(tools::PropertyIOManipulator::XML, 0,
-                                      "\t\t");
+  PayloadRanges ranges{{{-1, -1}, {-1, -1}}};
   std::string tab = "\t";
   ofs << tab << "<job>\n";
   ofs << tab << tab << (format("<id>%1$d</id>\n") % id_).str();
   ofs << tab << tab << (format("<tag>%1$s</tag>\n") % tag_).str();
-  ofs << iomXML << input_;
+  ranges[0] = input_.ToStream(ofs, tab + tab);
   ofs << tab << tab
       << (format("<status>%1$s</status>\n") % ConvertStatus(status_)).str();
 
@@ -137,13 +170,19 @@ void Job::ToStream(std::ofstream &ofs) const {
     ofs << tab << tab << (format("<time>%1$s</time>\n") % time_).str();
   }
   if (has_output_) {
-    ofs << iomXML << output_;
+    ranges[1] = output_.ToStream(ofs, tab + tab);
   }
   if (has_error_) {
     ofs << tab << tab << (format("<error>%1$s</error>\n") % error_).str();
   }
   ofs << tab << "</job>\n";
-  return;
+  return ranges;
+}
+
+void Job::RebasePayloads(const std::shared_ptr<const JobFile> &file,
+                         const PayloadRanges &ranges) const {
+  input_.Rebase(file, ranges[0].first, ranges[0].second);
+  output_.Rebase(file, ranges[1].first, ranges[1].second);
 }
 
 void Job::UpdateFrom(const Job &ext) {
@@ -158,7 +197,8 @@ void Job::UpdateFrom(const Job &ext) {
   }
   if (ext.hasOutput()) {
     has_output_ = true;
-    output_ = ext.getOutput();
+    // copies a payload that was not read yet without parsing it
+    output_ = ext.output_;
   }
   if (ext.hasError()) {
     has_error_ = true;
@@ -183,32 +223,40 @@ void Job::UpdateFromResult(const JobResult &res) {
 
 std::vector<Job> LOAD_JOBS(const std::string &job_file) {
 
-  tools::Property xml;
-  xml.LoadFromXML(job_file);
-
-  std::vector<tools::Property *> jobProps = xml.Select("jobs.job");
+  // input and output of the jobs are only read once they are accessed
+  auto file = std::make_shared<const JobFile>(job_file);
   std::vector<Job> jobs;
-  jobs.reserve(jobProps.size());
-  for (tools::Property *prop : jobProps) {
-    jobs.push_back(Job(*prop));
-  }
-
+  tools::ReadXMLRecords(
+      job_file, "jobs.job", {"input", "output"},
+      [&](const tools::XMLRecord &record) { jobs.emplace_back(record, file); });
   return jobs;
 }
 
 void WRITE_JOBS(const std::vector<Job> &jobs, const std::string &job_file) {
+  // the old job file is still read by jobs which payloads were not accessed,
+  // so the new one is written next to it and moved over it afterwards
+  std::string tmp_file = job_file + ".tmp";
   std::ofstream ofs;
-  ofs.open(job_file, std::ofstream::out);
+  ofs.open(tmp_file, std::ofstream::out | std::ofstream::binary);
   if (!ofs.is_open()) {
-    throw std::runtime_error("Bad file handle: " + job_file);
+    throw std::runtime_error("Bad file handle: " + tmp_file);
   }
+  std::vector<Job::PayloadRanges> ranges;
+  ranges.reserve(jobs.size());
   ofs << "<jobs>" << std::endl;
   for (auto &job : jobs) {
-    job.ToStream(ofs);
+    ranges.push_back(job.ToStream(ofs));
   }
   ofs << "</jobs>" << std::endl;
 
   ofs.close();
+  if (ofs.fail() || std::rename(tmp_file.c_str(), job_file.c_str()) != 0) {
+    throw std::runtime_error("Could not write job file " + job_file);
+  }
+  auto file = std::make_shared<const JobFile>(job_file);
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    jobs[i].RebasePayloads(file, ranges[i]);
+  }
   return;
 }
 
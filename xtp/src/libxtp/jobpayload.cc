@@ -0,0 +1,126 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// VOTCA includes
+#include <votca/tools/propertyiomanipulator.h>
+
+// Local VOTCA includes
+#include "votca/xtp/jobpayload.h"
+
+namespace votca {
+namespace xtp {
+
+JobFile::JobFile(const std::string& filename)
+    : filename_(filename), file_(filename, std::ios::binary) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Bad file handle: " + filename);
+  }
+}
+
+std::string JobFile::Read(std::streamoff begin, std::streamoff end) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::string bytes(std::size_t(end - begin), '\0');
+  file_.clear();
+  file_.seekg(begin);
+  file_.read(bytes.data(), std::streamsize(bytes.size()));
+  if (file_.gcount() != std::streamsize(bytes.size())) {
+    throw std::runtime_error("Could not read job payload from " + filename_);
+  }
+  return bytes;
+}
+
+JobPayload& JobPayload::operator=(const JobPayload& other) {
+  if (this != &other) {
+    std::scoped_lock lock(mutex_, other.mutex_);
+    prop_ = other.prop_;
+    source_ = other.source_;
+  }
+  return *this;
+}
+
+JobPayload& JobPayload::operator=(const tools::Property& prop) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prop_ = prop;
+  source_ = nullptr;
+  return *this;
+}
+
+void JobPayload::setSource(std::shared_ptr<const JobFile> file,
+                           std::streamoff begin, std::streamoff end) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prop_ = tools::Property();
+  source_ = std::make_shared<const Source>(Source{std::move(file), begin, end});
+}
+
+bool JobPayload::isPending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return source_ != nullptr;
+}
+
+const tools::Property& JobPayload::get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (source_) {
+    tools::Property xml;
+    xml.LoadFromXMLString(source_->file->Read(source_->begin, source_->end));
+    prop_ = *xml.begin();
+    source_ = nullptr;
+  }
+  return prop_;
+}
+
+tools::Property& JobPayload::get() {
+  return const_cast<tools::Property&>(
+      static_cast<const JobPayload&>(*this).get());
+}
+
+std::pair<std::streamoff, std::streamoff> JobPayload::ToStream(
+    std::ofstream& ofs, const std::string& indent) const {
+  std::shared_ptr<const Source> source;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source = source_;
+  }
+  if (source) {
+    ofs << indent;
+    std::streamoff begin = ofs.tellp();
+    ofs << source->file->Read(source->begin, source->end);
+    std::streamoff end = ofs.tellp();
+    ofs << "\n";
+    return {begin, end};
+  }
+  tools::PropertyIOManipulator iomXML(tools::PropertyIOManipulator::XML, 0,
+                                      indent);
+  ofs << iomXML << get();
+  return {-1, -1};
+}
+
+void JobPayload::Rebase(std::shared_ptr<const JobFile> file,
+                        std::streamoff begin, std::streamoff end) const {
+  if (begin < 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (source_) {
+    source_ =
+        std::make_shared<const Source>(Source{std::move(file), begin, end});
+  }
+}
+
+}  // namespace xtp
+}  // namespace votca
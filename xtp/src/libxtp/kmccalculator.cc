@@ -79,20 +79,23 @@ void KMCCalculator::LoadGraph(Topology& top) {
         "in Kelvin.");
   }
 
-  Rate_Engine rate_engine(temperature_, field_);
+  Index nsites = Index(nodes_.size());
+  graph_ = EventGraph(nblist, nsites, carriertype_);
+  // the nodes read their events from the graph, so rate updates of the
+  // graph reach them without copies
+  for (Index i = 0; i < nsites; i++) {
+    Index first = graph_.EventsBegin(i);
+    nodes_[i].setEvents(nodes_.data(), graph_.Destinations().data() + first,
+                        graph_.Rates().data() + first,
+                        graph_.DeltaRs().data() + 3 * first,
+                        graph_.EventCount(i));
+  }
+
   XTP_LOG(Log::error, log_) << "\nCalculating initial rates." << std::flush;
-  XTP_LOG(Log::error, log_) << rate_engine << std::flush;
   XTP_LOG(Log::error, log_)
       << "    carriertype: " << carriertype_.ToLongString() << std::flush;
-
-  for (const QMPair* pair : nblist) {
-    Rate_Engine::PairRates rates = rate_engine.Rate(*pair, carriertype_);
-    nodes_[pair->Seg1()->getId()].AddEventfromQmPair(*pair, nodes_,
-                                                     rates.rate12);
-    nodes_[pair->Seg2()->getId()].AddEventfromQmPair(*pair, nodes_,
-                                                     rates.rate21);
-  }
-  RandomVariable_.setMaxInt(Index(nodes_.size()));
+  UpdateRates(temperature_, field_);
+  RandomVariable_.setMaxInt(nsites);
   XTP_LOG(Log::error, log_) << "    Rates for " << nodes_.size()
                             << " sites are computed." << std::flush;
   WriteRatestoFile(ratefile_, nblist);
@@ -104,8 +107,9 @@ void KMCCalculator::LoadGraph(Topology& top) {
   double maxlength = 0;
   for (const auto& node : nodes_) {
 
-    Index size = Index(node.Events().size());
-    for (const auto& event : node.Events()) {
+    Index size = node.EventCount();
+    for (Index i = 0; i < size; i++) {
+      GLink event = node.Event(i);
       if (event.isDecayEvent()) {
         continue;
       }
@@ -130,7 +134,7 @@ void KMCCalculator::LoadGraph(Topology& top) {
   double avg = double(events) / double(nodes_.size());
   double deviation = 0.0;
   for (const auto& node : nodes_) {
-    double size = double(node.Events().size());
+    double size = double(node.EventCount());
     deviation += (size - avg) * (size - avg);
   }
   deviation = std::sqrt(deviation / double(nodes_.size()));
@@ -148,12 +152,21 @@ void KMCCalculator::LoadGraph(Topology& top) {
       << "spatial carrier density: "
       << double(numberofcarriers_) / (top.BoxVolume() * conv) << " nm^-3"
       << std::flush;
+  return;
+}
 
-  for (auto& node : nodes_) {
-    node.InitEscapeRate();
-    node.MakeHuffTree();
+void KMCCalculator::UpdateRates(double temperature,
+                                const Eigen::Vector3d& field) {
+  temperature_ = temperature;
+  field_ = field;
+  Rate_Engine rate_engine(temperature_, field_);
+  XTP_LOG(Log::error, log_) << rate_engine << std::flush;
+  std::vector<Index> changed = graph_.UpdateRates(rate_engine);
+  for (Index site : changed) {
+    nodes_[site].UpdateEventRates();
   }
-  return;
+  XTP_LOG(Log::error, log_)
+      << "    Rates of " << changed.size() << " sites changed." << std::flush;
 }
 
 void KMCCalculator::ResetForbiddenlist(
@@ -183,7 +196,8 @@ bool KMCCalculator::CheckForbidden(
 bool KMCCalculator::CheckSurrounded(
     const GNode& node, const std::vector<GNode*>& forbiddendests) const {
   bool surrounded = true;
-  for (const auto& event : node.Events()) {
+  for (Index i = 0; i < node.EventCount(); i++) {
+    GLink event = node.Event(i);
     bool thisevent_possible = true;
     for (const GNode* fnode : forbiddendests) {
       if (event.getDestination() == fnode) {
@@ -236,9 +250,9 @@ double KMCCalculator::Promotetime(double cumulated_rate) {
   return dt;
 }
 
-const GLink& KMCCalculator::ChooseHoppingDest(const GNode& node) {
+GLink KMCCalculator::ChooseHoppingDest(const GNode& node) {
   double u = 1 - RandomVariable_.rand_uniform();
-  return *(node.findHoppingDestination(u));
+  return node.findHoppingDestination(u);
 }
 
 Chargecarrier* KMCCalculator::ChooseAffectedCarrier(double cumulated_rate) {
@@ -266,12 +280,20 @@ void KMCCalculator::WriteRatestoFile(std::string filename,
          << temperature_ * tools::conv::hrt2ev / tools::conv::kB
          << "K for carrier:" << carriertype_.ToString() << endl;
 
-  Rate_Engine rate_engine(temperature_, field_);
+  // the rates are already in the graph, only sort them by pair
+  std::vector<Rate_Engine::PairRates> rates(nblist.size());
+  for (Index e = 0; e < graph_.NumberOfEvents(); e++) {
+    Rate_Engine::PairRates& pair_rates = rates[graph_.PairId(e)];
+    if (graph_.isForward(e)) {
+      pair_rates.rate12 = graph_.Rate(e);
+    } else {
+      pair_rates.rate21 = graph_.Rate(e);
+    }
+  }
   for (const QMPair* pair : nblist) {
-    Rate_Engine::PairRates rates = rate_engine.Rate(*pair, carriertype_);
     ratefs << pair->getId() << " " << pair->Seg1()->getId() << " "
-           << pair->Seg2()->getId() << " " << rates.rate12 << " "
-           << rates.rate21 << "\n";
+           << pair->Seg2()->getId() << " " << rates[pair->getId()].rate12
+           << " " << rates[pair->getId()].rate21 << "\n";
   }
   ratefs << std::flush;
   ratefs.close();
@@ -17,11 +17,17 @@
  *
  */
 
+// Standard includes
+#include <limits>
+#include <map>
+#include <memory>
+
 // Local VOTCA includes
 #include "votca/xtp/ERIs.h"
 #include "votca/xtp/aobasis.h"
 #include "votca/xtp/aomatrix.h"
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/ripotential.h"
 #include "votca/xtp/threecenter.h"
 
 // include libint last otherwise it overrides eigen
@@ -33,20 +39,64 @@
 namespace votca {
 namespace xtp {
 
-std::vector<std::vector<Index>> AOBasis::ComputeShellPairs(
-    double threshold) const {
+namespace {
+/*
+ * Setting up a libint2 engine allocates its scratch memory and
+ * precomputes tables, which for small molecules costs as much as the
+ * integrals themselves. Every thread calling into the integral code
+ * therefore keeps one set of engines, one per OpenMP thread, for each
+ * operator and braket and reuses it for all later integrals, so a job
+ * farm running many small molecules on one thread sets them up only once.
+ * An engine is only rebuilt if a basis needs more primitives or a higher
+ * angular momentum than it was built for.
+ *
+ * The set is shared with its callers. If a caller further up the stack
+ * still holds it, it is neither resized nor reconfigured under that caller,
+ * the pool moves on to a new set and the old one lives until its last
+ * holder releases it.
+ */
+using EngineSet = std::shared_ptr<std::vector<libint2::Engine>>;
+
+EngineSet EnginePool(
+    libint2::Operator op, libint2::BraKet braket, Index maxnprim, Index maxL,
+    double precision = std::numeric_limits<double>::epsilon()) {
+  struct Pool {
+    Index maxnprim = 0;
+    Index maxL = -1;
+    EngineSet engines;
+  };
+  thread_local std::map<std::pair<int, int>, Pool> pools;
+  Pool& pool = pools[{static_cast<int>(op), static_cast<int>(braket)}];
 
   Index nthreads = OPENMP::getMaxThreads();
+  bool in_use = pool.engines.use_count() > 1;
+  if (!pool.engines || in_use || maxnprim > pool.maxnprim ||
+      maxL > pool.maxL || Index(pool.engines->size()) < nthreads) {
+    pool.maxnprim = std::max(maxnprim, pool.maxnprim);
+    pool.maxL = std::max(maxL, pool.maxL);
+    libint2::Engine engine(op, pool.maxnprim, static_cast<int>(pool.maxL), 0,
+                           precision);
+    engine.set(braket);
+    pool.engines =
+        std::make_shared<std::vector<libint2::Engine>>(nthreads, engine);
+  }
+  for (libint2::Engine& engine : *pool.engines) {
+    engine.set_precision(precision);
+  }
+  return pool.engines;
+}
 
-  std::vector<libint2::Shell> shells = GenerateLibintBasis();
+EngineSet EnginePool(libint2::Operator op, Index maxnprim, Index maxL) {
+  return EnginePool(op, libint2::BraKet::x_x, maxnprim, maxL);
+}
+}  // namespace
 
-  // construct the 2-electron repulsion integrals engine
-  std::vector<libint2::Engine> engines;
-  engines.reserve(nthreads);
-  engines.emplace_back(libint2::Operator::overlap, getMaxNprim(), getMaxL(), 0);
-  for (Index i = 1; i != nthreads; ++i) {
-    engines.push_back(engines[0]);
-  }
+std::vector<std::vector<Index>> AOBasis::ComputeShellPairs(
+    double threshold) const {
+
+  const std::vector<libint2::Shell>& shells = LibintBasis();
+  EngineSet engines =
+      EnginePool(libint2::Operator::overlap, getMaxNprim(), getMaxL());
 
   std::vector<std::vector<Index>> pairs(shells.size());
 
@@ -54,7 +104,7 @@ std::vector<std::vector<Index>> AOBasis::ComputeShellPairs(
   for (Index s1 = 0; s1 < Index(shells.size()); ++s1) {
     Index thread_id = OPENMP::getThreadId();
 
-    libint2::Engine& engine = engines[thread_id];
+    libint2::Engine& engine = (*engines)[thread_id];
     const libint2::Engine::target_ptr_vec& buf = engine.results();
     Index n1 = shells[s1].size();
 
@@ -79,57 +129,56 @@ std::vector<std::vector<Index>> AOBasis::ComputeShellPairs(
 using MatrixLibInt =
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
-template <libint2::Operator obtype,
-          typename OperatorParams =
-              typename libint2::operator_traits<obtype>::oper_params_type>
-std::array<MatrixLibInt, libint2::operator_traits<obtype>::nopers>
-    computeOneBodyIntegrals(const AOBasis& aobasis,
-                            OperatorParams oparams = OperatorParams()) {
+// engines of one operator with their parameters already set and the number
+// of components the operator has
+struct OneBodyOperator {
+  EngineSet engines;
+  Index nopers;
+};
 
-  Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Shell> shells = aobasis.GenerateLibintBasis();
+// all operators are evaluated in a single pass over the significant shell
+// pairs, the components of all operators are returned in order
+std::vector<MatrixLibInt> computeOneBodyIntegrals(
+    const AOBasis& aobasis, const std::vector<OneBodyOperator>& operators) {
 
-  std::vector<std::vector<Index>> shellpair_list = aobasis.ComputeShellPairs();
-
-  Index nopers = static_cast<Index>(libint2::operator_traits<obtype>::nopers);
-  std::array<MatrixLibInt, libint2::operator_traits<obtype>::nopers> result;
-  for (MatrixLibInt& r : result) {
-    r = MatrixLibInt::Zero(aobasis.AOBasisSize(), aobasis.AOBasisSize());
-  }
+  const std::vector<libint2::Shell>& shells = aobasis.LibintBasis();
+  const std::vector<std::vector<Index>>& shellpair_list = aobasis.ShellPairs();
+  std::vector<Index> shell2bf = aobasis.getMapToBasisFunctions();
 
-  std::vector<libint2::Engine> engines(nthreads);
-  engines[0] = libint2::Engine(obtype, aobasis.getMaxNprim(),
-                               static_cast<int>(aobasis.getMaxL()), 0);
-  engines[0].set_params(oparams);
-  for (Index i = 1; i < nthreads; ++i) {
-    engines[i] = engines[0];
+  Index ncomponents = 0;
+  for (const OneBodyOperator& op : operators) {
+    ncomponents += op.nopers;
   }
-
-  std::vector<Index> shell2bf = aobasis.getMapToBasisFunctions();
+  std::vector<MatrixLibInt> result(
+      ncomponents,
+      MatrixLibInt::Zero(aobasis.AOBasisSize(), aobasis.AOBasisSize()));
 
 #pragma omp parallel for schedule(dynamic)
   for (Index s1 = 0; s1 < aobasis.getNumofShells(); ++s1) {
     Index thread_id = OPENMP::getThreadId();
-    libint2::Engine& engine = engines[thread_id];
-    const libint2::Engine::target_ptr_vec& buf = engine.results();
-
     Index bf1 = shell2bf[s1];
     Index n1 = shells[s1].size();
 
     for (Index s2 : shellpair_list[s1]) {
-
-      engine.compute(shells[s1], shells[s2]);
-      if (buf[0] == nullptr) {
-        continue;  // if all integrals screened out, skip to next shell set
-      }
       Index bf2 = shell2bf[s2];
       Index n2 = shells[s2].size();
-      for (unsigned int op = 0; op != nopers; ++op) {
-        Eigen::Map<const MatrixLibInt> buf_mat(buf[op], n1, n2);
-        result[op].block(bf1, bf2, n1, n2) = buf_mat;
-        if (s1 != s2) {  // if s1 >= s2, copy {s1,s2} to the corresponding
-                         // {s2,s1} block, note the transpose!
-          result[op].block(bf2, bf1, n2, n1) = buf_mat.transpose();
+      Index component = 0;
+      for (const OneBodyOperator& op : operators) {
+        libint2::Engine& engine = (*op.engines)[thread_id];
+        const libint2::Engine::target_ptr_vec& buf = engine.results();
+        engine.compute(shells[s1], shells[s2]);
+        if (buf[0] == nullptr) {
+          // if all integrals screened out, skip to next operator
+          component += op.nopers;
+          continue;
+        }
+        for (Index i = 0; i < op.nopers; ++i, ++component) {
+          Eigen::Map<const MatrixLibInt> buf_mat(buf[i], n1, n2);
+          result[component].block(bf1, bf2, n1, n2) = buf_mat;
+          if (s1 != s2) {  // if s1 >= s2, copy {s1,s2} to the corresponding
+                           // {s2,s1} block, note the transpose!
+            result[component].block(bf2, bf1, n2, n1) = buf_mat.transpose();
+          }
         }
       }
     }
@@ -137,6 +186,26 @@ std::array<MatrixLibInt, libint2::operator_traits<obtype>::nopers>
   return result;
 }
 
+template <libint2::Operator obtype,
+          typename OperatorParams =
+              typename libint2::operator_traits<obtype>::oper_params_type>
+std::vector<MatrixLibInt> computeOneBodyIntegrals(
+    const AOBasis& aobasis, OperatorParams oparams = OperatorParams()) {
+  // the shell pairs are screened with the overlap engines, computing them
+  // while the overlap engines are held would need a second set
+  aobasis.ShellPairs();
+  EngineSet engines =
+      EnginePool(obtype, aobasis.getMaxNprim(), aobasis.getMaxL());
+  for (libint2::Engine& engine : *engines) {
+    engine.set_params(oparams);
+  }
+  return computeOneBodyIntegrals(
+      aobasis,
+      {OneBodyOperator{
+          engines,
+          static_cast<Index>(libint2::operator_traits<obtype>::nopers)}});
+}
+
 /***********************************
  * KINETIC
  ***********************************/
@@ -187,6 +256,38 @@ Eigen::MatrixXd AOOverlap::singleShellOverlap(const AOShell& shell) const {
   }
 }
 
+Eigen::MatrixXd AOOverlap::CrossOverlap(const AOBasis& bra,
+                                        const AOBasis& ket) const {
+  const std::vector<libint2::Shell>& brashells = bra.LibintBasis();
+  const std::vector<libint2::Shell>& ketshells = ket.LibintBasis();
+  std::vector<Index> bra2bf = bra.getMapToBasisFunctions();
+  std::vector<Index> ket2bf = ket.getMapToBasisFunctions();
+
+  EngineSet engines =
+      EnginePool(libint2::Operator::overlap,
+                 std::max(bra.getMaxNprim(), ket.getMaxNprim()),
+                 std::max(bra.getMaxL(), ket.getMaxL()));
+
+  MatrixLibInt result =
+      MatrixLibInt::Zero(bra.AOBasisSize(), ket.AOBasisSize());
+#pragma omp parallel for schedule(dynamic)
+  for (Index s1 = 0; s1 < bra.getNumofShells(); ++s1) {
+    libint2::Engine& engine = (*engines)[OPENMP::getThreadId()];
+    const libint2::Engine::target_ptr_vec& buf = engine.results();
+    Index n1 = brashells[s1].size();
+    for (Index s2 = 0; s2 < ket.getNumofShells(); ++s2) {
+      engine.compute(brashells[s1], ketshells[s2]);
+      if (buf[0] == nullptr) {
+        continue;
+      }
+      Index n2 = ketshells[s2].size();
+      result.block(bra2bf[s1], ket2bf[s2], n1, n2) =
+          Eigen::Map<const MatrixLibInt>(buf[0], n1, n2);
+    }
+  }
+  return result;
+}
+
 /***********************************
  * DIPOLE
  ***********************************/
@@ -201,6 +302,53 @@ void AODipole::Fill(const AOBasis& aobasis) {
   }
 }
 
+void FillOneBodyMatrices(const AOBasis& aobasis, AOOverlap* overlap,
+                         AOKinetic* kinetic, AODipole* dipole) {
+  // component 0 of the dipole integrals is the overlap, so the overlap only
+  // needs its own engine if no dipoles are requested
+  std::vector<OneBodyOperator> operators;
+  aobasis.ShellPairs();  // before any engines are held, see above
+  Index maxnprim = aobasis.getMaxNprim();
+  Index maxL = aobasis.getMaxL();
+  if (dipole != nullptr) {
+    EngineSet engines =
+        EnginePool(libint2::Operator::emultipole1, maxnprim, maxL);
+    for (libint2::Engine& engine : *engines) {
+      engine.set_params(dipole->r_);
+    }
+    operators.push_back(OneBodyOperator{engines, 4});
+  } else if (overlap != nullptr) {
+    operators.push_back(OneBodyOperator{
+        EnginePool(libint2::Operator::overlap, maxnprim, maxL), 1});
+  }
+  if (kinetic != nullptr) {
+    operators.push_back(OneBodyOperator{
+        EnginePool(libint2::Operator::kinetic, maxnprim, maxL), 1});
+  }
+  if (operators.empty()) {
+    return;
+  }
+  std::vector<MatrixLibInt> results =
+      computeOneBodyIntegrals(aobasis, operators);
+
+  Index component = 0;
+  if (dipole != nullptr) {
+    for (Index i = 0; i < 3; i++) {
+      dipole->aomatrix_[i] = results[1 + i];
+    }
+    if (overlap != nullptr) {
+      overlap->aomatrix_ = results[0];
+    }
+    component = 4;
+  } else if (overlap != nullptr) {
+    overlap->aomatrix_ = results[0];
+    component = 1;
+  }
+  if (kinetic != nullptr) {
+    kinetic->aomatrix_ = results[component];
+  }
+}
+
 /***********************************
  * COULOMB
  ***********************************/
@@ -209,26 +357,19 @@ void AOCoulomb::Fill(const AOBasis& aobasis) {
 }
 
 void AOCoulomb::computeCoulombIntegrals(const AOBasis& aobasis) {
-  Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Shell> shells = aobasis.GenerateLibintBasis();
+  const std::vector<libint2::Shell>& shells = aobasis.LibintBasis();
   std::vector<Index> shell2bf = aobasis.getMapToBasisFunctions();
 
   aomatrix_ =
       Eigen::MatrixXd::Zero(aobasis.AOBasisSize(), aobasis.AOBasisSize());
 
-  // build engines for each thread
-  std::vector<libint2::Engine> engines(nthreads);
-  engines[0] =
-      libint2::Engine(libint2::Operator::coulomb, aobasis.getMaxNprim(),
-                      static_cast<int>(aobasis.getMaxL()), 0);
-  engines[0].set(libint2::BraKet::xs_xs);
-  for (Index i = 1; i != nthreads; ++i) {
-    engines[i] = engines[0];
-  }
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xs_xs,
+                 aobasis.getMaxNprim(), aobasis.getMaxL());
 
 #pragma omp parallel for schedule(dynamic)
   for (Index s1 = 0; s1 < aobasis.getNumofShells(); ++s1) {
-    libint2::Engine& engine = engines[OPENMP::getThreadId()];
+    libint2::Engine& engine = (*engines)[OPENMP::getThreadId()];
     const libint2::Engine::target_ptr_vec& buf = engine.results();
 
     Index bf1 = shell2bf[s1];
@@ -262,22 +403,17 @@ Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
   Index noshells = basis.getNumofShells();
 
   Eigen::MatrixXd result = Eigen::MatrixXd::Zero(noshells, noshells);
-  Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Engine> engines(nthreads);
   double epsilon = 0.0;
-  engines[0] = libint2::Engine(libint2::Operator::coulomb, basis.getMaxNprim(),
-                               static_cast<int>(basis.getMaxL()), 0, epsilon);
-
-  for (Index i = 1; i < nthreads; ++i) {
-    engines[i] = engines[0];
-  }
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xx_xx,
+                 basis.getMaxNprim(), basis.getMaxL(), epsilon);
 
-  std::vector<libint2::Shell> shells = basis.GenerateLibintBasis();
+  const std::vector<libint2::Shell>& shells = basis.LibintBasis();
 
 #pragma omp parallel for schedule(dynamic)
   for (Index s1 = 0l; s1 < basis.getNumofShells(); ++s1) {
     Index thread_id = OPENMP::getThreadId();
-    libint2::Engine& engine = engines[thread_id];
+    libint2::Engine& engine = (*engines)[thread_id];
     const libint2::Engine::target_ptr_vec& buf = engine.results();
     Index n1 = shells[s1].size();
 
@@ -285,7 +421,7 @@ Eigen::MatrixXd ERIs::ComputeSchwarzShells(const AOBasis& basis) const {
       Index n2 = shells[s2].size();
       Index n12 = n1 * n2;
 
-      engines[thread_id]
+      (*engines)[thread_id]
           .compute2<libint2::Operator::coulomb, libint2::BraKet::xx_xx, 0>(
               shells[s1], shells[s2], shells[s1], shells[s2]);
 
@@ -302,8 +438,6 @@ std::array<Eigen::MatrixXd, 2> ERIs::Compute4c(const Eigen::MatrixXd& dmat,
                                                double error) const {
   assert(schwarzscreen_.rows() > 0 && schwarzscreen_.cols() > 0 &&
          "Please call Initialize_4c before running this");
-  Index nthreads = OPENMP::getMaxThreads();
-
   Eigen::MatrixXd hartree = Eigen::MatrixXd::Zero(dmat.rows(), dmat.cols());
   Eigen::MatrixXd exchange;
   if (with_exchange) {
@@ -317,23 +451,18 @@ std::array<Eigen::MatrixXd, 2> ERIs::Compute4c(const Eigen::MatrixXd& dmat,
   double engine_precision = std::min(fock_precision / dnorm_block.maxCoeff(),
                                      std::numeric_limits<double>::epsilon()) /
                             double(max_nprim4);
-  std::vector<libint2::Engine> engines(nthreads);
-  engines[0] = libint2::Engine(libint2::Operator::coulomb, int(maxnprim_),
-                               int(maxL_), 0);
-  engines[0].set_precision(engine_precision);  // shellset-dependent precision
-                                               // control will likely break
-                                               // positive definiteness
-                                               // stick with this simple recipe
-  for (Index i = 1; i < nthreads; ++i) {
-    engines[i] = engines[0];
-  }
+  // shellset-dependent precision control will likely break positive
+  // definiteness, stick with this simple recipe
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xx_xx, maxnprim_,
+                 maxL_, engine_precision);
   Index nshells = basis_.size();
 
 #pragma omp parallel for schedule(dynamic) reduction(+ : hartree) \
     reduction(+ : exchange)
   for (Index s1 = 0; s1 < nshells; ++s1) {
     Index thread_id = OPENMP::getThreadId();
-    libint2::Engine& engine = engines[thread_id];
+    libint2::Engine& engine = (*engines)[thread_id];
     const auto& buf = engine.results();
     Index start_1 = starts_[s1];
     const libint2::Shell& shell1 = basis_[s1];
@@ -449,18 +578,12 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
     matrix_[i] = Symmetric_Matrix(dftbasis.AOBasisSize());
   }
 
-  Index nthreads = OPENMP::getMaxThreads();
-  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
-  std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
-  std::vector<libint2::Engine> engines(nthreads);
-  engines[0] = libint2::Engine(
-      libint2::Operator::coulomb,
-      std::max(dftbasis.getMaxNprim(), auxbasis.getMaxNprim()),
-      static_cast<int>(std::max(dftbasis.getMaxL(), auxbasis.getMaxL())), 0);
-  engines[0].set(libint2::BraKet::xs_xx);
-  for (Index i = 1; i < nthreads; ++i) {
-    engines[i] = engines[0];
-  }
+  const std::vector<libint2::Shell>& dftshells = dftbasis.LibintBasis();
+  const std::vector<libint2::Shell>& auxshells = auxbasis.LibintBasis();
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xs_xx,
+                 std::max(dftbasis.getMaxNprim(), auxbasis.getMaxNprim()),
+                 std::max(dftbasis.getMaxL(), auxbasis.getMaxL()));
 
   std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
   std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
@@ -468,7 +591,7 @@ void TCMatrix_dft::Fill(const AOBasis& auxbasis, const AOBasis& dftbasis) {
 #pragma omp parallel for schedule(dynamic)
   for (Index is = dftbasis.getNumofShells() - 1; is >= 0; is--) {
 
-    libint2::Engine& engine = engines[OPENMP::getThreadId()];
+    libint2::Engine& engine = (*engines)[OPENMP::getThreadId()];
     const libint2::Engine::target_ptr_vec& buf = engine.results();
     const libint2::Shell& dftshell = dftshells[is];
     Index start = shell2bf[is];
@@ -535,7 +658,7 @@ std::vector<Eigen::MatrixXd> ComputeAO3cBlock(const libint2::Shell& auxshell,
       auxshell.size(),
       Eigen::MatrixXd::Zero(dftbasis.AOBasisSize(), dftbasis.AOBasisSize()));
 
-  std::vector<libint2::Shell> dftshells = dftbasis.GenerateLibintBasis();
+  const std::vector<libint2::Shell>& dftshells = dftbasis.LibintBasis();
   std::vector<Index> shell2bf = dftbasis.getMapToBasisFunctions();
 
   const libint2::Engine::target_ptr_vec& buf = engine.results();
@@ -588,18 +711,11 @@ void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
 
   OpenMP_CUDA transform;
   transform.setOperators(dftn, dftm);
-  Index nthreads = OPENMP::getMaxThreads();
-
-  std::vector<libint2::Shell> auxshells = auxbasis.GenerateLibintBasis();
-  std::vector<libint2::Engine> engines(nthreads);
-  engines[0] = libint2::Engine(
-      libint2::Operator::coulomb,
-      std::max(dftbasis.getMaxNprim(), auxbasis.getMaxNprim()),
-      static_cast<int>(std::max(dftbasis.getMaxL(), auxbasis.getMaxL())), 0);
-  engines[0].set(libint2::BraKet::xs_xx);
-  for (Index i = 1; i < nthreads; ++i) {
-    engines[i] = engines[0];
-  }
+  const std::vector<libint2::Shell>& auxshells = auxbasis.LibintBasis();
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xs_xx,
+                 std::max(dftbasis.getMaxNprim(), auxbasis.getMaxNprim()),
+                 std::max(dftbasis.getMaxL(), auxbasis.getMaxL()));
   std::vector<Index> auxshell2bf = auxbasis.getMapToBasisFunctions();
 
 #pragma omp parallel
@@ -610,7 +726,7 @@ void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
       const libint2::Shell& auxshell = auxshells[aux];
 
       std::vector<Eigen::MatrixXd> ao3c =
-          ComputeAO3cBlock(auxshell, dftbasis, engines[threadid]);
+          ComputeAO3cBlock(auxshell, dftbasis, (*engines)[threadid]);
 
       // this is basically a transpose of AO3c and at the same time the ao->mo
       // transformation
@@ -637,5 +753,121 @@ void TCMatrix_gwbse::Fill3cMO(const AOBasis& auxbasis, const AOBasis& dftbasis,
   }
 }
 
+/***********************************
+ * RI POTENTIAL
+ ***********************************/
+Eigen::VectorXd RIPotential::ContractThreeCenter(
+    const Eigen::MatrixXd& dmat) const {
+  // (P|mu nu) is symmetric in mu nu, so only the symmetric part of dmat
+  // contributes, the off diagonal shell pairs are counted twice
+  const Eigen::MatrixXd dsym = 0.5 * (dmat + dmat.transpose());
+  const std::vector<libint2::Shell>& dftshells = dftbasis_.LibintBasis();
+  const std::vector<libint2::Shell>& auxshells = auxbasis_.LibintBasis();
+  const std::vector<std::vector<Index>>& shellpairs = dftbasis_.ShellPairs();
+  EngineSet engines =
+      EnginePool(libint2::Operator::coulomb, libint2::BraKet::xs_xx,
+                 std::max(dftbasis_.getMaxNprim(), auxbasis_.getMaxNprim()),
+                 std::max(dftbasis_.getMaxL(), auxbasis_.getMaxL()));
+  std::vector<Index> shell2bf = dftbasis_.getMapToBasisFunctions();
+  std::vector<Index> auxshell2bf = auxbasis_.getMapToBasisFunctions();
+
+  Eigen::VectorXd result = Eigen::VectorXd::Zero(auxbasis_.AOBasisSize());
+#pragma omp parallel for schedule(dynamic)
+  for (Index aux = 0; aux < auxbasis_.getNumofShells(); aux++) {
+    libint2::Engine& engine = (*engines)[OPENMP::getThreadId()];
+    const libint2::Engine::target_ptr_vec& buf = engine.results();
+    const libint2::Shell& auxshell = auxshells[aux];
+    Index naux = Index(auxshell.size());
+    Eigen::VectorXd contracted = Eigen::VectorXd::Zero(naux);
+
+    for (Index s1 = 0; s1 < dftbasis_.getNumofShells(); s1++) {
+      const libint2::Shell& shell1 = dftshells[s1];
+      Index start1 = shell2bf[s1];
+      Index n1 = Index(shell1.size());
+      for (Index s2 : shellpairs[s1]) {
+        const libint2::Shell& shell2 = dftshells[s2];
+        Index start2 = shell2bf[s2];
+        Index n2 = Index(shell2.size());
+        engine.compute2<libint2::Operator::coulomb, libint2::BraKet::xs_xx, 0>(
+            auxshell, libint2::Shell::unit(), shell1, shell2);
+        if (buf[0] == nullptr) {
+          continue;
+        }
+        double degeneracy = (s1 == s2) ? 1.0 : 2.0;
+        Eigen::Map<const MatrixLibInt> result_mat(buf[0], naux, n1 * n2);
+        // row major (n1,n2) block of dsym flattened like the integrals
+        MatrixLibInt dblock = dsym.block(start1, start2, n1, n2);
+        contracted += degeneracy * result_mat *
+                      Eigen::Map<const Eigen::VectorXd>(dblock.data(), n1 * n2);
+      }
+    }
+    result.segment(auxshell2bf[aux], naux) = contracted;
+  }
+  return result;
+}
+
+Eigen::VectorXd RIPotential::AuxiliaryPotential(
+    const std::vector<Eigen::Vector3d>& positions,
+    const std::vector<Index>& indices) const {
+  const std::vector<libint2::Shell>& auxshells = auxbasis_.LibintBasis();
+  std::vector<Index> auxshell2bf = auxbasis_.getMapToBasisFunctions();
+  EngineSet engines = EnginePool(
+      libint2::Operator::nuclear, auxbasis_.getMaxNprim(), auxbasis_.getMaxL());
+
+  Eigen::VectorXd result = Eigen::VectorXd::Zero(Index(indices.size()));
+#pragma omp parallel for schedule(dynamic, 32)
+  for (Index i = 0; i < Index(indices.size()); i++) {
+    libint2::Engine& engine = (*engines)[OPENMP::getThreadId()];
+    const libint2::Engine::target_ptr_vec& buf = engine.results();
+    const Eigen::Vector3d& pos = positions[indices[i]];
+    // a unit point charge at pos, libint returns -(P|1/|r-pos||1)
+    engine.set_params(
+        std::vector<std::pair<double, std::array<double, 3>>>{
+            {1.0, {pos.x(), pos.y(), pos.z()}}});
+    double potential = 0.0;
+    for (Index aux = 0; aux < Index(auxshells.size()); aux++) {
+      engine.compute(auxshells[aux], libint2::Shell::unit());
+      if (buf[0] == nullptr) {
+        continue;
+      }
+      Index naux = Index(auxshells[aux].size());
+      potential += Eigen::Map<const Eigen::VectorXd>(buf[0], naux)
+                       .dot(coefficients_.segment(auxshell2bf[aux], naux));
+    }
+    result(i) = potential;
+  }
+  return result;
+}
+
+std::array<Eigen::VectorXd, 10> RIPotential::AuxiliaryMoments() const {
+  const std::vector<libint2::Shell>& auxshells = auxbasis_.LibintBasis();
+  std::vector<Index> auxshell2bf = auxbasis_.getMapToBasisFunctions();
+  libint2::Engine engine(libint2::Operator::emultipole2,
+                         auxbasis_.getMaxNprim(),
+                         static_cast<int>(auxbasis_.getMaxL()), 0);
+  engine.set_params(
+      std::array<libint2::Shell::real_t, 3>{center_.x(), center_.y(),
+                                            center_.z()});
+  const libint2::Engine::target_ptr_vec& buf = engine.results();
+
+  std::array<Eigen::VectorXd, 10> moments;
+  for (Eigen::VectorXd& moment : moments) {
+    moment = Eigen::VectorXd::Zero(auxbasis_.AOBasisSize());
+  }
+  for (Index aux = 0; aux < Index(auxshells.size()); aux++) {
+    engine.compute(auxshells[aux], libint2::Shell::unit());
+    if (buf[0] == nullptr) {
+      continue;
+    }
+    Index naux = Index(auxshells[aux].size());
+    // emultipole2 returns: overlap, x, y, z, xx, xy, xz, yy, yz, zz
+    for (Index op = 0; op < 10; op++) {
+      moments[op].segment(auxshell2bf[aux], naux) =
+          Eigen::Map<const Eigen::VectorXd>(buf[op], naux);
+    }
+  }
+  return moments;
+}
+
 }  // namespace xtp
 }  // namespace votca
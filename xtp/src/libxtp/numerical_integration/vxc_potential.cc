@@ -24,6 +24,7 @@
 #include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
+#include "votca/xtp/threadreduction.h"
 #include "votca/xtp/vxc_functionals.h"
 #include "votca/xtp/vxc_grid.h"
 #include "votca/xtp/vxc_potential.h"
@@ -161,9 +162,10 @@ Mat_p_Energy Vxc_Potential<Grid>::IntegrateVXC(
 
   assert(density_matrix.isApprox(density_matrix.transpose()) &&
          "Density matrix has to be symmetric!");
-  Mat_p_Energy vxc = Mat_p_Energy(density_matrix.rows(), density_matrix.cols());
+  TiledAccumulator vxc(density_matrix.rows(), density_matrix.cols());
+  double EXC = 0.0;
 
-#pragma omp parallel for schedule(guided) reduction(+ : vxc)
+#pragma omp parallel for schedule(guided) reduction(+ : EXC)
   for (Index i = 0; i < grid_.getBoxesSize(); ++i) {
     const GridBox& box = grid_[i];
     if (!box.Matrixsize()) {
@@ -201,11 +203,11 @@ Mat_p_Energy Vxc_Potential<Grid>::IntegrateVXC(
           weight * (0.5 * xc.df_drho * ao.values + 2.0 * xc.df_dsigma * grad);
       Vxc_here.noalias() += temp * ao.values.transpose();
     }
-    box.AddtoBigMatrix(vxc.matrix(), Vxc_here);
-    vxc.energy() += EXC_box;
+    box.AddtoBigMatrix(vxc, Vxc_here);
+    EXC += EXC_box;
   }
 
-  return Mat_p_Energy(vxc.energy(), vxc.matrix() + vxc.matrix().transpose());
+  return Mat_p_Energy(EXC, vxc.Matrix() + vxc.Matrix().transpose());
 }
 
 template class Vxc_Potential<Vxc_Grid>;
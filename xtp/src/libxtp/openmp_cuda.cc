@@ -19,6 +19,7 @@
 
 // Local VOTCA includes
 #include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/threadreduction.h"
 
 namespace votca {
 namespace xtp {
@@ -486,9 +487,9 @@ Eigen::MatrixXd OpenMP_CUDA::getReductionVar() {
     cpus_[i].reduce() = *(gpu.temp.back());
   }
 #endif
-  for (Index i = 1; i < Index(cpus_.size()); i++) {
-    cpus_[0].reduce() += cpus_[i].reduce();
-  }
+  TreeReduce(Index(cpus_.size()), [&](Index i, Index j) {
+    cpus_[i].reduce() += cpus_[j].reduce();
+  });
   return cpus_[0].reduce();
 }
 
@@ -48,14 +48,14 @@ std::vector<Index> Orbitals::CheckDegeneracy(Index level,
                                              double energy_difference) const {
 
   std::vector<Index> result;
-  if (level > mos_.eigenvalues().size()) {
+  if (level > mos_->eigenvalues().size()) {
     throw std::runtime_error(
         "Level for degeneracy is higher than maximum level");
   }
-  double MOEnergyLevel = mos_.eigenvalues()(level);
+  double MOEnergyLevel = mos_->eigenvalues()(level);
 
-  for (Index i = 0; i < mos_.eigenvalues().size(); ++i) {
-    if (std::abs(mos_.eigenvalues()(i) - MOEnergyLevel) < energy_difference) {
+  for (Index i = 0; i < mos_->eigenvalues().size(); ++i) {
+    if (std::abs(mos_->eigenvalues()(i) - MOEnergyLevel) < energy_difference) {
       result.push_back(i);
     }
   }
@@ -67,7 +67,7 @@ std::vector<Index> Orbitals::CheckDegeneracy(Index level,
 }
 
 std::vector<Index> Orbitals::SortEnergies() {
-  std::vector<Index> index = std::vector<Index>(mos_.eigenvalues().size());
+  std::vector<Index> index = std::vector<Index>(mos_->eigenvalues().size());
   std::iota(index.begin(), index.end(), 0);
   std::stable_sort(index.begin(), index.end(), [this](Index i1, Index i2) {
     return this->MOs().eigenvalues()[i1] < this->MOs().eigenvalues()[i2];
@@ -159,7 +159,7 @@ Eigen::MatrixXd Orbitals::DensityMatrixGroundState() const {
   if (!hasMOs()) {
     throw std::runtime_error("Orbitals file does not contain MO coefficients");
   }
-  Eigen::MatrixXd occstates = mos_.eigenvectors().leftCols(occupied_levels_);
+  Eigen::MatrixXd occstates = mos_->eigenvectors().leftCols(occupied_levels_);
   Eigen::MatrixXd dmatGS = 2.0 * occstates * occstates.transpose();
   return dmatGS;
 }
@@ -173,7 +173,7 @@ Eigen::MatrixXd Orbitals::DensityMatrixKSstate(const QMState& state) const {
     throw std::runtime_error("State:" + state.ToString() +
                              " is not a Kohn Sham state");
   }
-  Eigen::VectorXd KSstate = mos_.eigenvectors().col(state.StateIdx());
+  Eigen::VectorXd KSstate = mos_->eigenvectors().col(state.StateIdx());
   Eigen::MatrixXd dmatKS = KSstate * KSstate.transpose();
   return dmatKS;
 }
@@ -182,8 +182,8 @@ Eigen::MatrixXd Orbitals::CalculateQParticleAORepresentation() const {
   if (!hasQPdiag()) {
     throw std::runtime_error("Orbitals file does not contain QP coefficients");
   }
-  return mos_.eigenvectors().middleCols(qpmin_, qpmax_ - qpmin_ + 1) *
-         QPdiag_.eigenvectors();
+  return mos_->eigenvectors().middleCols(qpmin_, qpmax_ - qpmin_ + 1) *
+         QPdiag_->eigenvectors();
 }
 
 // Determine QuasiParticle Density Matrix
@@ -225,7 +225,7 @@ Eigen::MatrixXd Orbitals::TransitionDensityMatrix(const QMState& state) const {
         "Spin type not known for transition density matrix. Available only for "
         "singlet");
   }
-  const Eigen::MatrixXd& BSECoefs = BSE_singlet_.eigenvectors();
+  const Eigen::MatrixXd& BSECoefs = BSE_singlet_->eigenvectors();
   if (BSECoefs.cols() < state.StateIdx() + 1 || BSECoefs.rows() < 2) {
     throw std::runtime_error("Orbitals object has no information about state:" +
                              state.ToString());
@@ -236,7 +236,8 @@ Eigen::MatrixXd Orbitals::TransitionDensityMatrix(const QMState& state) const {
   // or beta spin electron is excited
 
   /*Trying to implement D_{alpha,beta}=
-   * sqrt2*sum_{i}^{occ}sum_{j}^{virt}{BSEcoef(i,j)*MOcoef(alpha,i)*MOcoef(beta,j)}
+   * sqrt2*sum_{i}^{occ}sum_{j}^{virt}
+   *   {BSEcoef(i,j)*MOcoef(alpha,i)*MOcoef(beta,j)}
    */
   // c stands for conduction band and thus virtual orbitals
   // v stand for valence band and thus occupied orbitals
@@ -244,11 +245,11 @@ Eigen::MatrixXd Orbitals::TransitionDensityMatrix(const QMState& state) const {
   Eigen::VectorXd coeffs = BSECoefs.col(state.StateIdx());
 
   if (!useTDA_) {
-    coeffs += BSE_singlet_.eigenvectors2().col(state.StateIdx());
+    coeffs += BSE_singlet_->eigenvectors2().col(state.StateIdx());
   }
   coeffs *= std::sqrt(2.0);
-  auto occlevels = mos_.eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
-  auto virtlevels = mos_.eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
+  auto occlevels = mos_->eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
+  auto virtlevels = mos_->eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
   Eigen::Map<const Eigen::MatrixXd> mat(coeffs.data(), bse_ctotal_,
                                         bse_vtotal_);
 
@@ -278,8 +279,8 @@ std::array<Eigen::MatrixXd, 2> Orbitals::DensityMatrixExcitedState_R(
   }
 
   const Eigen::MatrixXd& BSECoefs = (state.Type() == QMStateType::Singlet)
-                                        ? BSE_singlet_.eigenvectors()
-                                        : BSE_triplet_.eigenvectors();
+                                        ? BSE_singlet_->eigenvectors()
+                                        : BSE_triplet_->eigenvectors();
   if (BSECoefs.cols() < state.StateIdx() + 1 || BSECoefs.rows() < 2) {
     throw std::runtime_error("Orbitals object has no information about state:" +
                              state.ToString());
@@ -301,12 +302,12 @@ std::array<Eigen::MatrixXd, 2> Orbitals::DensityMatrixExcitedState_R(
   std::array<Eigen::MatrixXd, 2> dmatEX;
   // hole part as matrix products
   Eigen::MatrixXd occlevels =
-      mos_.eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
+      mos_->eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
   dmatEX[0] = occlevels * CalcAuxMat_vv(coeffs) * occlevels.transpose();
 
   // electron part as matrix products
   Eigen::MatrixXd virtlevels =
-      mos_.eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
+      mos_->eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
   dmatEX[1] = virtlevels * CalcAuxMat_cc(coeffs) * virtlevels.transpose();
 
   return dmatEX;
@@ -334,8 +335,8 @@ std::array<Eigen::MatrixXd, 2> Orbitals::DensityMatrixExcitedState_AR(
   }
 
   const Eigen::MatrixXd& BSECoefs_AR = (state.Type() == QMStateType::Singlet)
-                                           ? BSE_singlet_.eigenvectors2()
-                                           : BSE_triplet_.eigenvectors2();
+                                           ? BSE_singlet_->eigenvectors2()
+                                           : BSE_triplet_->eigenvectors2();
   if (BSECoefs_AR.cols() < state.StateIdx() + 1 || BSECoefs_AR.rows() < 2) {
     throw std::runtime_error("Orbitals object has no information about state:" +
                              state.ToString());
@@ -367,11 +368,11 @@ std::array<Eigen::MatrixXd, 2> Orbitals::DensityMatrixExcitedState_AR(
 
   std::array<Eigen::MatrixXd, 2> dmatAR;
   Eigen::MatrixXd virtlevels =
-      mos_.eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
+      mos_->eigenvectors().middleCols(bse_cmin_, bse_ctotal_);
   dmatAR[0] = virtlevels * CalcAuxMat_cc(coeffs) * virtlevels.transpose();
   // electron part as matrix products
   Eigen::MatrixXd occlevels =
-      mos_.eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
+      mos_->eigenvectors().middleCols(bse_vmin_, bse_vtotal_);
   dmatAR[1] = occlevels * CalcAuxMat_vv(coeffs) * occlevels.transpose();
 
   return dmatAR;
@@ -380,13 +381,13 @@ std::array<Eigen::MatrixXd, 2> Orbitals::DensityMatrixExcitedState_AR(
 Eigen::VectorXd Orbitals::Oscillatorstrengths() const {
 
   Index size = Index(transition_dipoles_.size());
-  if (size > BSE_singlet_.eigenvalues().size()) {
-    size = BSE_singlet_.eigenvalues().size();
+  if (size > BSE_singlet_->eigenvalues().size()) {
+    size = BSE_singlet_->eigenvalues().size();
   }
   Eigen::VectorXd oscs = Eigen::VectorXd::Zero(size);
   for (Index i = 0; i < size; ++i) {
     oscs(i) = transition_dipoles_[i].squaredNorm() * 2.0 / 3.0 *
-              (BSE_singlet_.eigenvalues()(i));
+              (BSE_singlet_->eigenvalues()(i));
   }
   return oscs;
 }
@@ -409,33 +410,33 @@ double Orbitals::getExcitedStateEnergy(const QMState& state) const {
   }
 
   if (state.Type() == QMStateType::Singlet) {
-    if (BSE_singlet_.eigenvalues().size() < state.StateIdx() + 1) {
+    if (BSE_singlet_->eigenvalues().size() < state.StateIdx() + 1) {
       throw std::runtime_error("Orbitals::getTotalEnergy You want " +
                                state.ToString() +
                                " which has not been calculated");
     }
-    omega = BSE_singlet_.eigenvalues()[state.StateIdx()];
+    omega = BSE_singlet_->eigenvalues()[state.StateIdx()];
   } else if (state.Type() == QMStateType::Triplet) {
-    if (BSE_triplet_.eigenvalues().size() < state.StateIdx() + 1) {
+    if (BSE_triplet_->eigenvalues().size() < state.StateIdx() + 1) {
       throw std::runtime_error("Orbitals::getTotalEnergy You want " +
                                state.ToString() +
                                " which has not been calculated");
     }
-    omega = BSE_triplet_.eigenvalues()[state.StateIdx()];
+    omega = BSE_triplet_->eigenvalues()[state.StateIdx()];
   } else if (state.Type() == QMStateType::DQPstate) {
-    if (QPdiag_.eigenvalues().size() < state.StateIdx() + 1 - getGWAmin()) {
+    if (QPdiag_->eigenvalues().size() < state.StateIdx() + 1 - getGWAmin()) {
       throw std::runtime_error("Orbitals::getTotalEnergy You want " +
                                state.ToString() +
                                " which has not been calculated");
     }
-    return QPdiag_.eigenvalues()[state.StateIdx() - getGWAmin()];
+    return QPdiag_->eigenvalues()[state.StateIdx() - getGWAmin()];
   } else if (state.Type() == QMStateType::KSstate) {
-    if (mos_.eigenvalues().size() < state.StateIdx() + 1) {
+    if (mos_->eigenvalues().size() < state.StateIdx() + 1) {
       throw std::runtime_error("Orbitals::getTotalEnergy You want " +
                                state.ToString() +
                                " which has not been calculated");
     }
-    return mos_.eigenvalues()[state.StateIdx()];
+    return mos_->eigenvalues()[state.StateIdx()];
   } else if (state.Type() == QMStateType::PQPstate) {
     if (this->QPpert_energies_.rows() < state.StateIdx() + 1 - getGWAmin()) {
       throw std::runtime_error("Orbitals::getTotalEnergy You want " +
@@ -458,7 +459,7 @@ double Orbitals::getExcitedStateEnergy(const QMState& state) const {
 }
 
 std::array<Eigen::MatrixXd, 3> Orbitals::CalcFreeTransition_Dipoles() const {
-  const Eigen::MatrixXd& dft_orbitals = mos_.eigenvectors();
+  const Eigen::MatrixXd& dft_orbitals = mos_->eigenvectors();
   AOBasis basis = getDftBasis();
   // Testing electric dipole AOMatrix
   AODipole dft_dipole;
@@ -478,15 +479,15 @@ std::array<Eigen::MatrixXd, 3> Orbitals::CalcFreeTransition_Dipoles() const {
 void Orbitals::CalcCoupledTransition_Dipoles() {
   std::array<Eigen::MatrixXd, 3> interlevel_dipoles =
       CalcFreeTransition_Dipoles();
-  Index numofstates = BSE_singlet_.eigenvalues().size();
+  Index numofstates = BSE_singlet_->eigenvalues().size();
   transition_dipoles_.resize(0);
   transition_dipoles_.reserve(numofstates);
   const double sqrt2 = std::sqrt(2.0);
   for (Index i_exc = 0; i_exc < numofstates; i_exc++) {
 
-    Eigen::VectorXd coeffs = BSE_singlet_.eigenvectors().col(i_exc);
+    Eigen::VectorXd coeffs = BSE_singlet_->eigenvectors().col(i_exc);
     if (!useTDA_) {
-      coeffs += BSE_singlet_.eigenvectors2().col(i_exc);
+      coeffs += BSE_singlet_->eigenvectors2().col(i_exc);
     }
     Eigen::Map<Eigen::MatrixXd> mat(coeffs.data(), bse_ctotal_, bse_vtotal_);
     Eigen::Vector3d tdipole = Eigen::Vector3d::Zero();
@@ -503,13 +504,13 @@ void Orbitals::CalcCoupledTransition_Dipoles() {
 
 void Orbitals::OrderMOsbyEnergy() {
   std::vector<Index> sort_index = SortEnergies();
-  tools::EigenSystem MO_copy = mos_;
-  Index size = mos_.eigenvalues().size();
+  tools::EigenSystem MO_copy = *mos_;
+  Index size = mos_->eigenvalues().size();
   for (Index i = 0; i < size; ++i) {
-    mos_.eigenvalues()(i) = MO_copy.eigenvalues()(sort_index[i]);
+    mos_->eigenvalues()(i) = MO_copy.eigenvalues()(sort_index[i]);
   }
   for (Index i = 0; i < size; ++i) {
-    mos_.eigenvectors().col(i) = MO_copy.eigenvectors().col(sort_index[i]);
+    mos_->eigenvectors().col(i) = MO_copy.eigenvectors().col(sort_index[i]);
   }
 }
 
@@ -530,7 +531,8 @@ void Orbitals::PrepareDimerGuess(const Orbitals& orbitalsA,
   Index electronsA = orbitalsA.getNumberOfAlphaElectrons();
   Index electronsB = orbitalsB.getNumberOfAlphaElectrons();
 
-  mos_.eigenvectors() = Eigen::MatrixXd::Zero(basisA + basisB, basisA + basisB);
+  mos_->eigenvectors() =
+      Eigen::MatrixXd::Zero(basisA + basisB, basisA + basisB);
 
   // AxB = | A 0 |  //   A = [EA, EB]  //
   //       | 0 B |  //                 //
@@ -549,15 +551,15 @@ void Orbitals::PrepareDimerGuess(const Orbitals& orbitalsA,
   this->setNumberOfOccupiedLevels(electronsA + electronsB);
   this->setNumberOfAlphaElectrons(electronsA + electronsB);
 
-  mos_.eigenvectors().topLeftCorner(basisA, basisA) =
+  mos_->eigenvectors().topLeftCorner(basisA, basisA) =
       orbitalsA.MOs().eigenvectors();
-  mos_.eigenvectors().bottomRightCorner(basisB, basisB) =
+  mos_->eigenvectors().bottomRightCorner(basisB, basisB) =
       orbitalsB.MOs().eigenvectors();
 
-  mos_.eigenvalues().resize(basisA + basisB);
+  mos_->eigenvalues().resize(basisA + basisB);
 
-  mos_.eigenvalues().head(basisA) = orbitalsA.MOs().eigenvalues();
-  mos_.eigenvalues().tail(basisB) = orbitalsB.MOs().eigenvalues();
+  mos_->eigenvalues().head(basisA) = orbitalsA.MOs().eigenvalues();
+  mos_->eigenvalues().tail(basisB) = orbitalsB.MOs().eigenvalues();
 
   OrderMOsbyEnergy();
 
@@ -565,11 +567,14 @@ void Orbitals::PrepareDimerGuess(const Orbitals& orbitalsA,
 }
 
 void Orbitals::WriteToCpt(const std::string& filename) const {
+  // the file may be the one the pending data still has to come from
+  LoadPendingData();
   CheckpointFile cpf(filename, CheckpointAccessLevel::CREATE);
   WriteToCpt(cpf);
 }
 
 void Orbitals::WriteToCpt(CheckpointFile f) const {
+  LoadPendingData();
   CheckpointWriter writer = f.getWriter("/QMdata");
   WriteToCpt(writer);
   WriteBasisSetsToCpt(writer);
@@ -583,18 +588,19 @@ void Orbitals::WriteBasisSetsToCpt(CheckpointWriter w) const {
 }
 
 void Orbitals::WriteToCpt(CheckpointWriter w) const {
+  LoadPendingData();
   w(votca::tools::ToolsVersionStr(), "XTPVersion");
   w(orbitals_version(), "version");
   w(occupied_levels_, "occupied_levels");
   w(number_alpha_electrons_, "number_alpha_electrons");
 
-  w(mos_, "mos");
+  w(*mos_, "mos");
   w(active_electrons_, "active_electrons");
-  w(mos_embedding_, "mos_embedding");
+  w(*mos_embedding_, "mos_embedding");
   w(lmos_, "LMOs");
   w(lmos_energies_, "LMOs_energies");
-  w(inactivedensity_, "inactivedensity");
-  w(expandedMOs_, "TruncMOsFullBasis");
+  w(*inactivedensity_, "inactivedensity");
+  w(*expandedMOs_, "TruncMOsFullBasis");
 
   CheckpointWriter molgroup = w.openChild("qmmolecule");
   atoms_.WriteToCpt(molgroup);
@@ -618,13 +624,13 @@ void Orbitals::WriteToCpt(CheckpointWriter w) const {
   w(rpa_inputenergies_, "RPA_inputenergies");
   w(QPpert_energies_, "QPpert_energies");
 
-  w(QPdiag_, "QPdiag");
+  w(*QPdiag_, "QPdiag");
 
-  w(BSE_singlet_, "BSE_singlet");
+  w(*BSE_singlet_, "BSE_singlet");
 
   w(transition_dipoles_, "transition_dipoles");
 
-  w(BSE_triplet_, "BSE_triplet");
+  w(*BSE_triplet_, "BSE_triplet");
 
   w(use_Hqp_offdiag_, "use_Hqp_offdiag");
 
@@ -635,6 +641,16 @@ void Orbitals::WriteToCpt(CheckpointWriter w) const {
   w(CalcType_, "CalcType");
 }
 
+void Orbitals::LoadPendingData() const {
+  mos_.Load();
+  mos_embedding_.Load();
+  inactivedensity_.Load();
+  expandedMOs_.Load();
+  QPdiag_.Load();
+  BSE_singlet_.Load();
+  BSE_triplet_.Load();
+}
+
 void Orbitals::ReadFromCpt(const std::string& filename) {
   CheckpointFile cpf(filename, CheckpointAccessLevel::READ);
   ReadFromCpt(cpf);
@@ -672,12 +688,13 @@ void Orbitals::ReadFromCpt(CheckpointReader r) {
   }
 
   r(version, "version");
-  r(mos_, "mos");
-  r(mos_embedding_, "mos_embedding");
+  // the large datasets are only read when they are first accessed
+  mos_.setSource(r, "mos");
+  mos_embedding_.setSource(r, "mos_embedding");
   r(active_electrons_, "active_electrons");
-  r(inactivedensity_, "inactivedensity");
+  inactivedensity_.setSource(r, "inactivedensity");
   r(CalcType_, "CalcType");
-  r(expandedMOs_, "TruncMOsFullBasis");
+  expandedMOs_.setSource(r, "TruncMOsFullBasis");
 
   if (version < 3) {
     // clang-format off
@@ -695,7 +712,7 @@ void Orbitals::ReadFromCpt(CheckpointReader r) {
     std::array<Index, 49> multiplier;
     multiplier.fill(1);
     OrbReorder ord(votcaOrder_old, multiplier);
-    ord.reorderOrbitals(mos_.eigenvectors(), this->getDftBasis());
+    ord.reorderOrbitals(mos_->eigenvectors(), this->getDftBasis());
   }
 
   if (version < 5) {  // we need to construct the basissets, NB. can only be
@@ -727,13 +744,13 @@ void Orbitals::ReadFromCpt(CheckpointReader r) {
 
   r(rpa_inputenergies_, "RPA_inputenergies");
   r(QPpert_energies_, "QPpert_energies");
-  r(QPdiag_, "QPdiag");
+  QPdiag_.setSource(r, "QPdiag");
 
-  r(BSE_singlet_, "BSE_singlet");
+  BSE_singlet_.setSource(r, "BSE_singlet");
 
   r(transition_dipoles_, "transition_dipoles");
 
-  r(BSE_triplet_, "BSE_triplet");
+  BSE_triplet_.setSource(r, "BSE_triplet");
 
   r(use_Hqp_offdiag_, "use_Hqp_offdiag");
 
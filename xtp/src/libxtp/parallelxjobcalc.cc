@@ -24,6 +24,9 @@
 #include <boost/format.hpp>
 #include <libint2/initialize.h>
 
+// VOTCA includes
+#include <votca/tools/profiler.h>
+
 // Local VOTCA includes
 #include "votca/xtp/parallelxjobcalc.h"
 
@@ -94,7 +97,15 @@ void ParallelXJobCalc<JobContainer>::JobOperator::Run() {
     if (job == nullptr) {
       break;
     } else {
-      Result res = this->master_.EvalJob(top_, *job, *this);
+      Result res;
+      {
+        tools::ScopedTimer timer("ParallelXJobCalc::EvalJob");
+        res = this->master_.EvalJob(top_, *job, *this);
+      }
+      // the regions of this job end up in its output
+      if (tools::Profiler::isEnabled() && res.hasOutput()) {
+        res.getOutput().add(tools::Profiler::TakeThreadReport());
+      }
       this->master_.progObs_->ReportJobDone(*job, res, *this);
     }
   }
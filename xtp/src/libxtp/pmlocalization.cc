@@ -22,11 +22,25 @@
 
 #include "votca/xtp/pmlocalization.h"
 #include "votca/xtp/aomatrix.h"
+#include "votca/xtp/threadreduction.h"
+#include <algorithm>
 #include <limits>
+#include <tuple>
 
 namespace votca {
 namespace xtp {
 
+namespace {
+Eigen::MatrixXd gather_rows(const Eigen::MatrixXd &W,
+                            const std::vector<Index> &rows) {
+  Eigen::MatrixXd result(Index(rows.size()), W.cols());
+  for (Index i = 0; i < Index(rows.size()); i++) {
+    result.row(i) = W.row(rows[i]);
+  }
+  return result;
+}
+}  // namespace
+
 void PMLocalization::computePML(Orbitals &orbitals) {
 
   if (method_ == "jacobi-sweeps") {
@@ -37,43 +51,55 @@ void PMLocalization::computePML(Orbitals &orbitals) {
     XTP_LOG(Log::error, log_)
         << TimeStamp() << " Using Unitary Optimizer" << std::flush;
     computePML_UT(orbitals);
+  } else if (method_ == "gradient-ascent") {
+    XTP_LOG(Log::error, log_)
+        << TimeStamp() << " Using Gradient Ascent" << std::flush;
+    computePML_GA(orbitals);
+  } else {
+    throw std::runtime_error("Unknown localization method " + method_);
   }
 }
 
 double PMLocalization::cost(const Eigen::MatrixXd &W,
-                            const std::vector<Eigen::MatrixXd> &Sat_all,
-                            const Index nat) const {
+                            const std::vector<AtomPopulation> &Sat_all) const {
 
   double Dinv = 0.0;
   double p = 2.0;  // standard PM
-  for (Index iat = 0; iat < nat; iat++) {
-    Eigen::MatrixXd qw = Sat_all[iat] * W;
-    for (Index i = 0; i < W.cols(); i++) {
-      double Qa = W.col(i).transpose() * qw.col(i);
-      Dinv += std::pow(Qa, p);
-    }
+#pragma omp parallel for schedule(dynamic) reduction(+ : Dinv)
+  for (Index iat = 0; iat < Index(Sat_all.size()); iat++) {
+    const AtomPopulation &atom = Sat_all[iat];
+    Eigen::MatrixXd w = gather_rows(W, atom.orbitals);
+    Eigen::MatrixXd qw = atom.Q * w;
+    Eigen::ArrayXd Qa = w.cwiseProduct(qw).colwise().sum().transpose();
+    Dinv += Qa.pow(p).sum();
   }
   return Dinv;
 }
 
 std::pair<double, Eigen::MatrixXd> PMLocalization::cost_derivative(
-    const Eigen::MatrixXd &W, const std::vector<Eigen::MatrixXd> &Sat_all,
-    const Index nat) const {
-  Eigen::MatrixXd Jderiv = Eigen::MatrixXd::Zero(n_occs_, n_occs_);
+    const Eigen::MatrixXd &W,
+    const std::vector<AtomPopulation> &Sat_all) const {
+  // rows of the derivative belong to the orbitals of an atom, so every
+  // thread sums into its own matrix
+  std::vector<Eigen::MatrixXd> Jderiv(
+      OPENMP::getMaxThreads(), Eigen::MatrixXd::Zero(W.rows(), W.cols()));
   double Dinv = 0.0;
   double p = 2.0;  // standard PM
-  for (Index iat = 0; iat < nat; iat++) {
-    Eigen::MatrixXd qw = Sat_all[iat] * W;
-    for (Index i = 0; i < W.cols(); i++) {
-      double qwp = W.col(i).transpose() * qw.col(i);
-      Dinv += std::pow(qwp, p);
-      double t = p * std::pow(qwp, p - 1);
-      for (Index j = 0; j < W.cols(); j++) {
-        Jderiv(j, i) += t * qw(j, i);
-      }
+#pragma omp parallel for schedule(dynamic) reduction(+ : Dinv)
+  for (Index iat = 0; iat < Index(Sat_all.size()); iat++) {
+    const AtomPopulation &atom = Sat_all[iat];
+    Eigen::MatrixXd w = gather_rows(W, atom.orbitals);
+    Eigen::MatrixXd qw = atom.Q * w;
+    Eigen::ArrayXd qwp = w.cwiseProduct(qw).colwise().sum().transpose();
+    Dinv += qwp.pow(p).sum();
+    Eigen::RowVectorXd t = (p * qwp.pow(p - 1)).matrix().transpose();
+    Eigen::MatrixXd &thread_deriv = Jderiv[OPENMP::getThreadId()];
+    for (Index j = 0; j < Index(atom.orbitals.size()); j++) {
+      thread_deriv.row(atom.orbitals[j]) += qw.row(j).cwiseProduct(t);
     }
   }
-  return {Dinv, Jderiv};
+  TreeReduce(Jderiv);
+  return {Dinv, Jderiv[0]};
 }
 
 Eigen::VectorXd PMLocalization::fit_polynomial(const Eigen::VectorXd &x,
@@ -205,16 +231,9 @@ void PMLocalization::computePML_UT(Orbitals &orbitals) {
   W_ = Eigen::MatrixXd::Identity(n_occs_, n_occs_);
 
   // prepare Mulliken charges
-  // get overlap matrix
-  aobasis_ = orbitals.getDftBasis();
-  AOOverlap overlap;
-  overlap.Fill(aobasis_);
-  overlap_ = overlap.Matrix();
-  numfuncpatom_ = aobasis_.getFuncPerAtom();
-  Index numatoms = Index(numfuncpatom_.size());
-
-  // could be a bit memory expensive
-  std::vector<Eigen::MatrixXd> Sat_all = setup_pop_matrices(occupied_orbitals);
+  setup_overlap(orbitals);
+  std::vector<AtomPopulation> Sat_all =
+      setup_pop_matrices(occupied_orbitals, overlap_ * occupied_orbitals);
   XTP_LOG(Log::info, log_) << TimeStamp() << " Calculated charge matrices"
                            << std::flush;
 
@@ -231,7 +250,7 @@ void PMLocalization::computePML_UT(Orbitals &orbitals) {
     H_old_ = H_;
 
     // calculate cost and its derivative wrt unitary matrix for current W
-    auto [J, Jderiv] = cost_derivative(W_, Sat_all, numatoms);
+    auto [J, Jderiv] = cost_derivative(W_, Sat_all);
     J_ = J;
     XTP_LOG(Log::info, log_)
         << TimeStamp() << " Calculated cost function and its W-derivative"
@@ -286,7 +305,7 @@ void PMLocalization::computePML_UT(Orbitals &orbitals) {
         Eigen::MatrixXd W_rotated = rotate_W(mu(i), W_, Hval, Hvec);
 
         // calculate cost and derivative for this rotated W matrix
-        auto [cost, der] = cost_derivative(W_rotated, Sat_all, numatoms);
+        auto [cost, der] = cost_derivative(W_rotated, Sat_all);
         cost_points(i) = cost;
         derivative_points(i) =
             2.0 *
@@ -312,7 +331,7 @@ void PMLocalization::computePML_UT(Orbitals &orbitals) {
         Eigen::MatrixXd W_new = rotate_W(step, W_, Hval, Hvec);
 
         // has objective function value changed in the right direction?
-        double J_new = cost(W_new, Sat_all, numatoms);
+        double J_new = cost(W_new, Sat_all);
         double delta_J = J_new - J_;
 
         if (delta_J > 0.0) {
@@ -379,32 +398,14 @@ void PMLocalization::computePML_UT(Orbitals &orbitals) {
   // all done, what are the actual LMOS?
   localized_orbitals_ =
       (W_.transpose() * occupied_orbitals.transpose()).transpose();  //?
-  check_orthonormality();
-  // determine the energies of the localized orbitals
-  Eigen::VectorXd energies = calculate_lmo_energies(orbitals);
-
-  // sort the LMOS according to energies
-  auto [LMOS, LMOS_energies] = sort_lmos(energies);
-  // print info
-  for (Index i = 0; i < LMOS_energies.size(); i++) {
-    XTP_LOG(Log::error, log_)
-        << (boost::format(" LMO index = %1$4i Energy = %2$10.5f Hartree ") %
-            (i) % LMOS_energies(i))
-               .str()
-        << std::flush;
-  }
-  orbitals.setLMOs(LMOS);
-  orbitals.setLMOs_energies(LMOS_energies);
+  store_lmos(orbitals);
 }
 
 void PMLocalization::computePML_JS(Orbitals &orbitals) {
   // initialize with occupied CMOs
   localized_orbitals_ = orbitals.MOs().eigenvectors().leftCols(
       orbitals.getNumberOfAlphaElectrons());
-  aobasis_ = orbitals.getDftBasis();
-  AOOverlap overlap;
-  overlap.Fill(aobasis_);
-  overlap_ = overlap.Matrix();
+  setup_overlap(orbitals);
 
   XTP_LOG(Log::error, log_) << std::flush;
   XTP_LOG(Log::error, log_)
@@ -427,17 +428,37 @@ void PMLocalization::computePML_JS(Orbitals &orbitals) {
 
     if (max_penalty < convergence_limit_) break;
 
-    XTP_LOG(Log::info, log_)
-        << "Orbitals to be changed: " << maxrow << " " << maxcol << std::flush;
+    std::vector<std::pair<Index, Index>> pairs = {{maxrow, maxcol}};
+    if (parallel_rotations_) {
+      pairs = select_rotation_pairs();
+    }
+    std::vector<double> angles;
+    for (const auto &[s, t] : pairs) {
+      angles.push_back(rotation_angle(s, t));
+    }
+    if (pairs.size() == 1) {
+      XTP_LOG(Log::info, log_) << "Orbitals to be changed: " << pairs[0].first
+                               << " " << pairs[0].second << std::flush;
+      XTP_LOG(Log::info, log_)
+          << "Sine of the rotation angle = " << std::sin(angles[0])
+          << std::flush;
+    } else {
+      XTP_LOG(Log::info, log_)
+          << "Orbital pairs to be changed: " << pairs.size() << std::flush;
+    }
 
-    Eigen::MatrixX2d max_orbs(localized_orbitals_.rows(), 2);
-    max_orbs << localized_orbitals_.col(maxrow),
-        localized_orbitals_.col(maxcol);
-    Eigen::MatrixX2d rotated_orbs = rotateorbitals(max_orbs, maxrow, maxcol);
-    localized_orbitals_.col(maxrow) = rotated_orbs.col(0);
-    localized_orbitals_.col(maxcol) = rotated_orbs.col(1);
+    // the pairs do not share orbitals, so the rotations are independent
+#pragma omp parallel for
+    for (Index i = 0; i < Index(pairs.size()); i++) {
+      rotateorbitals(pairs[i].first, pairs[i].second, angles[i]);
+    }
+    std::vector<Index> rotated;
+    for (const auto &[s, t] : pairs) {
+      rotated.push_back(s);
+      rotated.push_back(t);
+    }
 
-    update_penalty(maxrow, maxcol);
+    update_penalty(rotated);
 
     iteration++;
   }
@@ -448,6 +469,126 @@ void PMLocalization::computePML_JS(Orbitals &orbitals) {
   XTP_LOG(Log::error, log_) << TimeStamp() << " Orbitals localized after "
                             << iteration + 1 << " iterations" << std::flush;
 
+  store_lmos(orbitals);
+}
+
+void PMLocalization::computePML_GA(Orbitals &orbitals) {
+  // the populations are always set up for the current orbitals, so every
+  // step starts from the identity as unitary matrix
+  localized_orbitals_ = orbitals.MOs().eigenvectors().leftCols(
+      orbitals.getNumberOfAlphaElectrons());
+  n_occs_ = orbitals.getNumberOfAlphaElectrons();
+  setup_overlap(orbitals);
+  s_localized_orbitals_ = overlap_ * localized_orbitals_;
+  const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(n_occs_, n_occs_);
+
+  // sufficient increase for the Armijo condition and the minimal cosine
+  // between search direction and gradient
+  const double armijo = 1e-4;
+  const double min_cosine = 1e-2;
+
+  G_ = Eigen::MatrixXd::Zero(n_occs_, n_occs_);
+  H_ = Eigen::MatrixXd::Zero(n_occs_, n_occs_);
+  J_ = 0.0;
+  double last_step = 0.0;
+
+  Index iteration = 0;
+  for (; iteration < nrOfIterations_; iteration++) {
+    std::vector<AtomPopulation> Sat_all =
+        setup_pop_matrices(localized_orbitals_, s_localized_orbitals_);
+    G_old_ = G_;
+    H_old_ = H_;
+    auto [J, Jderiv] = cost_derivative(identity, Sat_all);
+    J_ = J;
+    G_ = Jderiv - Jderiv.transpose();
+    double G_norm = inner_prod(G_, G_);
+
+    if (G_norm < convergence_limit_) {
+      break;
+    }
+
+    std::string update_type = "SD";
+    H_ = G_;
+    if (iteration % n_occs_ != 0) {
+      double gamma = std::max(
+          0.0, inner_prod(G_ - G_old_, G_) / inner_prod(G_old_, G_old_));
+      Eigen::MatrixXd H_cg = G_ + gamma * H_old_;
+      double cosine = inner_prod(G_, H_cg) /
+                      std::sqrt(G_norm * inner_prod(H_cg, H_cg));
+      if (cosine > min_cosine) {
+        update_type = "CGPR";
+        H_ = H_cg;
+      }
+    }
+
+    // derivative of the cost function along exp(mu*H) at mu=0, it is only
+    // zero if the gradient vanishes
+    double slope = 2.0 * inner_prod(G_, H_);
+    if (slope <= 0.0) {
+      break;
+    }
+    Eigen::EigenSolver<Eigen::MatrixXd> es(H_);
+    Eigen::VectorXcd Hval = es.eigenvalues();
+    Eigen::MatrixXcd Hvec = es.eigenvectors();
+    double wmax = Hval.cwiseAbs().maxCoeff();
+    double Tmu = 2.0 * tools::conv::Pi / (4.0 * wmax);
+
+    // backtracking from twice the last step, trial steps are the maximum of
+    // the parabola through J(0), the slope and J(step) where possible
+    double step = (iteration == 0) ? Tmu : std::min(Tmu, 2.0 * last_step);
+    Eigen::MatrixXd R;
+    double J_new = 0.0;
+    Index backtracks = 0;
+    while (true) {
+      R = rotate_W(step, identity, Hval, Hvec);
+      J_new = cost(R, Sat_all);
+      double curvature = 2.0 * (J_new - J_ - slope * step) / (step * step);
+      double step_q = (curvature < 0.0) ? -slope / curvature : step;
+      if (step_q < step) {
+        Eigen::MatrixXd R_q = rotate_W(step_q, identity, Hval, Hvec);
+        double J_q = cost(R_q, Sat_all);
+        if (J_q > J_new && J_q - J_ >= armijo * step_q * slope) {
+          R = R_q;
+          J_new = J_q;
+          step = step_q;
+          break;
+        }
+      }
+      if (J_new - J_ >= armijo * step * slope) {
+        break;
+      }
+      if (++backtracks > 50) {
+        throw std::runtime_error(
+            "Armijo line search did not find an increasing step");
+      }
+      step = std::clamp(step_q, 0.1 * step, 0.5 * step);
+    }
+    last_step = step;
+    localized_orbitals_ *= R;
+    s_localized_orbitals_ *= R;
+    // the gradient is needed in the basis of the rotated orbitals, H
+    // commutes with R
+    G_ = R.transpose() * G_ * R;
+
+    XTP_LOG(Log::error, log_)
+        << (boost::format(" GA iteration = %1$6i (%6$4.s) Tmu = %4$4.2e mu_opt "
+                          "= %5$1.4f |deltaJ| = %2$4.2e |G| = %3$4.2e") %
+            (iteration) % std::abs(J_new - J_) % G_norm % Tmu % step %
+            update_type)
+               .str()
+        << std::flush;
+  }
+  if (iteration == nrOfIterations_) {
+    throw std::runtime_error(
+        "Localization with gradient ascent did not converge");
+  }
+  XTP_LOG(Log::error, log_) << TimeStamp() << " Orbitals localized after "
+                            << iteration << " iterations" << std::flush;
+
+  store_lmos(orbitals);
+}
+
+void PMLocalization::store_lmos(Orbitals &orbitals) {
   // check if localized orbitals orthonormal, if nor warn
   check_orthonormality();
 
@@ -534,36 +675,100 @@ void PMLocalization::check_orthonormality() {
   return;
 }
 
-// Function to rotate the 2 maximum orbitals (s and t)
-Eigen::MatrixX2d PMLocalization::rotateorbitals(const Eigen::MatrixX2d &maxorbs,
-                                                const Index s, const Index t) {
-  const double gamma =
-      0.25 *
-      asin(B_(s, t) / sqrt((A_(s, t) * A_(s, t)) + (B_(s, t) * B_(s, t))));
-  Eigen::MatrixX2d rotatedorbitals(maxorbs.rows(), 2);
-  rotatedorbitals.col(0) =
-      (std::cos(gamma) * maxorbs.col(0)) + (std::sin(gamma) * maxorbs.col(1));
-  rotatedorbitals.col(1) = -1 * (std::sin(gamma) * maxorbs.col(0)) +
-                           (std::cos(gamma) * maxorbs.col(1));
-  XTP_LOG(Log::info, log_) << "Sine of the rotation angle = " << std::sin(gamma)
-                           << std::flush;
-  return rotatedorbitals;
+double PMLocalization::rotation_angle(Index s, Index t) const {
+  return 0.25 *
+         asin(B_(s, t) / sqrt((A_(s, t) * A_(s, t)) + (B_(s, t) * B_(s, t))));
 }
 
-Eigen::VectorXd PMLocalization::pop_per_atom(const Eigen::VectorXd &orbital) {
+// Function to rotate the 2 orbitals s and t
+void PMLocalization::rotateorbitals(Index s, Index t, double gamma) {
+  const double c = std::cos(gamma);
+  const double sn = std::sin(gamma);
+  for (Eigen::MatrixXd *orbs : {&localized_orbitals_, &s_localized_orbitals_}) {
+    Eigen::VectorXd orb_s = orbs->col(s);
+    orbs->col(s) = c * orb_s + sn * orbs->col(t);
+    orbs->col(t) = -sn * orb_s + c * orbs->col(t);
+  }
+}
 
-  Eigen::RowVectorXd MullikenPop_orb_per_basis =
-      (orbital.asDiagonal() * overlap_ * orbital.asDiagonal()).colwise().sum();
+// greedily picks the pairs with the largest penalty above the convergence
+// limit, so that no orbital appears twice
+std::vector<std::pair<Index, Index>> PMLocalization::select_rotation_pairs()
+    const {
+  std::vector<std::tuple<double, Index, Index>> candidates;
+  for (Index s = 0; s < PM_penalty_.rows(); s++) {
+    for (Index t = s + 1; t < PM_penalty_.cols(); t++) {
+      if (PM_penalty_(s, t) >= convergence_limit_) {
+        candidates.emplace_back(PM_penalty_(s, t), s, t);
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto &a, const auto &b) {
+              return std::get<0>(a) > std::get<0>(b);
+            });
+  std::vector<bool> used(PM_penalty_.rows(), false);
+  std::vector<std::pair<Index, Index>> pairs;
+  for (const auto &[penalty, s, t] : candidates) {
+    if (!used[s] && !used[t]) {
+      pairs.emplace_back(s, t);
+      used[s] = true;
+      used[t] = true;
+    }
+  }
+  return pairs;
+}
+
+void PMLocalization::setup_overlap(const Orbitals &orbitals) {
+  aobasis_ = orbitals.getDftBasis();
+  AOOverlap overlap;
+  overlap.Fill(aobasis_);
+  overlap_ = overlap.Matrix();
+  numfuncpatom_ = aobasis_.getFuncPerAtom();
+  atomstart_.clear();
   Index start = 0;
+  for (Index nfunc : numfuncpatom_) {
+    atomstart_.push_back(start);
+    start += nfunc;
+  }
+}
 
-  Eigen::VectorXd per_atom = Eigen::VectorXd::Zero(Index(numfuncpatom_.size()));
+// |Q_st| on an atom is at most the product of the weights of s and t, so
+// dropping the atoms where the weight is below the threshold neglects at
+// most threshold*weight of t
+bool PMLocalization::has_weight(const Eigen::MatrixXd &orbitals,
+                                const Eigen::MatrixXd &s_orbitals, Index s,
+                                Index atom) const {
+  Index start = atomstart_[atom];
+  Index size = numfuncpatom_[atom];
+  return orbitals.col(s).segment(start, size).norm() > population_threshold_ ||
+         s_orbitals.col(s).segment(start, size).norm() > population_threshold_;
+}
+
+double PMLocalization::pair_pop(const Eigen::MatrixXd &orbitals,
+                                const Eigen::MatrixXd &s_orbitals, Index s,
+                                Index t, Index atom) const {
+  Index start = atomstart_[atom];
+  Index size = numfuncpatom_[atom];
+  return 0.5 * (orbitals.col(s).segment(start, size).dot(
+                    s_orbitals.col(t).segment(start, size)) +
+                orbitals.col(t).segment(start, size).dot(
+                    s_orbitals.col(s).segment(start, size)));
+}
+
+PMLocalization::OrbitalPopulation PMLocalization::pop_per_atom(
+    Index s) const {
+  OrbitalPopulation pop;
   for (Index atom_id = 0; atom_id < Index(numfuncpatom_.size()); atom_id++) {
-    per_atom(atom_id) =
-        MullikenPop_orb_per_basis.segment(start, numfuncpatom_[atom_id]).sum();
-    start += numfuncpatom_[atom_id];
+    if (has_weight(localized_orbitals_, s_localized_orbitals_, s, atom_id)) {
+      double p = pair_pop(localized_orbitals_, s_localized_orbitals_, s, s,
+                          atom_id);
+      pop.atoms.push_back(atom_id);
+      pop.pops.push_back(p);
+      pop.sumsq += p * p;
+    }
   }
-
-  return per_atom;
+  return pop;
 }
 
 // Determine PM cost function based on Mulliken populations
@@ -576,86 +781,48 @@ void PMLocalization::initial_penalty() {
                              localized_orbitals_.cols());
   B_ = A_;
 
-  numfuncpatom_ = aobasis_.getFuncPerAtom();
+  s_localized_orbitals_ = overlap_ * localized_orbitals_;
 
   // get the s-s elements first ("diagonal in orbital")
-  MullikenPop_orb_per_atom_ = Eigen::MatrixXd::Zero(
-      localized_orbitals_.cols(), Index(numfuncpatom_.size()));
+  MullikenPop_orb_per_atom_.resize(localized_orbitals_.cols());
 #pragma omp parallel for
   for (Index s = 0; s < localized_orbitals_.cols(); s++) {
-    MullikenPop_orb_per_atom_.row(s) = pop_per_atom(localized_orbitals_.col(s));
+    MullikenPop_orb_per_atom_[s] = pop_per_atom(s);
   }
 
 // now we only need to calculate the off-diagonals explicitly
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic)
   for (Index s = 0; s < localized_orbitals_.cols(); s++) {
-    Eigen::MatrixXd s_overlap =
-        localized_orbitals_.col(s).asDiagonal() * overlap_;
-
     for (Index t = s + 1; t < localized_orbitals_.cols(); t++) {
-
-      Eigen::Vector2d temp = offdiag_penalty_elements(s_overlap, s, t);
-
-      A_(s, t) = temp(0);
-      B_(s, t) = temp(1);
-      PM_penalty_(s, t) =
-          A_(s, t) + sqrt((A_(s, t) * A_(s, t)) + (B_(s, t) * B_(s, t)));
+      pair_penalty(s, t);
     }
   }
   return;
 }
 
-std::vector<Eigen::MatrixXd> PMLocalization::setup_pop_matrices(
-    const Eigen::MatrixXd &occ_orbitals) {
+std::vector<PMLocalization::AtomPopulation>
+    PMLocalization::setup_pop_matrices(
+        const Eigen::MatrixXd &occ_orbitals,
+        const Eigen::MatrixXd &s_occ_orbitals) const {
 
-  // initialize everything
   Index numatoms = Index(numfuncpatom_.size());
-  Index noccs = occ_orbitals.cols();
-
-  std::vector<Eigen::MatrixXd> Qat;
-  for (Index iat = 0; iat < numatoms; iat++) {
-    Qat.push_back(Eigen::MatrixXd::Zero(noccs, noccs));
-  }
-
-  numfuncpatom_ = aobasis_.getFuncPerAtom();
-
-  // get the s-s elements first ("diagonal in orbital")
-  MullikenPop_orb_per_atom_ =
-      Eigen::MatrixXd::Zero(noccs, Index(numfuncpatom_.size()));
-#pragma omp parallel for
-  for (Index s = 0; s < noccs; s++) {
-    MullikenPop_orb_per_atom_.row(s) = pop_per_atom(occ_orbitals.col(s));
-  }
+  std::vector<AtomPopulation> Qat(numatoms);
 
-  // put this on the diagonals
+#pragma omp parallel for schedule(dynamic)
   for (Index iat = 0; iat < numatoms; iat++) {
-    Qat[iat].diagonal() = MullikenPop_orb_per_atom_.col(iat);
-  }
-
-// now fill the offdiagonals
-#pragma omp parallel for
-  for (Index s = 0; s < noccs; s++) {
-
-    Eigen::MatrixXd s_overlap = occ_orbitals.col(s).asDiagonal() * overlap_;
-
-    for (Index t = s + 1; t < noccs; t++) {
-
-      Eigen::MatrixXd splitwiseMullikenPop_orb_SandT =
-          s_overlap * occ_orbitals.col(t).asDiagonal();
-      Eigen::RowVectorXd MullikenPop_orb_SandT_per_basis =
-          0.5 * (splitwiseMullikenPop_orb_SandT.colwise().sum() +
-                 splitwiseMullikenPop_orb_SandT.rowwise().sum().transpose());
-
-      Index start = 0;
-
-      for (Index atom_id = 0; atom_id < Index(numfuncpatom_.size());
-           atom_id++) {
-        Qat[atom_id](s, t) = MullikenPop_orb_SandT_per_basis
-                                 .segment(start, numfuncpatom_[atom_id])
-                                 .sum();
-        Qat[atom_id](t, s) = Qat[atom_id](s, t);
-
-        start += numfuncpatom_[atom_id];
+    AtomPopulation &atom = Qat[iat];
+    for (Index s = 0; s < occ_orbitals.cols(); s++) {
+      if (has_weight(occ_orbitals, s_occ_orbitals, s, iat)) {
+        atom.orbitals.push_back(s);
+      }
+    }
+    Index size = Index(atom.orbitals.size());
+    atom.Q = Eigen::MatrixXd::Zero(size, size);
+    for (Index i = 0; i < size; i++) {
+      for (Index j = i; j < size; j++) {
+        atom.Q(i, j) = pair_pop(occ_orbitals, s_occ_orbitals, atom.orbitals[i],
+                                atom.orbitals[j], iat);
+        atom.Q(j, i) = atom.Q(i, j);
       }
     }
   }
@@ -663,35 +830,34 @@ std::vector<Eigen::MatrixXd> PMLocalization::setup_pop_matrices(
   return Qat;
 }
 
-Eigen::Vector2d PMLocalization::offdiag_penalty_elements(
-    const Eigen::MatrixXd &s_overlap, Index s, Index t) {
-
-  Eigen::MatrixXd splitwiseMullikenPop_orb_SandT =
-      s_overlap * localized_orbitals_.col(t).asDiagonal();
-  Eigen::RowVectorXd MullikenPop_orb_SandT_per_basis =
-      0.5 * (splitwiseMullikenPop_orb_SandT.colwise().sum() +
-             splitwiseMullikenPop_orb_SandT.rowwise().sum().transpose());
+Eigen::Vector2d PMLocalization::offdiag_penalty_elements(Index s,
+                                                         Index t) const {
+  const OrbitalPopulation &pop_s = MullikenPop_orb_per_atom_[s];
+  const OrbitalPopulation &pop_t = MullikenPop_orb_per_atom_[t];
 
-  Index start =
-      0;  // This helps to sum only over the basis functions on an atom
-  double Ast = 0;
+  // sum over atoms of Q_st^2 - 0.25 (Q_ss - Q_tt)^2 and Q_st (Q_ss - Q_tt),
+  // only atoms on which both orbitals have weight contribute more than the
+  // squares of the diagonal populations
+  double Ast = -0.25 * (pop_s.sumsq + pop_t.sumsq);
   double Bst = 0;
 
-  for (Index atom_id = 0; atom_id < Index(numfuncpatom_.size()); atom_id++) {
-    double MullikenPop_orb_SandT_per_atom =
-        MullikenPop_orb_SandT_per_basis.segment(start, numfuncpatom_[atom_id])
-            .sum();
-
-    Ast += MullikenPop_orb_SandT_per_atom * MullikenPop_orb_SandT_per_atom -
-           0.25 * ((MullikenPop_orb_per_atom_(s, atom_id) -
-                    MullikenPop_orb_per_atom_(t, atom_id)) *
-                   (MullikenPop_orb_per_atom_(s, atom_id) -
-                    MullikenPop_orb_per_atom_(t, atom_id)));
-
-    Bst += MullikenPop_orb_SandT_per_atom *
-           (MullikenPop_orb_per_atom_(s, atom_id) -
-            MullikenPop_orb_per_atom_(t, atom_id));
-    start += numfuncpatom_[atom_id];
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < pop_s.atoms.size() && j < pop_t.atoms.size()) {
+    if (pop_s.atoms[i] < pop_t.atoms[j]) {
+      i++;
+    } else if (pop_t.atoms[j] < pop_s.atoms[i]) {
+      j++;
+    } else {
+      double MullikenPop_orb_SandT_per_atom =
+          pair_pop(localized_orbitals_, s_localized_orbitals_, s, t,
+                   pop_s.atoms[i]);
+      Ast += MullikenPop_orb_SandT_per_atom * MullikenPop_orb_SandT_per_atom +
+             0.5 * pop_s.pops[i] * pop_t.pops[j];
+      Bst += MullikenPop_orb_SandT_per_atom * (pop_s.pops[i] - pop_t.pops[j]);
+      i++;
+      j++;
+    }
   }
 
   Eigen::Vector2d out(Ast, Bst);
@@ -699,36 +865,35 @@ Eigen::Vector2d PMLocalization::offdiag_penalty_elements(
   return out;
 }
 
+void PMLocalization::pair_penalty(Index s, Index t) {
+  Eigen::Vector2d temp = offdiag_penalty_elements(s, t);
+  A_(s, t) = temp(0);
+  B_(s, t) = temp(1);
+  PM_penalty_(s, t) =
+      A_(s, t) + sqrt((A_(s, t) * A_(s, t)) + (B_(s, t) * B_(s, t)));
+}
+
 // Update PM cost function based on Mulliken populations after rotations
-void PMLocalization::update_penalty(Index orb1, Index orb2) {
+void PMLocalization::update_penalty(const std::vector<Index> &rotated) {
 
-  // update the get the s-s elements for orb1 and orb2
-#pragma omp parallel for
-  for (Index s = 0; s < localized_orbitals_.cols(); s++) {
-    if (s == orb1 || s == orb2) {
+  std::vector<bool> changed(localized_orbitals_.cols(), false);
+  for (Index s : rotated) {
+    changed[s] = true;
+  }
 
-      MullikenPop_orb_per_atom_.row(s) =
-          pop_per_atom(localized_orbitals_.col(s));
-    }
+  // update the s-s elements of the rotated orbitals
+#pragma omp parallel for
+  for (Index i = 0; i < Index(rotated.size()); i++) {
+    MullikenPop_orb_per_atom_[rotated[i]] = pop_per_atom(rotated[i]);
   }
 
 // now we only need to calculate the off-diagonals explicitly for all
-// pairs involving orb1 or orb2
-#pragma omp parallel for
+// pairs involving a rotated orbital
+#pragma omp parallel for schedule(dynamic)
   for (Index s = 0; s < localized_orbitals_.cols(); s++) {
-    Eigen::MatrixXd s_overlap =
-        localized_orbitals_.col(s).asDiagonal() * overlap_;
-
     for (Index t = s + 1; t < localized_orbitals_.cols(); t++) {
-
-      // we do this only if any of s or t matches orb1 or orb2
-      if (s == orb1 || s == orb2 || t == orb1 || t == orb2) {
-
-        Eigen::Vector2d temp = offdiag_penalty_elements(s_overlap, s, t);
-        A_(s, t) = temp(0);
-        B_(s, t) = temp(1);
-        PM_penalty_(s, t) =
-            A_(s, t) + sqrt((A_(s, t) * A_(s, t)) + (B_(s, t) * B_(s, t)));
+      if (changed[s] || changed[t]) {
+        pair_penalty(s, t);
       }
     }
   }
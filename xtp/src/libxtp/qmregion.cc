@@ -374,6 +374,8 @@ void QMRegion::WriteToCpt(CheckpointWriter& w) const {
   w(do_gwbse_, "GWBSE");
   w(initstate_.ToString(), "initial_state");
   w(grid_accuracy_for_ext_interaction_, "ext_grid");
+  // the file written to may be the one pending data would be read from
+  orb_.LoadPendingData();
   CheckpointWriter v = w.openChild("QMdata");
   orb_.WriteToCpt(v);
   orb_.WriteBasisSetsToCpt(v);
@@ -400,6 +402,9 @@ void QMRegion::ReadFromCpt(CheckpointReader& r) {
   CheckpointReader rr = r.openChild("QMdata");
   orb_.ReadFromCpt(rr);
   orb_.ReadBasisSetsFromCpt(rr);
+  // the job topology rewrites the file it was read from, the orbitals must
+  // not keep it open
+  orb_.LoadPendingData();
 
   CheckpointReader rr2 = r.openChild("E-hist");
   E_hist_.ReadFromCpt(rr2);
@@ -36,14 +36,18 @@ std::ostream& operator<<(std::ostream& out, const Rate_Engine& rate_engine) {
   return out;
 }
 
-Rate_Engine::PairRates Rate_Engine::Rate(const QMPair& pair,
-                                         QMStateType carriertype) const {
-  double charge = 0.0;
+double Rate_Engine::Charge(QMStateType carriertype) const {
   if (carriertype == QMStateType::Electron) {
-    charge = -1.0;
+    return -1.0;
   } else if (carriertype == QMStateType::Hole) {
-    charge = 1.0;
+    return 1.0;
   }
+  return 0.0;
+}
+
+Rate_Engine::PairRates Rate_Engine::Rate(const QMPair& pair,
+                                         QMStateType carriertype) const {
+  double charge = Charge(carriertype);
 
   double reorg12 = pair.getReorg12(carriertype) + pair.getLambdaO(carriertype);
   double reorg21 = pair.getReorg21(carriertype) - pair.getLambdaO(carriertype);
@@ -71,6 +75,29 @@ Rate_Engine::PairRates Rate_Engine::Rate(const QMPair& pair,
   return result;
 }
 
+Eigen::VectorXd Rate_Engine::Rates(
+    const Eigen::Ref<const Eigen::VectorXd>& jeff2,
+    const Eigen::Ref<const Eigen::VectorXd>& dG_site,
+    const Eigen::Ref<const Eigen::VectorXd>& reorg,
+    const Eigen::Ref<const Eigen::Matrix3Xd>& dr,
+    QMStateType carriertype) const {
+  if (ratetype_ != "marcus") {
+    throw std::runtime_error("Only marcus rates implemented.");
+  }
+  double charge = Charge(carriertype);
+  Eigen::ArrayXd dG = dG_site.array();
+  if (charge != 0.0) {
+    dG += charge * (dr.transpose() * field_).array();
+  }
+  // same as Marcusrate, but for all events at once
+  double hbar = tools::conv::hbar * tools::conv::ev2hrt;
+  Eigen::ArrayXd four_reorg_T = 4 * reorg.array() * temperature_;
+  Eigen::ArrayXd rates = 2 * tools::conv::Pi / hbar * jeff2.array() /
+                         (tools::conv::Pi * four_reorg_T).sqrt() *
+                         (-(dG - reorg.array()).square() / four_reorg_T).exp();
+  return rates.matrix();
+}
+
 double Rate_Engine::Marcusrate(double Jeff2, double deltaG,
                                double reorg) const {
 
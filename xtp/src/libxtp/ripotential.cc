@@ -0,0 +1,95 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <cmath>
+
+// Local VOTCA includes
+#include "votca/xtp/aomatrix.h"
+#include "votca/xtp/ripotential.h"
+
+namespace votca {
+namespace xtp {
+
+void RIPotential::FitDensity(const Eigen::MatrixXd& dmat) {
+  AOCoulomb auxcoulomb;
+  auxcoulomb.Fill(auxbasis_);
+  Eigen::MatrixXd inv_sqrt = auxcoulomb.Pseudo_InvSqrt(1e-8);
+  coefficients_ = inv_sqrt * (inv_sqrt * ContractThreeCenter(dmat));
+
+  // the fitted density lives where the auxiliary functions are, a shell
+  // reaches as far as its most diffuse gaussian is above 1e-10
+  center_ = Eigen::Vector3d::Zero();
+  for (const AOShell& shell : auxbasis_) {
+    center_ += shell.getPos();
+  }
+  center_ /= double(auxbasis_.getNumofShells());
+  extent_ = 0.0;
+  for (const AOShell& shell : auxbasis_) {
+    double reach = std::sqrt(-std::log(1e-10) / shell.getMinDecay());
+    extent_ = std::max(extent_, (shell.getPos() - center_).norm() + reach);
+  }
+
+  std::array<Eigen::VectorXd, 10> auxmoments = AuxiliaryMoments();
+  for (Index i = 0; i < 10; i++) {
+    moments_[i] = auxmoments[i].dot(coefficients_);
+  }
+}
+
+double RIPotential::FarfieldPotential(const Eigen::Vector3d& position) const {
+  const Eigen::Vector3d R = position - center_;
+  const double invR2 = 1.0 / R.squaredNorm();
+  const double invR = std::sqrt(invR2);
+  const Eigen::Vector3d dipole(moments_[1], moments_[2], moments_[3]);
+  Eigen::Matrix3d secondmoment;
+  secondmoment << moments_[4], moments_[5], moments_[6], moments_[5],
+      moments_[7], moments_[8], moments_[6], moments_[8], moments_[9];
+  secondmoment -= secondmoment.trace() / 3.0 * Eigen::Matrix3d::Identity();
+  double potential = moments_[0] * invR + dipole.dot(R) * invR * invR2 +
+                     1.5 * R.dot(secondmoment * R) * invR * invR2 * invR2;
+  // the density is made of electrons
+  return -potential;
+}
+
+Eigen::VectorXd RIPotential::Potential(
+    const std::vector<Eigen::Vector3d>& positions) const {
+  if (coefficients_.size() == 0) {
+    throw std::runtime_error("RIPotential: call FitDensity first");
+  }
+  Eigen::VectorXd result = Eigen::VectorXd::Zero(Index(positions.size()));
+  std::vector<Index> nearpoints;
+  nearpoints.reserve(positions.size());
+  for (Index i = 0; i < Index(positions.size()); i++) {
+    double distance = (positions[i] - center_).norm();
+    if (farfield_tolerance_ > 0.0 &&
+        std::pow(extent_ / distance, 3) < farfield_tolerance_) {
+      result(i) = FarfieldPotential(positions[i]);
+    } else {
+      nearpoints.push_back(i);
+    }
+  }
+  Eigen::VectorXd near = AuxiliaryPotential(positions, nearpoints);
+  for (Index i = 0; i < Index(nearpoints.size()); i++) {
+    result(nearpoints[i]) = near(i);
+  }
+  return result;
+}
+
+}  // namespace xtp
+}  // namespace votca
@@ -40,123 +40,92 @@ void Overlap_filter::Info(Logger& log) const {
   }
 }
 
+Eigen::MatrixXd Overlap_filter::MixedOverlap(const Orbitals& orb) const {
+  AOOverlap S_ao;
+  return S_ao.CrossOverlap(orb.getDftBasis(), lastbasis_);
+}
+
 Eigen::VectorXd Overlap_filter::CalculateOverlap(const Orbitals& orb,
                                                  QMStateType type) const {
-  AOOverlap S_ao;
-  S_ao.Fill(orb.getDftBasis());
+  if (lastbasis_.getNumofShells() == 0) {
+    throw std::runtime_error(
+        "Overlap filter: no previous state to compare to, call UpdateHist "
+        "first");
+  }
+  Eigen::MatrixXd S_mixed = MixedOverlap(orb);
 
-  Eigen::MatrixXd coeffs = CalcAOCoeffs(orb, type);
   if (type.isSingleParticleState()) {
-    return (coeffs.transpose() * S_ao.Matrix() * laststatecoeff_).cwiseAbs();
-  } else {
-
-    Index basis = orb.getBasisSetSize();
-    Eigen::VectorXd overlap = Eigen::VectorXd::Zero(coeffs.cols());
-#pragma omp parallel for schedule(dynamic)
-    for (Index i = 0; i < coeffs.cols(); i++) {
-      {
-        Eigen::VectorXd state = coeffs.col(i).head(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> mat(state.data(), basis, basis);
-        Eigen::VectorXd laststate = laststatecoeff_.head(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> lastmat(laststate.data(), basis,
-                                                  basis);
-
-        overlap(i) = (mat * S_ao.Matrix() * lastmat.transpose())
-                         .cwiseProduct(S_ao.Matrix())
-                         .sum();
-      }
-      if (!orb.getTDAApprox()) {
-        Eigen::VectorXd state = coeffs.col(i).tail(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> mat(state.data(), basis, basis);
-        Eigen::VectorXd laststate = laststatecoeff_.tail(basis * basis);
-        Eigen::Map<const Eigen::MatrixXd> lastmat(laststate.data(), basis,
-                                                  basis);
-
-        overlap(i) -= (mat * S_ao.Matrix() * lastmat.transpose())
-                          .cwiseProduct(S_ao.Matrix())
-                          .sum();
-      }
+    Eigen::VectorXd projected = S_mixed * laststatecoeff_;
+    if (type == QMStateType::DQPstate) {
+      return (orb.CalculateQParticleAORepresentation().transpose() * projected)
+          .cwiseAbs();
     }
-    return overlap.cwiseAbs();
+    return (orb.MOs().eigenvectors().transpose() * projected).cwiseAbs();
   }
-}
 
-Eigen::MatrixXd Overlap_filter::CalcExcitonAORepresentation(
-    const Orbitals& orb, QMStateType type) const {
-  Eigen::MatrixXd coeffs;
-  Index nostates = orb.NumberofStates(type);
-  Index bse_cmax = orb.getBSEcmax();
-  Index bse_cmin = orb.getBSEcmin();
-  Index bse_vmax = orb.getBSEvmax();
-  Index bse_vmin = orb.getBSEvmin();
-  Index bse_vtotal = bse_vmax - bse_vmin + 1;
-  Index bse_ctotal = bse_cmax - bse_cmin + 1;
-  Index basis = orb.getBasisSetSize();
-  Index bse_size_ao = basis * basis;
-  auto occlevels = orb.MOs().eigenvectors().middleCols(bse_vmin, bse_vtotal);
-  auto virtlevels = orb.MOs().eigenvectors().middleCols(bse_cmin, bse_ctotal);
-
-  if (orb.getTDAApprox()) {
-    coeffs.resize(bse_size_ao, nostates);
-  } else {
-    coeffs.resize(2 * bse_size_ao, nostates);
-  }
-#pragma omp parallel for schedule(dynamic)
-  for (Index i = 0; i < nostates; i++) {
-    {
-      Eigen::VectorXd exciton;
-      if (type == QMStateType::Singlet) {
-        exciton = orb.BSESinglets().eigenvectors().col(i);
-      } else {
-        exciton = orb.BSETriplets().eigenvectors().col(i);
-      }
-      Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), bse_ctotal,
-                                            bse_vtotal);
-      const Eigen::MatrixXd aomatrix =
-          occlevels * mat.transpose() * virtlevels.transpose();
-      coeffs.col(i).head(bse_size_ao) =
-          Eigen::Map<const Eigen::VectorXd>(aomatrix.data(), bse_size_ao);
-    }
-    if (!orb.getTDAApprox()) {
-      Eigen::VectorXd exciton;
-      if (type == QMStateType::Singlet) {
-        exciton = orb.BSESinglets().eigenvectors2().col(i);
-      } else {
-        exciton = orb.BSETriplets().eigenvectors2().col(i);
-      }
-      Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), bse_ctotal,
-                                            bse_vtotal);
-      const Eigen::MatrixXd aomatrix =
-          occlevels * mat.transpose() * virtlevels.transpose();
-      coeffs.col(i).tail(bse_size_ao) =
-          Eigen::Map<const Eigen::VectorXd>(aomatrix.data(), bse_size_ao);
-    }
+  // Tr(A_i S B^T S^T) with A_i = O X_i^T V^T and B = H E^T reduces to
+  // sum_cv X_i(c,v) M(c,v) with M = (V^T S E)(H^T S^T O), so all states
+  // follow from a single matrix vector product with the BSE eigenvectors
+  Index bse_vtotal = orb.getBSEvmax() - orb.getBSEvmin() + 1;
+  Index bse_ctotal = orb.getBSEcmax() - orb.getBSEcmin() + 1;
+  auto occlevels =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEvmin(), bse_vtotal);
+  auto virtlevels =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEcmin(), bse_ctotal);
+
+  const tools::EigenSystem& bse = (type == QMStateType::Singlet)
+                                      ? orb.BSESinglets()
+                                      : orb.BSETriplets();
+
+  Eigen::MatrixXd electron = virtlevels.transpose() * S_mixed * lastelectron_;
+  Eigen::MatrixXd occ_mixed = S_mixed.transpose() * occlevels;
+  Eigen::MatrixXd M = electron * (lasthole_.transpose() * occ_mixed);
+  Eigen::VectorXd overlap =
+      bse.eigenvectors().transpose() *
+      Eigen::Map<const Eigen::VectorXd>(M.data(), M.size());
+  if (!orb.getTDAApprox()) {
+    Eigen::MatrixXd M2 = electron * (lasthole2_.transpose() * occ_mixed);
+    overlap -= bse.eigenvectors2().transpose() *
+               Eigen::Map<const Eigen::VectorXd>(M2.data(), M2.size());
   }
-  return coeffs;
+  return overlap.cwiseAbs();
 }
 
-Eigen::MatrixXd Overlap_filter::CalcAOCoeffs(const Orbitals& orb,
-                                             QMStateType type) const {
-  Eigen::MatrixXd coeffs;
-  if (type.isSingleParticleState()) {
-    if (type == QMStateType::DQPstate) {
-      coeffs = orb.CalculateQParticleAORepresentation();
+Eigen::MatrixXd Overlap_filter::CalcHoleAORepresentation(
+    const Orbitals& orb, const Eigen::VectorXd& exciton) const {
+  Index bse_vtotal = orb.getBSEvmax() - orb.getBSEvmin() + 1;
+  Index bse_ctotal = orb.getBSEcmax() - orb.getBSEcmin() + 1;
+  auto occlevels =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEvmin(), bse_vtotal);
+  Eigen::Map<const Eigen::MatrixXd> mat(exciton.data(), bse_ctotal,
+                                        bse_vtotal);
+  return occlevels * mat.transpose();
+}
+
+void Overlap_filter::UpdateHist(const Orbitals& orb, QMState state) {
+  lastbasis_ = orb.getDftBasis();
+  if (state.Type().isSingleParticleState()) {
+    if (state.Type() == QMStateType::DQPstate) {
+      laststatecoeff_ = orb.CalculateQParticleAORepresentation().col(
+          state.StateIdx() - orb.getGWAmin());
     } else {
-      coeffs = orb.MOs().eigenvectors();
+      laststatecoeff_ = orb.MOs().eigenvectors().col(state.StateIdx());
     }
-  } else {
-    coeffs = CalcExcitonAORepresentation(orb, type);
+    return;
   }
-  return coeffs;
-}
 
-void Overlap_filter::UpdateHist(const Orbitals& orb, QMState state) {
-  Eigen::MatrixXd aocoeffs = CalcAOCoeffs(orb, state.Type());
-  Index offset = 0;
-  if (state.Type() == QMStateType::DQPstate) {
-    offset = orb.getGWAmin();
+  const tools::EigenSystem& bse = (state.Type() == QMStateType::Singlet)
+                                      ? orb.BSESinglets()
+                                      : orb.BSETriplets();
+  Index bse_ctotal = orb.getBSEcmax() - orb.getBSEcmin() + 1;
+  lastelectron_ =
+      orb.MOs().eigenvectors().middleCols(orb.getBSEcmin(), bse_ctotal);
+  lasthole_ =
+      CalcHoleAORepresentation(orb, bse.eigenvectors().col(state.StateIdx()));
+  if (!orb.getTDAApprox()) {
+    lasthole2_ = CalcHoleAORepresentation(
+        orb, bse.eigenvectors2().col(state.StateIdx()));
   }
-  laststatecoeff_ = aocoeffs.col(state.StateIdx() - offset);
 }
 
 std::vector<Index> Overlap_filter::CalcIndeces(const Orbitals& orb,
@@ -170,13 +139,38 @@ std::vector<Index> Overlap_filter::CalcIndeces(const Orbitals& orb,
 }
 
 void Overlap_filter::WriteToCpt(CheckpointWriter& w) {
-  w(laststatecoeff_, "laststatecoeff");
   w(threshold_, "threshold");
+  bool hashistory = (lastbasis_.getNumofShells() > 0);
+  w(hashistory, "hashistory");
+  if (hashistory) {
+    w(laststatecoeff_, "laststatecoeff");
+    w(lasthole_, "lasthole");
+    w(lasthole2_, "lasthole2");
+    w(lastelectron_, "lastelectron");
+    CheckpointWriter ww = w.openChild("lastbasis");
+    lastbasis_.WriteToCpt(ww);
+  }
 }
 
 void Overlap_filter::ReadFromCpt(CheckpointReader& r) {
-  r(laststatecoeff_, "laststatecoeff");
   r(threshold_, "threshold");
+  bool hashistory = false;
+  try {
+    r(hashistory, "hashistory");
+  } catch (std::runtime_error&) {
+    throw std::runtime_error(
+        "Overlap filter: the checkpoint stores the previous state in the old "
+        "AO matrix format, restart the state tracking from an initial "
+        "state.");
+  }
+  if (hashistory) {
+    r(laststatecoeff_, "laststatecoeff");
+    r(lasthole_, "lasthole");
+    r(lasthole2_, "lasthole2");
+    r(lastelectron_, "lastelectron");
+    CheckpointReader rr = r.openChild("lastbasis");
+    lastbasis_.ReadFromCpt(rr);
+  }
 }
 
 }  // namespace xtp
@@ -22,6 +22,7 @@
 #define VOTCA_XTP_OVERLAP_FILTER_H
 
 // Local VOTCA includes
+#include "votca/xtp/aobasis.h"
 #include "votca/xtp/statefilter_base.h"
 
 namespace votca {
@@ -30,6 +31,11 @@ namespace xtp {
 /**
     \brief overlap_filter
     tracks states according to their overlap with a previous state
+
+    Only the factors of the previous state and its basis are stored, the
+    overlap with all candidate states is then a projection of the mixed
+    geometry AO overlap onto the MO/transition space, so no AO
+    representation of the candidate states has to be built.
  */
 
 class Overlap_filter : public StateFilter_base {
@@ -53,13 +59,27 @@ class Overlap_filter : public StateFilter_base {
 
  private:
   Eigen::VectorXd CalculateOverlap(const Orbitals& orb, QMStateType type) const;
-  Eigen::MatrixXd CalcAOCoeffs(const Orbitals& orb, QMStateType type) const;
 
-  Eigen::MatrixXd CalcExcitonAORepresentation(const Orbitals& orb,
-                                              QMStateType type) const;
+  // <chi_new|chi_old> between the current and the stored basis
+  Eigen::MatrixXd MixedOverlap(const Orbitals& orb) const;
+
+  // the hole side O X^T of an exciton in the AO basis, the electron side
+  // are the virtual MOs themselves
+  Eigen::MatrixXd CalcHoleAORepresentation(
+      const Orbitals& orb, const Eigen::VectorXd& exciton) const;
+
   double threshold_ = 0.0;
 
+  // the previous state is kept in factorised form, a single particle state as
+  // its AO coefficients, an exciton as
+  // A = lasthole_ * lastelectron_^T (- lasthole2_ * lastelectron_^T for
+  // the deexcitation part beyond TDA)
   Eigen::VectorXd laststatecoeff_;
+  Eigen::MatrixXd lasthole_;
+  Eigen::MatrixXd lasthole2_;
+  Eigen::MatrixXd lastelectron_;
+  // basis at the geometry of the previous state
+  AOBasis lastbasis_;
 };
 
 }  // namespace xtp
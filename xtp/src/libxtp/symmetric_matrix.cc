@@ -18,6 +18,7 @@
  */
 
 // Standard includes
+#include <cmath>
 #include <iostream>
 
 // Local VOTCA includes
@@ -70,6 +71,15 @@ double Symmetric_Matrix::TraceofProd(const Symmetric_Matrix& a) const {
   return result;
 }
 
+double Symmetric_Matrix::FrobeniusNorm() const {
+  double diagonal = 0.0;
+  for (Index i = 0; i < dimension; ++i) {
+    const double value = data[(i * (i + 1)) / 2 + i];
+    diagonal += value * value;
+  }
+  return std::sqrt(2 * Packed().squaredNorm() - diagonal);
+}
+
 void Symmetric_Matrix::AddtoEigenMatrix(Eigen::MatrixXd& full,
                                         double factor) const {
   for (Index j = 0; j < full.cols(); ++j) {
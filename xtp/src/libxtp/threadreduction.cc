@@ -0,0 +1,100 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+
+// Local VOTCA includes
+#include "votca/xtp/threadreduction.h"
+
+namespace votca {
+namespace xtp {
+
+TiledAccumulator::TiledAccumulator(Index rows, Index cols, Index tilesize)
+    : tilesize_(tilesize),
+      rowtiles_((rows + tilesize - 1) / tilesize),
+      coltiles_((cols + tilesize - 1) / tilesize),
+      result_(Eigen::MatrixXd::Zero(rows, cols)),
+      locks_(std::size_t(rowtiles_ * coltiles_)) {}
+
+template <class Func>
+void TiledAccumulator::ForTiles(Index row, Index col, Index rows, Index cols,
+                                bool upperonly, const Func& func) {
+  if (rows == 0 || cols == 0) {
+    return;
+  }
+  const Index firstrow = row / tilesize_;
+  const Index lastrow = (row + rows - 1) / tilesize_;
+  const Index firstcol = col / tilesize_;
+  const Index lastcol = (col + cols - 1) / tilesize_;
+  const Index nrows = lastrow - firstrow + 1;
+  const Index ntiles = nrows * (lastcol - firstcol + 1);
+  // threads start at different tiles so that they do not queue up
+  const Index nthreads = std::max(OPENMP::getMaxThreads(), Index(1));
+  const Index start = (OPENMP::getThreadId() * ntiles) / nthreads;
+  for (Index k = 0; k < ntiles; k++) {
+    const Index tile = (start + k) % ntiles;
+    const Index tr = firstrow + tile % nrows;
+    const Index tc = firstcol + tile / nrows;
+    if (upperonly && tr > tc) {
+      continue;
+    }
+    const Index r0 = std::max(row, tr * tilesize_);
+    const Index r1 = std::min(row + rows, (tr + 1) * tilesize_);
+    const Index c0 = std::max(col, tc * tilesize_);
+    const Index c1 = std::min(col + cols, (tc + 1) * tilesize_);
+    func(r0, c0, r1 - r0, c1 - c0, tr == tc, locks_[tr + tc * rowtiles_]);
+  }
+}
+
+void TiledAccumulator::Add(Index row, Index col,
+                           const Eigen::Ref<const Eigen::MatrixXd>& block) {
+  assert(row + block.rows() <= result_.rows() &&
+         col + block.cols() <= result_.cols() && "block does not fit");
+  ForTiles(row, col, block.rows(), block.cols(), false,
+           [&](Index r, Index c, Index nr, Index nc, bool, std::mutex& lock) {
+             std::lock_guard<std::mutex> guard(lock);
+             result_.block(r, c, nr, nc) +=
+                 block.block(r - row, c - col, nr, nc);
+           });
+}
+
+void TiledAccumulator::AddUpperProduct(
+    double alpha, const Eigen::Ref<const Eigen::MatrixXd>& A,
+    const Eigen::Ref<const Eigen::MatrixXd>& B) {
+  assert(A.rows() == B.rows() && A.cols() == result_.rows() &&
+         B.cols() == result_.cols() && result_.rows() == result_.cols() &&
+         "product has the wrong size");
+  ForTiles(0, 0, result_.rows(), result_.cols(), true,
+           [&](Index r, Index c, Index nr, Index nc, bool diagonal,
+               std::mutex& lock) {
+             const Eigen::MatrixXd tile =
+                 alpha * A.middleCols(r, nr).transpose() * B.middleCols(c, nc);
+             std::lock_guard<std::mutex> guard(lock);
+             if (diagonal) {
+               result_.block(r, c, nr, nc).triangularView<Eigen::Upper>() +=
+                   tile;
+             } else {
+               result_.block(r, c, nr, nc) += tile;
+             }
+           });
+}
+
+}  // namespace xtp
+}  // namespace votca
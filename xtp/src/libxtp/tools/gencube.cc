@@ -19,6 +19,7 @@
 
 // Standard includes
 #include <cstdio>
+#include <filesystem>
 
 // Third party includes
 #include <boost/format.hpp>
@@ -27,6 +28,7 @@
 #include <votca/tools/constants.h>
 #include <votca/tools/elements.h>
 #include <votca/tools/getline.h>
+#include <votca/tools/tokenizer.h>
 
 // Local VOTCA includes
 #include "votca/xtp/aobasis.h"
@@ -43,8 +45,14 @@ void GenCube::ParseOptions(const tools::Property& options) {
 
   orbfile_ = options.ifExistsReturnElseReturnDefault<std::string>(
       ".input", job_name_ + ".orb");
+  format_ = options.ifExistsReturnElseReturnDefault<std::string>(".format",
+                                                                 "cube");
+  if (format_ != "cube" && format_ != "hdf5") {
+    throw std::runtime_error("gencube: format must be cube or hdf5, not " +
+                             format_);
+  }
   output_file_ = options.ifExistsReturnElseReturnDefault<std::string>(
-      ".output", job_name_ + ".cube");
+      ".output", job_name_ + (format_ == "cube" ? ".cube" : ".h5"));
 
   // padding
   padding_ = options.get(".padding").as<double>();
@@ -54,7 +62,16 @@ void GenCube::ParseOptions(const tools::Property& options) {
   steps_.x() = options.get(".xsteps").as<Index>();
   steps_.z() = options.get(".zsteps").as<Index>();
 
-  state_ = options.get(".state").as<QMState>();
+  std::vector<std::string> states =
+      tools::Tokenizer(options.get(".state").as<std::string>(), " ,\n\t")
+          .ToVector();
+  if (states.empty()) {
+    throw std::runtime_error("gencube: no state given");
+  }
+  states_.clear();
+  for (const std::string& state : states) {
+    states_.push_back(QMState(state));
+  }
   dostateonly_ = options.get(".diff2gs").as<bool>();
 
   mode_ = options.get(".mode").as<std::string>();
@@ -74,9 +91,30 @@ void GenCube::calculateCube() {
 
   CubeFile_Writer writer(steps_, padding_, log_);
   XTP_LOG(Log::error, log_) << "Created cube grid" << std::flush;
-  writer.WriteFile(output_file_, orbitals, state_, dostateonly_);
-  XTP_LOG(Log::error, log_)
-      << "Wrote cube data to " << output_file_ << std::flush;
+  if (format_ == "hdf5") {
+    writer.WriteHDF5(output_file_, orbitals, states_, dostateonly_);
+    XTP_LOG(Log::error, log_)
+        << "Wrote grid data to " << output_file_ << std::flush;
+    return;
+  }
+
+  // several states go to one cube per state, named output_<state>.cube
+  std::vector<std::string> filenames;
+  if (states_.size() == 1) {
+    filenames.push_back(output_file_);
+  } else {
+    std::filesystem::path output(output_file_);
+    for (const QMState& state : states_) {
+      std::filesystem::path file = output;
+      file.replace_filename(output.stem().string() + "_" + state.ToString() +
+                            output.extension().string());
+      filenames.push_back(file.string());
+    }
+  }
+  writer.WriteFiles(filenames, orbitals, states_, dostateonly_);
+  for (const std::string& file : filenames) {
+    XTP_LOG(Log::error, log_) << "Wrote cube data to " << file << std::flush;
+  }
   return;
 }
 
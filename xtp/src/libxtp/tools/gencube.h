@@ -48,6 +48,7 @@ class GenCube final : public QMTool {
 
   std::string orbfile_;
   std::string output_file_;
+  std::string format_;
   std::string infile1_;
   std::string infile2_;
 
@@ -55,7 +56,7 @@ class GenCube final : public QMTool {
 
   double padding_;
   Eigen::Array<Index, 3, 1> steps_;
-  QMState state_;
+  std::vector<QMState> states_;
   std::string mode_;
   Logger log_;
 };
@@ -48,9 +48,10 @@ std::pair<double, double> CalcStatistics(const std::vector<double>& v) {
   return {mean, stdev};
 }
 
+// if flops is given, the achieved GFLOP/s are reported as well
 template <class T>
 tools::Property RunPart(T&& payload, const std::string& name,
-                        Index repetitions) {
+                        Index repetitions, double flops = 0.0) {
   std::vector<double> individual_timings;
   individual_timings.reserve(repetitions);
   Index count = 0;
@@ -75,6 +76,11 @@ tools::Property RunPart(T&& payload, const std::string& name,
   tools::Property output(name, "", "");
   output.add("avg", std::to_string(mean1));
   output.add("std", std::to_string(std1));
+  if (flops > 0.0) {
+    double gflops = flops / mean1 * 1e-9;
+    std::cout << "GFLOP/s:" << gflops << std::endl;
+    output.add("gflops", std::to_string(gflops));
+  }
   tools::Property& runs = output.add("runs", "");
   for (double time : individual_timings) {
     runs.add("timing", std::to_string(time));
@@ -170,42 +176,49 @@ bool GPUBenchmark::Run() {
   sbtda_op.configure(opt);
   HxOperator hx_op(epsilon_inv_fake, Mmn, Hqp_fake);
   hx_op.configure(opt);
-  Index spacesize = 100;  // A searchspace of 100 is pretty decent
-  Eigen::MatrixXd state = Eigen::MatrixXd::Random(s_op.size(), spacesize);
-  Eigen::MatrixXd result_op = Eigen::MatrixXd::Zero(s_op.size(), spacesize);
-
-  output.add(RunPart(
-      [&]() {
-        result_op += s_op * state;
-        return 1;
-      },
-      "SingletOperator_TDA", repetitions_));
-
-  output.add(RunPart(
-      [&]() {
-        result_op += t_op * state;
-        return 1;
-      },
-      "TripletOperator_TDA", repetitions_));
-
-  output.add(RunPart(
-      [&]() {
-        result_op += sbtda_op * state;
-        return 1;
-      },
-      "SingletOperator_BTDA_B", repetitions_));
-
-  output.add(RunPart(
-      [&]() {
-        result_op += hx_op * state;
-        return 1;
-      },
-      "HxOperator", repetitions_));
+  // a Davidson iteration applies a few new vectors, a restart the whole
+  // searchspace, for which 100 is pretty decent
+  for (Index spacesize : {Index(10), Index(100)}) {
+    Eigen::MatrixXd state = Eigen::MatrixXd::Random(s_op.size(), spacesize);
+    Eigen::MatrixXd result_op = Eigen::MatrixXd::Zero(s_op.size(), spacesize);
+    // effective rate, i.e. as if the operator was a dense matrix
+    double flops = 2.0 * double(s_op.size()) * double(s_op.size()) *
+                   double(spacesize);
+    std::string suffix = "_" + std::to_string(spacesize);
+
+    output.add(RunPart(
+        [&]() {
+          result_op += s_op * state;
+          return 1;
+        },
+        "SingletOperator_TDA" + suffix, repetitions_, flops));
+
+    output.add(RunPart(
+        [&]() {
+          result_op += t_op * state;
+          return 1;
+        },
+        "TripletOperator_TDA" + suffix, repetitions_, flops));
+
+    output.add(RunPart(
+        [&]() {
+          result_op += sbtda_op * state;
+          return 1;
+        },
+        "SingletOperator_BTDA_B" + suffix, repetitions_, flops));
+
+    output.add(RunPart(
+        [&]() {
+          result_op += hx_op * state;
+          return 1;
+        },
+        "HxOperator" + suffix, repetitions_, flops));
+    frequency += result_op.sum();
+  }
   std::ofstream outputfile;
   outputfile.open(outputfile_);
   outputfile << output << std::endl;
   outputfile.close();
-  frequency += result_op.sum();
   return true;
 }
 
@@ -0,0 +1,428 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// Standard includes
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+
+// VOTCA includes
+#include <votca/tools/property.h>
+#include <votca/tools/version.h>
+
+// Local VOTCA includes
+#include "votca/xtp/ERIs.h"
+#include "votca/xtp/bse_operator.h"
+#include "votca/xtp/davidsonsolver.h"
+#include "votca/xtp/dipoledipoleinteraction.h"
+#include "votca/xtp/eigen.h"
+#include "votca/xtp/logger.h"
+#include "votca/xtp/openmp_cuda.h"
+#include "votca/xtp/orbitals.h"
+#include "votca/xtp/rpa.h"
+#include "votca/xtp/sigmafactory.h"
+#include "votca/xtp/threecenter.h"
+#include "votca/xtp/vxc_grid.h"
+#include "votca/xtp/vxc_potential.h"
+
+// Local private VOTCA includes
+#include "kernel_benchmark.h"
+
+namespace votca {
+namespace xtp {
+
+void KernelBenchmark::ParseOptions(const tools::Property& options) {
+  outputfile_ = options.get("outputfile").as<std::string>();
+  repetitions_ = options.get("repetitions").as<Index>();
+  threads_ = options.get("threads").as<std::vector<Index>>();
+  std::vector<std::string> kernels =
+      options.get("kernels").as<std::vector<std::string>>();
+  kernels_ = std::set<std::string>(kernels.begin(), kernels.end());
+  bse_vectors_ = options.get("bse_vectors").as<std::vector<Index>>();
+  davidson_roots_ = options.get("davidson_roots").as<Index>();
+  polar_sites_ = options.get("polar_sites").as<Index>();
+}
+
+namespace {
+
+/// peak resident memory of the process in kB, -1 if it is not available
+Index PeakMemoryKB() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) {
+      return Index(std::stol(line.substr(6)));
+    }
+  }
+  return -1;
+}
+
+/// resets the peak resident memory to the current one, so that PeakMemoryKB
+/// only covers what is allocated afterwards. Only linux supports this.
+bool ResetPeakMemory() {
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  clear_refs << "5";
+  clear_refs.flush();
+  return bool(clear_refs);
+}
+
+/**
+ * Runs `kernel` repetitions times for every thread count. The kernel returns
+ * a checksum of its result, which keeps the compiler from optimising the
+ * call away and allows to spot changes in the results between builds. If
+ * flops is given, the achieved GFLOP/s are reported as well.
+ */
+template <class Kernel>
+tools::Property BenchmarkKernel(const std::string& name, Kernel&& kernel,
+                                const std::vector<Index>& threads,
+                                Index repetitions, double flops = 0.0) {
+  tools::Property output("kernel", "", "");
+  output.setAttribute("name", name);
+  if (flops > 0.0) {
+    output.add("flops", std::to_string(flops));
+  }
+  std::cout << name << std::endl;
+  double reference_time = 0.0;
+  Index reference_threads = 0;
+  for (Index nthreads : threads) {
+    OPENMP::setMaxThreads(nthreads);
+    ResetPeakMemory();
+    double checksum = 0.0;
+    std::vector<double> timings;
+    timings.reserve(repetitions);
+    for (Index i = 0; i < repetitions; i++) {
+      std::chrono::time_point<std::chrono::steady_clock> start =
+          std::chrono::steady_clock::now();
+      checksum = kernel();
+      std::chrono::time_point<std::chrono::steady_clock> end =
+          std::chrono::steady_clock::now();
+      timings.push_back(
+          std::chrono::duration_cast<std::chrono::duration<double>>(end -
+                                                                    start)
+              .count());
+    }
+    double mean = std::reduce(timings.begin(), timings.end()) /
+                  double(timings.size());
+    double sq_sum = std::inner_product(timings.begin(), timings.end(),
+                                       timings.begin(), 0.0);
+    double stdev = std::sqrt(
+        std::max(0.0, sq_sum / double(timings.size()) - mean * mean));
+    double min = *std::min_element(timings.begin(), timings.end());
+    if (reference_threads == 0) {
+      reference_time = mean;
+      reference_threads = nthreads;
+    }
+    double speedup = reference_time / mean;
+    double efficiency =
+        speedup * double(reference_threads) / double(nthreads);
+
+    std::cout << " threads:" << nthreads << " avg:" << mean
+              << " std:" << stdev << " speedup:" << speedup << std::endl;
+    tools::Property& run = output.add("threads", "");
+    run.setAttribute("n", nthreads);
+    run.add("avg", std::to_string(mean));
+    run.add("std", std::to_string(stdev));
+    run.add("min", std::to_string(min));
+    run.add("speedup", std::to_string(speedup));
+    run.add("efficiency", std::to_string(efficiency));
+    if (flops > 0.0) {
+      run.add("gflops", std::to_string(flops / mean * 1e-9));
+    }
+    run.add("peak_memory_kB", std::to_string(PeakMemoryKB()));
+    run.add("checksum", std::to_string(checksum));
+    tools::Property& runs = run.add("runs", "");
+    for (double time : timings) {
+      runs.add("timing", std::to_string(time));
+    }
+  }
+  return output;
+}
+
+/// cubic lattice of polar sites with 5 bohr spacing, each site is its own
+/// segment as for a polarisable environment of small molecules
+std::vector<PolarSegment> PolarLattice(Index nsites) {
+  const std::array<std::string, 4> elements = {"C", "H", "N", "O"};
+  Index edge = Index(std::ceil(std::cbrt(double(nsites))));
+  std::vector<PolarSegment> segments;
+  segments.reserve(nsites);
+  for (Index i = 0; i < nsites; i++) {
+    Eigen::Vector3d pos(double(i % edge), double((i / edge) % edge),
+                        double(i / (edge * edge)));
+    PolarSegment seg("site", i);
+    seg.push_back(PolarSite(i, elements[i % 4], 5.0 * pos));
+    segments.push_back(seg);
+  }
+  return segments;
+}
+
+}  // namespace
+
+bool KernelBenchmark::Run() {
+
+  if (threads_.empty()) {
+    threads_.push_back(OPENMP::getMaxThreads());
+  }
+  // random operands are the same for every run
+  std::srand(42);
+
+  tools::Property output("KernelBenchmark", "", "");
+  output.add("Version", tools::ToolsVersionStr());
+  output.add("Repetitions", std::to_string(repetitions_));
+  output.add("CPUs", std::to_string(OPENMP::getMaxThreads()));
+  output.add("GPUs", std::to_string(OpenMP_CUDA::UsingGPUs()));
+  output.add("MKL_overload", std::to_string(XTP_HAS_MKL_OVERLOAD()));
+  output.add("Eigen", std::to_string(EIGEN_WORLD_VERSION) + "." +
+                          std::to_string(EIGEN_MAJOR_VERSION) + "." +
+                          std::to_string(EIGEN_MINOR_VERSION));
+  output.add("Eigen_SIMD", Eigen::SimdInstructionSetsInUse());
+  output.add("peak_memory_per_thread_count",
+             ResetPeakMemory() ? "true" : "false");
+
+  std::cout << "Repetitions:" << repetitions_ << std::endl;
+  std::cout << "Thread counts:";
+  for (Index nthreads : threads_) {
+    std::cout << " " << nthreads;
+  }
+  std::cout << std::endl;
+
+  if (RunKernel("dipoledipole")) {
+    std::vector<PolarSegment> segments = PolarLattice(polar_sites_);
+    eeInteractor interactor(0.39);
+    DipoleDipoleInteraction dipdip(interactor, segments);
+    Eigen::VectorXd x = Eigen::VectorXd::Random(dipdip.rows());
+    // effective rate, i.e. as if the operator was a dense matrix
+    double flops = 2.0 * double(dipdip.rows()) * double(dipdip.rows());
+    output.add(BenchmarkKernel(
+        "DipoleDipoleInteraction_multiply",
+        [&]() {
+          Eigen::VectorXd y = dipdip * x;
+          return y.sum();
+        },
+        threads_, repetitions_, flops));
+  }
+
+  const std::array<std::string, 7> gwbse_kernels = {
+      "threecenter", "rpa",          "sigma_ppm", "sigma_exact",
+      "sigma_cda",   "bse_operator", "davidson"};
+  bool run_gwbse =
+      std::any_of(gwbse_kernels.begin(), gwbse_kernels.end(),
+                  [&](const std::string& k) { return RunKernel(k); });
+  if (!run_gwbse && !RunKernel("vxc") && !RunKernel("eris_3c")) {
+    OPENMP::setMaxThreads(nThreads_);
+    std::ofstream outputfile(outputfile_);
+    outputfile << output << std::endl;
+    return true;
+  }
+
+  Orbitals orb;
+  orb.ReadFromCpt(job_name_ + ".orb");
+  std::cout << "\n\nCreating benchmark for " << job_name_ << ".orb"
+            << std::endl;
+  OPENMP::setMaxThreads(threads_.back());
+  const AOBasis& basis = orb.getDftBasis();
+  output.add("Basisset", basis.Name());
+  output.add("Basissetsize", std::to_string(basis.AOBasisSize()));
+  std::cout << "BasisSet:" << basis.Name() << " size:" << basis.AOBasisSize()
+            << std::endl;
+
+  if (RunKernel("vxc") || RunKernel("eris_3c")) {
+    Eigen::MatrixXd dmat = orb.DensityMatrixGroundState();
+    if (RunKernel("vxc")) {
+      std::string gridname =
+          orb.getXCGrid().empty() ? "medium" : orb.getXCGrid();
+      Vxc_Grid grid;
+      grid.GridSetup(gridname, orb.QMAtoms(), basis);
+      Vxc_Potential<Vxc_Grid> vxc(grid);
+      vxc.setXCfunctional(orb.getXCFunctionalName());
+      output.add("Vxc_grid", gridname);
+      output.add("Vxc_gridsize", std::to_string(grid.getGridSize()));
+      output.add(BenchmarkKernel(
+          "Vxc_Potential_IntegrateVXC",
+          [&]() {
+            Mat_p_Energy e_vxc = vxc.IntegrateVXC(dmat);
+            return e_vxc.energy() + e_vxc.matrix().sum();
+          },
+          threads_, repetitions_));
+    }
+    if (RunKernel("eris_3c")) {
+      const AOBasis& auxbasis = orb.getAuxBasis();
+      ERIs eris;
+      eris.Initialize(basis, auxbasis);
+      output.add(BenchmarkKernel(
+          "ERIs_CalculateERIs_3c",
+          [&]() { return eris.CalculateERIs_3c(dmat).sum(); }, threads_,
+          repetitions_));
+    }
+  }
+
+  if (run_gwbse) {
+    const AOBasis& auxbasis = orb.getAuxBasis();
+    output.add("AuxBasisset", auxbasis.Name());
+    output.add("AuxBasissetsize", std::to_string(auxbasis.AOBasisSize()));
+    output.add("rpamin", std::to_string(orb.getRPAmin()));
+    output.add("rpamax", std::to_string(orb.getRPAmax()));
+    output.add("qpmin", std::to_string(orb.getGWAmin()));
+    output.add("qpmax", std::to_string(orb.getGWAmax()));
+    output.add("bsemin", std::to_string(orb.getBSEvmin()));
+    output.add("bsemax", std::to_string(orb.getBSEcmax()));
+    std::cout << "AuxBasisSet:" << auxbasis.Name()
+              << " size:" << auxbasis.AOBasisSize() << std::endl;
+
+    TCMatrix_gwbse Mmn;
+    Index max_3c = std::max(orb.getBSEcmax(), orb.getGWAmax());
+    Mmn.Initialize(auxbasis.AOBasisSize(), orb.getRPAmin(), max_3c,
+                   orb.getRPAmin(), orb.getRPAmax());
+    if (RunKernel("threecenter")) {
+      output.add(BenchmarkKernel(
+          "TCMatrix_gwbse_Fill",
+          [&]() {
+            Mmn.Fill(auxbasis, basis, orb.MOs().eigenvectors());
+            return Mmn[0].sum();
+          },
+          threads_, repetitions_));
+    } else {
+      Mmn.Fill(auxbasis, basis, orb.MOs().eigenvectors());
+    }
+
+    Logger log;
+    RPA rpa(log, Mmn);
+    rpa.configure(orb.getHomo(), orb.getRPAmin(), orb.getRPAmax());
+    Index rpatotal = orb.getRPAmax() - orb.getRPAmin() + 1;
+    rpa.setRPAInputEnergies(
+        orb.MOs().eigenvalues().segment(orb.getRPAmin(), rpatotal));
+    if (RunKernel("rpa")) {
+      double n_occ = double(orb.getHomo() + 1 - orb.getRPAmin());
+      double n_unocc = double(orb.getRPAmax() - orb.getHomo());
+      double naux = double(auxbasis.AOBasisSize());
+      // one rank-n_unocc update of the aux x aux matrix per occupied level
+      // for each of the two frequencies
+      double flops = 2.0 * 2.0 * naux * naux * n_occ * n_unocc;
+      output.add(BenchmarkKernel(
+          "RPA_calculate_epsilon",
+          [&]() {
+            return rpa.calculate_epsilon_i(0.5).sum() +
+                   rpa.calculate_epsilon_r(-0.5).sum();
+          },
+          threads_, repetitions_, flops));
+    }
+
+    Sigma().RegisterAll();
+    Sigma_base::options sigma_opt;
+    sigma_opt.homo = orb.getHomo();
+    sigma_opt.qpmin = orb.getGWAmin();
+    sigma_opt.qpmax = orb.getGWAmax();
+    sigma_opt.rpamin = orb.getRPAmin();
+    sigma_opt.rpamax = orb.getRPAmax();
+    sigma_opt.eta = 1e-3;
+    sigma_opt.alpha = 1e-3;
+    sigma_opt.quadrature_scheme = "legendre";
+    sigma_opt.order = 12;
+    Index qptotal = orb.getGWAmax() - orb.getGWAmin() + 1;
+    Eigen::VectorXd frequencies =
+        orb.MOs().eigenvalues().segment(orb.getGWAmin(), qptotal);
+    for (std::string method : {"ppm", "exact", "cda"}) {
+      if (!RunKernel("sigma_" + method)) {
+        continue;
+      }
+      std::unique_ptr<Sigma_base> sigma = Sigma().Create(method, Mmn, rpa);
+      sigma->configure(sigma_opt);
+      sigma->PrepareScreening();
+      output.add(BenchmarkKernel(
+          "Sigma_" + method + "_CalcCorrelationDiag",
+          [&]() { return sigma->CalcCorrelationDiag(frequencies).sum(); },
+          threads_, repetitions_));
+    }
+
+    // quasiparticle hamiltonian from the dft energies, so that the bse
+    // operators have a physical spectrum for the Davidson solver
+    Index hqp_size = orb.getBSEcmax() - orb.getBSEvmin() + 1;
+    Eigen::MatrixXd Hqp = orb.MOs()
+                              .eigenvalues()
+                              .segment(orb.getBSEvmin(), hqp_size)
+                              .asDiagonal();
+    Eigen::VectorXd epsilon_inv =
+        Eigen::VectorXd::Constant(auxbasis.AOBasisSize(), 0.5);
+    BSEOperator_Options opt;
+    opt.cmax = orb.getBSEcmax();
+    opt.homo = orb.getHomo();
+    opt.qpmin = orb.getGWAmin();
+    opt.rpamin = orb.getRPAmin();
+    opt.vmin = orb.getBSEvmin();
+    SingletOperator_TDA s_op(epsilon_inv, Mmn, Hqp);
+    s_op.configure(opt);
+    TripletOperator_TDA t_op(epsilon_inv, Mmn, Hqp);
+    t_op.configure(opt);
+    output.add("bsesize", std::to_string(s_op.size()));
+
+    if (RunKernel("bse_operator")) {
+      for (Index nvectors : bse_vectors_) {
+        Eigen::MatrixXd state = Eigen::MatrixXd::Random(s_op.size(), nvectors);
+        // effective rate, i.e. as if the operator was a dense matrix
+        double flops = 2.0 * double(s_op.size()) * double(s_op.size()) *
+                       double(nvectors);
+        std::string suffix = "_" + std::to_string(nvectors);
+        output.add(BenchmarkKernel(
+            "SingletOperator_TDA_matmul" + suffix,
+            [&]() {
+              Eigen::MatrixXd result = s_op * state;
+              return result.sum();
+            },
+            threads_, repetitions_, flops));
+        output.add(BenchmarkKernel(
+            "TripletOperator_TDA_matmul" + suffix,
+            [&]() {
+              Eigen::MatrixXd result = t_op * state;
+              return result.sum();
+            },
+            threads_, repetitions_, flops));
+      }
+    }
+
+    if (RunKernel("davidson")) {
+      Index iterations = 0;
+      output.add(BenchmarkKernel(
+          "DavidsonSolver_SingletOperator_TDA",
+          [&]() {
+            DavidsonSolver DS(log);
+            DS.set_correction("DPR");
+            DS.set_tolerance("normal");
+            DS.set_size_update("safe");
+            DS.set_iter_max(50);
+            DS.set_max_search_space(10 * davidson_roots_);
+            DS.solve(s_op, davidson_roots_);
+            iterations = DS.num_iterations();
+            return DS.eigenvalues().sum();
+          },
+          threads_, repetitions_));
+      output.add("davidson_iterations", std::to_string(iterations));
+    }
+  }
+
+  OPENMP::setMaxThreads(nThreads_);
+  std::ofstream outputfile(outputfile_);
+  outputfile << output << std::endl;
+  return true;
+}
+
+}  // namespace xtp
+}  // namespace votca
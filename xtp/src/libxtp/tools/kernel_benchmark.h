@@ -0,0 +1,68 @@
+/*
+ *            Copyright 2009-2024 The VOTCA Development Team
+ *                       (http://www.votca.org)
+ *
+ *      Licensed under the Apache License, Version 2.0 (the "License")
+ *
+ * You may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *              http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+#ifndef VOTCA_XTP_KERNELBENCHMARK_H
+#define VOTCA_XTP_KERNELBENCHMARK_H
+
+// Standard includes
+#include <set>
+
+// Local VOTCA includes
+#include "votca/xtp/qmtool.h"
+
+namespace votca {
+namespace xtp {
+
+/**
+ * \brief Times the cpu kernels of dft, gw and bse
+ *
+ * Every kernel is run for each of the given thread counts. Timings, GFLOP/s,
+ * the peak memory and a checksum of the result are written to an xml file,
+ * so the numbers can be compared between builds and releases.
+ */
+class KernelBenchmark final : public QMTool {
+ public:
+  KernelBenchmark() = default;
+
+  ~KernelBenchmark() = default;
+  std::string Identify() const { return "KernelBenchmark"; }
+
+ protected:
+  void ParseOptions(const tools::Property &user_options);
+  bool Run();
+
+ private:
+  bool RunKernel(const std::string &kernel) const {
+    return kernels_.count(kernel) > 0;
+  }
+
+  Index repetitions_;
+  std::string outputfile_;
+  std::vector<Index> threads_;
+  std::set<std::string> kernels_;
+  std::vector<Index> bse_vectors_;
+  Index davidson_roots_;
+  Index polar_sites_;
+};
+
+}  // namespace xtp
+}  // namespace votca
+
+#endif  // VOTCA_XTP_KERNELBENCHMARK_H
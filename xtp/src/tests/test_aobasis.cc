@@ -184,4 +184,39 @@ BOOST_AUTO_TEST_CASE(Adding_a_basis) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(Cached_libint_data) {
+  libint2::initialize();
+  QMMolecule mol("a", 0);
+  mol.LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) + "/aobasis/molecule.xyz");
+  BasisSet basis;
+  basis.Load(std::string(XTP_TEST_DATA_FOLDER) + "/aobasis/3-21G.xml");
+  AOBasis aobasis;
+  aobasis.Fill(basis, mol);
+
+  const std::vector<libint2::Shell>& shells = aobasis.LibintBasis();
+  BOOST_CHECK_EQUAL(&shells, &aobasis.LibintBasis());
+  BOOST_CHECK_EQUAL(shells.size(), aobasis.GenerateLibintBasis().size());
+
+  std::vector<std::vector<votca::Index>> pairs = aobasis.ComputeShellPairs();
+  const std::vector<std::vector<votca::Index>>& cached = aobasis.ShellPairs();
+  BOOST_CHECK_EQUAL(pairs.size(), cached.size());
+  for (std::size_t i = 0; i < pairs.size(); i++) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(pairs[i].begin(), pairs[i].end(),
+                                  cached[i].begin(), cached[i].end());
+  }
+
+  // a copy keeps the old cache when the original moves
+  AOBasis copy = aobasis;
+  QMMolecule mol2 = mol;
+  mol2.Translate(Eigen::Vector3d(1, 2, 3));
+  aobasis.UpdateShellPositions(mol2);
+  BOOST_CHECK_CLOSE(aobasis.LibintBasis()[0].O[0],
+                    aobasis.getShell(0).getPos().x(), 1e-10);
+  BOOST_CHECK_CLOSE(copy.LibintBasis()[0].O[0], copy.getShell(0).getPos().x(),
+                    1e-10);
+  BOOST_CHECK_CLOSE(aobasis.LibintBasis()[0].O[0] - copy.LibintBasis()[0].O[0],
+                    1.0, 1e-8);
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
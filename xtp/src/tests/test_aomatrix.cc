@@ -61,6 +61,18 @@ BOOST_AUTO_TEST_CASE(aomatrices_test) {
     cout << overlap.Matrix() << endl;
   }
 
+  Eigen::MatrixXd cross_same = overlap.CrossOverlap(aobasis, aobasis);
+  BOOST_CHECK(cross_same.isApprox(overlap.Matrix(), 1e-10));
+
+  QMMolecule shifted = mol;
+  shifted.Translate(Eigen::Vector3d(0.1, -0.2, 0.05));
+  AOBasis aobasis_shifted;
+  aobasis_shifted.Fill(basis, shifted);
+  Eigen::MatrixXd cross = overlap.CrossOverlap(aobasis, aobasis_shifted);
+  Eigen::MatrixXd cross_back = overlap.CrossOverlap(aobasis_shifted, aobasis);
+  BOOST_CHECK(cross.isApprox(cross_back.transpose(), 1e-10));
+  BOOST_CHECK(!cross.isApprox(overlap.Matrix(), 1e-4));
+
   AOKinetic kinetic;
   kinetic.Fill(aobasis);
   Eigen::MatrixXd kinetic_ref = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
@@ -75,6 +87,20 @@ BOOST_AUTO_TEST_CASE(aomatrices_test) {
     cout << kinetic.Matrix() << endl;
   }
 
+  AOOverlap batch_overlap;
+  AOKinetic batch_kinetic;
+  AODipole batch_dipole;
+  batch_dipole.setCenter(Eigen::Vector3d(0.5, 0.0, -0.3));
+  FillOneBodyMatrices(aobasis, &batch_overlap, &batch_kinetic, &batch_dipole);
+  AODipole dipole;
+  dipole.setCenter(Eigen::Vector3d(0.5, 0.0, -0.3));
+  dipole.Fill(aobasis);
+  BOOST_CHECK(batch_overlap.Matrix().isApprox(overlap.Matrix(), 1e-12));
+  BOOST_CHECK(batch_kinetic.Matrix().isApprox(kinetic.Matrix(), 1e-12));
+  for (votca::Index i = 0; i < 3; i++) {
+    BOOST_CHECK(batch_dipole.Matrix()[i].isApprox(dipole.Matrix()[i], 1e-12));
+  }
+
   AOCoulomb coulomb;
   coulomb.Fill(aobasis);
   Eigen::MatrixXd coulomb_ref = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
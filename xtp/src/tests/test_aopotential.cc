@@ -245,6 +245,72 @@ BOOST_AUTO_TEST_CASE(aomultipole_comparison) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(aomultipole_farfield) {
+  libint2::initialize();
+  Orbitals orbitals;
+  orbitals.QMAtoms().LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                                  "/aopotential/molecule.xyz");
+  BasisSet basis;
+  basis.Load(std::string(XTP_TEST_DATA_FOLDER) + "/aopotential/3-21G.xml");
+  AOBasis aobasis;
+  aobasis.Fill(basis, orbitals.QMAtoms());
+
+  // point multipoles from close by to far away, so that all of them
+  // individually integrated, merged into octree cells and replaced by
+  // equivalent charges occur
+  std::vector<std::unique_ptr<StaticSite> > externalsites;
+  Index id = 0;
+  for (Index i = -8; i <= 8; i++) {
+    for (Index j = -8; j <= 8; j++) {
+      for (Index k = -8; k <= 8; k++) {
+        Eigen::Vector3d pos =
+            4.0 * Eigen::Vector3d(double(i), double(j), double(k));
+        if (pos.norm() < 9.0) {
+          continue;
+        }
+        auto site = std::make_unique<StaticSite>(id, "X", pos);
+        Vector9d multipoles = Vector9d::Zero();
+        multipoles(0) = (id % 2 == 0) ? 0.4 : -0.3;
+        multipoles.segment<3>(1) = Eigen::Vector3d(0.03, -0.05, 0.02);
+        multipoles.segment<5>(4) << 0.05, -0.02, 0.01, 0.03, -0.04;
+        site->setMultipole(multipoles, 2);
+        externalsites.push_back(std::move(site));
+        id++;
+      }
+    }
+  }
+  // a dense cluster inside twice the basis extent, only its octree cells
+  // are small enough compared to their distance to be merged
+  for (Index i = 0; i < 4; i++) {
+    for (Index j = 0; j < 4; j++) {
+      for (Index k = 0; k < 4; k++) {
+        Eigen::Vector3d pos = Eigen::Vector3d(12.0, 1.0, 1.0) +
+                              0.04 * Eigen::Vector3d(double(i), double(j),
+                                                     double(k));
+        auto site = std::make_unique<StaticSite>(id, "X", pos);
+        site->setCharge((id % 2 == 0) ? 0.2 : -0.1);
+        externalsites.push_back(std::move(site));
+        id++;
+      }
+    }
+  }
+
+  AOMultipole exact;
+  exact.FillPotential(aobasis, externalsites);
+  AOMultipole exact2;
+  exact2.FillPotential(aobasis, externalsites, 0.0);
+  BOOST_CHECK(exact.Matrix().isApprox(exact2.Matrix(), 1e-14));
+
+  for (double tolerance : {1e-2, 1e-3, 1e-4}) {
+    AOMultipole compressed;
+    compressed.FillPotential(aobasis, externalsites, tolerance);
+    double error = (compressed.Matrix() - exact.Matrix()).norm() /
+                   exact.Matrix().norm();
+    BOOST_CHECK_LT(error, tolerance);
+  }
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_CASE(large_l_test) {
   libint2::initialize();
   QMMolecule mol("C", 0);
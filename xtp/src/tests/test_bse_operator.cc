@@ -67,10 +67,10 @@ BOOST_AUTO_TEST_CASE(bse_operator) {
   Mmn.MultiplyRightWithAuxMatrix(rpa_op);
   epsilon_inv << 0.999807798016267, 0.994206065211371, 0.917916768047073,
       0.902913813951883, 0.902913745974602, 0.902913584797742,
-      0.853352878674581, 0.853352727016914, 0.853352541699637, 0.79703468058566,
-      0.797034577207669, 0.797034400395582, 0.787701833916331,
-      0.518976361745313, 0.518975064844033, 0.518973712898761,
-      0.459286057710524;
+      0.853352878674581, 0.853352727016914, 0.853352541699637,
+      0.79703468058566, 0.797034577207669, 0.797034400395582,
+      0.787701833916331, 0.518976361745313, 0.518975064844033,
+      0.518973712898761, 0.459286057710524;
 
   BSEOperator_Options opt;
   opt.cmax = 8;
@@ -147,6 +147,18 @@ BOOST_AUTO_TEST_CASE(bse_operator) {
   bool check_hd2diag = hd2_mat.diagonal().isApprox(Hd2.diagonal(), 0.001);
   BOOST_CHECK_EQUAL(check_hd2diag, true);
 
+  // a few vectors are applied in a single fused pass instead of row by row
+  Eigen::MatrixXd vecs = Eigen::MatrixXd::Random(Hx.rows(), 2);
+  BOOST_CHECK((Hqp_op * vecs).isApprox(hqp_mat * vecs, 1e-10));
+  BOOST_CHECK((Hx * vecs).isApprox(hx_mat * vecs, 1e-10));
+  BOOST_CHECK((Hd * vecs).isApprox(hd_mat * vecs, 1e-10));
+  BOOST_CHECK((Hd2 * vecs).isApprox(hd2_mat * vecs, 1e-10));
+
+  // without memory for the slice copies the rows are used again
+  opt.max_slice_memory = 0.0;
+  Hd.configure(opt);
+  BOOST_CHECK((Hd * vecs).isApprox(hd_mat * vecs, 1e-10));
+
   libint2::finalize();
 }
 
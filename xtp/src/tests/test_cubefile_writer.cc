@@ -27,6 +27,7 @@
 
 // Local VOTCA includes
 #include "votca/tools/eigenio_matrixmarket.h"
+#include "votca/xtp/checkpoint.h"
 #include "votca/xtp/cubefile_writer.h"
 
 using namespace votca::xtp;
@@ -52,8 +53,7 @@ Eigen::VectorXd Readcubefile(const std::string& filename) {
   return Eigen::Map<Eigen::VectorXd>(cube_values.data(), cube_values.size());
 }
 
-BOOST_AUTO_TEST_CASE(constructors_test) {
-  libint2::initialize();
+Orbitals SetupOrbitals() {
   Orbitals A;
   A.QMAtoms().LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
                            "/cubefile_writer/molecule.xyz");
@@ -77,6 +77,13 @@ BOOST_AUTO_TEST_CASE(constructors_test) {
 
   A.BSESinglets().eigenvectors() = spsi_ref;
 
+  return A;
+}
+
+BOOST_AUTO_TEST_CASE(constructors_test) {
+  libint2::initialize();
+  Orbitals A = SetupOrbitals();
+
   Eigen::Array<votca::Index, 3, 1> steps(3, 4, 7);
   Logger log;
   double padding = 0.5;
@@ -143,4 +150,61 @@ BOOST_AUTO_TEST_CASE(constructors_test) {
   libint2::finalize();
 }
 
+struct GridValue {
+  struct data {
+    double value;
+  };
+  static void SetupCptTable(CptTable& table) {
+    table.addCol<double>("value", HOFFSET(data, value));
+  }
+};
+
+BOOST_AUTO_TEST_CASE(multistate_test) {
+  libint2::initialize();
+  Orbitals A = SetupOrbitals();
+
+  Eigen::Array<votca::Index, 3, 1> steps(3, 4, 7);
+  Logger log;
+  CubeFile_Writer writer(steps, 0.5, log);
+  std::vector<QMState> states = {QMState("s1"), QMState("ks5"),
+                                 QMState("n")};
+  std::vector<std::string> files = {"test_multi_s1.cube", "test_multi_ks5.cube",
+                                    "test_multi_n.cube"};
+  writer.WriteFiles(files, A, states, false);
+
+  auto result1 = Readcubefile("test_multi_s1.cube");
+  Eigen::VectorXd values_ref1 = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+      std::string(XTP_TEST_DATA_FOLDER) + "/cubefile_writer/values_ref1.mm");
+  BOOST_CHECK_EQUAL(values_ref1.size(), result1.size());
+  BOOST_CHECK(values_ref1.isApprox(result1, 1e-4));
+
+  for (votca::Index i = 1; i < votca::Index(states.size()); i++) {
+    writer.WriteFile("test_single.cube", A, states[i], false);
+    auto single = Readcubefile("test_single.cube");
+    auto multi = Readcubefile(files[i]);
+    BOOST_CHECK_EQUAL(single.size(), multi.size());
+    BOOST_CHECK(single.isApprox(multi, 1e-10));
+  }
+
+  writer.WriteHDF5("test_multi.h5", A, states, false);
+  CheckpointFile cpf("test_multi.h5", CheckpointAccessLevel::READ);
+  CheckpointReader r = cpf.getReader();
+  votca::Index zsteps;
+  r(zsteps, "zsteps");
+  BOOST_CHECK_EQUAL(zsteps, 7);
+  votca::Index gridsize = steps.prod();
+  for (votca::Index i = 0; i < votca::Index(states.size()); i++) {
+    CheckpointReader sr = r.openChild(states[i].ToString());
+    CptTable table = sr.openTable<GridValue>("values");
+    BOOST_CHECK_EQUAL(votca::Index(table.numRows()), gridsize);
+    std::vector<double> values(table.numRows());
+    table.read(values);
+    Eigen::VectorXd cube = Readcubefile(files[i]).tail(gridsize);
+    Eigen::Map<Eigen::VectorXd> h5(values.data(), gridsize);
+    BOOST_CHECK(cube.isApprox(h5, 1e-4));
+  }
+
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -138,6 +138,7 @@ BOOST_AUTO_TEST_CASE(dft_full) {
   xml << "    <mixing>0.7</mixing>\n";
   xml << "</convergence>" << std::endl;
   xml << "<integration_grid>xcoarse</integration_grid>" << std::endl;
+  xml << "<multipole_farfield_tolerance>0</multipole_farfield_tolerance>\n";
   xml << "<max_iterations>200</max_iterations>" << std::endl;
   xml << "</xtpdft>" << std::endl;
   xml << "</dftpackage>" << std::endl;
@@ -232,6 +233,7 @@ BOOST_AUTO_TEST_CASE(density_guess) {
   xml << "    <mixing>0.7</mixing>\n";
   xml << "</convergence>" << std::endl;
   xml << "<integration_grid>xcoarse</integration_grid>" << std::endl;
+  xml << "<multipole_farfield_tolerance>0</multipole_farfield_tolerance>\n";
   xml << "<max_iterations>1</max_iterations>" << std::endl;
   xml << "</xtpdft>" << std::endl;
   xml << "</dftpackage>" << std::endl;
@@ -145,6 +145,15 @@ BOOST_AUTO_TEST_CASE(threecenter) {
     std::cout << eris_ref << std::endl;
   }
   BOOST_CHECK_EQUAL(compare_eris, true);
+
+  // J and K of a density difference added to the old ones, with screening
+  Eigen::MatrixXd dmat_old = 0.9 * dmat;
+  std::array<Eigen::MatrixXd, 2> old =
+      eris.CalculateERIs_EXX_3c(Eigen::MatrixXd::Zero(0, 0), dmat_old);
+  std::array<Eigen::MatrixXd, 2> diff = eris.CalculateERIs_EXX_3c(
+      Eigen::MatrixXd::Zero(0, 0), dmat - dmat_old, 1e-8);
+  BOOST_CHECK(eri.isApprox(old[0] + diff[0], 1e-6));
+  BOOST_CHECK(exx_dmat.isApprox(old[1] + diff[1], 1e-6));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,7 @@
 #include "votca/xtp/espfit.h"
 #include "votca/xtp/logger.h"
 #include "votca/xtp/orbitals.h"
+#include "votca/xtp/ripotential.h"
 #include <libint2/initialize.h>
 using namespace votca::xtp;
 using namespace votca;
@@ -116,4 +117,89 @@ BOOST_AUTO_TEST_CASE(esp_charges) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(esp_charges_ri) {
+  libint2::initialize();
+  Orbitals orbitals;
+  orbitals.QMAtoms().LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                                  "/espfit/molecule.xyz");
+  orbitals.SetupDftBasis(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/espfit/3-21G.xml");
+  orbitals.SetupAuxBasis(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/espfit/aux-def2-svp.xml");
+  orbitals.setNumberOfOccupiedLevels(5);
+
+  Eigen::MatrixXd MOs = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+      std::string(XTP_TEST_DATA_FOLDER) + "/espfit/MOs.mm");
+  orbitals.MOs().eigenvectors() = MOs;
+  orbitals.MOs().eigenvalues() = Eigen::VectorXd::Ones(13);
+  QMState gs = QMState("n");
+  Logger log;
+
+  auto charges = [&orbitals](const StaticSegment& result) {
+    Eigen::VectorXd pcharges =
+        Eigen::VectorXd::Zero(orbitals.QMAtoms().size());
+    Index index = 0;
+    for (const auto& site : result) {
+      pcharges(index) = site.getCharge();
+      index++;
+    }
+    return pcharges;
+  };
+
+  // the reference is the numerically integrated density on a fine grid,
+  // the fitted density has to give the same charges up to the fitting error
+  Espfit esp_num = Espfit(log);
+  esp_num.setUseSVD(1e-8);
+  Eigen::VectorXd p_num = charges(esp_num.Fit2Density(orbitals, gs, "fine"));
+
+  Espfit esp_ri = Espfit(log);
+  esp_ri.setUseSVD(1e-8);
+  esp_ri.setUseRI(0.0);
+  Eigen::VectorXd p_ri = charges(esp_ri.Fit2Density(orbitals, gs, "fine"));
+  double error_ri = (p_ri - p_num).cwiseAbs().maxCoeff();
+  if (error_ri > 2e-3) {
+    std::cout << "numerical" << std::endl;
+    std::cout << p_num << std::endl;
+    std::cout << "fitted density" << std::endl;
+    std::cout << p_ri << std::endl;
+  }
+  BOOST_CHECK_LT(error_ri, 2e-3);
+  BOOST_CHECK_SMALL(p_ri.sum(), 1e-6);
+
+  // far from the molecule the potential of the fitted density is taken from
+  // its multipole moments, the total potential of the neutral molecule is
+  // dominated by the dipole there, so a wrong sign of a moment shows up
+  AOBasis dftbasis = orbitals.getDftBasis();
+  AOBasis auxbasis = orbitals.getAuxBasis();
+  RIPotential direct(dftbasis, auxbasis);
+  direct.FitDensity(orbitals.DensityMatrixFull(gs));
+  BOOST_CHECK_CLOSE(direct.FittedElectrons(), 10.0, 0.1);
+  RIPotential farfield(dftbasis, auxbasis);
+  farfield.setFarfieldTolerance(1e-2);
+  farfield.FitDensity(orbitals.DensityMatrixFull(gs));
+
+  std::vector<Eigen::Vector3d> positions;
+  for (double distance : {200.0, 400.0}) {
+    positions.push_back(distance * Eigen::Vector3d(1.0, 0.0, 0.0));
+    positions.push_back(distance * Eigen::Vector3d(0.0, -1.0, 0.0));
+    positions.push_back(distance * Eigen::Vector3d(0.0, 0.0, 1.0));
+    positions.push_back(distance *
+                        Eigen::Vector3d(1.0, 1.0, -1.0).normalized());
+  }
+  Eigen::VectorXd nuclear = Eigen::VectorXd::Zero(Index(positions.size()));
+  for (Index i = 0; i < Index(positions.size()); i++) {
+    for (const QMAtom& atom : orbitals.QMAtoms()) {
+      nuclear(i) +=
+          double(atom.getNuccharge()) / (positions[i] - atom.getPos()).norm();
+    }
+  }
+  Eigen::VectorXd total_direct = nuclear + direct.Potential(positions);
+  Eigen::VectorXd total_farfield = nuclear + farfield.Potential(positions);
+  double error_farfield =
+      (total_farfield - total_direct).cwiseAbs().maxCoeff();
+  BOOST_CHECK_LT(error_farfield, 1e-2 * total_direct.cwiseAbs().maxCoeff());
+
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE eventgraph_test
+
+// Standard includes
+#include <vector>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/eventgraph.h"
+
+using namespace votca;
+using namespace votca::xtp;
+
+BOOST_AUTO_TEST_SUITE(eventgraph_test)
+
+BOOST_AUTO_TEST_CASE(rates_test) {
+  QMStateType e = QMStateType::Electron;
+  std::vector<Segment> segs;
+  for (Index i = 0; i < 4; i++) {
+    segs.push_back(Segment("one", i));
+    segs.back().setU_nX_nN(0.002 + 0.001 * double(i), e);
+    segs.back().setU_xN_xX(0.001, e);
+    segs.back().setU_xX_nN(0.001 + 0.0005 * double(i), e);
+    segs.back().setEMpoles(e, -0.001 * double(i));
+  }
+  QMNBList nblist;
+  nblist.Add(segs[0], segs[1], Eigen::Vector3d(5, 0, 0));
+  nblist.Add(segs[2], segs[0], Eigen::Vector3d(0, 4, 0));
+  nblist.Add(segs[1], segs[3], Eigen::Vector3d(0, 0, -3));
+  for (QMPair* pair : nblist) {
+    pair->setJeff2(1e-6 * double(pair->getId() + 1), e);
+  }
+
+  EventGraph graph(nblist, 4, e);
+  BOOST_CHECK_EQUAL(graph.NumberOfSites(), 4);
+  BOOST_CHECK_EQUAL(graph.NumberOfEvents(), 6);
+  std::vector<Index> counts = {2, 2, 1, 1};
+  for (Index i = 0; i < 4; i++) {
+    BOOST_CHECK_EQUAL(graph.EventCount(i), counts[i]);
+  }
+  // the events of a site are in the order of the pairs
+  BOOST_CHECK_EQUAL(graph.Destination(graph.EventsBegin(0)), 1);
+  BOOST_CHECK_EQUAL(graph.Destination(graph.EventsBegin(0) + 1), 2);
+
+  Eigen::Vector3d field = {1.0, 0.5, 0.0};
+  field *= 9.72345198649679e-05;
+  double temperature = 0.000950043476927;  // 300K
+  Rate_Engine engine(temperature, field);
+  graph.UpdateRates(engine);
+
+  for (Index site = 0; site < 4; site++) {
+    for (Index ev = graph.EventsBegin(site); ev < graph.EventsEnd(site);
+         ev++) {
+      const QMPair* pair = nblist[graph.PairId(ev)];
+      Rate_Engine::PairRates rates = engine.Rate(*pair, e);
+      if (graph.isForward(ev)) {
+        BOOST_CHECK_EQUAL(pair->Seg1()->getId(), site);
+        BOOST_CHECK(graph.DeltaR(ev).isApprox(pair->R()));
+        BOOST_CHECK_CLOSE(graph.Rate(ev), rates.rate12, 1e-8);
+      } else {
+        BOOST_CHECK_EQUAL(pair->Seg2()->getId(), site);
+        BOOST_CHECK(graph.DeltaR(ev).isApprox(-pair->R()));
+        BOOST_CHECK_CLOSE(graph.Rate(ev), rates.rate21, 1e-8);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(update_test) {
+  QMStateType e = QMStateType::Electron;
+  std::vector<Segment> segs;
+  for (Index i = 0; i < 4; i++) {
+    segs.push_back(Segment("one", i));
+    segs.back().setU_nX_nN(0.002, e);
+    segs.back().setU_xN_xX(0.001, e);
+  }
+  QMNBList nblist;
+  nblist.Add(segs[0], segs[1], Eigen::Vector3d(5, 0, 0));
+  nblist.Add(segs[2], segs[3], Eigen::Vector3d(0, 4, 0));
+  for (QMPair* pair : nblist) {
+    pair->setJeff2(1e-6, e);
+  }
+
+  EventGraph graph(nblist, 4, e);
+  double temperature = 0.000950043476927;  // 300K
+  std::vector<Index> all = {0, 1, 2, 3};
+  Rate_Engine engine(temperature, Eigen::Vector3d::Zero());
+  BOOST_CHECK(graph.UpdateRates(engine) == all);
+  BOOST_CHECK(graph.UpdateRates(engine).empty());
+
+  // a field along the first pair only changes the rates of its sites
+  Eigen::Vector3d field = {9.72345198649679e-05, 0.0, 0.0};
+  std::vector<double> rates_before = graph.Rates();
+  std::vector<Index> changed =
+      graph.UpdateRates(Rate_Engine(temperature, field));
+  BOOST_CHECK(changed == std::vector<Index>({0, 1}));
+  BOOST_CHECK_EQUAL(graph.Rate(graph.EventsBegin(2)),
+                    rates_before[graph.EventsBegin(2)]);
+
+  {
+    CheckpointFile cpf("eventgraph.hdf5", CheckpointAccessLevel::CREATE);
+    CheckpointWriter w = cpf.getWriter("/eventgraph");
+    graph.WriteToCpt(w);
+  }
+  EventGraph graph2;
+  {
+    CheckpointFile cpf("eventgraph.hdf5", CheckpointAccessLevel::READ);
+    CheckpointReader r = cpf.getReader("/eventgraph");
+    graph2.ReadFromCpt(r);
+  }
+  BOOST_CHECK_EQUAL(graph2.NumberOfSites(), graph.NumberOfSites());
+  BOOST_CHECK(graph2.Rates() == graph.Rates());
+  BOOST_CHECK(graph2.Destinations() == graph.Destinations());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -47,26 +47,59 @@ BOOST_AUTO_TEST_CASE(chosen_id_test) {
   }
   Segment seg("one", 6);
   GNode g(seg, electron, true);
-  g.AddEvent(&dests[0], Eigen::Vector3d::Zero(), 10);
-  g.AddEvent(&dests[1], Eigen::Vector3d::Zero(), 20);
-  g.AddEvent(&dests[2], Eigen::Vector3d::Zero(), 15);
-  g.AddEvent(&dests[3], Eigen::Vector3d::Zero(), 18);
-  g.AddEvent(&dests[4], Eigen::Vector3d::Zero(), 12);
-  g.AddEvent(&dests[5], Eigen::Vector3d::Zero(), 25);
+  std::vector<Index> destinations = {0, 1, 2, 3, 4, 5};
+  std::vector<double> rates = {10, 20, 15, 18, 12, 25};
+  Eigen::Matrix3Xd dr = Eigen::Matrix3Xd::Zero(3, 6);
+  g.setEvents(dests.data(), destinations.data(), rates.data(), dr.data(), 6);
   g.InitEscapeRate();
   g.MakeHuffTree();
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.55)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.55).getDestination()->getId(),
                     0);
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.85)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.85).getDestination()->getId(),
                     1);
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.25)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.25).getDestination()->getId(),
                     2);
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.15)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.15).getDestination()->getId(),
                     3);
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.35)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.35).getDestination()->getId(),
                     4);
-  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.65)->getDestination()->getId(),
+  BOOST_CHECK_EQUAL(g.findHoppingDestination(0.65).getDestination()->getId(),
                     5);
+
+  // the node reads the rates from the arrays it was given
+  rates[5] = 0;
+  g.UpdateEventRates();
+  BOOST_CHECK_CLOSE(g.getEscapeRate(), 75, 1e-12);
+  for (double p = 0.01; p < 1; p += 0.01) {
+    BOOST_CHECK(g.findHoppingDestination(p).getDestination()->getId() != 5);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(decay_test) {
+  QMStateType singlet = QMStateType::Singlet;
+  std::vector<GNode> nodes;
+  for (Index i = 0; i < 2; i++) {
+    Segment seg("one", i);
+    nodes.push_back(GNode(seg, singlet, true));
+  }
+  std::vector<Index> destinations = {1};
+  std::vector<double> rates = {3};
+  Eigen::Matrix3Xd dr(3, 1);
+  dr.col(0) = Eigen::Vector3d(1, 2, 3);
+  GNode& g = nodes[0];
+  g.setEvents(nodes.data(), destinations.data(), rates.data(), dr.data(), 1);
+  g.AddDecayEvent(1);
+  g.InitEscapeRate();
+  g.MakeHuffTree();
+  BOOST_CHECK_EQUAL(g.EventCount(), 2);
+  BOOST_CHECK_CLOSE(g.getEscapeRate(), 4, 1e-12);
+
+  GLink hop = g.Event(0);
+  BOOST_CHECK(!hop.isDecayEvent());
+  BOOST_CHECK_EQUAL(hop.getDestination(), &nodes[1]);
+  BOOST_CHECK(hop.getDeltaR().isApprox(dr.col(0)));
+  BOOST_CHECK(g.Event(1).isDecayEvent());
+  BOOST_CHECK_CLOSE(g.Event(1).getRate(), 1, 1e-12);
 }
 
 BOOST_AUTO_TEST_CASE(count_test) {
@@ -80,25 +113,18 @@ BOOST_AUTO_TEST_CASE(count_test) {
   Segment seg("one", 12);
   GNode g(seg, electron, true);
 
-  g.AddEvent(&dests[0], Eigen::Vector3d::Zero(), 15);
-  g.AddEvent(&dests[1], Eigen::Vector3d::Zero(), 9);
-  g.AddEvent(&dests[2], Eigen::Vector3d::Zero(), 11);
-  g.AddEvent(&dests[3], Eigen::Vector3d::Zero(), 8);
-  g.AddEvent(&dests[4], Eigen::Vector3d::Zero(), 12);
-  g.AddEvent(&dests[5], Eigen::Vector3d::Zero(), 7);
-  g.AddEvent(&dests[6], Eigen::Vector3d::Zero(), 13);
-  g.AddEvent(&dests[7], Eigen::Vector3d::Zero(), 6);
-  g.AddEvent(&dests[8], Eigen::Vector3d::Zero(), 14);
-  g.AddEvent(&dests[9], Eigen::Vector3d::Zero(), 5);
-  g.AddEvent(&dests[10], Eigen::Vector3d::Zero(), 100);
+  std::vector<Index> destinations = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  std::vector<double> rates = {15, 9, 11, 8, 12, 7, 13, 6, 14, 5, 100};
+  Eigen::Matrix3Xd dr = Eigen::Matrix3Xd::Zero(3, 11);
+  g.setEvents(dests.data(), destinations.data(), rates.data(), dr.data(), 11);
 
   g.InitEscapeRate();
   g.MakeHuffTree();
   std::vector<Index> count(11, 0);
   double d = 0;
   while (d < 1) {
-    GLink* L = g.findHoppingDestination(d);
-    Index ind = L->getDestination()->getId();
+    GLink L = g.findHoppingDestination(d);
+    Index ind = L.getDestination()->getId();
     count[ind]++;
     d += 0.000001;
   }
@@ -43,6 +43,7 @@ BOOST_AUTO_TEST_CASE(off_test) {
   fb.resetMatrices(J, K, dmat);
   BOOST_CHECK(J.isApproxToConstant(0.0));
   BOOST_CHECK(K.isApproxToConstant(0.0));
+  BOOST_CHECK(!fb.isIncremental());
 
   BOOST_CHECK(fb.getDmat_diff().isApprox(dmat));
 
@@ -71,6 +72,7 @@ BOOST_AUTO_TEST_CASE(on_test) {
   fb.resetMatrices(J, K, dmat);
   BOOST_CHECK(J.isApprox(J2));
   BOOST_CHECK(K.isApprox(K2));
+  BOOST_CHECK(fb.isIncremental());
 
   fb.UpdateCriteria(1e-6, iteration);
   fb.UpdateDmats(dmat, 1e-6, iteration);
@@ -87,6 +89,7 @@ BOOST_AUTO_TEST_CASE(on_test) {
   fb.resetMatrices(J, K, dmat);
   BOOST_CHECK(J.isApproxToConstant(0.0));
   BOOST_CHECK(K.isApproxToConstant(0.0));
+  BOOST_CHECK(!fb.isIncremental());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
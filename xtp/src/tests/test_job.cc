@@ -0,0 +1,131 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE job_test
+
+// Standard includes
+#include <fstream>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/job.h"
+
+using namespace votca::xtp;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(job_test)
+
+BOOST_AUTO_TEST_CASE(load_write_jobs) {
+
+  ofstream jobstream("jobs.xml");
+  jobstream << "<jobs>" << std::endl;
+  jobstream << "\t<job>" << std::endl;
+  jobstream << "\t\t<id>0</id>" << std::endl;
+  jobstream << "\t\t<tag>seg0:n</tag>" << std::endl;
+  jobstream << "\t\t<input>" << std::endl;
+  jobstream << "\t\t\t<segment id=\"0\" type=\"A\">0:n</segment>"
+            << std::endl;
+  jobstream << "\t\t</input>" << std::endl;
+  jobstream << "\t\t<status>COMPLETE</status>" << std::endl;
+  jobstream << "\t\t<host>node0</host>" << std::endl;
+  jobstream << "\t\t<output>" << std::endl;
+  jobstream << "\t\t\t<energy>1.5</energy>" << std::endl;
+  jobstream << "\t\t</output>" << std::endl;
+  jobstream << "\t</job>" << std::endl;
+  jobstream << "\t<job>" << std::endl;
+  jobstream << "\t\t<id>1</id>" << std::endl;
+  jobstream << "\t\t<tag>seg1:n</tag>" << std::endl;
+  jobstream << "\t\t<input>" << std::endl;
+  jobstream << "\t\t\t<segment id=\"1\" type=\"B\">1:n</segment>"
+            << std::endl;
+  jobstream << "\t\t</input>" << std::endl;
+  jobstream << "\t\t<status>AVAILABLE</status>" << std::endl;
+  jobstream << "\t</job>" << std::endl;
+  jobstream << "</jobs>" << std::endl;
+  jobstream.close();
+
+  std::vector<Job> jobs = LOAD_JOBS("jobs.xml");
+  BOOST_REQUIRE_EQUAL(jobs.size(), 2);
+  BOOST_CHECK_EQUAL(jobs[0].getId(), 0);
+  BOOST_CHECK_EQUAL(jobs[0].getTag(), "seg0:n");
+  BOOST_CHECK_EQUAL(jobs[0].getStatusStr(), "COMPLETE");
+  BOOST_CHECK_EQUAL(jobs[0].getHost(), "node0");
+  BOOST_CHECK(jobs[0].hasOutput());
+  BOOST_CHECK(!jobs[1].hasOutput());
+  BOOST_CHECK(!jobs[1].hasHost());
+
+  // only the input of the second job is parsed before writing
+  const votca::tools::Property& input = jobs[1].getInput();
+  BOOST_CHECK_EQUAL(input.name(), "input");
+  BOOST_CHECK_EQUAL(input.get("segment").as<std::string>(), "1:n");
+  BOOST_CHECK_EQUAL(input.get("segment").getAttribute<std::string>("type"),
+                    "B");
+
+  jobs[1].Reset();
+  jobs[1].setStatus("ASSIGNED");
+  jobs[1].setHost("node1");
+  WRITE_JOBS(jobs, "jobs.xml");
+
+  // the pending payloads now refer to the rewritten file
+  BOOST_CHECK_EQUAL(jobs[0].getOutput().get("energy").as<double>(), 1.5);
+  BOOST_CHECK_EQUAL(jobs[0].getInput().get("segment").as<std::string>(),
+                    "0:n");
+
+  std::vector<Job> reloaded = LOAD_JOBS("jobs.xml");
+  BOOST_REQUIRE_EQUAL(reloaded.size(), 2);
+  BOOST_CHECK_EQUAL(reloaded[1].getStatusStr(), "ASSIGNED");
+  BOOST_CHECK_EQUAL(reloaded[1].getHost(), "node1");
+  const votca::tools::Property& first = reloaded[0].getInput();
+  BOOST_CHECK_EQUAL(first.get("segment").getAttribute<int>("id"), 0);
+  BOOST_CHECK_EQUAL(reloaded[0].getOutput().get("energy").as<double>(), 1.5);
+  const votca::tools::Property& segment = reloaded[1].getInput().get("segment");
+  BOOST_CHECK_EQUAL(segment.getAttribute<std::string>("type"), "B");
+}
+
+BOOST_AUTO_TEST_CASE(update_jobs) {
+
+  ofstream jobstream("jobs_update.xml");
+  jobstream << "<jobs>" << std::endl;
+  jobstream << "\t<job>" << std::endl;
+  jobstream << "\t\t<id>3</id>" << std::endl;
+  jobstream << "\t\t<tag>pair</tag>" << std::endl;
+  jobstream << "\t\t<input>" << std::endl;
+  jobstream << "\t\t\t<pair>3</pair>" << std::endl;
+  jobstream << "\t\t</input>" << std::endl;
+  jobstream << "\t\t<status>COMPLETE</status>" << std::endl;
+  jobstream << "\t\t<host>other</host>" << std::endl;
+  jobstream << "\t\t<output>" << std::endl;
+  jobstream << "\t\t\t<coupling>0.25</coupling>" << std::endl;
+  jobstream << "\t\t</output>" << std::endl;
+  jobstream << "\t</job>" << std::endl;
+  jobstream << "</jobs>" << std::endl;
+  jobstream.close();
+
+  votca::tools::Property input;
+  input.add("input", "").add("pair", "3");
+  std::vector<Job> jobs;
+  jobs.push_back(Job(3, "pair", input, Job::AVAILABLE));
+
+  UPDATE_JOBS(LOAD_JOBS("jobs_update.xml"), jobs, "this");
+  BOOST_CHECK_EQUAL(jobs[0].getStatusStr(), "COMPLETE");
+  BOOST_CHECK_EQUAL(jobs[0].getHost(), "other");
+  BOOST_CHECK_EQUAL(jobs[0].getOutput().get("coupling").as<double>(), 0.25);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
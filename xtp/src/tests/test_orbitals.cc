@@ -256,4 +256,40 @@ BOOST_AUTO_TEST_CASE(osc_strength) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(lazy_loading) {
+  Orbitals orbitals;
+  orbitals.QMAtoms().LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                                  "/orbitals/molecule.xyz");
+  orbitals.SetupDftBasis(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/orbitals/3-21G.xml");
+  orbitals.SetupAuxBasis(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/orbitals/3-21G.xml");
+  orbitals.setNumberOfOccupiedLevels(4);
+  orbitals.MOs().eigenvalues() = Eigen::VectorXd::LinSpaced(17, -1, 1);
+  orbitals.MOs().eigenvectors() =
+      votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+          std::string(XTP_TEST_DATA_FOLDER) + "/orbitals/MOs2.mm");
+  orbitals.setBSEindices(0, 16);
+  orbitals.BSESinglets().eigenvalues() = Eigen::VectorXd::Ones(3);
+  orbitals.BSESinglets().eigenvectors() = Eigen::MatrixXd::Random(52, 3);
+  orbitals.WriteToCpt("lazy.orb");
+
+  Orbitals lazy;
+  lazy.ReadFromCpt("lazy.orb");
+  Orbitals copy = lazy;
+  BOOST_CHECK(copy.BSESinglets().eigenvectors().isApprox(
+      orbitals.BSESinglets().eigenvectors(), 1e-12));
+  BOOST_CHECK(lazy.MOs().eigenvectors().isApprox(
+      orbitals.MOs().eigenvectors(), 1e-12));
+
+  // writing back to the file it was read from first reads everything
+  lazy.WriteToCpt("lazy.orb");
+  Orbitals reread;
+  reread.ReadFromCpt("lazy.orb");
+  BOOST_CHECK(reread.BSESinglets().eigenvectors().isApprox(
+      orbitals.BSESinglets().eigenvectors(), 1e-12));
+  BOOST_CHECK(reread.MOs().eigenvalues().isApprox(orbitals.MOs().eigenvalues(),
+                                                  1e-12));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
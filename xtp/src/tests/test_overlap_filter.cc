@@ -24,6 +24,7 @@
 #include <boost/test/unit_test.hpp>
 
 // Local VOTCA includes
+#include <votca/xtp/checkpoint.h>
 #include <votca/xtp/filterfactory.h>
 
 // VOTCA includes
@@ -157,6 +158,26 @@ BOOST_AUTO_TEST_CASE(coeffs_test) {
     BOOST_CHECK_EQUAL(ref_btda[i], results_btda[i]);
   }
 
+  // the factorised previous state and its basis survive the checkpoint
+  {
+    CheckpointFile ff("overlap_filter.hdf5");
+    CheckpointWriter ww = ff.getWriter();
+    rho_f3->WriteToCpt(ww);
+  }
+  std::unique_ptr<StateFilter_base> rho_f4 =
+      std::unique_ptr<StateFilter_base>(Filter().Create("overlap"));
+  {
+    CheckpointFile ff("overlap_filter.hdf5", CheckpointAccessLevel::READ);
+    CheckpointReader rr = ff.getReader();
+    rho_f4->ReadFromCpt(rr);
+  }
+  std::vector<votca::Index> results_cpt =
+      rho_f4->CalcIndeces(A, QMStateType::Singlet);
+  BOOST_CHECK_EQUAL(results_cpt.size(), ref_btda.size());
+  for (votca::Index i = 0; i < votca::Index(results_cpt.size()); i++) {
+    BOOST_CHECK_EQUAL(ref_btda[i], results_cpt[i]);
+  }
+
   libint2::finalize();
 }
 
@@ -26,6 +26,7 @@
 #include <votca/tools/filesystem.h>
 
 // Local VOTCA includes
+#include "votca/xtp/aomatrix.h"
 #include "votca/xtp/logger.h"
 #include "votca/xtp/orbitals.h"
 #include "votca/xtp/pmlocalization.h"
@@ -35,6 +36,25 @@ using namespace votca;
 using namespace std;
 
 BOOST_AUTO_TEST_SUITE(pmlocalization_test)
+
+// sum over orbitals and atoms of the squared Mulliken populations
+double PMFunctional(const Eigen::MatrixXd &lmos, const AOBasis &basis) {
+  AOOverlap overlap;
+  overlap.Fill(basis);
+  Eigen::MatrixXd s_lmos = overlap.Matrix() * lmos;
+  double functional = 0.0;
+  for (Index i = 0; i < lmos.cols(); i++) {
+    Index start = 0;
+    for (Index nfunc : basis.getFuncPerAtom()) {
+      double pop = lmos.col(i).segment(start, nfunc).dot(
+          s_lmos.col(i).segment(start, nfunc));
+      functional += pop * pop;
+      start += nfunc;
+    }
+  }
+  return functional;
+}
+
 BOOST_AUTO_TEST_CASE(jacobisweeps_test) {
 
   libint2::initialize();
@@ -131,4 +151,52 @@ BOOST_AUTO_TEST_CASE(unitaryoptimizer_test) {
   libint2::finalize();
 }
 
+BOOST_AUTO_TEST_CASE(parallel_jacobi_and_gradient_ascent_test) {
+
+  libint2::initialize();
+  Orbitals orbitals;
+  orbitals.QMAtoms().LoadFromFile(std::string(XTP_TEST_DATA_FOLDER) +
+                                  "/pmlocalization/ch3oh.xyz");
+  orbitals.setNumberOfOccupiedLevels(9);
+  orbitals.setNumberOfAlphaElectrons(9);
+
+  orbitals.SetupDftBasis(std::string(XTP_TEST_DATA_FOLDER) +
+                         "/pmlocalization/def2-tzvp.xml");
+
+  orbitals.MOs().eigenvectors() =
+      votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+          std::string(XTP_TEST_DATA_FOLDER) +
+          "/pmlocalization/orbitalsMOs_ref.mm");
+  orbitals.MOs().eigenvalues() = votca::tools::EigenIO_MatrixMarket::ReadVector(
+      std::string(XTP_TEST_DATA_FOLDER) +
+      "/pmlocalization/ch3oh_energies_ref.mm");
+
+  Eigen::MatrixXd ref_LMOs = votca::tools::EigenIO_MatrixMarket::ReadMatrix(
+      std::string(XTP_TEST_DATA_FOLDER) + "/pmlocalization/ch3oh.mm");
+  double ref_functional = PMFunctional(ref_LMOs, orbitals.getDftBasis());
+
+  AOOverlap overlap;
+  overlap.Fill(orbitals.getDftBasis());
+
+  // both have to find the maximum the serial Jacobi sweeps found
+  for (std::string method : {"jacobi-sweeps", "gradient-ascent"}) {
+    Logger log;
+    tools::Property options;
+    options.add("max_iterations", "1000");
+    options.add("convergence_limit", "1e-12");
+    options.add("method", method);
+    options.add("parallel_rotations", "true");
+
+    PMLocalization pml(log, options);
+    pml.computePML(orbitals);
+
+    Eigen::MatrixXd LMOs = orbitals.getLMOs();
+    Eigen::MatrixXd norm = LMOs.transpose() * overlap.Matrix() * LMOs;
+    BOOST_CHECK(norm.isApprox(Eigen::MatrixXd::Identity(9, 9), 1e-8));
+    BOOST_CHECK_CLOSE(PMFunctional(LMOs, orbitals.getDftBasis()),
+                      ref_functional, 1e-5);
+  }
+  libint2::finalize();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -160,4 +160,18 @@ BOOST_AUTO_TEST_CASE(TraceofProd_test) {
   BOOST_CHECK_EQUAL(check, 1);
 }
 
+BOOST_AUTO_TEST_CASE(Norm_test) {
+
+  Index dim = 5;
+  Eigen::MatrixXd test = Eigen::MatrixXd::Random(dim, dim);
+  Eigen::MatrixXd trans = test.transpose();
+  test += trans;
+  Symmetric_Matrix sym = Symmetric_Matrix(test);
+  BOOST_CHECK_CLOSE(sym.FrobeniusNorm(), test.norm(), 1e-10);
+
+  Symmetric_Matrix sum = Symmetric_Matrix(test);
+  sum.Packed() += 2.0 * sym.Packed();
+  BOOST_CHECK(sum.FullMatrix().isApprox(3 * test, 1e-10));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2009-2024 The VOTCA Development Team (http://www.votca.org)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#define BOOST_TEST_MAIN
+
+#define BOOST_TEST_MODULE threadreduction_test
+
+// Standard includes
+#include <array>
+
+// Third party includes
+#include <boost/test/unit_test.hpp>
+
+// Local VOTCA includes
+#include "votca/xtp/threadreduction.h"
+
+using namespace votca::xtp;
+using namespace votca;
+
+BOOST_AUTO_TEST_SUITE(threadreduction_test)
+
+BOOST_AUTO_TEST_CASE(add_blocks) {
+  Index rows = 37;
+  Index cols = 23;
+  std::vector<Eigen::MatrixXd> blocks;
+  std::vector<std::array<Index, 2>> offsets;
+  Eigen::MatrixXd ref = Eigen::MatrixXd::Zero(rows, cols);
+  for (Index i = 0; i < 50; i++) {
+    Index r = (7 * i) % 30;
+    Index c = (3 * i) % 20;
+    Eigen::MatrixXd block = Eigen::MatrixXd::Random(rows - r, cols - c);
+    ref.bottomRightCorner(rows - r, cols - c) += block;
+    blocks.push_back(block);
+    offsets.push_back({r, c});
+  }
+
+  TiledAccumulator acc(rows, cols, 5);
+#pragma omp parallel for
+  for (Index i = 0; i < Index(blocks.size()); i++) {
+    acc.Add(offsets[i][0], offsets[i][1], blocks[i]);
+  }
+  BOOST_CHECK(acc.Matrix().isApprox(ref, 1e-12));
+}
+
+BOOST_AUTO_TEST_CASE(add_upper_product) {
+  Index size = 31;
+  std::vector<Eigen::MatrixXd> as;
+  std::vector<Eigen::MatrixXd> bs;
+  Eigen::MatrixXd ref = Eigen::MatrixXd::Zero(size, size);
+  for (Index i = 0; i < 20; i++) {
+    as.push_back(Eigen::MatrixXd::Random(7, size));
+    bs.push_back(Eigen::MatrixXd::Random(7, size));
+    ref -= 0.5 * as.back().transpose() * bs.back();
+  }
+  ref.triangularView<Eigen::StrictlyLower>().setZero();
+
+  TiledAccumulator acc(size, size, 4);
+#pragma omp parallel for
+  for (Index i = 0; i < Index(as.size()); i++) {
+    acc.AddUpperProduct(-0.5, as[i], bs[i]);
+  }
+  BOOST_CHECK(acc.Matrix().isApprox(ref, 1e-12));
+}
+
+BOOST_AUTO_TEST_CASE(tree_reduce) {
+  for (Index n = 1; n < 10; n++) {
+    std::vector<Eigen::VectorXd> partials;
+    Eigen::VectorXd ref = Eigen::VectorXd::Zero(6);
+    for (Index i = 0; i < n; i++) {
+      partials.push_back(Eigen::VectorXd::Random(6));
+      ref += partials.back();
+    }
+    TreeReduce(partials);
+    BOOST_CHECK(partials[0].isApprox(ref, 1e-12));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
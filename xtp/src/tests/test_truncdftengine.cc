@@ -165,6 +165,7 @@ BOOST_AUTO_TEST_CASE(dft_trunc) {
   xml << "    <mixing>0.7</mixing>\n";
   xml << "</convergence>" << std::endl;
   xml << "<integration_grid>xcoarse</integration_grid>" << std::endl;
+  xml << "<multipole_farfield_tolerance>0</multipole_farfield_tolerance>\n";
   xml << "<max_iterations>100</max_iterations>" << std::endl;
   xml << "<dft_in_dft>" << std::endl;
   xml << "    <activeatoms>1</activeatoms>" << std::endl;